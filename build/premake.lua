@@ -624,5 +624,26 @@ project "PONY"
         SrcDir() .. "r2.ouro/",
         "pch.h" )
 
+-- ------------------------------------------------------------------------------
+project "BENCH"
+
+    kind "ConsoleApp"
+    SetupOuroveonLayer( true, "bench" )
+    CommonAppLink()
+
+    files
+    {
+        SrcDir() .. "r5.bench/pch.cpp",
+
+        SrcDir() .. "r5.bench/**.cpp",
+        SrcDir() .. "r5.bench/**.h",
+        SrcDir() .. "r5.bench/**.inl",
+    }
+
+    AddPCH( 
+        "../src/r5.bench/pch.cpp",
+        SrcDir() .. "r2.ouro/",
+        "pch.h" )
+
 
 group ""
@@ -10,6 +10,7 @@
 #include "pch.h"
 
 #include "base/instrumentation.h"
+#include "base/logging.h"
 #include "base/operations.h"
 
 #include "data/uuid.h"
@@ -18,6 +19,7 @@
 #include "config/frontend.h"
 #include "config/data.h"
 #include "config/layout.h"
+#include "config/logging.h"
 
 #include "app/core.h"
 #include "app/module.frontend.h"
@@ -29,6 +31,8 @@
 
 #include "platform_folders.h"
 
+#include <csignal>
+
 
 #if OURO_PLATFORM_WIN
 #include "win32/utils.h"
@@ -171,12 +175,18 @@ CoreStart::CoreStart()
     base::instr::setThreadName( OURO_THREAD_PREFIX "$::main-thread" );
 
     base::OperationsInit();
+
+    // move logging off to its background thread from here on
+    blog::backend::start();
 }
 
 CoreStart::~CoreStart()
 {
     base::OperationsTerm();
 
+    // flush out anything outstanding and return to direct logging
+    blog::backend::stop();
+
     rpmalloc_finalize();
 }
 
@@ -185,6 +195,7 @@ Core::Core()
     : CoreStart()
     , m_networkConfiguration( std::make_shared<endlesss::api::NetConfiguration>() )
     , m_taskExecutor(        std::clamp( std::thread::hardware_concurrency(), 2U, OURO_THREAD_LIMIT ), std::make_shared<TaskFlowWorkerHook>("app")  )
+    , m_taskExecutorIO(      std::clamp( std::thread::hardware_concurrency(), OURO_IO_THREAD_MIN, OURO_IO_THREAD_MAX ), std::make_shared<TaskFlowWorkerHook>("io") )
     , m_taskExecutorPlugins( std::clamp( std::thread::hardware_concurrency(), 1U, 3U ),                std::make_shared<TaskFlowWorkerHook>("plug") )
 {
 }
@@ -252,6 +263,7 @@ int Core::Run()
     // big and wide
     blog::core( FMTX( "initialising taskflow {}" ), tf::version() );
     blog::core( FMTX( " + {} primary worker threads" ), m_taskExecutor.num_workers() );
+    blog::core( FMTX( " + {} i/o worker threads" ), m_taskExecutorIO.num_workers() );
     blog::core( FMTX( " + {} plugin pool threads" ), m_taskExecutorPlugins.num_workers() );
 
     // configure app event bus
@@ -363,6 +375,39 @@ int Core::Run()
         }
     }
 
+    // apply any logging preferences now we know where to find them; optional
+    {
+        config::Logging configLogging;
+        if ( config::load( *this, configLogging ) == config::LoadResult::Success )
+        {
+            for ( const auto& [ systemName, levelName ] : configLogging.minimumLevels )
+            {
+                const auto system = blog::backend::systemFromName( systemName );
+                const auto level  = blog::backend::levelFromName( levelName );
+                if ( !system.has_value() || !level.has_value() )
+                {
+                    blog::error::cfg( FMTX( "unknown logging filter [{} : {}]" ), systemName, levelName );
+                    continue;
+                }
+                blog::backend::setMinimumLevel( system.value(), level.value() );
+            }
+
+            if ( configLogging.fileSinkEnabled )
+            {
+                const auto fileSinkStatus = blog::backend::openRotatingFileSink(
+                    m_appConfigPath / "logs",
+                    GetAppCacheName(),
+                    static_cast<uint64_t>( configLogging.fileSinkMaxSizeMb ) * 1024 * 1024,
+                    static_cast<uint32_t>( configLogging.fileSinkMaxFiles ) );
+
+                if ( !fileSinkStatus.ok() )
+                {
+                    blog::error::core( FMTX( "unable to open log file ({})" ), fileSinkStatus.ToString() );
+                }
+            }
+        }
+    }
+
     // set network debugging capture output to be per-app into the writable config area
     m_networkConfiguration->setVerboseCaptureOutputPath( m_appConfigPath );
 
@@ -507,6 +552,7 @@ int Core::Run()
     }
 
     // finish up any async tasks run during startup
+    m_taskExecutorIO.wait_for_all();
     m_taskExecutor.wait_for_all();
 
     // ---------------------------------
@@ -613,6 +659,39 @@ void Core::emitAndClearExchangeData()
 #endif // OURO_EXCHANGE_IPC
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+void Core::runMainThreadCalls( const float deltaTime )
+{
+    std::scoped_lock<std::mutex> slm( m_mainThreadCallsMutex );
+    for ( auto& mtCall : m_mainThreadCalls )
+    {
+        mtCall.second( deltaTime );
+    }
+
+    m_stemDataProcessor.update( deltaTime, 0.35f );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+namespace {
+std::atomic_bool gTerminationRequested = false;
+
+void onTerminationSignal( int )
+{
+    gTerminationRequested = true;
+}
+} // anonymous namespace
+
+void Core::installTerminationHandlers()
+{
+    std::signal( SIGINT,  onTerminationSignal );
+    std::signal( SIGTERM, onTerminationSignal );
+}
+
+bool Core::wasTerminationRequested()
+{
+    return gTerminationRequested;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 void Core::tickActivityUpdate()
 {
@@ -869,6 +948,12 @@ void CoreGUI::imguiModalBasicOkCancel( const char* title, std::string_view displ
 // ---------------------------------------------------------------------------------------------------------------------
 int CoreGUI::Entrypoint()
 {
+    if ( shouldRunHeadless() )
+    {
+        blog::core( FMTX( "running headless, no frontend will be created" ) );
+        return EntrypointHeadless();
+    }
+
     const auto feLoad = config::load( *this, m_configFrontend );
     if ( feLoad != config::LoadResult::Success )
     {
@@ -983,6 +1068,13 @@ int CoreGUI::Entrypoint()
     return appResult;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+int CoreGUI::EntrypointHeadless()
+{
+    blog::error::core( FMTX( "{} does not support running headless" ), GetAppName() );
+    return -1;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 void CoreGUI::activateModalPopup( const std::string_view& label, ModalPopupExecutor&& executor )
 {
@@ -1012,16 +1104,7 @@ bool CoreGUI::beginInterfaceLayout( const ViewportFlags viewportFlags )
         return false;
 
     // run main-thread callbacks & misc updates
-    {
-        const float deltaTime = ImGui::GetIO().DeltaTime;
-        std::scoped_lock<std::mutex> slm( m_mainThreadCallsMutex );
-        for ( auto& mtCall : m_mainThreadCalls )
-        {
-            mtCall.second( deltaTime );
-        }
-
-        m_stemDataProcessor.update( deltaTime, 0.35f );
-    }
+    runMainThreadCalls( ImGui::GetIO().DeltaTime );
 
     // inject dock space if we're expecting to lay the imgui out with docking
     if ( hasViewportFlag( viewportFlags, VF_WithDocking ) )
@@ -1477,13 +1560,13 @@ bool CoreGUI::unregisterMainMenuEntry( const UIInjectionHandle handle )
     return false;
 }
 
-void CoreGUI::registerMainThreadCall( std::string_view name, MainThreadCall func )
+void Core::registerMainThreadCall( std::string_view name, MainThreadCall func )
 {
     std::scoped_lock<std::mutex> slm( m_mainThreadCallsMutex );
     m_mainThreadCalls.emplace( name, func );
 }
 
-void CoreGUI::unregisterMainThreadCall( std::string_view name )
+void Core::unregisterMainThreadCall( std::string_view name )
 {
     std::scoped_lock<std::mutex> slm( m_mainThreadCallsMutex );
     m_mainThreadCalls.erase( name );
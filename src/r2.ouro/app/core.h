@@ -103,6 +103,7 @@ struct ICoreServices : public config::IPathProvider
     ouro_nodiscard virtual const endlesss::toolkit::Exchange&           getEndlesssExchange() const = 0;
     ouro_nodiscard virtual const endlesss::toolkit::PopulationQuery&    getEndlesssPopulation() const = 0;
     ouro_nodiscard virtual tf::Executor&                                getTaskExecutor() = 0;
+    ouro_nodiscard virtual tf::Executor&                                getTaskExecutorIO() = 0;
     ouro_nodiscard virtual tf::Executor&                                getTaskExecutorPlugins() = 0;
     ouro_nodiscard virtual sol::state_view&                             getLuaState() = 0;
     ouro_nodiscard virtual base::EventBusClient                         getEventBusClient() const = 0;
@@ -169,8 +170,23 @@ struct Core : CoreStart,
 
     static void waitForConsoleKey();
 
+
+    using MainThreadCall = std::function< void( float ) >;
+
+    // functions to run on the main thread each tick, be that a GUI frame or a headless service loop update
+    void registerMainThreadCall( std::string_view name, MainThreadCall func );
+    void unregisterMainThreadCall( std::string_view name );
+
 protected:
 
+    // run all registered main thread calls and other per-tick core housekeeping
+    void runMainThreadCalls( const float deltaTime );
+
+    // for apps running unattended; hooks SIGINT / SIGTERM so that a headless service loop can shut down cleanly
+    // rather than being killed mid-write. wasTerminationRequested() returns true once one of those has arrived
+    static void installTerminationHandlers();
+    ouro_nodiscard static bool wasTerminationRequested();
+
     // called once basic initial configuration is done for the application to continue work
     virtual int Entrypoint() = 0;
 
@@ -213,6 +229,7 @@ protected:
 
     // multithreading bro ever heard of it
     tf::Executor                            m_taskExecutor;                 // task dispatcher for the app
+    tf::Executor                            m_taskExecutorIO;               // task dispatcher for work that mostly waits on network or disk, so it doesn't tie up compute workers
     tf::Executor                            m_taskExecutorPlugins;          // task dispatcher used for plugins, both discovery and giving to CLAP thread pooling
 
     // application-wide lua state wrapper
@@ -256,6 +273,13 @@ protected:
     app::MidiModule                         m_mdMidi;
 
 
+    using MainThreadCalls = absl::flat_hash_map< std::string, MainThreadCall >;
+
+    // list of functions to run on the main thread each tick
+    std::mutex                              m_mainThreadCallsMutex;
+    MainThreadCalls                         m_mainThreadCalls;
+
+
 protected:
 
     // network activity tracing
@@ -341,6 +365,7 @@ public:
     ouro_nodiscard const endlesss::toolkit::Exchange&           getEndlesssExchange() const override    { return m_endlesssExchange; }
     ouro_nodiscard const endlesss::toolkit::PopulationQuery&    getEndlesssPopulation() const override  { return m_endlesssPopulation;}
     ouro_nodiscard tf::Executor&                                getTaskExecutor() override              { return m_taskExecutor; }
+    ouro_nodiscard tf::Executor&                                getTaskExecutorIO() override            { return m_taskExecutorIO; }
     ouro_nodiscard tf::Executor&                                getTaskExecutorPlugins() override       { return m_taskExecutorPlugins; }
     ouro_nodiscard sol::state_view&                             getLuaState() override                  { return m_lua; }
     ouro_nodiscard base::EventBusClient                         getEventBusClient() const override
@@ -371,8 +396,6 @@ struct CoreGUI : Core,
     using FileDialogInst            = std::unique_ptr<ImGuiFileDialog>;
     using FileDialogCallback        = std::function< void( ImGuiFileDialog& ) >;
 
-    using MainThreadCall            = std::function< void( float ) >;
-
 
     enum ViewportFlags
     {
@@ -400,9 +423,6 @@ struct CoreGUI : Core,
     UIInjectionHandle registerMainMenuEntry( const int32_t ordering, const std::string& menuName, const UIInjectionCallback& callback );
     bool unregisterMainMenuEntry( const UIInjectionHandle handle );
 
-    void registerMainThreadCall( std::string_view name, MainThreadCall func );
-    void unregisterMainThreadCall( std::string_view name );
-
     // ICoreCustomRendering
     void registerRenderCallback( const RenderPoint rp, const RenderInjectionCallback& callback ) override;
 
@@ -454,7 +474,6 @@ protected:
     using MenuMenuEntryList     = std::vector< MenuMenuEntry >;
 
     using CustomRenderCallbacks = std::vector< ICoreCustomRendering::RenderInjectionCallback >;
-    using MainThreadCalls       = absl::flat_hash_map< std::string, MainThreadCall >;
 
     // generic modal-popup tracking types to simplify client code opening and running dialog boxes
     using ModalPopupsWaiting    = std::vector< std::string >;
@@ -476,6 +495,11 @@ protected:
     // once services all started, this will be called to begin app-specific main loop; return exit value 
     virtual int EntrypointGUI() = 0;
 
+    // apps that can also run without a window return true here to skip creating the frontend entirely - no
+    // window, GL context or imgui state is made - and EntrypointHeadless() is called instead of EntrypointGUI()
+    virtual bool shouldRunHeadless() const { return false; }
+    virtual int EntrypointHeadless();
+
 
     // call inside app main loop to perform pre/post core functions (eg. checking for exit, submitting rendering)
     bool beginInterfaceLayout( const ViewportFlags viewportFlags );
@@ -535,10 +559,6 @@ protected:
     CustomRenderCallbacks   m_preImguiRenderCallbacks;
     CustomRenderCallbacks   m_postImguiRenderCallbacks;
 
-    // list of functions to run on the main thread each tick
-    std::mutex              m_mainThreadCallsMutex;
-    MainThreadCalls         m_mainThreadCalls;
-
     // instance of the file picker imgui gizmo
     FileDialogInst          m_activeFileDialog;
     FileDialogCallback      m_fileDialogCallbackOnOK;
@@ -0,0 +1,509 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "base/logging.h"
+
+namespace blog {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// a single queued chunk of log output; lines longer than cTextCapacity are split across consecutive records
+struct Record
+{
+    static constexpr std::size_t cTextCapacity = 352;
+
+    std::chrono::system_clock::time_point   m_time;
+    const char*                             m_prefix;           // prefixes are always string literals
+    uint8_t                                 m_prefixLength;
+    System                                  m_system;
+    Level                                   m_level;
+    bool                                    m_continues;        // text carries on in the next record
+    fmt::color                              m_fg1;
+    fmt::color                              m_fg2;
+    uint16_t                                m_textLength;
+    char                                    m_text[cTextCapacity];
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// single-producer queue owned by one thread at a time
+struct ThreadQueue
+{
+    static constexpr std::size_t cCapacity = 256;
+
+    ThreadQueue()
+        : m_queue( cCapacity )
+    {
+        m_assembly.reserve( 1024 );
+    }
+
+    mcc::ReaderWriterQueue< Record >    m_queue;
+    std::atomic_bool                    m_claimed = false;
+
+    std::string                         m_assembly;             // drain-thread-only, joins split records back up
+};
+
+// fixed pool of per-thread queues, allocated once on first start() and kept for the life of the process so that
+// thread-local pointers into it never dangle; any threads beyond the pool size share an overflow queue behind a lock,
+// which producers only ever try-lock so that logging never blocks
+static constexpr std::size_t                        cThreadQueuePoolSize = 48;
+static constexpr std::chrono::milliseconds          cDrainInterval{ 5 };
+
+static constexpr std::array< std::string_view, (std::size_t)System::Count > cSystemNames =
+{
+#define _BLOG_SYSTEM_NAME( _name, _colour, _nameBold )     #_name,
+    _BLOG_SYSTEMS( _BLOG_SYSTEM_NAME )
+#undef _BLOG_SYSTEM_NAME
+};
+
+std::array< std::atomic_uint8_t, (std::size_t)System::Count >  gMinimumLevels{};     // zero-initialised to Level::Debug
+
+std::unique_ptr< std::array< ThreadQueue, cThreadQueuePoolSize > >  gThreadQueues;
+std::unique_ptr< ThreadQueue >                      gOverflowQueue;
+std::mutex                                          gOverflowQueueLock;
+
+std::atomic_bool                                    gAccepting  = false;            // producers push to queues rather than stdout
+std::atomic_bool                                    gDraining   = false;            // drain thread keeps running
+std::atomic_uint32_t                                gProducersInFlight = 0;         // producers between checking gAccepting and finishing their enqueue
+std::unique_ptr< std::thread >                      gDrainThread;
+std::atomic_uint64_t                                gDroppedLines = 0;
+
+// file sink state, only touched under gSinkLock
+std::mutex                                          gSinkLock;
+std::ofstream                                       gSinkFile;
+fs::path                                            gSinkDirectory;
+std::string                                         gSinkBaseName;
+uint64_t                                            gSinkMaxBytes   = 0;
+uint32_t                                            gSinkMaxFiles   = 0;
+uint64_t                                            gSinkBytes      = 0;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// per-thread link to a claimed pool queue, handed back when the owning thread exits
+struct ThreadQueueHandle
+{
+    ~ThreadQueueHandle()
+    {
+        if ( m_queue != nullptr )
+            m_queue->m_claimed.store( false, std::memory_order_release );
+    }
+
+    ThreadQueue*    m_queue = nullptr;
+};
+thread_local ThreadQueueHandle                      tThreadQueue;
+
+// ---------------------------------------------------------------------------------------------------------------------
+static void composeConsoleLine( fmt::memory_buffer& output, const std::string_view prefix, const fmt::color fg1, const fmt::color fg2, const std::string_view text )
+{
+    constexpr std::string_view midsep = " | ";
+    constexpr std::string_view suffix = "\n";
+
+#if OURO_ENABLE_COLOURED_LOGGING
+    const auto foreground1 = fmt::detail::make_foreground_color<char>( fmt::detail::color_type( fg1 ) );
+    const auto foreground2 = fmt::detail::make_foreground_color<char>( fmt::detail::color_type( fg2 ) );
+
+    output.append( foreground1.begin(), foreground1.end() );
+#endif // OURO_ENABLE_COLOURED_LOGGING
+
+    output.append( prefix );
+
+#if OURO_ENABLE_COLOURED_LOGGING
+    fmt::detail::reset_color( output );
+#endif // OURO_ENABLE_COLOURED_LOGGING
+
+    output.append( midsep );
+
+#if OURO_ENABLE_COLOURED_LOGGING
+    output.append( foreground2.begin(), foreground2.end() );
+#endif // OURO_ENABLE_COLOURED_LOGGING
+
+    output.append( text );
+    output.append( suffix );
+
+#if OURO_ENABLE_COLOURED_LOGGING
+    fmt::detail::reset_color( output );
+#endif // OURO_ENABLE_COLOURED_LOGGING
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+static void rotateFileSinkUnguarded()
+{
+    gSinkFile.close();
+
+    const auto rotatedPath = [&]( const uint32_t index )
+    {
+        if ( index == 0 )
+            return gSinkDirectory / fmt::format( FMTX( "{}.log" ), gSinkBaseName );
+        return gSinkDirectory / fmt::format( FMTX( "{}.{}.log" ), gSinkBaseName, index );
+    };
+
+    // shuffle everything up one, dropping the oldest
+    std::error_code ec;
+    fs::remove( rotatedPath( gSinkMaxFiles ), ec );
+    for ( uint32_t index = gSinkMaxFiles; index > 0; index-- )
+    {
+        if ( fs::exists( rotatedPath( index - 1 ), ec ) )
+            fs::rename( rotatedPath( index - 1 ), rotatedPath( index ), ec );
+    }
+
+    gSinkFile.open( rotatedPath( 0 ), std::ios::out | std::ios::trunc );
+    gSinkBytes = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+static void writeToFileSink( const Record& record, const std::string_view text )
+{
+    std::scoped_lock<std::mutex> sinkLock( gSinkLock );
+
+    if ( !gSinkFile.is_open() )
+        return;
+
+    static constexpr std::array< std::string_view, 4 > cLevelTags = { "dbg", "   ", "ERR", "   " };
+
+    const auto timeSinceEpoch   = record.m_time.time_since_epoch();
+    const auto timeMilliseconds = std::chrono::duration_cast<std::chrono::milliseconds>( timeSinceEpoch ).count() % 1000;
+    const auto timeLocal        = fmt::localtime( std::chrono::system_clock::to_time_t( record.m_time ) );
+
+    fmt::memory_buffer fileLine;
+    fmt::format_to( std::back_inserter( fileLine ), FMTX( "{:%Y-%m-%d %H:%M:%S}.{:03} | {} | {} | {}\n" ),
+        timeLocal,
+        timeMilliseconds,
+        std::string_view( record.m_prefix, record.m_prefixLength ),
+        cLevelTags[ (std::size_t)record.m_level ],
+        text );
+
+    gSinkFile.write( fileLine.data(), fileLine.size() );
+    gSinkBytes += fileLine.size();
+
+    if ( gSinkMaxBytes > 0 && gSinkBytes >= gSinkMaxBytes )
+        rotateFileSinkUnguarded();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// drain-thread side; returns number of records processed
+static std::size_t drainQueue( ThreadQueue& threadQueue, fmt::memory_buffer& consoleOutput )
+{
+    std::size_t recordsDrained = 0;
+
+    while ( const Record* record = threadQueue.m_queue.peek() )
+    {
+        threadQueue.m_assembly.append( record->m_text, record->m_textLength );
+
+        if ( !record->m_continues )
+        {
+            const std::string_view prefix( record->m_prefix, record->m_prefixLength );
+
+            composeConsoleLine( consoleOutput, prefix, record->m_fg1, record->m_fg2, threadQueue.m_assembly );
+            writeToFileSink( *record, threadQueue.m_assembly );
+
+            threadQueue.m_assembly.clear();
+        }
+
+        threadQueue.m_queue.pop();
+        recordsDrained++;
+    }
+    return recordsDrained;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+static void drainAll( fmt::memory_buffer& consoleOutput, uint64_t& droppedLinesReported )
+{
+    consoleOutput.clear();
+
+    std::size_t recordsDrained = 0;
+    for ( auto& threadQueue : *gThreadQueues )
+        recordsDrained += drainQueue( threadQueue, consoleOutput );
+
+    recordsDrained += drainQueue( *gOverflowQueue, consoleOutput );
+
+    const uint64_t droppedLines = gDroppedLines.load( std::memory_order_relaxed );
+    if ( droppedLines != droppedLinesReported )
+    {
+        const auto droppedMessage = fmt::format( FMTX( "{} log line(s) dropped, queue full" ), droppedLines - droppedLinesReported );
+        composeConsoleLine( consoleOutput, "BLOG", fmt::color::red, fmt::color::orange_red, droppedMessage );
+        droppedLinesReported = droppedLines;
+    }
+
+    if ( consoleOutput.size() > 0 )
+    {
+        std::cout.write( consoleOutput.data(), consoleOutput.size() );
+        std::cout.flush();
+    }
+
+    if ( recordsDrained > 0 )
+    {
+        std::scoped_lock<std::mutex> sinkLock( gSinkLock );
+        if ( gSinkFile.is_open() )
+            gSinkFile.flush();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+static void drainThreadWorker()
+{
+    // no OuroveonThreadScope here, as it logs on entry/exit
+    ouroveonThreadEntry( OURO_THREAD_PREFIX "blog::drain" );
+
+    fmt::memory_buffer consoleOutput;
+    uint64_t droppedLinesReported = gDroppedLines.load();
+
+    while ( gDraining.load( std::memory_order_acquire ) )
+    {
+        drainAll( consoleOutput, droppedLinesReported );
+        std::this_thread::sleep_for( cDrainInterval );
+    }
+
+    // catch anything that arrived while shutting down
+    drainAll( consoleOutput, droppedLinesReported );
+
+    ouroveonThreadExit();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+static ThreadQueue* claimThreadQueue()
+{
+    if ( tThreadQueue.m_queue != nullptr )
+        return tThreadQueue.m_queue;
+
+    // first line logged from this thread, go find a free queue
+    for ( auto& threadQueue : *gThreadQueues )
+    {
+        bool expected = false;
+        if ( threadQueue.m_claimed.compare_exchange_strong( expected, true, std::memory_order_acq_rel ) )
+        {
+            tThreadQueue.m_queue = &threadQueue;
+            return tThreadQueue.m_queue;
+        }
+    }
+    return nullptr;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+static void enqueueRecords( ThreadQueue& threadQueue, const System system, const Level level, const std::string_view prefix, const fmt::color fg1, const fmt::color fg2, std::string_view text )
+{
+    Record record;
+    record.m_time           = std::chrono::system_clock::now();
+    record.m_prefix         = prefix.data();
+    record.m_prefixLength   = static_cast<uint8_t>( std::min< std::size_t >( prefix.size(), 255 ) );
+    record.m_system         = system;
+    record.m_level          = level;
+    record.m_fg1            = fg1;
+    record.m_fg2            = fg2;
+
+    // all or nothing; queueing only some chunks of a line would leave the drain thread holding an unterminated assembly
+    // that then gets glued onto the front of whatever this queue carries next. each queue only has one producer at a
+    // time, so the free space can only grow between this check and the enqueues below
+    const std::size_t chunkCount = std::max< std::size_t >( 1, ( text.size() + Record::cTextCapacity - 1 ) / Record::cTextCapacity );
+    if ( threadQueue.m_queue.max_capacity() - std::min( threadQueue.m_queue.size_approx(), threadQueue.m_queue.max_capacity() ) < chunkCount )
+    {
+        gDroppedLines.fetch_add( 1, std::memory_order_relaxed );
+        return;
+    }
+
+    do
+    {
+        const std::size_t chunkLength = std::min( text.size(), Record::cTextCapacity );
+
+        std::memcpy( record.m_text, text.data(), chunkLength );
+        record.m_textLength = static_cast<uint16_t>( chunkLength );
+        record.m_continues  = ( chunkLength < text.size() );
+
+        text.remove_prefix( chunkLength );
+
+        // never block or grow the queue; room was checked above, this is just belt and braces
+        if ( !threadQueue.m_queue.try_enqueue( record ) )
+        {
+            gDroppedLines.fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+
+    } while ( !text.empty() );
+}
+
+namespace detail {
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool _isEnabled( const System system, const Level level ) noexcept
+{
+    return static_cast<uint8_t>( level ) >= gMinimumLevels[ (std::size_t)system ].load( std::memory_order_relaxed );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void _submit( const System system, const Level level, const std::string_view prefix, const fmt::color fg1, const fmt::color fg2, const std::string_view text ) noexcept
+{
+    // announce ourselves before checking gAccepting; stop() waits for this to drop to zero after it clears gAccepting,
+    // so either we see the flag cleared and write directly, or our records are queued before the final drain
+    gProducersInFlight.fetch_add( 1 );
+    if ( gAccepting.load() )
+    {
+        ThreadQueue* threadQueue = claimThreadQueue();
+        if ( threadQueue != nullptr )
+        {
+            enqueueRecords( *threadQueue, system, level, prefix, fg1, fg2, text );
+        }
+        else
+        {
+            // every pooled queue is taken, so share the overflow one. never wait for it though - this can be the audio
+            // callback, which must not block on a lock; if another thread is mid-enqueue, the line is counted as dropped
+            std::unique_lock<std::mutex> overflowLock( gOverflowQueueLock, std::try_to_lock );
+            if ( overflowLock.owns_lock() )
+                enqueueRecords( *gOverflowQueue, system, level, prefix, fg1, fg2, text );
+            else
+                gDroppedLines.fetch_add( 1, std::memory_order_relaxed );
+        }
+        gProducersInFlight.fetch_sub( 1 );
+        return;
+    }
+    gProducersInFlight.fetch_sub( 1 );
+
+    // synchronous path, used during boot and shutdown
+    static thread_local fmt::memory_buffer consoleOutput;
+    consoleOutput.clear();
+
+    composeConsoleLine( consoleOutput, prefix, fg1, fg2, text );
+    std::cout.write( consoleOutput.data(), consoleOutput.size() );
+}
+
+} // namespace detail
+
+namespace backend {
+
+// ---------------------------------------------------------------------------------------------------------------------
+void start()
+{
+    ABSL_ASSERT( gDrainThread == nullptr );
+    if ( gDrainThread != nullptr )
+        return;
+
+    if ( gThreadQueues == nullptr )
+    {
+        gThreadQueues  = std::make_unique< std::array< ThreadQueue, cThreadQueuePoolSize > >();
+        gOverflowQueue = std::make_unique< ThreadQueue >();
+    }
+
+    gDraining.store( true, std::memory_order_release );
+    gDrainThread = std::make_unique<std::thread>( &drainThreadWorker );
+
+    gAccepting.store( true, std::memory_order_release );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void stop()
+{
+    if ( gDrainThread == nullptr )
+        return;
+
+    // flip producers back to writing directly and wait out any that were already mid-enqueue, then let the drain
+    // thread empty out the queues before it exits
+    gAccepting.store( false );
+    while ( gProducersInFlight.load() > 0 )
+        std::this_thread::yield();
+
+    gDraining.store( false, std::memory_order_release );
+
+    gDrainThread->join();
+    gDrainThread.reset();
+
+    closeFileSink();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status openRotatingFileSink( const fs::path& directory, std::string_view baseName, const uint64_t maxBytes, const uint32_t maxFiles )
+{
+    std::error_code ec;
+    if ( !fs::exists( directory, ec ) && !fs::create_directories( directory, ec ) )
+    {
+        return absl::PermissionDeniedError( fmt::format( FMTX( "unable to create log directory [{}] ({})" ), directory.string(), ec.message() ) );
+    }
+
+    std::scoped_lock<std::mutex> sinkLock( gSinkLock );
+
+    if ( gSinkFile.is_open() )
+        gSinkFile.close();
+
+    gSinkDirectory  = directory;
+    gSinkBaseName   = baseName;
+    gSinkMaxBytes   = maxBytes;
+    gSinkMaxFiles   = std::max( maxFiles, 1U );
+
+    // each session starts a fresh file, pushing the previous one down the list
+    rotateFileSinkUnguarded();
+
+    if ( !gSinkFile.is_open() )
+    {
+        return absl::PermissionDeniedError( fmt::format( FMTX( "unable to open log file in [{}]" ), directory.string() ) );
+    }
+    return absl::OkStatus();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void closeFileSink()
+{
+    std::scoped_lock<std::mutex> sinkLock( gSinkLock );
+
+    if ( gSinkFile.is_open() )
+    {
+        gSinkFile.flush();
+        gSinkFile.close();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void setMinimumLevel( const System system, const Level level )
+{
+    gMinimumLevels[ (std::size_t)system ].store( static_cast<uint8_t>( level ), std::memory_order_relaxed );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void setMinimumLevelForAll( const Level level )
+{
+    for ( auto& minimumLevel : gMinimumLevels )
+        minimumLevel.store( static_cast<uint8_t>( level ), std::memory_order_relaxed );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+Level getMinimumLevel( const System system )
+{
+    return static_cast<Level>( gMinimumLevels[ (std::size_t)system ].load( std::memory_order_relaxed ) );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::string_view getSystemName( const System system )
+{
+    return cSystemNames[ (std::size_t)system ];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::optional< System > systemFromName( std::string_view systemName )
+{
+    for ( std::size_t index = 0; index < cSystemNames.size(); index++ )
+    {
+        if ( cSystemNames[index] == systemName )
+            return static_cast<System>( index );
+    }
+    return std::nullopt;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::optional< Level > levelFromName( std::string_view levelName )
+{
+    if ( levelName == "debug" ) return Level::Debug;
+    if ( levelName == "info" )  return Level::Info;
+    if ( levelName == "error" ) return Level::Error;
+    if ( levelName == "off" )   return Level::Off;
+    return std::nullopt;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+uint64_t getDroppedLineCount()
+{
+    return gDroppedLines.load( std::memory_order_relaxed );
+}
+
+} // namespace backend
+} // namespace blog
@@ -0,0 +1,43 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#pragma once
+
+namespace blog {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// controls for the logging backend that sits behind blog::<system>(); until start() is called (and after stop()) lines
+// are written synchronously to stdout. once running, each thread pushes its lines into its own lock-free queue
+// which a background thread drains to the console and any file sink. a thread whose queue is full drops lines
+// (counted and reported later) rather than waiting
+//
+namespace backend {
+
+void start();
+void stop();        // drains everything that is still queued and flushes/closes any file sink
+
+// mirror all output (uncoloured, timestamped) to [directory]/[baseName].log; once that file passes maxBytes it is
+// rotated to [baseName].1.log and so on, keeping at most maxFiles old files around
+ouro_nodiscard absl::Status openRotatingFileSink( const fs::path& directory, std::string_view baseName, const uint64_t maxBytes, const uint32_t maxFiles );
+void closeFileSink();
+
+// runtime filtering; lines below the given level for a system are discarded before any formatting is done
+void setMinimumLevel( const System system, const Level level );
+void setMinimumLevelForAll( const Level level );
+ouro_nodiscard Level getMinimumLevel( const System system );
+
+ouro_nodiscard std::string_view getSystemName( const System system );
+ouro_nodiscard std::optional< System > systemFromName( std::string_view systemName );      // eg. "database"
+ouro_nodiscard std::optional< Level > levelFromName( std::string_view levelName );         // "debug", "info", "error", "off"
+
+// total number of lines thrown away because a thread's queue was full
+ouro_nodiscard uint64_t getDroppedLineCount();
+
+} // namespace backend
+} // namespace blog
@@ -89,4 +89,42 @@ constexpr void interleave_float_to_int24(
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// scale two channels in-place by a per-sample gain curve
+//
+constexpr void gain_curve_stereo(
+    const int    sample_count,
+    const float  gain[],
+    float        inout_left[],
+    float        inout_right[]
+)
+{
+    for ( auto i = 0; i < sample_count; i++ )
+    {
+        inout_left[i]  *= gain[i];
+        inout_right[i] *= gain[i];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// blend two channels of incoming samples into an existing pair in-place, each side weighted by its own per-sample gain
+// curve; linear, equal-power etc. are all just a choice of curves
+//
+constexpr void crossfade_stereo(
+    const int    sample_count,
+    const float  gain_existing[],
+    const float  gain_incoming[],
+    const float  input_left[],
+    const float  input_right[],
+    float        inout_left[],
+    float        inout_right[]
+)
+{
+    for ( auto i = 0; i < sample_count; i++ )
+    {
+        inout_left[i]  = ( inout_left[i]  * gain_existing[i] ) + ( input_left[i]  * gain_incoming[i] );
+        inout_right[i] = ( inout_right[i] * gain_existing[i] ) + ( input_right[i] * gain_incoming[i] );
+    }
+}
+
 } // namespace buffer
@@ -0,0 +1,50 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#pragma once
+
+#include "config/base.h"
+
+namespace config {
+
+// logging backend options; optional file output and per-system level filtering
+OURO_CONFIG( Logging )
+{
+    // data routing
+    static constexpr auto StoragePath       = IPathProvider::PathFor::SharedConfig;
+    static constexpr auto StorageFilename   = "logging.json";
+
+    // mirror log output to [app config]/logs/[app].log, rotating once the file gets to the given size
+    bool                                            fileSinkEnabled     = false;
+    int32_t                                         fileSinkMaxSizeMb   = 8;
+    int32_t                                         fileSinkMaxFiles    = 4;
+
+    // system name -> minimum level to emit, eg. { "database" : "error", "stem" : "off" }; 
+    // levels are "debug", "info", "error" or "off"
+    std::unordered_map< std::string, std::string >  minimumLevels;
+
+    template<class Archive>
+    void serialize( Archive& archive )
+    {
+        archive( CEREAL_OPTIONAL_NVP( fileSinkEnabled )
+               , CEREAL_OPTIONAL_NVP( fileSinkMaxSizeMb )
+               , CEREAL_OPTIONAL_NVP( fileSinkMaxFiles )
+               , CEREAL_OPTIONAL_NVP( minimumLevels )
+        );
+    }
+
+    bool postLoad()
+    {
+        fileSinkMaxSizeMb = std::max( fileSinkMaxSizeMb, 1 );
+        fileSinkMaxFiles  = std::max( fileSinkMaxFiles, 1 );
+        return true;
+    }
+};
+
+} // namespace config
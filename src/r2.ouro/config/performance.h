@@ -39,6 +39,9 @@ OURO_CONFIG( Performance )
     // optionally enable/disable the Vibes rendering system at the root to avoid burning any memory or GPU if desired
     bool            enableVibesRenderer = true;
 
+    // hold loaded stems as 16-bit samples rather than 32-bit float, roughly doubling how many fit in the stem cache
+    bool            enableCompactStemStorage = false;
+
 
     template<class Archive>
     void serialize( Archive& archive )
@@ -47,6 +50,7 @@ OURO_CONFIG( Performance )
                , CEREAL_NVP( liveRiffInstancePoolSize )
                , CEREAL_OPTIONAL_NVP( enableUnstableNetworkCompensation )
                , CEREAL_OPTIONAL_NVP( enableVibesRenderer )
+               , CEREAL_OPTIONAL_NVP( enableCompactStemStorage )
         );
     }
 
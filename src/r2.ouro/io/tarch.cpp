@@ -9,10 +9,13 @@
 
 #include "pch.h"
 
+#include "base/construction.h"
 #include "base/utils.h"
 #include "filesys/fsutil.h"
 #include "io/tarch.h"
 
+#include "zstd.h"
+
 namespace io {
 
 
@@ -89,6 +92,17 @@ struct THeader
         check[7] = ' ';
     }
 
+    // entry name, re-joined with the ustar prefix field if one was used to store a longer path
+    std::string getEntryPath() const
+    {
+        std::string entryPath( name, strnlen( name, sizeof( name ) ) );
+        if ( ustar[0] == 'u' && prefix[0] != '\0' )
+        {
+            entryPath = std::string( prefix, strnlen( prefix, sizeof( prefix ) ) ) + '/' + entryPath;
+        }
+        return entryPath;
+    }
+
     // create a default header setup with sensible empty defaults
     static void createDefault( THeader& result )
     {
@@ -117,183 +131,653 @@ inline constexpr uint32_t oct2uint( const char (&oct)[inputSize] )
     return out;
 }
 
-
-
-absl::Status archiveFilesInDirectoryToTAR(
-    const std::filesystem::path& inputPath,
-    const std::filesystem::path& outputTarFile,
-    const ArchiveProgressCallback& archivingProgressFunction )
+// size of a file's data inside the tar once padded up to the next 512-byte block boundary
+inline constexpr std::size_t paddedEntrySize( const std::size_t fileSize )
 {
-    // allocate a buffer to use as staging for read/writing from the input files to the output stream
-    static constexpr std::size_t ioBufferSize = 1 * 1024 * 1024;
-    void* ioBuffer = mem::alloc16<char>( ioBufferSize );
+    return ( fileSize + 511 ) & ~static_cast<std::size_t>( 511 );
+}
 
-    FILE* tarOutputFile = fopen( outputTarFile.string().c_str(), "wb" );
+// magic bytes at the start of every zstd frame
+inline bool isZstdFrame( const uint8_t (&magic)[4] )
+{
+    return magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD;
+}
 
-    // auto close tar file and free the ioBuffer memory on scope exit
-    absl::Cleanup cleanupOnScopeExit = [&]() noexcept
-    {
-        fclose( tarOutputFile );
-        tarOutputFile = nullptr;
+// the archive writer puts an index of every file entry at the very front of the tar under this name, so that
+// MountedTar can pick it up without walking every header; unpacking skips it
+static constexpr char cEmbeddedIndexName[] = ".ouroveon.tarindex";
 
-        mem::free16( ioBuffer );
-        ioBuffer = nullptr;
-        };
 
+// ---------------------------------------------------------------------------------------------------------------------
+// list of entries and where their data lives in the (uncompressed) tar stream; embedded at the front of archives we
+// write, or stored alongside an archive by MountedTar. when stored alongside, it is tagged with the archive's size
+// and modification time so a replaced or re-exported archive is re-indexed rather than served with stale offsets
+struct MountedTarIndexFile
+{
+    static constexpr uint32_t cVersion = 1;
 
-    const fs::path baseInputPath = inputPath.parent_path();
+    struct IndexedEntry
+    {
+        std::string     m_path;
+        uint64_t        m_offset = 0;
+        uint64_t        m_length = 0;
 
+        template<class Archive>
+        void serialize( Archive& archive )
+        {
+            archive( m_path, m_offset, m_length );
+        }
+    };
 
-    // keep track of bytes processed so the UI can show something happening
-    std::size_t bytesProcessedIntoTar = 0;
-    std::size_t filesProcessedIntoTar = 0;
-    if ( archivingProgressFunction != nullptr )
-        archivingProgressFunction( 0, 0 );
+    uint32_t                    m_version = cVersion;
+    uint64_t                    m_archiveSize = 0;
+    int64_t                     m_archiveModTime = 0;
+    std::vector< IndexedEntry > m_entries;
 
-    // create a blob of zeroed memory we use as padding to 512-byte edges at the end of files and the
-    // end of the whole tar stream
-    char ioPadding[512];
-    memset( ioPadding, 0, 512 );
+    template<class Archive>
+    void serialize( Archive& archive )
+    {
+        archive( m_version, m_archiveSize, m_archiveModTime, m_entries );
+    }
 
-    const auto appendToTar = [&](
-        const bool bIsDirectory,
-        const fs::path& entryFullFilename,
-        const fs::path& entryRelativePath ) noexcept -> absl::Status
+    std::string toBinary()
+    {
+        std::ostringstream binaryStream( std::ios::binary );
         {
-            THeader tarHeader;
-            THeader::createDefault( tarHeader );
+            cereal::BinaryOutputArchive archive( binaryStream );
+            serialize( archive );
+        }
+        return binaryStream.str();
+    }
+};
 
-            std::error_code lwtError;
-            const auto fileModTime          = fs::last_write_time( entryFullFilename, lwtError );
+// ---------------------------------------------------------------------------------------------------------------------
+static int32_t fileModTimeForTar( const fs::path& entryFullFilename )
+{
+    std::error_code lwtError;
+    const auto fileModTime          = fs::last_write_time( entryFullFilename, lwtError );
 #if OURO_PLATFORM_WIN
-            const auto fileModSystemTime    = std::chrono::utc_clock::to_sys( std::chrono::file_clock::to_utc( fileModTime ) );
+    const auto fileModSystemTime    = std::chrono::utc_clock::to_sys( std::chrono::file_clock::to_utc( fileModTime ) );
 #else
-            const auto fileModSystemTime    = std::chrono::file_clock::to_sys( fileModTime );
+    const auto fileModSystemTime    = std::chrono::file_clock::to_sys( fileModTime );
 #endif
-            const auto fileModTimeT         = std::chrono::system_clock::to_time_t(
+    const auto fileModTimeT         = std::chrono::system_clock::to_time_t(
 #if OURO_PLATFORM_OSX
-                                                                                   std::chrono::time_point_cast<std::chrono::microseconds>(
+                                                                           std::chrono::time_point_cast<std::chrono::microseconds>(
 #endif
-                                                                                   fileModSystemTime
+                                                                           fileModSystemTime
 #if OURO_PLATFORM_OSX
-                                                                                   )
+                                                                           )
 #endif
-                                                                                   );
-            
-            snprintf( tarHeader.mtime, sizeof( tarHeader.mtime ), "%011o", (int32_t)fileModTimeT );
+                                                                           );
+    return static_cast<int32_t>( fileModTimeT );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// buffers everything written into large sequential writes, optionally passing the whole stream through zstd on the way
+//
+struct TarOutputStream
+{
+    DECLARE_NO_COPY_NO_MOVE( TarOutputStream );
+
+    static constexpr std::size_t cStagingBufferSize = 8 * 1024 * 1024;
+
+    TarOutputStream( FILE* outputFile, const int32_t zstdCompressionLevel )
+        : m_outputFile( outputFile )
+    {
+        m_staging.reserve( cStagingBufferSize );
+
+        if ( zstdCompressionLevel > 0 )
+        {
+            m_zstdContext = ZSTD_createCCtx();
+            ZSTD_CCtx_setParameter( m_zstdContext, ZSTD_c_compressionLevel, zstdCompressionLevel );
+            ZSTD_CCtx_setParameter( m_zstdContext, ZSTD_c_checksumFlag, 1 );
+
+            m_compressed.resize( ZSTD_CStreamOutSize() );
+        }
+    }
+
+    ~TarOutputStream()
+    {
+        if ( m_zstdContext != nullptr )
+            ZSTD_freeCCtx( m_zstdContext );
+    }
+
+    absl::Status write( const void* data, const std::size_t length )
+    {
+        const uint8_t* dataBytes = static_cast<const uint8_t*>( data );
+        m_staging.insert( m_staging.end(), dataBytes, dataBytes + length );
+
+        if ( m_staging.size() >= cStagingBufferSize )
+            return flush( false );
+
+        return absl::OkStatus();
+    }
+
+    absl::Status writePadding( const std::size_t length )
+    {
+        m_staging.resize( m_staging.size() + length, 0 );
+        return absl::OkStatus();
+    }
+
+    // write out all staged data; if finalFlush is set, also closes off the compressed stream
+    absl::Status flush( const bool finalFlush )
+    {
+        if ( m_zstdContext == nullptr )
+        {
+            if ( !m_staging.empty() && fwrite( m_staging.data(), m_staging.size(), 1, m_outputFile ) != 1 )
+                return absl::DataLossError( "failed writing to tar file" );
+
+            m_staging.clear();
+            return absl::OkStatus();
+        }
+
+        ZSTD_inBuffer inputBuffer = { m_staging.data(), m_staging.size(), 0 };
+        const ZSTD_EndDirective endDirective = finalFlush ? ZSTD_e_end : ZSTD_e_continue;
+
+        bool finished = false;
+        while ( !finished )
+        {
+            ZSTD_outBuffer outputBuffer = { m_compressed.data(), m_compressed.size(), 0 };
+
+            const std::size_t remaining = ZSTD_compressStream2( m_zstdContext, &outputBuffer, &inputBuffer, endDirective );
+            if ( ZSTD_isError( remaining ) )
+                return absl::InternalError( fmt::format( FMTX( "zstd compression failed; {}" ), ZSTD_getErrorName( remaining ) ) );
+
+            if ( outputBuffer.pos > 0 && fwrite( m_compressed.data(), outputBuffer.pos, 1, m_outputFile ) != 1 )
+                return absl::DataLossError( "failed writing to compressed tar file" );
+
+            finished = finalFlush ? ( remaining == 0 ) : ( inputBuffer.pos == inputBuffer.size );
+        }
+
+        m_staging.clear();
+        return absl::OkStatus();
+    }
+
+private:
+
+    FILE*                   m_outputFile    = nullptr;
+    ZSTD_CCtx*              m_zstdContext   = nullptr;
+
+    std::vector< uint8_t >  m_staging;
+    std::vector< uint8_t >  m_compressed;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// sequential reads from a tar file, transparently decompressing it if it turns out to be zstd-compressed
+//
+struct TarInputStream
+{
+    DECLARE_NO_COPY_NO_MOVE( TarInputStream );
+
+    TarInputStream( FILE* inputFile )
+        : m_inputFile( inputFile )
+    {
+        uint8_t magic[4] = { 0, 0, 0, 0 };
+        const bool isCompressed = ( fread( magic, 4, 1, m_inputFile ) == 1 ) && isZstdFrame( magic );
+        fseek( m_inputFile, 0, SEEK_SET );
+
+        if ( isCompressed )
+        {
+            m_zstdContext = ZSTD_createDCtx();
+
+            m_compressed.resize( ZSTD_DStreamInSize() );
+            m_decompressed.resize( ZSTD_DStreamOutSize() );
+        }
+    }
+
+    ~TarInputStream()
+    {
+        if ( m_zstdContext != nullptr )
+            ZSTD_freeDCtx( m_zstdContext );
+    }
+
+    ouro_nodiscard bool isCompressed() const { return m_zstdContext != nullptr; }
+
+    ouro_nodiscard bool read( void* destination, std::size_t length )
+    {
+        if ( m_zstdContext == nullptr )
+            return ( length == 0 ) || ( fread( destination, length, 1, m_inputFile ) == 1 );
+
+        uint8_t* destinationBytes = static_cast<uint8_t*>( destination );
+        while ( length > 0 )
+        {
+            if ( m_decompressedRead < m_decompressedSize )
+            {
+                const std::size_t toCopy = std::min( length, m_decompressedSize - m_decompressedRead );
+                memcpy( destinationBytes, m_decompressed.data() + m_decompressedRead, toCopy );
+
+                destinationBytes    += toCopy;
+                length              -= toCopy;
+                m_decompressedRead  += toCopy;
+                continue;
+            }
+
+            if ( !decompressMore() )
+                return false;
+        }
+        return true;
+    }
+
+    ouro_nodiscard bool skip( std::size_t length )
+    {
+        if ( m_zstdContext == nullptr )
+            return ( length == 0 ) || ( fseek( m_inputFile, static_cast<long>( length ), SEEK_CUR ) == 0 );
+
+        // no seeking inside a compressed stream, just decompress and discard
+        while ( length > 0 )
+        {
+            if ( m_decompressedRead == m_decompressedSize && !decompressMore() )
+                return false;
+
+            const std::size_t toSkip = std::min( length, m_decompressedSize - m_decompressedRead );
+            m_decompressedRead  += toSkip;
+            length              -= toSkip;
+        }
+        return true;
+    }
+
+private:
+
+    ouro_nodiscard bool decompressMore()
+    {
+        if ( m_compressedInput.pos == m_compressedInput.size && !m_inputExhausted )
+        {
+            m_compressedInput.src  = m_compressed.data();
+            m_compressedInput.size = fread( m_compressed.data(), 1, m_compressed.size(), m_inputFile );
+            m_compressedInput.pos  = 0;
+
+            m_inputExhausted = ( m_compressedInput.size == 0 );
+        }
+
+        ZSTD_outBuffer outputBuffer = { m_decompressed.data(), m_decompressed.size(), 0 };
+
+        const std::size_t decompressResult = ZSTD_decompressStream( m_zstdContext, &outputBuffer, &m_compressedInput );
+        if ( ZSTD_isError( decompressResult ) )
+            return false;
+
+        m_decompressedRead = 0;
+        m_decompressedSize = outputBuffer.pos;
+
+        // nothing more to read and nothing came out; the stream is truncated
+        return !( m_inputExhausted && outputBuffer.pos == 0 );
+    }
+
+    FILE*                   m_inputFile         = nullptr;
+    ZSTD_DCtx*              m_zstdContext       = nullptr;
+
+    std::vector< uint8_t >  m_compressed;
+    ZSTD_inBuffer           m_compressedInput   = { nullptr, 0, 0 };
+    bool                    m_inputExhausted    = false;
+
+    std::vector< uint8_t >  m_decompressed;
+    std::size_t             m_decompressedRead  = 0;
+    std::size_t             m_decompressedSize  = 0;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status archiveFilesInDirectoryToTAR(
+    const std::filesystem::path& inputPath,
+    const std::filesystem::path& outputTarFile,
+    const ArchiveProgressCallback& archivingProgressFunction,
+    const ArchiveOptions& options )
+{
+    const fs::path baseInputPath = inputPath.parent_path();
+
+    struct PlannedEntry
+    {
+        fs::path        m_fullFilename;
+        std::string     m_tarName;          // path within the archive, forward-slash separated, trailing slash for directories
+        bool            m_isDirectory   = false;
+        std::size_t     m_fileSize      = 0;
+        std::size_t     m_headerOffset  = 0;
+    };
+    std::vector< PlannedEntry > plannedEntries;
+
+    const auto addPlannedEntry = [&]( const bool bIsDirectory, const fs::path& entryFullFilename ) -> absl::Status
+        {
+            PlannedEntry& entry = plannedEntries.emplace_back();
 
             // get output name from relative path, ensure all separators are forward-slash
-            std::string entryNamePath = entryRelativePath.string();
-            std::replace( entryNamePath.begin(), entryNamePath.end(), '\\', '/' );
+            entry.m_fullFilename = entryFullFilename;
+            entry.m_tarName      = entryFullFilename.lexically_relative( baseInputPath ).generic_string();
+            entry.m_isDirectory  = bIsDirectory;
 
             if ( bIsDirectory )
             {
-                entryNamePath += '/';
-
-                tarHeader.link = tarHeader.type = THeader::FileType::DIRECTORY;
+                entry.m_tarName += '/';
             }
             else
             {
                 std::error_code fileSizeError;
-                const std::uintmax_t fileSize = fs::file_size( entryFullFilename, fileSizeError );
+                entry.m_fileSize = fs::file_size( entryFullFilename, fileSizeError );
 
                 if ( fileSizeError )
                 {
                     return absl::InternalError( fmt::format( FMTX( "error ({}) trying to get file size for [{}]" ), fileSizeError.message(), entryFullFilename.string() ) );
                 }
-                snprintf( tarHeader.size, sizeof( tarHeader.size ), "%011o", (int32_t)fileSize );
+            }
+            return absl::OkStatus();
+        };
+
+    // gather everything up front; knowing all the sizes lets us lay out the whole archive (and its index) before
+    // any data is read. sorting by name gives the same archive for the same inputs no matter what order the file
+    // system hands them back in; parent directories always sort ahead of their contents
+    {
+        std::ignore = addPlannedEntry( true, inputPath );
+
+        auto fileIterator = fs::recursive_directory_iterator( inputPath, std::filesystem::directory_options::skip_permission_denied );
+
+        std::error_code osError;
+        for ( auto fIt = fs::begin( fileIterator ); fIt != fs::end( fileIterator ); fIt = fIt.increment( osError ) )
+        {
+            if ( osError )
+            {
+                return absl::AbortedError( fmt::format( FMTX( "error ({}) during file iteration, aborted" ), osError.message() ) );
+            }
+
+            const auto addStatus = addPlannedEntry( fIt->is_directory(), fIt->path() );
+            if ( !addStatus.ok() )
+                return addStatus;
+        }
 
-                tarHeader.link = tarHeader.type = THeader::FileType::NORMAL;
+        std::sort( plannedEntries.begin() + 1, plannedEntries.end(), []( const PlannedEntry& lhs, const PlannedEntry& rhs )
+            {
+                return lhs.m_tarName < rhs.m_tarName;
+            });
+
+        for ( const auto& entry : plannedEntries )
+        {
+            if ( entry.m_tarName.size() > sizeof( THeader::name ) )
+            {
+                return absl::InvalidArgumentError( fmt::format( FMTX( "path too long to store in tar [{}]" ), entry.m_tarName ) );
             }
+        }
+    }
+
+    // build the index; the serialised size depends only on the entry names, not the offsets, so we can measure it
+    // with placeholder offsets, lay everything out behind it and then fill the real values in
+    MountedTarIndexFile embeddedIndex;
+    for ( const auto& entry : plannedEntries )
+    {
+        if ( !entry.m_isDirectory )
+            embeddedIndex.m_entries.emplace_back( MountedTarIndexFile::IndexedEntry{ entry.m_tarName, 0, entry.m_fileSize } );
+    }
+    const std::size_t embeddedIndexSize = embeddedIndex.toBinary().size();
+    {
+        std::size_t layoutOffset = sizeof( THeader ) + paddedEntrySize( embeddedIndexSize );
+        std::size_t indexEntry   = 0;
+        for ( auto& entry : plannedEntries )
+        {
+            entry.m_headerOffset = layoutOffset;
+            layoutOffset += sizeof( THeader ) + paddedEntrySize( entry.m_fileSize );
+
+            if ( !entry.m_isDirectory )
+                embeddedIndex.m_entries[indexEntry++].m_offset = entry.m_headerOffset + sizeof( THeader );
+        }
+        // EOF marker for TAR is two blank 512-byte chunks
+        embeddedIndex.m_archiveSize = layoutOffset + ( sizeof( THeader ) * 2 );
+    }
+    const std::string embeddedIndexData = embeddedIndex.toBinary();
+    ABSL_ASSERT( embeddedIndexData.size() == embeddedIndexSize );
+
+
+    FILE* tarOutputFile = fopen( outputTarFile.string().c_str(), "wb" );
+    if ( tarOutputFile == nullptr )
+    {
+        return absl::PermissionDeniedError( fmt::format( FMTX( "unable to create tar [{}]" ), outputTarFile.string() ) );
+    }
+    absl::Cleanup closeFileOnScopeExit = [&]() noexcept
+    {
+        fclose( tarOutputFile );
+        tarOutputFile = nullptr;
+        };
+
+    TarOutputStream tarOutput( tarOutputFile, options.m_zstdCompressionLevel );
+
+    const auto writeHeader = [&]( const std::string& tarName, const bool bIsDirectory, const std::size_t fileSize, const int32_t modTime ) -> absl::Status
+        {
+            THeader tarHeader;
+            THeader::createDefault( tarHeader );
+
+            snprintf( tarHeader.mtime, sizeof( tarHeader.mtime ), "%011o", modTime );
+            snprintf( tarHeader.size, sizeof( tarHeader.size ), "%011o", (int32_t)fileSize );
+
+            tarHeader.link = tarHeader.type = bIsDirectory ? THeader::FileType::DIRECTORY : THeader::FileType::NORMAL;
 
             // copy in name
-            strncpy( tarHeader.name, entryNamePath.c_str(), 100 );
+            strncpy( tarHeader.name, tarName.c_str(), sizeof( tarHeader.name ) );
 
             tarHeader.computeChecksum();
 
-            // write header into current tar stream
-            fwrite( &tarHeader, sizeof( tarHeader ), 1, tarOutputFile );
+            return tarOutput.write( &tarHeader, sizeof( tarHeader ) );
+        };
+
+    // embedded index goes first
+    {
+        auto writeStatus = writeHeader( cEmbeddedIndexName, false, embeddedIndexData.size(), 0 );
+        if ( writeStatus.ok() )
+            writeStatus = tarOutput.write( embeddedIndexData.data(), embeddedIndexData.size() );
+        if ( writeStatus.ok() )
+            writeStatus = tarOutput.writePadding( paddedEntrySize( embeddedIndexData.size() ) - embeddedIndexData.size() );
+        if ( !writeStatus.ok() )
+            return writeStatus;
+    }
+
+    // files are read ahead of the writer by a small pool of threads into a ring of slots; the writer then consumes
+    // them strictly in archive order. with many small files this keeps several reads in flight at once rather than
+    // paying the open/read latency of each one in turn. how far ahead they get is bounded by the total bytes buffered
+    // (options.m_readAheadBytes) as well as by the number of slots, so a run of large stems can't balloon memory use
+    std::vector< std::size_t > fileEntryIndices;
+    for ( std::size_t entryI = 0; entryI < plannedEntries.size(); entryI++ )
+    {
+        if ( !plannedEntries[entryI].m_isDirectory )
+            fileEntryIndices.push_back( entryI );
+    }
+
+    struct ReadSlot
+    {
+        std::vector< uint8_t >  m_data;
+        absl::Status            m_status;
+        int32_t                 m_modTime = 0;
+        bool                    m_ready   = false;
+    };
 
-            // .. and then a copy of the file data verbatim
-            if ( !bIsDirectory )
+    const std::size_t readWindow = std::max< std::size_t >( options.m_readAheadThreads * 8, 1 );
+    std::vector< ReadSlot > readSlots( readWindow );
+
+    std::mutex                  readLock;
+    std::condition_variable     readSlotFilled;
+    std::condition_variable     readSlotFreed;
+    std::size_t                 filesConsumed = 0;
+    std::size_t                 bytesBuffered = 0;          // file data reserved by readers and not yet written out
+    std::atomic_size_t          nextFileToRead = 0;
+    std::atomic_bool            abortReading = false;
+
+    const auto readFileIntoSlot = [&]( const std::size_t fileIndex, ReadSlot& slot )
+        {
+            const PlannedEntry& entry = plannedEntries[ fileEntryIndices[fileIndex] ];
+
+            slot.m_modTime = fileModTimeForTar( entry.m_fullFilename );
+            slot.m_status  = absl::OkStatus();
+            slot.m_data.resize( entry.m_fileSize );
+
+            FILE* entryInputFile = fopen( entry.m_fullFilename.string().c_str(), "rb" );
+            if ( entryInputFile == nullptr )
             {
-                FILE* entryInputFile = fopen( entryFullFilename.string().c_str(), "rb" );
-                absl::Cleanup closeFileOnScopeExit = [&]() noexcept {
-                    fclose( entryInputFile );
-                    entryInputFile = nullptr;
-                    };
-
-                // simple in/out pump of data from the file
-                std::size_t bytesRead = 0;
-                std::size_t bytesWritten = 0;
-                while ( static_cast<void>(bytesRead = fread( ioBuffer, 1, ioBufferSize, entryInputFile )), bytesRead > 0 )
-                {
-                    fwrite( ioBuffer, bytesRead, 1, tarOutputFile );
-                    bytesWritten += bytesRead;
-                }
-                bytesProcessedIntoTar += bytesWritten;
+                slot.m_status = absl::NotFoundError( fmt::format( FMTX( "unable to open [{}] for archiving" ), entry.m_fullFilename.string() ) );
+                return;
+            }
+
+            // must read exactly what we laid out the archive for; the index is already built
+            const bool readAll   = ( entry.m_fileSize == 0 ) || ( fread( slot.m_data.data(), entry.m_fileSize, 1, entryInputFile ) == 1 );
+            const bool atFileEnd = ( fgetc( entryInputFile ) == EOF );
+            fclose( entryInputFile );
 
-                // check and null-pad out to 512 byte boundary
-                const std::size_t paddingBytes = 512 - bytesWritten % 512;
-                if ( paddingBytes != 512 )
+            if ( !readAll || !atFileEnd )
+            {
+                slot.m_status = absl::DataLossError( fmt::format( FMTX( "[{}] changed size during archiving" ), entry.m_fullFilename.string() ) );
+            }
+        };
+
+    std::vector< std::thread > readThreads;
+    for ( uint32_t threadI = 0; threadI < options.m_readAheadThreads; threadI++ )
+    {
+        readThreads.emplace_back( [&]()
+            {
+                for ( ;; )
                 {
-                    fwrite( ioPadding, paddingBytes, 1, tarOutputFile );
+                    const std::size_t fileIndex = nextFileToRead.fetch_add( 1 );
+                    if ( fileIndex >= fileEntryIndices.size() )
+                        break;
+
+                    const std::size_t fileSize = plannedEntries[ fileEntryIndices[fileIndex] ].m_fileSize;
+
+                    // wait until the writer has freed up the slot this file maps to and there's room in the byte budget;
+                    // the file the writer is waiting on always goes ahead, otherwise later files that got in first
+                    // could hold the budget with nothing able to release it
+                    {
+                        std::unique_lock<std::mutex> lock( readLock );
+                        readSlotFreed.wait( lock, [&]()
+                            {
+                                if ( abortReading )
+                                    return true;
+                                if ( fileIndex >= filesConsumed + readWindow )
+                                    return false;
+                                return ( fileIndex == filesConsumed ) || ( bytesBuffered + fileSize <= options.m_readAheadBytes );
+                            });
+
+                        if ( abortReading )
+                            break;
+
+                        bytesBuffered += fileSize;
+                    }
+
+                    ReadSlot& slot = readSlots[ fileIndex % readWindow ];
+                    readFileIntoSlot( fileIndex, slot );
+
+                    {
+                        std::scoped_lock<std::mutex> lock( readLock );
+                        slot.m_ready = true;
+                    }
+                    readSlotFilled.notify_all();
                 }
-            }
+            });
+    }
 
-            return absl::OkStatus();
+    absl::Cleanup joinReadersOnScopeExit = [&]() noexcept
+    {
+        {
+            std::scoped_lock<std::mutex> lock( readLock );
+            abortReading = true;
+        }
+        readSlotFreed.notify_all();
+
+        for ( auto& readThread : readThreads )
+            readThread.join();
         };
 
-    // begin with the initial directory
-    std::ignore = appendToTar( true, inputPath, inputPath.filename() );
 
-    // create an iterator to walk the rest
-    auto fileIterator = fs::recursive_directory_iterator( inputPath, std::filesystem::directory_options::skip_permission_denied );
+    // keep track of bytes processed so the UI can show something happening
+    std::size_t bytesProcessedIntoTar = 0;
+    std::size_t filesProcessedIntoTar = 0;
+    if ( archivingProgressFunction != nullptr )
+        archivingProgressFunction( 0, 0 );
 
-    std::error_code osError;
-    for ( auto fIt = fs::begin( fileIterator ); fIt != fs::end( fileIterator ); fIt = fIt.increment( osError ) )
+    std::size_t fileIndex = 0;
+    for ( const auto& entry : plannedEntries )
     {
-        if ( osError )
+        absl::Status writeStatus;
+
+        if ( entry.m_isDirectory )
         {
-            return absl::AbortedError( fmt::format( FMTX( "error ({}) during file iteration, aborted" ), osError.message() ) );
+            writeStatus = writeHeader( entry.m_tarName, true, 0, fileModTimeForTar( entry.m_fullFilename ) );
         }
+        else
+        {
+            ReadSlot& slot = readSlots[ fileIndex % readWindow ];
 
-        const auto& entryFullFilename   = fIt->path();
-        const bool bIsDirectory         = fIt->is_directory();
+            if ( options.m_readAheadThreads == 0 )
+            {
+                readFileIntoSlot( fileIndex, slot );
+            }
+            else
+            {
+                std::unique_lock<std::mutex> lock( readLock );
+                readSlotFilled.wait( lock, [&]() { return slot.m_ready; } );
+            }
+
+            writeStatus = slot.m_status;
+            if ( writeStatus.ok() )
+                writeStatus = writeHeader( entry.m_tarName, false, entry.m_fileSize, slot.m_modTime );
+            if ( writeStatus.ok() )
+                writeStatus = tarOutput.write( slot.m_data.data(), slot.m_data.size() );
+            if ( writeStatus.ok() )
+                writeStatus = tarOutput.writePadding( paddedEntrySize( entry.m_fileSize ) - entry.m_fileSize );
+
+            bytesProcessedIntoTar += entry.m_fileSize;
+            fileIndex++;
 
-        const auto entryRelativePath = entryFullFilename.lexically_relative( baseInputPath );
+            // release the buffer rather than letting each slot hang on to the largest file it has ever held
+            slot.m_data = {};
 
-        const auto appendStatus = appendToTar( bIsDirectory, entryFullFilename, entryRelativePath );
-        filesProcessedIntoTar++;
+            // hand the slot and its share of the byte budget back to the readers
+            {
+                std::scoped_lock<std::mutex> lock( readLock );
+                slot.m_ready = false;
+                filesConsumed = fileIndex;
+                if ( options.m_readAheadThreads > 0 )
+                    bytesBuffered -= entry.m_fileSize;
+            }
+            readSlotFreed.notify_all();
+        }
 
-        if ( !appendStatus.ok() )
-            return appendStatus;
+        if ( !writeStatus.ok() )
+            return writeStatus;
+
+        // the root directory entry itself is not included in the reported count
+        if ( &entry != &plannedEntries.front() )
+        {
+            filesProcessedIntoTar++;
 
-        if ( archivingProgressFunction != nullptr )
-            archivingProgressFunction( bytesProcessedIntoTar, filesProcessedIntoTar );
+            if ( archivingProgressFunction != nullptr )
+                archivingProgressFunction( bytesProcessedIntoTar, filesProcessedIntoTar );
+        }
     }
 
     // EOF marker for TAR is two blank 512-byte chunks
-    fwrite( ioPadding, 512, 1, tarOutputFile );
-    fwrite( ioPadding, 512, 1, tarOutputFile );
+    std::ignore = tarOutput.writePadding( sizeof( THeader ) * 2 );
 
-    return absl::OkStatus();
+    return tarOutput.flush( true );
 }
 
 absl::Status unarchiveTARIntoDirectory(
     const std::filesystem::path& inputTarFile,
     const std::filesystem::path& outputPath,
-    const ArchiveProgressCallback& archivingProgressFunction )
+    const ArchiveProgressCallback& archivingProgressFunction,
+    const UnarchiveOptions& options,
+    UnarchiveStats* stats )
 {
     FILE* tarInputFile = fopen( inputTarFile.string().c_str(), "rb" );
+    if ( tarInputFile == nullptr )
+    {
+        return absl::NotFoundError( fmt::format( FMTX( "unable to open Tar [{}]" ), inputTarFile.string() ) );
+    }
     absl::Cleanup closeFileOnScopeExit = [&]() noexcept {
         fclose( tarInputFile );
         tarInputFile = nullptr;
         };
 
+    TarInputStream tarInput( tarInputFile );
+
     std::vector<uint8_t> loadBuffer;
     loadBuffer.reserve( 1 * 1024 * 1024 );
 
+    UnarchiveStats localStats;
+    UnarchiveStats& unarchiveStats = ( stats != nullptr ) ? *stats : localStats;
+    unarchiveStats = {};
+
     // keep track of bytes processed so the UI can show something happening
     std::size_t bytesProcessedFromTar = 0;
     std::size_t filesProcessedFromTar = 0;
@@ -305,10 +789,9 @@ absl::Status unarchiveTARIntoDirectory(
         THeader tarHeader;
         THeader::createDefault( tarHeader );
 
-        std::size_t bytesRead = fread( &tarHeader, sizeof( THeader ), 1, tarInputFile );
-        if ( bytesRead != 1 )
+        if ( !tarInput.read( &tarHeader, sizeof( THeader ) ) )
         {
-            return absl::AbortedError( fmt::format( FMTX( "unable to read Tar [{}] header, fread returned {}" ), inputTarFile.string(), bytesRead ) );
+            return absl::AbortedError( fmt::format( FMTX( "unable to read Tar [{}] header" ), inputTarFile.string() ) );
         }
 
         // header is entirely zero? marks the end of the file
@@ -338,32 +821,81 @@ absl::Status unarchiveTARIntoDirectory(
         {
             const uint32_t fileSize = oct2uint( tarHeader.size );
 
-            loadBuffer.resize( fileSize );
-            const std::size_t loadBufferRead = fread( loadBuffer.data(), 1, fileSize, tarInputFile );
-            if ( loadBufferRead != fileSize )
+            const std::size_t paddedSize   = paddedEntrySize( fileSize );
+            const std::size_t paddingBytes = paddedSize - fileSize;
+
+            // our own index is only useful to MountedTar, it doesn't belong in the output
+            if ( tarHeader.getEntryPath() == cEmbeddedIndexName )
             {
-                return absl::AbortedError( fmt::format( FMTX( "unable to read file data from tar [{}], fread returned {}" ), inputTarFile.string(), loadBufferRead ) );
+                if ( !tarInput.skip( paddedSize ) )
+                {
+                    return absl::AbortedError( fmt::format( FMTX( "unable to skip tar index in [{}]" ), inputTarFile.string() ) );
+                }
+                continue;
             }
 
-            const std::size_t paddingBytes = 512 - fileSize % 512;
-            if ( paddingBytes != 512 )
+            bool skipFile = false;
+            if ( options.m_skipExistingWithSameSize )
             {
-                fseek( tarInputFile, static_cast<long>( paddingBytes ), SEEK_CUR );
+                std::error_code existingError;
+                const std::uintmax_t existingSize = fs::file_size( outputFilePath, existingError );
+
+                skipFile = ( !existingError && existingSize == fileSize );
             }
 
+            if ( skipFile )
             {
-                FILE* stemOutputFile = fopen( outputFilePath.string().c_str(), "wb" );
-                absl::Cleanup closeOutputFileOnScopeExit = [&]() noexcept {
-                    fclose( stemOutputFile );
-                    stemOutputFile = nullptr;
-                    };
+                // jump straight over the file data and padding to the next header
+                if ( !tarInput.skip( paddedSize ) )
+                {
+                    return absl::AbortedError( fmt::format( FMTX( "unable to seek past [{}] in tar [{}]" ), tarHeader.name, inputTarFile.string() ) );
+                }
+
+                unarchiveStats.m_filesSkipped++;
+            }
+            else
+            {
+                loadBuffer.resize( fileSize );
+                if ( !tarInput.read( loadBuffer.data(), fileSize ) )
+                {
+                    return absl::AbortedError( fmt::format( FMTX( "unable to read file data for [{}] from tar [{}]" ), tarHeader.name, inputTarFile.string() ) );
+                }
 
-                if ( stemOutputFile == nullptr )
+                if ( !tarInput.skip( paddingBytes ) )
                 {
-                    return absl::AbortedError( fmt::format( FMTX( "failed to create output stem file [{}]" ), outputFilePath.string() ) );
+                    return absl::AbortedError( fmt::format( FMTX( "unable to seek past [{}] in tar [{}]" ), tarHeader.name, inputTarFile.string() ) );
                 }
 
-                fwrite( loadBuffer.data(), fileSize, 1, stemOutputFile );
+                // write to a temporary alongside the destination and only move it into place once it is complete, so
+                // an interrupted unpack never leaves behind a truncated file that could be mistaken for a valid one
+                fs::path partialFilePath = outputFilePath;
+                partialFilePath += ".unpacking";
+                {
+                    FILE* stemOutputFile = fopen( partialFilePath.string().c_str(), "wb" );
+                    if ( stemOutputFile == nullptr )
+                    {
+                        return absl::AbortedError( fmt::format( FMTX( "failed to create output stem file [{}]" ), partialFilePath.string() ) );
+                    }
+                    absl::Cleanup closeOutputFileOnScopeExit = [&]() noexcept {
+                        fclose( stemOutputFile );
+                        stemOutputFile = nullptr;
+                        };
+
+                    if ( fileSize > 0 && fwrite( loadBuffer.data(), fileSize, 1, stemOutputFile ) != 1 )
+                    {
+                        return absl::AbortedError( fmt::format( FMTX( "failed to write output stem file [{}]" ), partialFilePath.string() ) );
+                    }
+                }
+
+                std::error_code renameError;
+                fs::rename( partialFilePath, outputFilePath, renameError );
+                if ( renameError )
+                {
+                    return absl::AbortedError( fmt::format( FMTX( "failed to move [{}] into place ({})" ), outputFilePath.string(), renameError.message() ) );
+                }
+
+                unarchiveStats.m_filesWritten++;
+                unarchiveStats.m_bytesWritten += fileSize;
             }
 
             bytesProcessedFromTar += fileSize;
@@ -382,4 +914,186 @@ absl::Status unarchiveTARIntoDirectory(
     return absl::OkStatus();
 }
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::StatusOr< MountedTar::Instance > MountedTar::mount( const std::filesystem::path& inputTarFile )
+{
+    auto mappingResult = sys::MappedFile::openReadOnly( inputTarFile );
+    if ( !mappingResult.ok() )
+        return mappingResult.status();
+
+    MountedTar::Instance instanceResult = base::protected_make_shared<MountedTar>();
+    instanceResult->m_mapping = std::move( mappingResult.value() );
+
+    std::error_code lwtError;
+    const int64_t archiveModTime = static_cast<int64_t>( fs::last_write_time( inputTarFile, lwtError ).time_since_epoch().count() );
+
+    // archives we wrote ourselves carry their index up front, anything else gets one built and saved alongside
+    if ( instanceResult->loadEmbeddedIndex() )
+        return instanceResult;
+
+    const fs::path indexFile = getIndexPath( inputTarFile );
+    if ( !instanceResult->loadIndex( indexFile, archiveModTime ) )
+    {
+        const auto indexStatus = instanceResult->buildIndex();
+        if ( !indexStatus.ok() )
+            return indexStatus;
+
+        instanceResult->saveIndex( indexFile, archiveModTime );
+    }
+
+    return instanceResult;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::span< const uint8_t > MountedTar::find( const std::string& entryPath ) const
+{
+    const auto entryIt = m_entries.find( entryPath );
+    if ( entryIt == m_entries.end() )
+        return {};
+
+    return m_mapping->view( entryIt->second.m_offset, entryIt->second.m_length );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::filesystem::path MountedTar::getIndexPath( const std::filesystem::path& inputTarFile )
+{
+    fs::path indexFile = inputTarFile;
+    indexFile += ".index";
+    return indexFile;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status MountedTar::buildIndex()
+{
+    const std::string archiveName = m_mapping->getPath().string();
+
+    const uint8_t*    tarData = m_mapping->data();
+    const std::size_t tarSize = m_mapping->size();
+
+    m_entries.clear();
+
+    std::size_t headerOffset = 0;
+    while ( headerOffset + sizeof( THeader ) <= tarSize )
+    {
+        const THeader& tarHeader = *reinterpret_cast<const THeader*>( tarData + headerOffset );
+
+        // header is entirely zero? marks the end of the file
+        if ( tarHeader.sumBlockData() == 0 )
+            break;
+
+        // check for a 'ustar' as a magic identifier
+        if ( tarHeader.ustar[0] != 'u' || tarHeader.ustar[1] != 's' || tarHeader.ustar[2] != 't' )
+        {
+            return absl::AbortedError( fmt::format( FMTX( "Tar header mising ustar identifier at offset {}, aborting [{}]" ), headerOffset, archiveName ) );
+        }
+
+        const std::size_t fileOffset = headerOffset + sizeof( THeader );
+        const std::size_t fileSize   = oct2uint( tarHeader.size );
+
+        if ( fileOffset + fileSize > tarSize )
+        {
+            return absl::OutOfRangeError( fmt::format( FMTX( "Tar entry [{}] runs past the end of the archive [{}]" ), tarHeader.getEntryPath(), archiveName ) );
+        }
+
+        if ( tarHeader.link == THeader::FileType::NORMAL && tarHeader.getEntryPath() != cEmbeddedIndexName )
+        {
+            m_entries.insert_or_assign( tarHeader.getEntryPath(), Entry{ fileOffset, fileSize } );
+        }
+
+        headerOffset = fileOffset + paddedEntrySize( fileSize );
+    }
+
+    return absl::OkStatus();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool MountedTar::loadIndex( const std::filesystem::path& indexFile, const int64_t archiveModTime )
+{
+    std::ifstream indexStream( indexFile, std::ios::binary );
+    if ( !indexStream )
+        return false;
+
+    return parseIndex( indexStream, indexFile.string(), archiveModTime );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool MountedTar::loadEmbeddedIndex()
+{
+    if ( m_mapping->size() < sizeof( THeader ) )
+        return false;
+
+    const THeader& tarHeader = *reinterpret_cast<const THeader*>( m_mapping->data() );
+    if ( tarHeader.link != THeader::FileType::NORMAL || tarHeader.getEntryPath() != cEmbeddedIndexName )
+        return false;
+
+    const std::size_t indexSize = oct2uint( tarHeader.size );
+    if ( sizeof( THeader ) + indexSize > m_mapping->size() )
+        return false;
+
+    // embedded indices are written alongside the data they describe, so there's no modification time to check
+    std::istringstream indexStream( std::string( reinterpret_cast<const char*>( m_mapping->data() + sizeof( THeader ) ), indexSize ), std::ios::binary );
+    return parseIndex( indexStream, cEmbeddedIndexName, 0 );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool MountedTar::parseIndex( std::istream& indexStream, const std::string& indexName, const int64_t archiveModTime )
+{
+    MountedTarIndexFile indexData;
+    try
+    {
+        cereal::BinaryInputArchive archive( indexStream );
+        indexData.serialize( archive );
+    }
+    catch ( cereal::Exception& cEx )
+    {
+        blog::error::core( FMTX( "tar index [{}] failed to parse : {}" ), indexName, cEx.what() );
+        return false;
+    }
+
+    if ( indexData.m_version        != MountedTarIndexFile::cVersion ||
+         indexData.m_archiveSize    != m_mapping->size() ||
+         indexData.m_archiveModTime != archiveModTime )
+    {
+        return false;
+    }
+
+    m_entries.clear();
+    m_entries.reserve( indexData.m_entries.size() );
+    for ( auto& indexedEntry : indexData.m_entries )
+    {
+        // don't trust anything that would read outside the mapping
+        if ( indexedEntry.m_offset + indexedEntry.m_length > m_mapping->size() )
+            return false;
+
+        m_entries.insert_or_assign( std::move( indexedEntry.m_path ), Entry{ indexedEntry.m_offset, indexedEntry.m_length } );
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void MountedTar::saveIndex( const std::filesystem::path& indexFile, const int64_t archiveModTime ) const
+{
+    MountedTarIndexFile indexData;
+    indexData.m_archiveSize     = m_mapping->size();
+    indexData.m_archiveModTime  = archiveModTime;
+    indexData.m_entries.reserve( m_entries.size() );
+    for ( const auto& entry : m_entries )
+    {
+        indexData.m_entries.emplace_back( MountedTarIndexFile::IndexedEntry{ entry.first, entry.second.m_offset, entry.second.m_length } );
+    }
+
+    // the archive may well live somewhere read-only; that just means the index is rebuilt each time it's mounted
+    std::ofstream indexStream( indexFile, std::ios::binary );
+    if ( !indexStream )
+    {
+        blog::core( FMTX( "unable to write tar index [{}], will be rebuilt on next mount" ), indexFile.string() );
+        return;
+    }
+
+    cereal::BinaryOutputArchive archive( indexStream );
+    indexData.serialize( archive );
+}
+
 } // namespace io
@@ -9,22 +9,107 @@
 
 #pragma once
 
+#include "sys/mmap.h"
+
 namespace io {
 
 using ArchiveProgressCallback = std::function< void( const std::size_t bytesProcessed, const std::size_t filesProcessed ) >;
 
-// walk through all files & directories in inputPath, pack them in order into the tar file specified by outputTarFile
+// optional behaviour for archiveFilesInDirectoryToTAR
+struct ArchiveOptions
+{
+    // number of threads reading files ahead of the writer; 0 reads each file inline, one after another
+    uint32_t            m_readAheadThreads = 4;
+
+    // cap on how much file data the read-ahead threads can have buffered at once; a single file larger than this is
+    // still read, but only once it's the next one the writer needs
+    std::size_t         m_readAheadBytes = 64 * 1024 * 1024;
+
+    // if above zero, the whole tar is passed through zstd at this level as it is written. compressed archives can be
+    // unpacked with unarchiveTARIntoDirectory but cannot be mounted
+    int32_t             m_zstdCompressionLevel = 0;
+};
+
+// walk through all files & directories in inputPath, pack them into the tar file specified by outputTarFile. entries
+// are written sorted by path so the same inputs always produce the same archive, and an index of every file is
+// embedded as the first entry for MountedTar to pick up
 absl::Status archiveFilesInDirectoryToTAR(
     const std::filesystem::path& inputPath,
     const std::filesystem::path& outputTarFile,
-    const ArchiveProgressCallback& archivingProgressFunction
+    const ArchiveProgressCallback& archivingProgressFunction,
+    const ArchiveOptions& options = {}
 );
 
-// load and extract all files and directories in inputTarFile into the root directory specified in outputPath
+// optional behaviour for unarchiveTARIntoDirectory
+struct UnarchiveOptions
+{
+    // if a file already exists at the destination with exactly the size recorded in the archive, seek past it rather
+    // than reading and rewriting it. as files are always written to a temporary name and renamed into place once
+    // complete, re-running an interrupted unpack with this set effectively resumes where the last one stopped
+    bool                m_skipExistingWithSameSize = false;
+};
+
+struct UnarchiveStats
+{
+    std::size_t         m_filesWritten = 0;
+    std::size_t         m_filesSkipped = 0;
+    std::size_t         m_bytesWritten = 0;
+};
+
+// load and extract all files and directories in inputTarFile into the root directory specified in outputPath;
+// zstd-compressed archives are detected and decompressed on the fly
 absl::Status unarchiveTARIntoDirectory(
     const std::filesystem::path& inputTarFile,
     const std::filesystem::path& outputPath,
-    const ArchiveProgressCallback& archivingProgressFunction
+    const ArchiveProgressCallback& archivingProgressFunction,
+    const UnarchiveOptions& options = {},
+    UnarchiveStats* stats = nullptr
 );
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// read-only random access into a tar written by archiveFilesInDirectoryToTAR; the archive is memory-mapped and files
+// are served in place, so nothing is extracted and any number of threads can read at once. archives carrying an
+// embedded index use that directly; for any others the index is built by walking the tar headers once and is then
+// saved alongside the archive, only rebuilt if the archive changes
+//
+struct MountedTar
+{
+    using Instance = std::shared_ptr< MountedTar >;
+
+    static absl::StatusOr< Instance > mount( const std::filesystem::path& inputTarFile );
+
+    // return the data for the file stored at entryPath (forward-slash separated, as written into the archive) or an
+    // empty span if there is no such file; the span remains valid for as long as this instance does
+    ouro_nodiscard std::span< const uint8_t > find( const std::string& entryPath ) const;
+
+    ouro_nodiscard std::size_t getEntryCount() const { return m_entries.size(); }
+    ouro_nodiscard const std::filesystem::path& getArchivePath() const { return m_mapping->getPath(); }
+
+    // where the saved index for a given archive lives
+    ouro_nodiscard static std::filesystem::path getIndexPath( const std::filesystem::path& inputTarFile );
+
+protected:
+
+    MountedTar() = default;
+
+private:
+
+    struct Entry
+    {
+        uint64_t    m_offset = 0;
+        uint64_t    m_length = 0;
+    };
+    using EntryMap = absl::flat_hash_map< std::string, Entry >;
+
+    absl::Status buildIndex();
+    ouro_nodiscard bool loadIndex( const std::filesystem::path& indexFile, const int64_t archiveModTime );
+    ouro_nodiscard bool loadEmbeddedIndex();
+    ouro_nodiscard bool parseIndex( std::istream& indexStream, const std::string& indexName, const int64_t archiveModTime );
+    void saveIndex( const std::filesystem::path& indexFile, const int64_t archiveModTime ) const;
+
+    sys::MappedFile::Instance   m_mapping;
+    EntryMap                    m_entries;
+};
+
 } // namespace io
@@ -55,6 +55,10 @@
 #define OURO_THREAD_LIMIT   (10U)
 #endif
 
+// bounds for the pool that runs blocking network and disk work, kept apart from the compute workers above
+#define OURO_IO_THREAD_MIN  (4U)
+#define OURO_IO_THREAD_MAX  (8U)
+
 
 // ---------------------------------------------------------------------------------------------------------------------
 
@@ -162,105 +166,89 @@ namespace fs = std::filesystem;
 // we want the power of {fmt}'s formatting but with a bit of boilerplate to establish common
 // colours and output formatting per subsystem; this exposes an arbitrarily coloured blog::<system> and blog::error::<system>
 // that standardize on the column prefixes and other details whilst otherwise behaving exactly like fmt::print
+//
+// formatted lines are handed to the backend in base/logging.cpp; once that has been started, lines are queued
+// per-thread and written out by a background thread, so logging never blocks the caller (eg. the audio thread)
 namespace blog {
+
+//                  name        colour       prefix
+#define _BLOG_SYSTEMS(_action)                       \
+    _action( core,     0xFD971F,    "CORE" )         \
+    _action( gfx,      0xb05279,    " GFX" )         \
+    _action( app,      0xA6E22E,    " APP" )         \
+    _action( instr,    0xAEEF1A,    "PERF" )         \
+    _action( cfg,      0xe6a637,    " CFG" )         \
+    _action( cache,    0xe6d738,    "  C$" )         \
+    _action( api,      0xa2e65a,    " API" )         \
+    _action( database, 0x55e52d,    "  DB" )         \
+    _action( plug,     0x78dce8,    "PLUG" )         \
+    _action( discord,  0x885de6,    "DISC" )         \
+                                                     \
+    _action( mix,      0x5bcce6,    " MIX" )         \
+    _action( jam,      0x5c7ee6,    " JAM" )         \
+    _action( riff,     0xe458e9,    "RIFF" )         \
+    _action( stem,     0xe65ea9,    "STEM" )
+
+enum class System : uint8_t
+{
+#define _BLOG_SYSTEM_ENUM( _name, _colour, _nameBold )     _name,
+    _BLOG_SYSTEMS( _BLOG_SYSTEM_ENUM )
+#undef _BLOG_SYSTEM_ENUM
+    Count
+};
+
+enum class Level : uint8_t
+{
+    Debug,
+    Info,
+    Error,
+    Off                 // only used as a filter threshold
+};
+
 namespace detail {
 
-    template < bool emit_in_release, const fmt::color _fg1, const fmt::color _fg2, typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>
+    // returns false if the given system is currently filtering out messages of this level
+    bool _isEnabled( const System system, const Level level ) noexcept;
+
+    // pass a formatted line (no trailing newline) on to the backend for output
+    void _submit( const System system, const Level level, const std::string_view prefix, const fmt::color fg1, const fmt::color fg2, const std::string_view text ) noexcept;
+
+    template < bool emit_in_release, const System _system, const Level _level, const fmt::color _fg1, const fmt::color _fg2, typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>
     void _printer( const std::string_view prefix, const S& format_str, const Args&... args ) noexcept
     {
         if constexpr ( ( emit_in_release && OURO_RELEASE ) || OURO_DEBUG )  // allow masking of output based on template arg and build config
         {
-            const auto& vargs = fmt::make_format_args( args... );
-
-            constexpr std::string_view midsep = " | ";
-            constexpr std::string_view suffix = "\n";
-
-#if OURO_ENABLE_COLOURED_LOGGING
-            constexpr auto foreground1 = fmt::detail::make_foreground_color<char>( fmt::detail::color_type( _fg1 ) );
-            constexpr auto foreground2 = fmt::detail::make_foreground_color<char>( fmt::detail::color_type( _fg2 ) );
-#endif // OURO_ENABLE_COLOURED_LOGGING
+            if ( !_isEnabled( _system, _level ) )
+                return;
 
-            // size of buffer used by ansi_color_escape
-            constexpr size_t size_of_text_style = 7u + 3u * 4u + 1u;
+            const auto& vargs = fmt::make_format_args( args... );
 
-            // format the input into our first buffer
-            static thread_local fmt::basic_memory_buffer<char> formatBuffer;
+            // format the input into a per-thread buffer; the inline storage is sized so that typical log lines
+            // never need to touch the heap, keeping this safe to call from real-time threads
+            static thread_local fmt::basic_memory_buffer<char, 1024> formatBuffer;
             {
                 formatBuffer.clear();
                 fmt::detail::vformat_to( formatBuffer, fmt::detail::to_string_view( format_str ), vargs, {} );
             }
 
-            // build the final output by appending components
-            static thread_local fmt::basic_memory_buffer<char> outputBuffer;
-            {
-                const auto size = formatBuffer.size() + 1;
-
-                const size_t bufferSize =
-                    (size_of_text_style * 5) +
-                    prefix.size() +
-                    size +
-                    suffix.size();
-
-                outputBuffer.try_reserve( bufferSize );
-                outputBuffer.clear();
-
-#if OURO_ENABLE_COLOURED_LOGGING
-                outputBuffer.append( foreground1.begin(), foreground1.end() );
-#endif // OURO_ENABLE_COLOURED_LOGGING
-
-                outputBuffer.append( prefix );
-
-#if OURO_ENABLE_COLOURED_LOGGING
-                fmt::detail::reset_color( outputBuffer );
-#endif // OURO_ENABLE_COLOURED_LOGGING
-
-                outputBuffer.append( midsep );
-
-#if OURO_ENABLE_COLOURED_LOGGING
-                outputBuffer.append( foreground2.begin(), foreground2.end() );
-#endif // OURO_ENABLE_COLOURED_LOGGING
-
-                outputBuffer.append( formatBuffer );
-                outputBuffer.append( suffix );
-
-#if OURO_ENABLE_COLOURED_LOGGING
-                fmt::detail::reset_color( outputBuffer );
-#endif // OURO_ENABLE_COLOURED_LOGGING
-                outputBuffer.push_back( '\0' );
-            }
-
-            std::cout << outputBuffer.data();
+            _submit( _system, _level, prefix, _fg1, _fg2, std::string_view( formatBuffer.data(), formatBuffer.size() ) );
         }
     }
 }
 
-#define ADD_BLOG( _name, _colour, _nameBold )                                                                                                                                               \
-        template <typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>                                                                                          \
-        void _name( const S& format_str, const Args&... args ) { detail::_printer<true, fmt::color::white, (fmt::color)_colour, S, Args...>( _nameBold, format_str, args...); }             \
-        namespace error {                                                                                                                                                                   \
-        template <typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>                                                                                          \
-        void _name( const S& format_str, const Args&... args ) { detail::_printer<true, fmt::color::red, fmt::color::orange_red, S, Args...>( _nameBold, format_str, args... ); }           \
-        }                                                                                                                                                                                   \
-        namespace debug {                                                                                                                                                                   \
-        template <typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>                                                                                          \
-        void _name( const S& format_str, const Args&... args ) { detail::_printer<false, fmt::color::hot_pink, fmt::color::light_pink, S, Args...>( _nameBold, format_str, args... ); }     \
+#define ADD_BLOG( _name, _colour, _nameBold )                                                                                                                                                                       \
+        template <typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>                                                                                                                  \
+        void _name( const S& format_str, const Args&... args ) { detail::_printer<true, System::_name, Level::Info, fmt::color::white, (fmt::color)_colour, S, Args...>( _nameBold, format_str, args...); }          \
+        namespace error {                                                                                                                                                                                           \
+        template <typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>                                                                                                                  \
+        void _name( const S& format_str, const Args&... args ) { detail::_printer<true, System::_name, Level::Error, fmt::color::red, fmt::color::orange_red, S, Args...>( _nameBold, format_str, args... ); }        \
+        }                                                                                                                                                                                                           \
+        namespace debug {                                                                                                                                                                                           \
+        template <typename S, typename... Args, FMT_ENABLE_IF( fmt::detail::is_string<S>::value )>                                                                                                                  \
+        void _name( const S& format_str, const Args&... args ) { detail::_printer<false, System::_name, Level::Debug, fmt::color::hot_pink, fmt::color::light_pink, S, Args...>( _nameBold, format_str, args... ); }  \
         }
 
-ADD_BLOG( core,     0xFD971F,    "CORE" )
-ADD_BLOG( gfx,      0xb05279,    " GFX" )
-ADD_BLOG( app,      0xA6E22E,    " APP" )
-ADD_BLOG( instr,    0xAEEF1A,    "PERF" )
-ADD_BLOG( cfg,      0xe6a637,    " CFG" )
-ADD_BLOG( cache,    0xe6d738,    "  C$" )
-ADD_BLOG( api,      0xa2e65a,    " API" )
-ADD_BLOG( database, 0x55e52d,    "  DB" )
-ADD_BLOG( plug,     0x78dce8,    "PLUG" )
-ADD_BLOG( discord,  0x885de6,    "DISC" )
-
-ADD_BLOG( mix,      0x5bcce6,    " MIX" )
-ADD_BLOG( jam,      0x5c7ee6,    " JAM" )
-ADD_BLOG( riff,     0xe458e9,    "RIFF" )
-ADD_BLOG( stem,     0xe65ea9,    "STEM" )
+_BLOG_SYSTEMS( ADD_BLOG )
 
 } // namespace blog
 
@@ -6,7 +6,8 @@
 //
 //  a buffer manager built to help sample processors offload more expensive encoding/compression tasks
 //  to a background worker thread; samples are added via appendStereoSamples() until the active buffer is expended, 
-//  at which point the worker thread is woken up and the buffer pointers exchanged so that the audio thread is not interrupted
+//  at which point the worker thread is woken up and the buffer pointers exchanged so that the audio thread is not interrupted;
+//  the worker in turn swaps the filled page for a third one of its own, so the processing runs without the lock held
 //
 //  it is intended that an ssp inherits from this processor with a chosen interleaved buffer type and
 //  implements processBufferedSamplesFromThread() that will be called (as you can imagine) from the worker thread
@@ -30,12 +31,14 @@ struct AsyncBufferProcessor
     {
         m_activePage    = new _bufferType( bufferSampleSize );
         m_reservePage   = new _bufferType( bufferSampleSize );
+        m_workPage      = new _bufferType( bufferSampleSize );
     }
 
     virtual ~AsyncBufferProcessor()
     {
         terminateProcessorThread();
 
+        delete m_workPage;
         delete m_reservePage;
         delete m_activePage;
     }
@@ -106,6 +109,7 @@ struct AsyncBufferProcessor
 
                 std::swap( m_activePage, m_reservePage );
                 m_activePage->m_currentSamples = 0;
+                m_processorPending = true;
             }
             m_processorCVar.notify_one();
         }
@@ -139,23 +143,30 @@ private:
         blog::core( "[{}] processor thread launched", m_identifier );
 
         ABSL_ASSERT( m_reservePage != nullptr );
+        ABSL_ASSERT( m_workPage != nullptr );
         for ( ;; )
         {
-            std::unique_lock<std::mutex> lock( m_processorMutex );
-            m_processorCVar.wait( lock );
+            {
+                std::unique_lock<std::mutex> lock( m_processorMutex );
+                m_processorCVar.wait( lock, [this] { return m_processorPending || !m_processorThreadRun; } );
+
+                if ( !m_processorThreadRun )
+                    break;
 
-            if ( !m_processorThreadRun )
-                break;
+                m_processorPending = false;
+
+                // take the filled page out of circulation and leave our spare in its place; the audio thread only
+                // ever touches the reserve page under this lock, so from here on it never has to wait for the encoder
+                std::swap( m_reservePage, m_workPage );
+            }
 
             {
                 base::instr::ScopedEvent se( m_identifier.c_str(), "process-samples", base::instr::PresetColour::Orange );
 
-                m_reservePage->quantise();
-                processBufferedSamplesFromThread( *m_reservePage );
-                m_reservePage->m_committed = true;
+                m_workPage->quantise();
+                processBufferedSamplesFromThread( *m_workPage );
+                m_workPage->m_committed = true;
             }
-
-            lock.unlock();
         }
     }
 
@@ -166,11 +177,13 @@ private:
     // inter-thread communication to signal compression jobs ready
     std::mutex                      m_processorMutex;
     std::condition_variable         m_processorCVar;
+    bool                            m_processorPending      = false;    // reserve page is waiting to be processed; guarded by m_processorMutex
 
     std::string                     m_identifier;
 
     _bufferType*                    m_activePage            = nullptr;
     _bufferType*                    m_reservePage           = nullptr;
+    _bufferType*                    m_workPage              = nullptr;     // only touched by the worker thread
 };
 
 using AsyncBufferProcessorIQ16 = AsyncBufferProcessor< base::IQ16Buffer >;
@@ -100,6 +100,8 @@ struct OpusStream::StreamInstance final : public AsyncBufferProcessorIQ16
         opus_encoder_ctl( m_opusEncoder, OPUS_SET_PACKET_LOSS_PERC( 0 ) );
         opus_encoder_ctl( m_opusEncoder, OPUS_GET_PACKET_LOSS_PERC( &m_compressionSetup.m_expectedPacketLossPercent ) );
 
+        opus_encoder_ctl( m_opusEncoder, OPUS_GET_LOOKAHEAD( &m_encoderLookahead ) );
+
         m_opusRepacketizer = opus_repacketizer_create();
 
         return absl::OkStatus();
@@ -173,6 +175,7 @@ struct OpusStream::StreamInstance final : public AsyncBufferProcessorIQ16
     }
 
     CompressionSetup                m_compressionSetup;
+    int32_t                         m_encoderLookahead      = 0;
 
     OpusEncoder*                    m_opusEncoder           = nullptr;
     OpusRepacketizer*               m_opusRepacketizer      = nullptr;
@@ -235,6 +238,12 @@ void OpusStream::setCompressionSetup( const OpusStream::CompressionSetup& setup
     m_state->m_compressionSetup = setup;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+uint16_t OpusStream::getEncoderLookahead() const
+{
+    return static_cast<uint16_t>( m_state->m_encoderLookahead );
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 OpusStream::OpusStream( const StreamProcessorInstanceID instanceID, std::unique_ptr< StreamInstance >& state )
     : ISampleStreamProcessor( instanceID )
@@ -80,6 +80,9 @@ public:
     CompressionSetup getCurrentCompressionSetup() const;
     void setCompressionSetup( const CompressionSetup& setup );
 
+    // encoder lookahead in samples, as required for the pre-skip field when wrapping the packets up in an Ogg container
+    uint16_t getEncoderLookahead() const;
+
 
 private:
 
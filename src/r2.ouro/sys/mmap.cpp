@@ -0,0 +1,153 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  cross platform read-only memory mapping of whole files
+//
+
+#include "pch.h"
+#include "base/construction.h"
+#include "sys/mmap.h"
+
+#if OURO_PLATFORM_WIN
+
+#include "win32/errors.h"
+
+#else // LINUX / MAC
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+namespace sys {
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::StatusOr< MappedFile::Instance > MappedFile::openReadOnly( const fs::path& filePath )
+{
+    MappedFile::Instance instanceResult = base::protected_make_shared<MappedFile>();
+
+    instanceResult->m_originalPath = filePath;
+
+#if OURO_PLATFORM_WIN
+
+    instanceResult->m_hFile = ::CreateFileW(
+        filePath.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,    // let the file be renamed or deleted under us, see openReadOnly()
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr );
+
+    if ( instanceResult->m_hFile == INVALID_HANDLE_VALUE )
+        return absl::NotFoundError( fmt::format( FMTX( "unable to open [{}] for mapping; {}" ), filePath.string(), getLastError() ) );
+
+    LARGE_INTEGER fileSize;
+    if ( ::GetFileSizeEx( instanceResult->m_hFile, &fileSize ) == FALSE )
+        return absl::InternalError( fmt::format( FMTX( "unable to get size of [{}]; {}" ), filePath.string(), getLastError() ) );
+
+    instanceResult->m_size = static_cast<std::size_t>( fileSize.QuadPart );
+
+    // zero-length files cannot be mapped; leave as an empty, valid instance
+    if ( instanceResult->m_size == 0 )
+        return instanceResult;
+
+    instanceResult->m_hFileMapping = ::CreateFileMappingW( instanceResult->m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if ( instanceResult->m_hFileMapping == nullptr )
+        return absl::InternalError( fmt::format( FMTX( "unable to create mapping for [{}]; {}" ), filePath.string(), getLastError() ) );
+
+    instanceResult->m_data = static_cast<const uint8_t*>( ::MapViewOfFile( instanceResult->m_hFileMapping, FILE_MAP_READ, 0, 0, 0 ) );
+    if ( instanceResult->m_data == nullptr )
+        return absl::InternalError( fmt::format( FMTX( "unable to map view of [{}]; {}" ), filePath.string(), getLastError() ) );
+
+#else // LINUX / MAC
+
+    const int fileDescriptor = ::open( filePath.string().c_str(), O_RDONLY );
+    if ( fileDescriptor < 0 )
+        return absl::NotFoundError( fmt::format( FMTX( "unable to open [{}] for mapping; {}" ), filePath.string(), getLastError() ) );
+
+    // the mapping holds its own reference to the file, the descriptor is not needed beyond this function
+    absl::Cleanup closeOnScopeExit = [fileDescriptor]() noexcept
+    {
+        ::close( fileDescriptor );
+    };
+
+    struct stat fileStat;
+    if ( ::fstat( fileDescriptor, &fileStat ) != 0 )
+        return absl::InternalError( fmt::format( FMTX( "unable to get size of [{}]; {}" ), filePath.string(), getLastError() ) );
+
+    instanceResult->m_size = static_cast<std::size_t>( fileStat.st_size );
+
+    // zero-length files cannot be mapped; leave as an empty, valid instance
+    if ( instanceResult->m_size == 0 )
+        return instanceResult;
+
+    void* mappedData = ::mmap( nullptr, instanceResult->m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+    if ( mappedData == MAP_FAILED )
+        return absl::InternalError( fmt::format( FMTX( "unable to map [{}]; {}" ), filePath.string(), getLastError() ) );
+
+    instanceResult->m_data = static_cast<const uint8_t*>( mappedData );
+
+#endif
+
+    return instanceResult;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+#if OURO_PLATFORM_WIN
+    if ( m_data != nullptr )
+        ::UnmapViewOfFile( m_data );
+    if ( m_hFileMapping != nullptr )
+        ::CloseHandle( m_hFileMapping );
+    if ( m_hFile != INVALID_HANDLE_VALUE )
+        ::CloseHandle( m_hFile );
+#else // LINUX / MAC
+    if ( m_data != nullptr )
+    {
+        if ( ::munmap( const_cast<uint8_t*>( m_data ), m_size ) != 0 )
+        {
+            blog::error::core( FMTX( "failed to unmap [{}]; {}" ), m_originalPath.string(), getLastError() );
+        }
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void MappedFile::adviseSequential() const
+{
+    if ( m_data == nullptr )
+        return;
+
+#if OURO_PLATFORM_WIN
+    WIN32_MEMORY_RANGE_ENTRY mappedRange;
+    mappedRange.VirtualAddress  = const_cast<uint8_t*>( m_data );
+    mappedRange.NumberOfBytes   = m_size;
+
+    ::PrefetchVirtualMemory( ::GetCurrentProcess(), 1, &mappedRange, 0 );
+#else // LINUX / MAC
+    ::madvise( const_cast<uint8_t*>( m_data ), m_size, MADV_SEQUENTIAL );
+    ::madvise( const_cast<uint8_t*>( m_data ), m_size, MADV_WILLNEED );
+#endif
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::string MappedFile::getLastError()
+{
+#if OURO_PLATFORM_WIN
+    return win32::FormatLastErrorCode();
+#else // LINUX / MAC
+    return std::string( ::strerror( errno ) );
+#endif
+}
+
+} // namespace sys
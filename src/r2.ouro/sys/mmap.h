@@ -0,0 +1,60 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  cross platform read-only memory mapping of whole files
+//
+
+#pragma once
+
+namespace sys {
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct MappedFile
+{
+    using Instance = std::shared_ptr< MappedFile >;
+
+    ~MappedFile();
+
+    // map the entire file read-only; the mapping is safe to read from any number of threads at once.
+    // the file can still be renamed or deleted by others while mapped (windows may refuse to replace it outright while
+    // any mapping is live), but it must never be truncated or rewritten in place - on POSIX, touching a page that no
+    // longer has file behind it raises SIGBUS. replace mapped files by writing a temporary and renaming it over the top
+    static absl::StatusOr< Instance > openReadOnly( const fs::path& filePath );
+
+    ouro_nodiscard const uint8_t* data() const { return m_data; }
+    ouro_nodiscard std::size_t size() const { return m_size; }
+
+    ouro_nodiscard std::span< const uint8_t > view( const std::size_t offset, const std::size_t length ) const
+    {
+        ABSL_ASSERT( offset + length <= m_size );
+        return std::span< const uint8_t >( m_data + offset, length );
+    }
+
+    ouro_nodiscard const fs::path& getPath() const { return m_originalPath; }
+
+    // hint that the whole mapping is about to be read once from front to back, so the OS can read ahead aggressively
+    // rather than faulting pages in one at a time; purely advisory, failure is ignored
+    void adviseSequential() const;
+
+protected:
+
+    MappedFile() = default;
+
+private:
+
+    static std::string getLastError();
+
+    fs::path        m_originalPath;
+    const uint8_t*  m_data = nullptr;
+    std::size_t     m_size = 0;
+
+#if OURO_PLATFORM_WIN
+    HANDLE          m_hFile         = INVALID_HANDLE_VALUE;
+    HANDLE          m_hFileMapping  = nullptr;
+#endif
+};
+
+} // namespace sys
@@ -24,4 +24,5 @@
 #include "endlesss/toolkit.riff.export.h"
 #include "endlesss/toolkit.riff.pipeline.h"
 #include "endlesss/toolkit.shares.h"
+#include "endlesss/toolkit.stem.precache.h"
 #include "endlesss/toolkit.warehouse.h"
@@ -181,7 +181,9 @@ httplib::Result NetConfiguration::attempt( const std::function<httplib::Result()
 
     // on failure, circle until we run out of tries or the call succeeds
     uint32_t delayInMs = 250;
-    while ( (opResult == nullptr || opResult.error() != httplib::Error::Success) && retries > 0 )
+    while ( (opResult == nullptr || opResult.error() != httplib::Error::Success) &&
+            opResult.error() != httplib::Error::Canceled &&     // deliberately aborted, trying again would undo that
+            retries > 0 )
     {
         {
             metricsActivityFailure();
@@ -232,7 +234,7 @@ endlesss::types::JamCouchID NetConfiguration::checkAndSanitizeJamCouchID( const
 // ---------------------------------------------------------------------------------------------------------------------
 // used by all API calls to create a primed http client instance; seeded with the correct headers, authentication, SSL etc
 // 
-std::unique_ptr<httplib::SSLClient> createEndlesssHttpClient( const NetConfiguration& ncfg, const UserAgent ua )
+std::unique_ptr<httplib::Client> createEndlesssHttpClient( const NetConfiguration& ncfg, const UserAgent ua )
 {
     using namespace std::literals::chrono_literals;
 
@@ -272,7 +274,7 @@ std::unique_ptr<httplib::SSLClient> createEndlesssHttpClient( const NetConfigura
             break;
     }
 
-    auto dataClient = std::make_unique< httplib::SSLClient >( requestDomain );
+    auto dataClient = std::make_unique< httplib::Client >( ncfg.resolveOrigin( requestDomain ) );
 
     dataClient->set_ca_cert_path( ncfg.api().certBundleRelative.c_str() );
     dataClient->enable_server_certificate_verification( true );
@@ -374,6 +376,46 @@ bool JamChanges::fetchSince( const NetConfiguration& ncfg, const endlesss::types
     return deserializeJson< JamChanges >( ncfg, res, *this, fmt::format( "{}( {} )", __FUNCTION__, jamDatabaseID_Sanitised ), "jam_changes_since" );
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+bool JamChanges::fetchLongpoll(
+    const NetConfiguration& ncfg,
+    const endlesss::types::JamCouchID& jamDatabaseID,
+    const std::string& seqSince,
+    const std::chrono::seconds timeout,
+    const ActiveClientHook& activeClientHook )
+{
+    const endlesss::types::JamCouchID& jamDatabaseID_Sanitised = ncfg.checkAndSanitizeJamCouchID( jamDatabaseID );
+
+    auto client = createEndlesssHttpClient( ncfg, UserAgent::Couchbase );
+
+    // the server will sit on the request for up to `timeout` before replying, so give the read some headroom on top
+    client->set_read_timeout( timeout + ncfg.getRequestTimeout() );
+
+    auto res = ncfg.attempt( [&]() -> httplib::Result {
+        // asked on every attempt; whoever owns the hook may have started shutting down since the last one
+        if ( activeClientHook && !activeClientHook( client.get() ) )
+            return httplib::Result{ nullptr, httplib::Error::Canceled };
+
+        auto postResult = client->Post(
+            fmt::format( "/user_appdata${}/_changes?since={}&timeout={}",
+                jamDatabaseID_Sanitised,
+                seqSince,
+                std::chrono::duration_cast<std::chrono::milliseconds>( timeout ).count() ).c_str(),
+            keyBodyLongpoll,
+            cMimeApplicationJson );
+
+        if ( activeClientHook )
+            activeClientHook( nullptr );
+
+        return postResult;
+        });
+
+    if ( res == nullptr || res.error() != httplib::Error::Success )
+        ncfg.metricsActivityFailure();
+
+    return deserializeJson< JamChanges >( ncfg, res, *this, fmt::format( "{}( {} )", __FUNCTION__, jamDatabaseID_Sanitised ), "jam_changes_longpoll" );
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 bool JamLatestState::fetch( const NetConfiguration& ncfg, const endlesss::types::JamCouchID& jamDatabaseID )
 {
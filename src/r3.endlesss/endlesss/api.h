@@ -69,6 +69,19 @@ public:
     // writable temp location for verbose/debug logging if enabled
     void setVerboseCaptureOutputPath( const fs::path& captureDir ) { m_verboseOutputDir = captureDir; }
 
+    // redirect every endlesss client (API, couch, CDN) at a different origin, eg. "http://127.0.0.1:12345"; used by the
+    // bench to run the network code against a local stub server. runtime-only, never loaded from or saved to config
+    void setStubOrigin( std::string origin ) { m_stubOrigin = std::move( origin ); }
+    ouro_nodiscard const std::string& getStubOrigin() const { return m_stubOrigin; }
+
+    // scheme + host to hand to a httplib::Client for the given endlesss domain; https to the real thing unless stubbed
+    ouro_nodiscard std::string resolveOrigin( std::string_view host ) const
+    {
+        if ( !m_stubOrigin.empty() )
+            return m_stubOrigin;
+        return fmt::format( FMTX( "https://{}" ), host );
+    }
+
     
     // modify loaded config::endlesss::rAPI data with advanced option toggles
     // call after init()
@@ -153,7 +166,7 @@ public:
 
 
     // utility function used by API calls to get their call attempted an getRequestRetries() number of times, returning
-    // on success (or whatever the final failure is otherwise)
+    // on success (or whatever the final failure is otherwise); a Canceled result is returned straight away, not retried
     httplib::Result attempt( const std::function<httplib::Result()>& operation ) const;
 
 
@@ -196,6 +209,9 @@ private:
     // for capture/debug output
     fs::path                    m_verboseOutputDir;
 
+    // see setStubOrigin()
+    std::string                 m_stubOrigin;
+
     // used to precondition incoming data against the version of endless that decided to start writing "Length" values
     // as strings instead of numbers - this regex patches those back to numbers
     std::regex                  m_dataFixRegex_lengthTypeMismatch;
@@ -648,11 +664,26 @@ struct JamChanges
         );
     }
 
-    static constexpr auto keyBody = R"({ "feed" : "normal", "style" : "all_docs", "active_only" : true })";
+    static constexpr auto keyBody           = R"({ "feed" : "normal", "style" : "all_docs", "active_only" : true })";
+    static constexpr auto keyBodyLongpoll   = R"({ "feed" : "longpoll", "style" : "all_docs", "active_only" : true })";
 
     bool fetch( const NetConfiguration& ncfg, const endlesss::types::JamCouchID& jamDatabaseID );
 
     bool fetchSince( const NetConfiguration& ncfg, const endlesss::types::JamCouchID& jamDatabaseID, const std::string& seqSince );
+
+    // called with the client just before each longpoll request goes out (and with nullptr once it returns) so that
+    // another thread can call stop() on it to abort the wait early; return false to abandon the request unsent
+    using ActiveClientHook = std::function< bool( httplib::Client* ) >;
+
+    // blocks until something changes after seqSince or the server-side timeout expires (returning empty results);
+    // connection failures are retried through NetConfiguration::attempt() like any other call, but a request the
+    // hook abandons is not
+    bool fetchLongpoll(
+        const NetConfiguration& ncfg,
+        const endlesss::types::JamCouchID& jamDatabaseID,
+        const std::string& seqSince,
+        const std::chrono::seconds timeout,
+        const ActiveClientHook& activeClientHook );
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
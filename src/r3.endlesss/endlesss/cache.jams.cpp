@@ -153,11 +153,8 @@ void Jams::asyncCacheRebuild(
     tf::Taskflow& taskFlow,
     const AsyncCallback& asyncCallback )
 {
-    taskFlow.emplace( [this, &netConfig, syncOptions, asyncCallback]()
+    taskFlow.emplace( [this, &netConfig, syncOptions, asyncCallback]( tf::Subflow& subflow )
     {
-        static constexpr std::array< char, 4> busyAscii = { '\\', '|', '/', '-' };
-        int32_t busyCounter = 0;
-
         asyncCallback( AsyncFetchState::Working, "Fetching subscribed jams ..." );
 
         api::SubscribedJams jamSubscribed;
@@ -176,71 +173,160 @@ void Jams::asyncCacheRebuild(
             return;
         }
 
-        asyncCallback( AsyncFetchState::Working, "Updating jam metadata ..." );
-
+        // snapshot what we already know about the dynamic jams so that unchanged entries, and anything we fail to
+        // refresh this time, can be carried over without hitting the servers again
+        absl::flat_hash_map< endlesss::types::JamCouchID, Data > previousData;
+        {
+            std::scoped_lock<std::mutex> lockProc( m_dataProcessMutex );
 
-        m_jamDataJoinIn.clear();
+            previousData.reserve( m_jamDataJoinIn.size() + m_jamDataUserSubscribed.size() );
+            for ( const Data& data : m_jamDataJoinIn )
+                previousData.insert_or_assign( data.m_jamCID, data );
+            for ( const Data& data : m_jamDataUserSubscribed )
+                previousData.insert_or_assign( data.m_jamCID, data );
+        }
 
-        int64_t dummyTimestamp = 0;
-        for ( const auto& jdb : jamJoinIn.band_ids )
+        // one unit of work per jam; results are written in-place so ordering from the server is preserved
+        struct JamSyncWork
         {
-            api::JamProfile jamProfile;
-            if ( !jamProfile.fetch( netConfig, endlesss::types::JamCouchID{ jdb } ) )
+            Data    m_data;
+            bool    m_hasPrevious   = false;
+            bool    m_valid         = false;
+        };
+        std::vector< JamSyncWork > workJoinIn;
+        std::vector< JamSyncWork > workSubscribed;
+
+        const auto makeWork = [&previousData]( const std::string& jamID, const int64_t timestampOrdering ) -> JamSyncWork
+        {
+            JamSyncWork work;
+
+            const auto previousIt = previousData.find( endlesss::types::JamCouchID{ jamID } );
+            if ( previousIt != previousData.end() )
             {
-                blog::error::cache( "jam profile failed on {}", jdb );
-                continue;
+                work.m_data         = previousIt->second;
+                work.m_hasPrevious  = true;
             }
-
-            auto& newJamData = m_jamDataJoinIn.emplace_back( jdb,
-                                                             jamProfile.displayName,
-                                                             jamProfile.bio,
-                                                             dummyTimestamp++ );
-
-            asyncCallback( AsyncFetchState::Working, fmt::format( FMTX( "Analysing Public ({})" ), busyAscii[busyCounter] ) );
-            busyCounter = (busyCounter + 1) % 4;
-
-            if ( syncOptions.sync_state )
+            else
             {
-                api::JamRiffCount riffCount;
-                if ( riffCount.fetch( netConfig, endlesss::types::JamCouchID{ jdb } ) )
-                {
-                    newJamData.m_riffCount = riffCount.total_rows;
-                }
+                work.m_data.m_jamCID = endlesss::types::JamCouchID{ jamID };
             }
-        }
+            work.m_data.m_timestampOrdering = timestampOrdering;
+            return work;
+        };
 
-        m_jamDataUserSubscribed.clear();
+        workJoinIn.reserve( jamJoinIn.band_ids.size() );
+        int64_t dummyTimestamp = 0;
+        for ( const auto& jdb : jamJoinIn.band_ids )
+            workJoinIn.emplace_back( makeWork( jdb, dummyTimestamp++ ) );
 
+        workSubscribed.reserve( jamSubscribed.rows.size() );
         for ( const auto& jdb : jamSubscribed.rows )
+            workSubscribed.emplace_back( makeWork( jdb.id, spacetime::parseISO8601( jdb.key ) ) );
+
+
+        const std::size_t totalWork = workJoinIn.size() + workSubscribed.size();
+        std::atomic_size_t completedWork = 0;
+        std::atomic_size_t requestsIssued = 0;
+        std::atomic_size_t jamsUnchanged = 0;
+        std::mutex callbackMutex;
+
+        asyncCallback( AsyncFetchState::Working, fmt::format( FMTX( "Updating jam metadata (0 / {}) ..." ), totalWork ) );
+
+        // limit how many jams are being queried at once; the endpoints are rate-limited and we'd rather not
+        // tie up every executor worker on network waits
+        tf::Semaphore requestLimiter( cMaxParallelRequests );
+
+        const auto syncJam = [&]( JamSyncWork& work )
         {
-            api::JamProfile jamProfile;
-            if ( !jamProfile.fetch( netConfig, endlesss::types::JamCouchID{ jdb.id }  ) )
+            // the latest entry on the jam database's changes feed is our change marker; any edit, be it a new riff or
+            // a renamed jam, moves it on. if it's where it was last time, there's nothing new to fetch
+            std::string changesSeq;
             {
-                blog::error::cache( "jam profile failed on {}", jdb.id );
-                continue;
+                api::JamChanges jamChanges;
+                requestsIssued++;
+                if ( jamChanges.fetch( netConfig, work.m_data.m_jamCID ) )
+                    changesSeq = jamChanges.results.empty() ? jamChanges.last_seq : jamChanges.results.front().seq;
             }
 
-            const auto jamTimestamp = spacetime::parseISO8601( jdb.key );
+            const bool bUnchanged = work.m_hasPrevious &&
+                                    !changesSeq.empty() &&
+                                    changesSeq == work.m_data.m_changesSeq &&
+                                    ( !syncOptions.sync_state || work.m_data.m_riffCount >= 0 );
+            if ( bUnchanged )
+            {
+                jamsUnchanged++;
+                work.m_valid = true;
+            }
+            else
+            {
+                bool bRiffCountValid = true;
+                if ( syncOptions.sync_state )
+                {
+                    api::JamRiffCount riffCount;
+                    requestsIssued++;
+                    bRiffCountValid = riffCount.fetch( netConfig, work.m_data.m_jamCID );
+                    if ( bRiffCountValid )
+                        work.m_data.m_riffCount = riffCount.total_rows;
+                }
 
-            auto& newJamData = m_jamDataUserSubscribed.emplace_back( jdb.id,
-                                                                     jamProfile.displayName,
-                                                                     jamProfile.bio,
-                                                                     jamTimestamp );
+                api::JamProfile jamProfile;
+                requestsIssued++;
+                if ( jamProfile.fetch( netConfig, work.m_data.m_jamCID ) )
+                {
+                    work.m_data.m_displayName = jamProfile.displayName;
+                    work.m_data.m_description = jamProfile.bio;
+                    work.m_valid = true;
+
+                    // only move the marker on once everything it covers has been refreshed, so a partial failure is
+                    // retried next time rather than skipped
+                    if ( bRiffCountValid )
+                        work.m_data.m_changesSeq = changesSeq;
+                }
+                else
+                {
+                    blog::error::cache( FMTX( "jam profile failed on {}" ), work.m_data.m_jamCID );
 
-            asyncCallback( AsyncFetchState::Working, fmt::format( FMTX( "Analysing Subscribed ({})" ), busyAscii[busyCounter] ) );
-            busyCounter = (busyCounter + 1) % 4;
+                    // keep stale metadata rather than dropping a jam we already knew about
+                    work.m_valid = work.m_hasPrevious;
+                }
+            }
 
-            if ( syncOptions.sync_state )
+            const std::size_t completed = ++completedWork;
             {
-                api::JamRiffCount riffCount;
-                if ( riffCount.fetch( netConfig, endlesss::types::JamCouchID{ jdb.id } ) )
-                {
-                    newJamData.m_riffCount = riffCount.total_rows;
-                }
+                std::scoped_lock<std::mutex> callbackLock( callbackMutex );
+                asyncCallback( AsyncFetchState::Working, fmt::format( FMTX( "Updating jam metadata ({} / {}) ..." ), completed, totalWork ) );
             }
+        };
+
+        for ( auto& work : workJoinIn )
+        {
+            tf::Task syncTask = subflow.emplace( [&syncJam, &work]() { syncJam( work ); } );
+            syncTask.acquire( requestLimiter );
+            syncTask.release( requestLimiter );
+        }
+        for ( auto& work : workSubscribed )
+        {
+            tf::Task syncTask = subflow.emplace( [&syncJam, &work]() { syncJam( work ); } );
+            syncTask.acquire( requestLimiter );
+            syncTask.release( requestLimiter );
         }
+        subflow.join();
 
-        postProcessNewData();
+        const auto collectValid = []( std::vector< JamSyncWork >& workList ) -> std::vector< Data >
+        {
+            std::vector< Data > result;
+            result.reserve( workList.size() );
+            for ( auto& work : workList )
+            {
+                if ( work.m_valid )
+                    result.emplace_back( std::move( work.m_data ) );
+            }
+            return result;
+        };
+
+        blog::cache( FMTX( "jam cache sync : {} jams ({} unchanged), {} requests issued" ), totalWork, jamsUnchanged.load(), requestsIssued.load() );
+
+        mergeDynamicData( collectValid( workJoinIn ), collectValid( workSubscribed ) );
         asyncCallback( AsyncFetchState::Success, "" );
     });
 
@@ -265,7 +351,65 @@ void Jams::postProcessNewData()
 
     std::scoped_lock<std::mutex> lockProc( m_dataProcessMutex );
 
+    rebuildStaticData();
+
+    for ( const auto jamType : cEachJamType )
+    {
+        rebuildSortedIndicesForType( jamType );
+        rebuildTimestampDescriptionsForType( jamType );
+    }
+
+    rebuildCouchIDMap();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Jams::mergeDynamicData( std::vector< Data >&& jamDataJoinIn, std::vector< Data >&& jamDataUserSubscribed )
+{
+    spacetime::ScopedTimer perfTimer( __FUNCTION__ );
+
+    // check if anything that feeds the sort orders has changed; most syncs only touch a few riff counts
+    // (or nothing at all) so we can often leave the existing index lists alone
+    const auto sortKeysMatch = []( const std::vector< Data >& lhs, const std::vector< Data >& rhs ) -> bool
+    {
+        if ( lhs.size() != rhs.size() )
+            return false;
+
+        for ( std::size_t idx = 0; idx < lhs.size(); idx++ )
+        {
+            if ( lhs[idx].m_jamCID              != rhs[idx].m_jamCID            ||
+                 lhs[idx].m_timestampOrdering   != rhs[idx].m_timestampOrdering ||
+                 lhs[idx].m_riffCount           != rhs[idx].m_riffCount         ||
+                 lhs[idx].m_displayName         != rhs[idx].m_displayName )
+                return false;
+        }
+        return true;
+    };
+
+    std::scoped_lock<std::mutex> lockProc( m_dataProcessMutex );
+
+    const bool bJoinInChanged     = !sortKeysMatch( m_jamDataJoinIn, jamDataJoinIn );
+    const bool bSubscribedChanged = !sortKeysMatch( m_jamDataUserSubscribed, jamDataUserSubscribed );
+
+    m_jamDataJoinIn         = std::move( jamDataJoinIn );
+    m_jamDataUserSubscribed = std::move( jamDataUserSubscribed );
+
+    if ( bJoinInChanged )
+        rebuildSortedIndicesForType( JamType::PublicJoinIn );
+    if ( bSubscribedChanged )
+        rebuildSortedIndicesForType( JamType::UserSubscribed );
+
+    rebuildTimestampDescriptionsForType( JamType::PublicJoinIn );
+    rebuildTimestampDescriptionsForType( JamType::UserSubscribed );
+
+    if ( bJoinInChanged || bSubscribedChanged )
+        rebuildCouchIDMap();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Jams::rebuildStaticData()
+{
     m_jamDataPublicArchive.clear();
+    m_jamDataPublicArchive.reserve( m_configEndlesssPublics.jams.size() );
 
     for ( const auto& pjam : m_configEndlesssPublics.jams )
     {
@@ -275,6 +419,10 @@ void Jams::postProcessNewData()
                                                          pjam.earliest_unixtime );
         pjd.m_riffCount = pjam.total_riffs;
     }
+
+    m_jamDataCollectibles.clear();
+    m_jamDataCollectibles.reserve( m_configEndlesssCollectibles.jams.size() );
+
     for ( const auto& cjam : m_configEndlesssCollectibles.jams )
     {
         auto& pjd = m_jamDataCollectibles.emplace_back(  cjam.bandId,
@@ -283,73 +431,112 @@ void Jams::postProcessNewData()
                                                          cjam.rifftime / 1000 );    // riff time is unix-nano
         pjd.m_riffCount = cjam.riffCount;
     }
+}
 
-    for ( auto& innerVec : m_idxSortedByTime )
-        innerVec.clear();
-    for ( auto& innerVec : m_idxSortedByName )
-        innerVec.clear();
-    for ( auto& innerVec : m_idxSortedByRiffs )
-        innerVec.clear();
+// ---------------------------------------------------------------------------------------------------------------------
+void Jams::rebuildSortedIndicesForType( const JamType jamType )
+{
+    const std::vector< Data >* dataArray = getArrayPtrForType( jamType );
+    ABSL_ASSERT( dataArray );
 
-    m_jamCouchIDToJamIndexMap.clear();
+    const size_t jamTypeIndex = (size_t)jamType;
 
-    for ( const auto jamType : cEachJamType )
-    {
-        const std::vector< Data >* dataArray = getArrayPtrForType( jamType );
-        ABSL_ASSERT( dataArray );
+    auto& sortedByTime  = m_idxSortedByTime[jamTypeIndex];
+    auto& sortedByName  = m_idxSortedByName[jamTypeIndex];
+    auto& sortedByRiffs = m_idxSortedByRiffs[jamTypeIndex];
 
-        const size_t jamTypeIndex = (size_t)jamType;
+    sortedByTime.clear();
+    sortedByTime.reserve( dataArray->size() );
+    for ( size_t idx = 0; idx < dataArray->size(); idx++ )
+        sortedByTime.push_back( idx );
 
-        for ( size_t idx = 0; idx < dataArray->size(); idx++ )
+    sortedByName  = sortedByTime;
+    sortedByRiffs = sortedByTime;
+
+    std::sort( sortedByTime.begin(), sortedByTime.end(),
+        [dataArray]( const size_t lhs, const size_t rhs ) -> bool
+        {
+            // newest first
+            return dataArray->at(lhs).m_timestampOrdering > dataArray->at(rhs).m_timestampOrdering;
+        });
+
+    // lower-case each name once up front rather than on every comparison
+    std::vector< std::string > lowercaseNames;
+    lowercaseNames.reserve( dataArray->size() );
+    for ( const Data& data : *dataArray )
+        lowercaseNames.emplace_back( base::StrToLwrExt( data.m_displayName ) );
+
+    std::sort( sortedByName.begin(), sortedByName.end(),
+        [&lowercaseNames]( const size_t lhs, const size_t rhs ) -> bool
         {
-            m_idxSortedByTime[jamTypeIndex].push_back( idx );
-            m_idxSortedByName[jamTypeIndex].push_back( idx );
-            m_idxSortedByRiffs[jamTypeIndex].push_back( idx );
+            return lowercaseNames[lhs] < lowercaseNames[rhs];
+        });
 
-            // insert_or_assign allows overwrite; given the jam-type ordering, this means items that exist in our
-            // subscribed jams will correctly take precedence over ones in the generic public jam archive (as we are 
-            // updating the riff counts etc for those regularly, whereas we do not do so for the general jam archive at runtime)
-            m_jamCouchIDToJamIndexMap.insert_or_assign( dataArray->at(idx).m_jamCID, CacheIndex( jamType, idx ) );
-        }
+    std::sort( sortedByRiffs.begin(), sortedByRiffs.end(),
+        [dataArray]( const size_t lhs, const size_t rhs ) -> bool
+        {
+            // largest first
+            return dataArray->at(lhs).m_riffCount > dataArray->at(rhs).m_riffCount;
+        });
+}
 
-        std::sort( m_idxSortedByTime[jamTypeIndex].begin(), m_idxSortedByTime[jamTypeIndex].end(),
-            [dataArray]( const size_t lhs, const size_t rhs ) -> bool
+// ---------------------------------------------------------------------------------------------------------------------
+void Jams::rebuildTimestampDescriptionsForType( const JamType jamType )
+{
+    switch ( jamType )
+    {
+        case JamType::PublicArchive:
+        {
+            for ( Data& data : m_jamDataPublicArchive )
             {
-                // newest first
-                return dataArray->at(lhs).m_timestampOrdering > dataArray->at(rhs).m_timestampOrdering;
-            });
+                if ( data.m_timestampOrdering > 0 )
+                    data.m_timestampOrderingDescription = spacetime::datestampStringFromUnix( data.m_timestampOrdering );
+                else
+                    data.m_timestampOrderingDescription = " - ";
+            }
+        }
+        break;
 
-        std::sort( m_idxSortedByName[jamTypeIndex].begin(), m_idxSortedByName[jamTypeIndex].end(),
-            [dataArray]( const size_t lhs, const size_t rhs ) -> bool
-            {
-                return base::StrToLwrExt( dataArray->at( lhs ).m_displayName ) < base::StrToLwrExt( dataArray->at( rhs ).m_displayName );
-            });
+        case JamType::PublicJoinIn:
+        {
+            for ( Data& data : m_jamDataJoinIn )
+                data.m_timestampOrderingDescription.clear();
+        }
+        break;
 
-        std::sort( m_idxSortedByRiffs[jamTypeIndex].begin(), m_idxSortedByRiffs[jamTypeIndex].end(),
-            [dataArray]( const size_t lhs, const size_t rhs ) -> bool
-            {
-                // largest first
-                return dataArray->at(lhs).m_riffCount > dataArray->at(rhs).m_riffCount;
-            });
-    }
+        case JamType::UserSubscribed:
+        {
+            for ( Data& data : m_jamDataUserSubscribed )
+                data.m_timestampOrderingDescription = spacetime::datestampStringFromUnix( data.m_timestampOrdering );
+        }
+        break;
 
-    {
-        for ( Data& data : m_jamDataPublicArchive )
+        case JamType::Collectible:
         {
-            if ( data.m_timestampOrdering > 0 )
+            for ( Data& data : m_jamDataCollectibles )
                 data.m_timestampOrderingDescription = spacetime::datestampStringFromUnix( data.m_timestampOrdering );
-            else
-                data.m_timestampOrderingDescription = " - ";
         }
+        break;
+    }
+}
 
-        for ( Data& data : m_jamDataJoinIn )
-            data.m_timestampOrderingDescription.clear();
+// ---------------------------------------------------------------------------------------------------------------------
+void Jams::rebuildCouchIDMap()
+{
+    m_jamCouchIDToJamIndexMap.clear();
 
-        for ( Data& data : m_jamDataUserSubscribed )
-            data.m_timestampOrderingDescription = spacetime::datestampStringFromUnix( data.m_timestampOrdering );
+    for ( const auto jamType : cEachJamType )
+    {
+        const std::vector< Data >* dataArray = getArrayPtrForType( jamType );
+        ABSL_ASSERT( dataArray );
 
-        for ( Data& data : m_jamDataCollectibles )
-            data.m_timestampOrderingDescription = spacetime::datestampStringFromUnix( data.m_timestampOrdering );
+        for ( size_t idx = 0; idx < dataArray->size(); idx++ )
+        {
+            // insert_or_assign allows overwrite; given the jam-type ordering, this means items that exist in our
+            // subscribed jams will correctly take precedence over ones in the generic public jam archive (as we are 
+            // updating the riff counts etc for those regularly, whereas we do not do so for the general jam archive at runtime)
+            m_jamCouchIDToJamIndexMap.insert_or_assign( dataArray->at(idx).m_jamCID, CacheIndex( jamType, idx ) );
+        }
     }
 }
 
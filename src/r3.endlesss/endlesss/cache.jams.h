@@ -25,6 +25,9 @@ struct Jams
 {
     static constexpr auto cFilename = "cache.jams.json";
 
+    // upper bound on simultaneous per-jam metadata requests issued during asyncCacheRebuild()
+    static constexpr std::size_t cMaxParallelRequests = 6;
+
     struct Data
     {
         Data() = default;
@@ -47,6 +50,8 @@ struct Jams
         int64_t                         m_timestampEarliestStem = -1;
         int64_t                         m_timestampLatestStem   = -1;
 
+        std::string                     m_changesSeq;                   // jam database's latest change seq when the above was fetched
+
 
         std::string                     m_timestampOrderingDescription; // not serialised, built on load
 
@@ -60,6 +65,7 @@ struct Jams
                    , CEREAL_NVP( m_timestampOrdering )
                    , CEREAL_NVP( m_timestampEarliestStem )
                    , CEREAL_NVP( m_timestampLatestStem )
+                   , CEREAL_OPTIONAL_NVP( m_changesSeq )    // absent in caches written before change tracking
             );
         }
     };
@@ -130,7 +136,10 @@ struct Jams
     };
     using AsyncCallback = std::function< void( const AsyncFetchState state, const std::string& status )>;
 
-    // fetch the users' latest jam membership state + list of active publics from the servers
+    // fetch the users' latest jam membership state + list of active publics from the servers; per-jam metadata
+    // requests are issued in parallel (bounded by cMaxParallelRequests). each jam's latest change seq is checked first
+    // and jams that haven't changed since the last rebuild keep what we have without further requests; jams we already
+    // hold also keep their previous metadata if a refresh fails
     void asyncCacheRebuild(
         const endlesss::api::NetConfiguration& netConfig,
         const config::endlesss::SyncOptions& syncOptions,
@@ -271,8 +280,18 @@ private:
 
     mutable std::mutex          m_dataProcessMutex;
 
+    // full rebuild of all derived data (static manifests, sorted indices, lookups); used after loading from disk
     void postProcessNewData();
 
+    // swap in freshly synchronised server-side jam lists, only re-sorting the types whose contents changed
+    void mergeDynamicData( std::vector< Data >&& jamDataJoinIn, std::vector< Data >&& jamDataUserSubscribed );
+
+    // the following all expect m_dataProcessMutex to be held
+    void rebuildStaticData();
+    void rebuildSortedIndicesForType( const JamType jamType );
+    void rebuildTimestampDescriptionsForType( const JamType jamType );
+    void rebuildCouchIDMap();
+
 
     ouro_nodiscard constexpr const std::vector< Data >* getArrayPtrForType( const JamType type ) const
     {
@@ -61,12 +61,13 @@ Stems::Stems()
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-absl::Status Stems::initialise( const fs::path& cachePath, const uint32_t targetSampleRate )
+absl::Status Stems::initialise( const fs::path& cachePath, const uint32_t targetSampleRate, const endlesss::live::Stem::SampleStorage sampleStorage )
 {
     const fs::path stemSubdir = getCachePathRoot( CacheVersion::Version2 );
 
     m_cacheStemRoot     = cachePath / stemSubdir;
     m_targetSampleRate  = targetSampleRate;
+    m_sampleStorage     = sampleStorage;
 
     const auto stemRootStatus = filesys::ensureDirectoryExists( m_cacheStemRoot );
     if ( !stemRootStatus.ok() )
@@ -80,9 +81,68 @@ absl::Status Stems::initialise( const fs::path& cachePath, const uint32_t target
     // single processing instance, used during post-fetch stem analysis
     m_processing = endlesss::live::Stem::createStemProcessing( targetSampleRate );
 
+    // mount any stem archives that have been dropped into the archive directory
+    const fs::path archiveRoot = cachePath / getArchivePathRoot();
+    if ( fs::exists( archiveRoot ) )
+    {
+        std::error_code osError;
+        for ( const auto& archiveEntry : fs::directory_iterator( archiveRoot, osError ) )
+        {
+            if ( !archiveEntry.is_regular_file() || archiveEntry.path().extension() != ".tar" )
+                continue;
+
+            const auto mountStatus = mountArchive( archiveEntry.path() );
+            if ( !mountStatus.ok() )
+            {
+                blog::error::cache( FMTX( "unable to mount stem archive [{}] : {}" ), archiveEntry.path().string(), mountStatus.ToString() );
+            }
+        }
+    }
+
     return absl::OkStatus();
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status Stems::mountArchive( const fs::path& tarFile )
+{
+    spacetime::Moment mountTimer;
+
+    auto mountResult = io::MountedTar::mount( tarFile );
+    if ( !mountResult.ok() )
+        return mountResult.status();
+
+    blog::cache( FMTX( "mounted stem archive [{}], {} stems, took {}" ),
+        tarFile.filename().string(),
+        mountResult.value()->getEntryCount(),
+        mountTimer.delta< std::chrono::milliseconds >() );
+
+    {
+        std::unique_lock<std::shared_mutex> lock( m_archivesLock );
+        m_archives.emplace_back( std::move( mountResult.value() ) );
+    }
+    return absl::OkStatus();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+Stems::ArchivedStem Stems::findArchivedStem( const endlesss::types::Stem& stemData ) const
+{
+    std::shared_lock<std::shared_mutex> lock( m_archivesLock );
+
+    if ( m_archives.empty() )
+        return {};
+
+    // archives are built from a jam's directory in the cache, so entries are stored under the same relative path
+    const std::string entryPath = ( getCachePathForStemData( {}, stemData.jamCouchID, stemData.couchID ) / stemData.couchID.value() ).generic_string();
+
+    for ( const auto& archive : m_archives )
+    {
+        const auto archivedData = archive->find( entryPath );
+        if ( !archivedData.empty() )
+            return { archive, archivedData };
+    }
+    return {};
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 endlesss::live::StemPtr Stems::request( const endlesss::types::Stem& stemData )
 {
@@ -97,7 +157,7 @@ endlesss::live::StemPtr Stems::request( const endlesss::types::Stem& stemData )
         auto stemIter = m_stems.find( stemDocumentID );
         if ( stemIter == m_stems.end() )
         {
-            auto newStem = std::make_shared<endlesss::live::Stem>( stemData, m_targetSampleRate );
+            auto newStem = std::make_shared<endlesss::live::Stem>( stemData, m_targetSampleRate, m_sampleStorage );
 
             m_usages.emplace( stemDocumentID, m_stemGeneration );
             m_stems.emplace( stemDocumentID, newStem );
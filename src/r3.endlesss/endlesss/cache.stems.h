@@ -10,6 +10,7 @@
 #pragma once
 
 #include "base/construction.h"
+#include "io/tarch.h"
 #include "endlesss/core.types.h"
 #include "endlesss/live.stem.h"
 
@@ -33,6 +34,10 @@ struct Stems
     // get path root relative to the ouroveon cache/common path
     ouro_nodiscard static fs::path getCachePathRoot( CacheVersion cv );
 
+    // stem archives (.tar, as written by the warehouse stem export) placed in here, relative to the cache/common
+    // path, are mounted as a read-only cache tier during initialise(); stems are then decoded straight out of them
+    ouro_nodiscard static fs::path getArchivePathRoot() { return "stem_archives"; }
+
     ouro_nodiscard static fs::path getCachePathForStemData(
         const fs::path& cacheRoot,
         const endlesss::types::JamCouchID& jamCID,
@@ -44,7 +49,8 @@ struct Stems
 
     absl::Status initialise( 
         const fs::path& cachePath,          // the root path of where to build the stored stems
-        const uint32_t targetSampleRate     // the chosen sample rate, stems will be resampled to this if they don't match
+        const uint32_t targetSampleRate,    // the chosen sample rate, stems will be resampled to this if they don't match
+        const endlesss::live::Stem::SampleStorage sampleStorage = endlesss::live::Stem::SampleStorage::Float32
     );
 
     ouro_nodiscard endlesss::live::StemPtr request( const endlesss::types::Stem& stemData );
@@ -60,6 +66,19 @@ struct Stems
     // given stem data, return a suitable path to write the cached data to
     ouro_nodiscard fs::path getCachePathForStem( const endlesss::types::Stem& stemData ) const;
 
+
+    // map a stem archive and make its contents available through findArchivedStem()
+    absl::Status mountArchive( const fs::path& tarFile );
+
+    struct ArchivedStem
+    {
+        io::MountedTar::Instance    m_archive;  // keeps the mapping alive while m_data is in use
+        std::span< const uint8_t >  m_data;     // compressed stem data, exactly as it would be in the cache directory
+    };
+
+    // look for the given stem in any mounted archive; m_data is empty if it isn't in any of them
+    ouro_nodiscard ArchivedStem findArchivedStem( const endlesss::types::Stem& stemData ) const;
+
     // return the single shared instance of read-only stem processing state
     // used by riff resolving code after fetching audio data in
     const endlesss::live::Stem::Processing& getStemProcessing() const
@@ -82,8 +101,16 @@ private:
     StemUsage           m_usages;
 
     uint32_t            m_targetSampleRate = 0;
+    endlesss::live::Stem::SampleStorage
+                        m_sampleStorage = endlesss::live::Stem::SampleStorage::Float32;
     uint32_t            m_stemGeneration = 0;
     std::mutex          m_pruneLock;
+
+    using MountedArchives   = std::vector< io::MountedTar::Instance >;
+
+    MountedArchives     m_archives;
+    mutable std::shared_mutex
+                        m_archivesLock;
 };
 
 } // namespace cache
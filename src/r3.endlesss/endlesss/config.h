@@ -88,9 +88,14 @@ OURO_CONFIG( rAPI )
     // path from the app shared data directory to a valid CA Root Certificates file
     std::string             certBundleRelative;
 
-    // seconds between polls when using a sentinel to track jam changes
+    // seconds between polls when using a sentinel to track jam changes, if longpoll is disabled
     int32_t                 jamSentinelPollRateInSeconds = 5;
 
+    // by default the sentinel holds open a longpoll _changes request and wakes as soon as the jam changes;
+    // the server is asked to return after this many seconds if nothing happens so we can re-arm the connection
+    bool                    jamSentinelUseLongpoll = true;
+    int32_t                 jamSentinelLongpollTimeoutInSeconds = 25;
+
 
     // 
     // NB. default vs unstable below is selected via the saved Performance configuration
@@ -142,6 +147,8 @@ OURO_CONFIG( rAPI )
                , CEREAL_NVP( userAgentWeb )
                , CEREAL_NVP( certBundleRelative )
                , CEREAL_OPTIONAL_NVP( jamSentinelPollRateInSeconds )
+               , CEREAL_OPTIONAL_NVP( jamSentinelUseLongpoll )
+               , CEREAL_OPTIONAL_NVP( jamSentinelLongpollTimeoutInSeconds )
                , CEREAL_OPTIONAL_NVP( networkTimeoutInSecondsDefault )
                , CEREAL_OPTIONAL_NVP( networkTimeoutInSecondsUnstable )
                , CEREAL_OPTIONAL_NVP( networkRequestRetryLimitDefault )
@@ -337,12 +344,19 @@ OURO_CONFIG( SharedRiffsCache )
     using RiffID        = ::endlesss::types::RiffCouchID;
     using JamID         = ::endlesss::types::JamCouchID;
 
-    uint32_t                        m_version = 1;
+    // version 1 stored shares newest-first; from version 2 they are kept oldest-first so that incremental
+    // syncs can append new shares to the end of each array
+    static constexpr uint32_t cVersionChronological = 2;
+
+    uint32_t                        m_version = cVersionChronological;
     std::string                     m_username;
     std::size_t                     m_count = 0;        // number of retrieved shares
     uint64_t                        m_lastSyncTime = 0;
+    uint64_t                        m_lastFullSyncTime = 0; // last time every page was pulled, rather than just the new ones
 
-    // flat storage of m_count shared riff details
+    std::size_t                     m_persistedCount = 0;   // not serialised; how many entries are already on disk, see toolkit::Shares::saveCache
+
+    // flat storage of m_count shared riff details, in chronological order
     std::vector< std::string >      m_names;
     std::vector< std::string >      m_images;
     std::vector< SharedRiffID >     m_sharedRiffIDs;    // unique ID for the shared-riff object, distinct from the riff couch ID
@@ -371,8 +385,63 @@ OURO_CONFIG( SharedRiffsCache )
                , CEREAL_NVP( m_private )
                , CEREAL_NVP( m_personal )
                , CEREAL_OPTIONAL_NVP( m_stems )
+               , CEREAL_OPTIONAL_NVP( m_lastFullSyncTime )
         );
     }
+
+    // add the entries from `other`, starting at `fromIndex`, to the end of our arrays
+    void append( const SharedRiffsCache& other, const std::size_t fromIndex = 0 )
+    {
+        ABSL_ASSERT( fromIndex <= other.m_count );
+
+        m_names.insert(         m_names.end(),          other.m_names.begin() + fromIndex,          other.m_names.end() );
+        m_images.insert(        m_images.end(),         other.m_images.begin() + fromIndex,         other.m_images.end() );
+        m_sharedRiffIDs.insert( m_sharedRiffIDs.end(),  other.m_sharedRiffIDs.begin() + fromIndex,  other.m_sharedRiffIDs.end() );
+        m_riffIDs.insert(       m_riffIDs.end(),        other.m_riffIDs.begin() + fromIndex,        other.m_riffIDs.end() );
+        m_jamIDs.insert(        m_jamIDs.end(),         other.m_jamIDs.begin() + fromIndex,         other.m_jamIDs.end() );
+        m_timestamps.insert(    m_timestamps.end(),     other.m_timestamps.begin() + fromIndex,     other.m_timestamps.end() );
+        m_private.insert(       m_private.end(),        other.m_private.begin() + fromIndex,        other.m_private.end() );
+        m_personal.insert(      m_personal.end(),       other.m_personal.begin() + fromIndex,       other.m_personal.end() );
+        m_stems.insert(         m_stems.end(),          other.m_stems.begin() + fromIndex,          other.m_stems.end() );
+
+        m_count += other.m_count - fromIndex;
+    }
+
+    void reverseEntries()
+    {
+        std::reverse( m_names.begin(),          m_names.end() );
+        std::reverse( m_images.begin(),         m_images.end() );
+        std::reverse( m_sharedRiffIDs.begin(),  m_sharedRiffIDs.end() );
+        std::reverse( m_riffIDs.begin(),        m_riffIDs.end() );
+        std::reverse( m_jamIDs.begin(),         m_jamIDs.end() );
+        std::reverse( m_timestamps.begin(),     m_timestamps.end() );
+        std::reverse( m_private.begin(),        m_private.end() );
+        std::reverse( m_personal.begin(),       m_personal.end() );
+        std::reverse( m_stems.begin(),          m_stems.end() );
+    }
+
+    bool postLoad()
+    {
+        // m_stems is optional in older data, the rest must all line up
+        if ( m_names.size()         != m_count ||
+             m_images.size()        != m_count ||
+             m_sharedRiffIDs.size() != m_count ||
+             m_riffIDs.size()       != m_count ||
+             m_jamIDs.size()        != m_count ||
+             m_timestamps.size()    != m_count ||
+             m_private.size()       != m_count ||
+             m_personal.size()      != m_count )
+            return false;
+
+        m_stems.resize( m_count );
+
+        if ( m_version < cVersionChronological )
+        {
+            reverseEntries();
+            m_version = cVersionChronological;
+        }
+        return true;
+    }
 };
 
 
@@ -35,6 +35,7 @@ struct IRiffFetchService
     ouro_nodiscard virtual const endlesss::api::NetConfiguration&   getNetConfiguration() const = 0;    // access keys
     ouro_nodiscard virtual endlesss::cache::Stems&                  getStemCache() = 0;                 // cache storage for stems
     ouro_nodiscard virtual tf::Executor&                            getTaskExecutor() = 0;              // parallelisation
+    ouro_nodiscard virtual tf::Executor&                            getTaskExecutorIO() = 0;            // blocking network / disk reads
 };
 
 using RiffFetchInstance = base::ServiceInstance<IRiffFetchService>;
@@ -10,6 +10,7 @@
 #include "pch.h"
 #include "base/instrumentation.h"
 #include "spacetime/chronicle.h"
+#include "spacetime/moment.h"
 
 #include "endlesss/live.riff.h"
 #include "endlesss/live.stem.h"
@@ -136,6 +137,10 @@ void Riff::fetch( services::RiffFetchProvider& services )
         tf::Taskflow stemLoadFlow;
         tf::Taskflow stemAnalysisFlow;
 
+        // each stem loads in two stages; the I/O executor pulls the compressed data from an archive, the cache or the
+        // network, then hands decoding over to the compute executor so workers there are never stuck waiting on a socket
+        std::array< std::shared_future<void>, 8 > stemDecodeFutures;
+
         std::vector< endlesss::live::Stem* > stemsWithAsyncAnalysis;
 
         for ( size_t stemI = 0; stemI < 8; stemI++ )
@@ -153,13 +158,23 @@ void Riff::fetch( services::RiffFetchProvider& services )
                 // if this was a fresh stem, enqueue it for loading via task graph
                 if ( loopStemRaw->m_state == endlesss::live::Stem::State::Empty )
                 {
-                    stemLoadFlow.emplace( [&stemData, &services, loopStemRaw]()
+                    stemLoadFlow.emplace( [&stemData, &services, &stemDecodeFutures, stemI, loopStemRaw]()
                     {
-                        loopStemRaw->fetch( services->getNetConfiguration(), services->getStemCache().getCachePathForStem( stemData ) );
+                        const auto& stemCache = services->getStemCache();
+
+                        // prefer reading directly out of a mounted archive if the stem is in one
+                        const auto archivedStem = stemCache.findArchivedStem( stemData );
+                        if ( loopStemRaw->fetchCompressed( services->getNetConfiguration(), stemCache.getCachePathForStem( stemData ), archivedStem.m_data, archivedStem.m_archive ) )
+                        {
+                            stemDecodeFutures[stemI] = services->getTaskExecutor().async( [loopStemRaw]()
+                                {
+                                    loopStemRaw->decodeFetched();
+                                }).share();
+                        }
                     });
-                    stemAnalysisFlow.emplace( [&stemProcessing, loopStemRaw]()
+                    stemAnalysisFlow.emplace( [&stemProcessing, loopStemRaw]( tf::Subflow& subflow )
                     {
-                        loopStemRaw->analyse( stemProcessing );
+                        loopStemRaw->analyse( stemProcessing, subflow );
                     });
                     stemsWithAsyncAnalysis.push_back( loopStemRaw );
                 }
@@ -173,8 +188,21 @@ void Riff::fetch( services::RiffFetchProvider& services )
         }
 
         // spread out stem loading across task system
-        auto stemLoadFuture = services->getTaskExecutor().run( stemLoadFlow );
-        stemLoadFuture.wait();
+        {
+            // time both stages, as a measure of how much background network / disk traffic is holding up riff loads
+            spacetime::ScopedTimer stemLoadTiming( "riff stem load" );
+
+            auto stemLoadFuture = services->getTaskExecutorIO().run( stemLoadFlow );
+            stemLoadFuture.wait();
+
+            stemLoadTiming.stage( "fetch" );
+
+            for ( const auto& stemDecodeFuture : stemDecodeFutures )
+            {
+                if ( stemDecodeFuture.valid() )
+                    stemDecodeFuture.wait();
+            }
+        }
 
         // with data loaded, enqueue the post-process analysis tasks; shift ownership of the graph and return
         // a future that all stems can wait() on pre-destruction to ensure the underlying data isn't tossed before the tasks complete
@@ -308,8 +336,11 @@ void Riff::exportToDisk( const streamProcessorFactoryFn& diskWriterForStem, cons
                 const int32_t readSampleTimeScaled           = (int32_t)( (double)sampleWrite * (double)stemTimeStretch );
                 const int32_t readSampleTimeScaledWithOffset = ( readSampleTimeScaled + sampleOffsetTimeScaled ) % sampleCount;
 
-                exportChannelLeft[sampleWrite]  = stemPtr->m_channel[0][readSampleTimeScaledWithOffset] * stemGain;
-                exportChannelRight[sampleWrite] = stemPtr->m_channel[1][readSampleTimeScaledWithOffset] * stemGain;
+                float sampleLeft, sampleRight;
+                stemPtr->getSamplePair( readSampleTimeScaledWithOffset, sampleLeft, sampleRight );
+
+                exportChannelLeft[sampleWrite]  = sampleLeft  * stemGain;
+                exportChannelRight[sampleWrite] = sampleRight * stemGain;
             }
 
             // output to disk, force flush immediately
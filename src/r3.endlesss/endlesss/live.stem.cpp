@@ -18,8 +18,10 @@
 #include "dsp/octave.h"
 #include "endlesss/live.stem.h"
 #include "filesys/fsutil.h"
+#include "io/tarch.h"
 #include "math/rng.h"
 #include "spacetime/moment.h"
+#include "sys/mmap.h"
 #include "config/spectrum.h"
 
 // vorbis decode
@@ -46,6 +48,146 @@
 namespace endlesss {
 namespace live {
 
+namespace {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// accepts decoded stereo audio a sample-pair at a time and writes it directly into a stem's final float channels;
+// if the source rate doesn't match the mixer, the data is fed through a pair of streaming r8brain resamplers in
+// fixed-size blocks on the way. beyond the output itself, only one block of working data per channel is held
+//
+struct StreamingStemWriter
+{
+    DECLARE_NO_COPY_NO_MOVE( StreamingStemWriter );
+
+    static constexpr int32_t cBlockSize = 4096;
+
+    StreamingStemWriter( std::array<float*, 2>& outputChannels, const uint32_t sourceRate, const uint32_t targetRate, const std::size_t sourceSamples )
+        : m_output( outputChannels )
+    {
+        if ( sourceRate != targetRate )
+        {
+            m_outputSamples = static_cast<std::size_t>( std::ceil( static_cast<double>( sourceSamples ) * static_cast<double>( targetRate ) / static_cast<double>( sourceRate ) ) );
+
+            for ( std::size_t channel = 0; channel < 2; channel++ )
+            {
+                m_resampler[channel] = std::make_unique<r8b::CDSPResampler24>( (double)sourceRate, (double)targetRate, cBlockSize );
+                m_staging[channel]   = mem::alloc16<double>( cBlockSize );
+            }
+        }
+        else
+        {
+            m_outputSamples = sourceSamples;
+        }
+
+        // zero-filled so that any shortfall in the decoded stream just reads as silence
+        m_output[0] = mem::alloc16To<float>( m_outputSamples, 0.0f );
+        m_output[1] = mem::alloc16To<float>( m_outputSamples, 0.0f );
+    }
+
+    ~StreamingStemWriter()
+    {
+        mem::free16( m_staging[0] );
+        mem::free16( m_staging[1] );
+    }
+
+    ouro_nodiscard constexpr bool isResampling() const { return m_staging[0] != nullptr; }
+    ouro_nodiscard constexpr std::size_t getSourceSamplesPushed() const { return m_sourcePushed; }
+
+    inline void push( const double left, const double right )
+    {
+        if ( isResampling() )
+        {
+            m_staging[0][m_stagingFill] = left;
+            m_staging[1][m_stagingFill] = right;
+
+            if ( ++m_stagingFill == cBlockSize )
+                processStaging();
+        }
+        else if ( m_outputWritten < m_outputSamples )
+        {
+            m_output[0][m_outputWritten] = static_cast<float>( left );
+            m_output[1][m_outputWritten] = static_cast<float>( right );
+            m_outputWritten++;
+        }
+
+        m_lastPushed[0] = left;
+        m_lastPushed[1] = right;
+        m_sourcePushed++;
+    }
+
+    // re-push the last sample-pair we saw; used to patch tiny gaps at the end of a stream without causing a click
+    void pushRepeatLast( const std::size_t count )
+    {
+        for ( std::size_t repeat = 0; repeat < count; repeat++ )
+            push( m_lastPushed[0], m_lastPushed[1] );
+    }
+
+    // flush anything still buffered and, if resampling, keep feeding silence until the filter delay has drained
+    // and the output is full; returns the final output length
+    std::size_t finish()
+    {
+        if ( isResampling() )
+        {
+            if ( m_stagingFill > 0 )
+                processStaging();
+
+            while ( m_outputWritten < m_outputSamples )
+            {
+                std::fill_n( m_staging[0], cBlockSize, 0.0 );
+                std::fill_n( m_staging[1], cBlockSize, 0.0 );
+                m_stagingFill = cBlockSize;
+
+                processStaging();
+            }
+        }
+        return m_outputSamples;
+    }
+
+    // decoding failed, release the output channels
+    void abandon()
+    {
+        mem::free16( m_output[0] );
+        mem::free16( m_output[1] );
+        m_output[0] = nullptr;
+        m_output[1] = nullptr;
+    }
+
+private:
+
+    void processStaging()
+    {
+        const std::size_t outputRemaining = m_outputSamples - m_outputWritten;
+
+        std::size_t written = 0;
+        for ( std::size_t channel = 0; channel < 2; channel++ )
+        {
+            double* resampled = nullptr;
+            const int32_t resampledCount = m_resampler[channel]->process( m_staging[channel], m_stagingFill, resampled );
+
+            written = std::min( static_cast<std::size_t>( resampledCount ), outputRemaining );
+            for ( std::size_t s = 0; s < written; s++ )
+            {
+                m_output[channel][m_outputWritten + s] = static_cast<float>( resampled[s] );
+            }
+        }
+
+        m_outputWritten += written;
+        m_stagingFill    = 0;
+    }
+
+    std::array<float*, 2>&                              m_output;
+    std::size_t                                         m_outputSamples = 0;
+    std::size_t                                         m_outputWritten = 0;
+    std::size_t                                         m_sourcePushed  = 0;
+
+    std::array< std::unique_ptr<r8b::CDSPResampler24>, 2 >  m_resampler;
+    std::array< double*, 2 >                            m_staging    = { nullptr, nullptr };
+    int32_t                                             m_stagingFill = 0;
+    std::array< double, 2 >                             m_lastPushed = { 0.0, 0.0 };
+};
+
+} // anonymous namespace
+
 // ---------------------------------------------------------------------------------------------------------------------
 Stem::Processing::~Processing()
 {
@@ -79,14 +221,37 @@ Stem::Processing::UPtr Stem::createStemProcessing( const uint32_t targetSampleRa
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-Stem::Stem( const types::Stem& stemData, const uint32_t targetSampleRate )
+// compressed stem data gathered by fetchCompressed(), held until decodeFetched() picks it up. a cache hit stays mapped
+// across that gap, so the cache file must never be truncated or rewritten in place while stems are loading - on POSIX
+// that would SIGBUS the decode. everything that writes stem cache files (writeToCache, downloadToCache, tar unpacking)
+// goes through a temporary and a rename, which leaves an existing mapping looking at the old, identical, contents
+struct Stem::FetchedData
+{
+    FetchedData()
+        : m_audioMemory( 0 )
+    {}
+
+    ouro_nodiscard bool isMapped() const { return !m_mappedData.empty(); }
+
+    RawAudioMemory              m_audioMemory;          // downloaded, or read from the cache if it couldn't be mapped
+    sys::MappedFile::Instance   m_cacheMapping;         // keeps a mapped cache file alive while m_mappedData points into it
+    io::MountedTar::Instance    m_archive;              // .. or the mounted archive, if that's where it came from
+    std::span< const uint8_t >  m_mappedData;           // decoded in place; the mapped cache file or a stem in a mounted archive
+    fs::path                    m_cacheFile;
+    bool                        m_writeToCache = false; // freshly downloaded, so write to m_cacheFile once it decodes cleanly
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+Stem::Stem( const types::Stem& stemData, const uint32_t targetSampleRate, const SampleStorage sampleStorage )
     : m_data( stemData )
     , m_state( State::Empty )
     , m_sampleRate( targetSampleRate )
     , m_sampleCount( 0 )
+    , m_sampleStorage( sampleStorage )
     , m_analysisState( AnalysisState::InProgress )
 {
     m_channel.fill( nullptr );
+    m_channelCompact.fill( nullptr );
 
     m_colourU32 = ImGui::ParseHexColour( m_data.colour.c_str() );
 
@@ -104,6 +269,8 @@ Stem::~Stem()
 
     mem::free16( m_channel[0] );
     mem::free16( m_channel[1] );
+    mem::free16( m_channelCompact[0] );
+    mem::free16( m_channelCompact[1] );
 
     m_sampleCount       = 0;
     m_state             = State::Empty;
@@ -111,18 +278,34 @@ Stem::~Stem()
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
+void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath, std::span< const uint8_t > archivedData )
+{
+    if ( fetchCompressed( ncfg, cachePath, archivedData ) )
+        decodeFetched();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Stem::fetchCompressed(
+    const api::NetConfiguration& ncfg,
+    const fs::path& cachePath,
+    std::span< const uint8_t > archivedData,
+    std::shared_ptr< io::MountedTar > archive )
 {
+    const bool fromArchive = !archivedData.empty();
+
     // ensure we have a space to write the stem back out to
-    const absl::Status cachePathAvailable = filesys::ensureDirectoryExists( cachePath );
-    if ( !cachePathAvailable.ok() )
+    if ( !fromArchive )
     {
-        blog::error::stem( FMTX( "Unable to create sub-directory in stem cache [{}], {}" ),
-            cachePath.string(),
-            cachePathAvailable.ToString() );
+        const absl::Status cachePathAvailable = filesys::ensureDirectoryExists( cachePath );
+        if ( !cachePathAvailable.ok() )
+        {
+            blog::error::stem( FMTX( "Unable to create sub-directory in stem cache [{}], {}" ),
+                cachePath.string(),
+                cachePathAvailable.ToString() );
 
-        m_state = State::Failed_CacheDirectory;
-        return;
+            m_state = State::Failed_CacheDirectory;
+            return false;
+        }
     }
 
     m_state = State::WorkEnqueued;
@@ -130,94 +313,135 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
     // take a short ID snippet to use as a more readable tag in the log in front of everything related to this stem
     const std::string stemCouchSnip = m_data.couchID.substr( 8 );
 
-    spacetime::ScopedTimer stemTiming( "stem finalize" );
+    // the heap buffer is only sized up if we end up downloading, or can't map the cache file
+    auto fetched = std::make_unique< FetchedData >();
+    fetched->m_mappedData   = archivedData;
+    fetched->m_archive      = std::move( archive );
+    fetched->m_cacheFile    = cachePath / m_data.couchID.value();
 
-    // prepare download buffer
-    RawAudioMemory audioMemory( m_data.fileLengthBytes );
+    RawAudioMemory& audioMemory = fetched->m_audioMemory;
+    const fs::path& cacheFile   = fetched->m_cacheFile;
 
     // check to see if we already have it downloaded
-    auto cacheFile = cachePath / m_data.couchID.value();
+    if ( fromArchive )
+    {
+        blog::cache( FMTX( "[s:{}..] found in mounted archive" ), stemCouchSnip );
+
+        // same tolerance as a file in the cache directory
+        if ( archivedData.size() != m_data.fileLengthBytes && !ncfg.api().hackAllowStemSizeMismatch )
+        {
+            blog::error::cache( FMTX( "[s:{}..] archived file size mismatch! expected {}, got {}" ),
+                stemCouchSnip,
+                m_data.fileLengthBytes,
+                archivedData.size() );
+
+            m_state = State::Failed_DataUnderflow;
+            return false;
+        }
+        // too short to even hold a container header
+        if ( archivedData.size() < 4 )
+        {
+            m_state = State::Failed_DataUnderflow;
+            return false;
+        }
+    }
+    else
     if ( fs::exists( cacheFile ) )
     {
         blog::cache( FMTX( "[s:{}..] found in cache" ), stemCouchSnip );
 
         const auto fileSize = fs::file_size( cacheFile );
 
-        if ( fileSize != audioMemory.m_rawLength )
+        if ( fileSize != m_data.fileLengthBytes )
         {
             // check if we should just accept discrepancies in the db/CDN size reports
             if ( fileSize > 0 && ncfg.api().hackAllowStemSizeMismatch )
             {
                 blog::cache( FMTX( "[s:{}..] allowed cached file size mismatch; expected {}, got {}" ),
                     stemCouchSnip,
-                    audioMemory.m_rawLength,
+                    m_data.fileLengthBytes,
                     fileSize );
-
-                audioMemory.allocate( fileSize );
             }
             else
             {
                 blog::error::cache( FMTX( "[s:{}..] cached file size mismatch! expected {}, got {}" ),
                     stemCouchSnip,
-                    audioMemory.m_rawLength,
+                    m_data.fileLengthBytes,
                     fileSize );
 
                 m_state = State::Failed_DataUnderflow;
-                return;
+                return false;
             }
         }
 
-        std::basic_ifstream<char> ifs( cacheFile, std::ios::in | std::ios::binary );
-        ifs.read( (char*)audioMemory.m_rawAudio, fileSize );
+        // decode straight out of a mapping of the cache file rather than copying the whole thing onto the heap first;
+        // anything too short to hold a container header goes through the buffer instead, which is padded for that check
+        absl::StatusOr< sys::MappedFile::Instance > cacheMapping = absl::UnavailableError( "too small to map" );
+        if ( fileSize >= 4 )
+            cacheMapping = sys::MappedFile::openReadOnly( cacheFile );
 
-        audioMemory.m_rawReceived = fileSize;
-    }
+        if ( cacheMapping.ok() )
+        {
+            (*cacheMapping)->adviseSequential();
 
-    math::RNG32 lRng;
+            fetched->m_cacheMapping = std::move( cacheMapping ).value();
+            fetched->m_mappedData   = std::span< const uint8_t >( fetched->m_cacheMapping->data(), fetched->m_cacheMapping->size() );
+        }
+        else
+        {
+            if ( fileSize >= 4 )
+                blog::error::cache( FMTX( "[s:{}..] unable to map cached file, reading instead; {}" ), stemCouchSnip, cacheMapping.status().ToString() );
 
-    if ( audioMemory.m_rawReceived == 0 )
-    {
-        bool stemFetchSuccess = false;
+            audioMemory.allocate( fileSize );
+
+            std::basic_ifstream<char> ifs( cacheFile, std::ios::in | std::ios::binary );
+            ifs.read( (char*)audioMemory.m_rawAudio, fileSize );
+
+            audioMemory.m_rawReceived = fileSize;
+        }
+    }
 
+    if ( !fetched->isMapped() && audioMemory.m_rawReceived == 0 )
+    {
         blog::stem( FMTX( "[s:{}..] downloading [{}/{}] ..." ),
             stemCouchSnip,
             m_data.fullEndpoint(),
             m_data.fileKey );
 
-        // things can take a while to propogate to the CDN; wait longer each cycle and try repeatedly
-        for ( auto remoteFetchAttempst = 0; remoteFetchAttempst < ncfg.getRequestRetries(); remoteFetchAttempst++ )
-        {
-            // extend & jitter fetch delay each time we start a full fetch attempt, up to 1s
-            const auto fetchDelayMs = std::min( lRng.genInt32( 0, 500 ) + ( remoteFetchAttempst * 250 ), 1000 );
-
-            std::this_thread::sleep_for( std::chrono::milliseconds( fetchDelayMs ) );
+        audioMemory.allocate( m_data.fileLengthBytes );
 
-            if ( !attemptRemoteFetch( ncfg, lRng.genUInt32(), audioMemory ) )
-            {
-                blog::stem( FMTX( "[s:{}..] failed attempt {} for [{}], will retry" ),
-                    stemCouchSnip,
-                    remoteFetchAttempst + 1,
-                    m_data.fileKey );
-            }
-            else
-            {
-                stemFetchSuccess = true;
-                break;
-            }
-        }
+        if ( !fetchRemoteWithRetries( ncfg, m_data, cacheFile, audioMemory, m_state, m_stateHttpStatus ) )
+            return false;
 
-        if ( !stemFetchSuccess )
-        {
-            blog::stem( FMTX( "[s:{}..] unable to acquire [{}]"),
-                stemCouchSnip,
-                m_data.fileKey );
-            return;
-        }
+        fetched->m_writeToCache = true;
     }
 
+    m_fetched = std::move( fetched );
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Stem::decodeFetched()
+{
+    ABSL_ASSERT( m_fetched != nullptr );
+
+    // take ownership of the compressed data so it is released when we're done, however decoding goes
+    const std::unique_ptr< FetchedData > fetched = std::move( m_fetched );
+
+    const RawAudioMemory& audioMemory = fetched->m_audioMemory;
+    const fs::path&       cacheFile   = fetched->m_cacheFile;
+
+    const std::string stemCouchSnip = m_data.couchID.substr( 8 );
+
+    spacetime::ScopedTimer stemTiming( "stem finalize" );
+
+    // the compressed data we're going to decode, wherever it came from
+    const uint8_t*    rawAudioData   = fetched->isMapped() ? fetched->m_mappedData.data() : audioMemory.m_rawAudio;
+    const std::size_t rawAudioLength = fetched->isMapped() ? fetched->m_mappedData.size() : audioMemory.m_rawLength;
+
     // luckily we can tell what compression is in play from the first 4 bytes (so far, at least)
-    const bool stemIsFLAC = (audioMemory.m_rawAudio[0] == 'f' && audioMemory.m_rawAudio[1] == 'L' && audioMemory.m_rawAudio[2] == 'a' && audioMemory.m_rawAudio[3] == 'C');
-    const bool stemIsOGG  = (audioMemory.m_rawAudio[0] == 'O' && audioMemory.m_rawAudio[1] == 'g' && audioMemory.m_rawAudio[2] == 'g' && audioMemory.m_rawAudio[3] == 'S');
+    const bool stemIsFLAC = (rawAudioData[0] == 'f' && rawAudioData[1] == 'L' && rawAudioData[2] == 'a' && rawAudioData[3] == 'C');
+    const bool stemIsOGG  = (rawAudioData[0] == 'O' && rawAudioData[1] == 'g' && rawAudioData[2] == 'g' && rawAudioData[3] == 'S');
 
     // header check - do we have a file we know how to decompress?
     if ( !stemIsFLAC && !stemIsOGG )
@@ -231,107 +455,88 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
     {
         base::instr::ScopedEvent wte( "Stem::fetch::OGG", base::instr::PresetColour::Cyan );
 
-        // decode the vorbis stream into interleaved shorts
-        short* oggData = nullptr;
-        int32_t oggChannels;
-        int32_t oggSampleRate;
-
-        m_sampleCount = stb_vorbis_decode_memory(
-            audioMemory.m_rawAudio,
-            (int32_t)audioMemory.m_rawLength,
-            &oggChannels,
-            &oggSampleRate,
-            &oggData );
+        int32_t vorbisError = 0;
+        stb_vorbis* vorbis = stb_vorbis_open_memory(
+            rawAudioData,
+            (int32_t)rawAudioLength,
+            &vorbisError,
+            nullptr );
 
-        if ( m_sampleCount <= 0 )
+        if ( vorbis == nullptr )
         {
-            blog::error::stem( FMTX( "[s:{}..] vorbis decode failure, sample count <0 ({})" ), stemCouchSnip, m_sampleCount );
+            blog::error::stem( FMTX( "[s:{}..] vorbis decode failure, unable to open stream ({})" ), stemCouchSnip, vorbisError );
             m_state = State::Failed_Decompression;
-            free( oggData );
             return;
         }
 
-        if ( oggChannels != 2 )
+        const stb_vorbis_info vorbisInfo = stb_vorbis_get_info( vorbis );
+        if ( vorbisInfo.channels != 2 )
         {
-            blog::error::stem( FMTX( "[s:{}..] invalid vorbis stream, only stereo supported; {} channels found" ), stemCouchSnip, oggChannels );
+            blog::error::stem( FMTX( "[s:{}..] invalid vorbis stream, only stereo supported; {} channels found" ), stemCouchSnip, vorbisInfo.channels );
             m_state = State::Failed_Decompression;
-            free( oggData );
+            stb_vorbis_close( vorbis );
             return;
         }
 
-        m_compressionFormat = Compression::OggVorbis;
-
-        // emit a successful capture back to the cache
-        {
-            std::basic_ofstream<char> ofs( cacheFile, std::ios::out | std::ios::binary );
-            ofs.write( (char*)audioMemory.m_rawAudio, audioMemory.m_rawReceived );
-        }
-
-        static constexpr double shortToDoubleNormalisedRcp = 1.0 / 32768.0;
-
-        // if the ogg is coming in at a different sample rate, up or downsample it to match our chosen mixer rate
-        if ( oggSampleRate != m_sampleRate )
+        // the final page should tell us the stream length; if it's missing (eg. a truncated upload we have been told to
+        // tolerate) then fall back to counting frames with a decode pass before rewinding for the real one
+        std::size_t vorbisSampleCount = stb_vorbis_stream_length_in_samples( vorbis );
+        if ( vorbisSampleCount == 0 )
         {
-            blog::stem( FMTX( "[s:{}..] resampling ogg data from {}"), stemCouchSnip, oggSampleRate );
-
-            auto* resampleIn = mem::alloc16<double>( m_sampleCount );
-
-            r8b::CDSPResampler24 resampler24(
-                (double)oggSampleRate,
-                m_sampleRate,
-                m_sampleCount );
+            blog::stem( FMTX( "[s:{}..] vorbis stream length unknown, counting samples" ), stemCouchSnip );
 
-            const auto outputSampleLength = resampler24.getMaxOutLen( 0 );
-            double* resampleOut = mem::alloc16<double>( outputSampleLength );
+            int32_t frameSamples = 0;
+            while ( ( frameSamples = stb_vorbis_get_frame_float( vorbis, nullptr, nullptr ) ) > 0 )
+                vorbisSampleCount += frameSamples;
 
-            // resample each channel to the chosen sample rate using r8brain
-            for ( std::size_t channel = 0; channel < 2; channel++ )
-            {
-                // convert sint16 to doubles
-                for ( size_t s = 0, readIndex = channel; s < m_sampleCount; s++, readIndex += 2 )
-                {
-                    resampleIn[s] = (double)oggData[readIndex] * shortToDoubleNormalisedRcp;
-                }
+            stb_vorbis_seek_start( vorbis );
+        }
 
-                // resample stem as one-shot, standalone task
-                resampler24.oneshot( resampleIn, m_sampleCount, resampleOut, outputSampleLength );
+        if ( vorbisSampleCount == 0 )
+        {
+            blog::error::stem( FMTX( "[s:{}..] vorbis decode failure, no samples in stream" ), stemCouchSnip );
+            m_state = State::Failed_Decompression;
+            stb_vorbis_close( vorbis );
+            return;
+        }
 
-                // allocate actual channel data storage and copy across, out of resampling buffer
-                m_channel[channel] = mem::alloc16<float>( outputSampleLength );
-                for ( size_t s = 0; s < outputSampleLength; s++ )
-                {
-                    m_channel[channel][s] = static_cast<float>(resampleOut[s]);
-                }
-            }
+        m_compressionFormat = Compression::OggVorbis;
 
-            mem::free16( resampleOut );
-            mem::free16( resampleIn );
+        // emit a successful capture back to the cache
+        if ( fetched->m_writeToCache )
+            writeToCache( cacheFile, audioMemory, stemCouchSnip );
 
-            m_sampleCount = outputSampleLength;
-        }
-        else
+        // if the ogg is coming in at a different sample rate, up or downsample it to match our chosen mixer rate
+        if ( vorbisInfo.sample_rate != m_sampleRate )
         {
-            // blog::stem( FMTX( "[s:{}..] stem already at {}" ), stemCouchSnip, m_sampleRate );
+            blog::stem( FMTX( "[s:{}..] resampling ogg data from {}"), stemCouchSnip, vorbisInfo.sample_rate );
+        }
 
-            m_channel[0] = mem::alloc16<float>( m_sampleCount );
-            m_channel[1] = mem::alloc16<float>( m_sampleCount );
+        // decode frame by frame, streaming the results into the final channel buffers
+        StreamingStemWriter stemWriter( m_channel, vorbisInfo.sample_rate, m_sampleRate, vorbisSampleCount );
+        for ( ;; )
+        {
+            float** frameOutput = nullptr;
+            const int32_t frameSamples = stb_vorbis_get_frame_float( vorbis, nullptr, &frameOutput );
+            if ( frameSamples <= 0 )
+                break;
 
-            for ( std::size_t s = 0, readIndex = 0; s < m_sampleCount; s++ )
+            for ( int32_t s = 0; s < frameSamples; s++ )
             {
-                m_channel[0][s] = (float)((double)oggData[readIndex++] * shortToDoubleNormalisedRcp);
-                m_channel[1][s] = (float)((double)oggData[readIndex++] * shortToDoubleNormalisedRcp);
+                stemWriter.push( frameOutput[0][s], frameOutput[1][s] );
             }
         }
 
-        // stb mallocs, we discard the data it gave us
-        free( oggData );
+        stb_vorbis_close( vorbis );
+
+        m_sampleCount = static_cast<int32_t>( stemWriter.finish() );
     }
     else // stemIsFLAC
     {
         base::instr::ScopedEvent wte( "Stem::fetch::FLAC", base::instr::PresetColour::Amber );
 
-        uint8_t* rawAudio = audioMemory.m_rawAudio;
-        uint32_t rawAudioLen = (uint32_t)audioMemory.m_rawLength;
+        const uint8_t* rawAudio = rawAudioData;
+        uint32_t rawAudioLen = (uint32_t)rawAudioLength;
 
         // create working memory buffer for the decoder
         const uint32_t flacWorkingMemorySize = fx_flac_size( FLAC_MAX_BLOCK_SIZE, FLAC_MAX_CHANNEL_COUNT );
@@ -340,10 +545,9 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
         // instance the decoder with the memory pool
         fx_flac_t* flac = fx_flac_init( flacWorkingMemory, FLAC_MAX_BLOCK_SIZE, FLAC_MAX_CHANNEL_COUNT );
 
-        // prep two channels to append to as we decode frames
-        std::array<double*, 2> flacStreamChannels;
-        flacStreamChannels.fill( nullptr );
-        std::size_t flacStreamChannelsWriteIndex = 0;
+        // created once we know the stream's sample rate & length; decoded frames are streamed through this directly
+        // into the final channel buffers
+        std::optional< StreamingStemWriter > stemWriter;
 
         // inner loop decoder buffer, stack local
         static constexpr std::size_t flacDecoderBufferSize = 1024 * 4;
@@ -392,7 +596,7 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
                 rawAudioLen,
                 rawAudioInBytes,
                 flacAudioOutSamples,
-                flacStreamChannelsWriteIndex );
+                stemWriter.has_value() ? stemWriter->getSourceSamplesPushed() : 0 );
 #endif // OURO_FLAC_VERBOSE
 
             switch ( flacState )
@@ -413,7 +617,7 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
                 case FLAC_END_OF_METADATA:
                 {
                     // check we haven't already seen a metadata block, should just be the one (AFAIK)
-                    ABSL_ASSERT( flacStreamChannels[0] == nullptr );
+                    ABSL_ASSERT( !stemWriter.has_value() );
 
                     flacSampleRate      = fx_flac_get_streaminfo( flac, FLAC_KEY_SAMPLE_RATE );
                     flacChannelCount    = fx_flac_get_streaminfo( flac, FLAC_KEY_N_CHANNELS );
@@ -424,6 +628,7 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
                     {
                         blog::error::stem( FMTX( "[s:{}..] flac decode error - expecting 2 channels, got {}" ), stemCouchSnip, flacChannelCount );
                         m_state = State::Failed_Decompression;
+                        break;
                     }
 
                     blog::stem( FMTX( "[s:{}..] start flac decode : {} samples, {}-bit @ {}" ),
@@ -440,9 +645,13 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
                     conversionNegativeRecp = 1.0 / static_cast<double>(sampleMaxNegativeValue);
                     conversionBitShift = 32 - flacSampleSize;
 
-                    // prepare storage for the decompressed frames
-                    flacStreamChannels[0] = mem::alloc16<double>( flacSampleCount );
-                    flacStreamChannels[1] = mem::alloc16<double>( flacSampleCount );
+                    // similar to OGG, handle sample rate conversion as we write into the final data buffers
+                    if ( flacSampleRate != m_sampleRate )
+                    {
+                        blog::stem( FMTX( "[s:{}..] resampling flac from {}" ), stemCouchSnip, flacSampleRate );
+                    }
+
+                    stemWriter.emplace( m_channel, static_cast<uint32_t>( flacSampleRate ), m_sampleRate, flacSampleCount );
                     break;
                 }
 
@@ -454,7 +663,7 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
                 case FLAC_END_OF_FRAME:
                 {
                     // check we got a metadata block first, otherwise we have nowhere to decode into
-                    if ( flacStreamChannels[0] == nullptr )
+                    if ( !stemWriter.has_value() )
                     {
                         blog::error::stem( FMTX( "[s:{}..] flac decode error - no metadata decoded before frames encountered" ), stemCouchSnip );
                         m_state = State::Failed_Decompression;
@@ -462,18 +671,17 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
                     }
 
                     ABSL_ASSERT( (flacAudioOutSamples % 2) == 0 );
-                    for ( uint32_t sample = 0; sample < flacAudioOutSamples; sample+=2, flacStreamChannelsWriteIndex++ )
+                    for ( uint32_t sample = 0; sample < flacAudioOutSamples; sample+=2 )
                     {
                         /* Quote: Note that this data is always shifted such that it uses the
                             entire 32-bit signed integer; shift to the right to the desired
                             output bit depth. You can obtain the bit-depth used in the file
                             using fx_flac_get_streaminfo(). */
 
-                        double sampleDoubleL = static_cast<double>( decodeBuffer[sample+0] >> conversionBitShift ) * conversionNegativeRecp;
-                        double sampleDoubleR = static_cast<double>( decodeBuffer[sample+1] >> conversionBitShift ) * conversionNegativeRecp;
+                        const double sampleDoubleL = static_cast<double>( decodeBuffer[sample+0] >> conversionBitShift ) * conversionNegativeRecp;
+                        const double sampleDoubleR = static_cast<double>( decodeBuffer[sample+1] >> conversionBitShift ) * conversionNegativeRecp;
 
-                        flacStreamChannels[0][flacStreamChannelsWriteIndex] = sampleDoubleL;
-                        flacStreamChannels[1][flacStreamChannelsWriteIndex] = sampleDoubleR;
+                        stemWriter->push( sampleDoubleL, sampleDoubleR );
                     }
                     break;
                 }
@@ -488,11 +696,13 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
         mem::free16( flacWorkingMemory );
 
         // check if we emerged from the loop with errors
-        if ( m_state != State::WorkEnqueued )
+        if ( m_state != State::WorkEnqueued || !stemWriter.has_value() )
         {
             // clean up the channel buffers before leaving
-            mem::free16( flacStreamChannels[0] );
-            mem::free16( flacStreamChannels[1] );
+            if ( stemWriter.has_value() )
+                stemWriter->abandon();
+
+            m_state = State::Failed_Decompression;
 
             blog::error::stem( FMTX( "[s:{}..] stem discarded, flac decompression error" ), stemCouchSnip );
             return;
@@ -507,100 +717,48 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
         // with a tiny number of samples missing (in the specific example, just 2 samples). The final frame is a FLAC_SEARCH_FRAME
         // rather than FLAC_END_OF_FRAME. I'm not sure why that happens; to try and support these final quirks, we allow a tiny amount of
         // drift here (but also log it out as an error)
-        ABSL_ASSERT( flacStreamChannelsWriteIndex <= flacSampleCount );
-        if ( flacStreamChannelsWriteIndex != flacSampleCount )
+        const std::size_t flacSamplesDecoded = stemWriter->getSourceSamplesPushed();
+        ABSL_ASSERT( flacSamplesDecoded <= flacSampleCount );
+        if ( flacSamplesDecoded != flacSampleCount )
         {
-            blog::error::stem( FMTX( "[s:{}..] FLAC decompression sample mismatch ( written {} != declared {} )" ), stemCouchSnip, flacStreamChannelsWriteIndex, flacSampleCount );
+            blog::error::stem( FMTX( "[s:{}..] FLAC decompression sample mismatch ( written {} != declared {} )" ), stemCouchSnip, flacSamplesDecoded, flacSampleCount );
         }
 
         // go backfill those missing samples, just copy them from the last one we got
-        if ( flacStreamChannelsWriteIndex > 1 && flacStreamChannelsWriteIndex < flacSampleCount )
+        if ( flacSamplesDecoded > 1 && flacSamplesDecoded < flacSampleCount )
         {
             // allow a maximum number of missing samples
-            const std::size_t missingSamples = flacSampleCount - flacStreamChannelsWriteIndex;
+            const std::size_t missingSamples = flacSampleCount - flacSamplesDecoded;
             if ( missingSamples < 4 )
             {
                 blog::error::stem( FMTX( "[s:{}..] FLAC fixing {} missing samples" ), stemCouchSnip, missingSamples );
 
                 // .. and 'fix' by just copying the last valid one we have over the gaps to avoid a click
-                for ( std::size_t hackSample = flacStreamChannelsWriteIndex; hackSample < flacSampleCount; hackSample++ )
-                {
-                    flacStreamChannels[0][hackSample] = flacStreamChannels[0][flacStreamChannelsWriteIndex - 1];
-                    flacStreamChannels[1][hackSample] = flacStreamChannels[1][flacStreamChannelsWriteIndex - 1];
-                }
-                flacStreamChannelsWriteIndex = flacSampleCount;
+                stemWriter->pushRepeatLast( missingSamples );
             }
             else
             {
+                stemWriter->abandon();
                 m_state = State::Failed_Decompression;
                 return;
             }
         }
-        m_sampleCount = static_cast<int32_t>( flacSampleCount );
-
-        // similar to OGG, handle sample rate conversion as we create the final data buffers
-        if ( flacSampleRate != m_sampleRate )
-        {
-            blog::stem( FMTX( "[s:{}..] resampling flac from {}" ), stemCouchSnip, flacSampleRate );
-
-            r8b::CDSPResampler24 resampler24(
-                (double)flacSampleRate,
-                m_sampleRate,
-                m_sampleCount );
-
-            const auto outputSampleLength = resampler24.getMaxOutLen( 0 );
-            double* resampleOut = mem::alloc16<double>( outputSampleLength );
-
-            // resample each channel to the chosen sample rate using r8brain
-            for ( std::size_t channel = 0; channel < 2; channel++ )
-            {
-                // resample stem as one-shot, standalone task
-                resampler24.oneshot( flacStreamChannels[channel], m_sampleCount, resampleOut, outputSampleLength);
-
-                // allocate actual channel data storage and copy across, out of resampling buffer
-                m_channel[channel] = mem::alloc16<float>( outputSampleLength );
-                for ( std::size_t s = 0; s < outputSampleLength; s++ )
-                {
-                    m_channel[channel][s] = static_cast<float>(resampleOut[s]);
-                }
-            }
-
-            mem::free16( resampleOut );
-
-            m_sampleCount = outputSampleLength;
-        }
-        // if the sample rate already matches, just copy across verbatim
-        else
-        {
-            // blog::stem( FMTX( "[s:{}..] stem already at {}" ), stemCouchSnip, m_sampleRate );
-
-            m_channel[0] = mem::alloc16<float>( m_sampleCount );
-            m_channel[1] = mem::alloc16<float>( m_sampleCount );
-
-            for ( std::size_t channel = 0; channel < 2; channel++ )
-            {
-                for ( std::size_t s = 0; s < m_sampleCount; s++ )
-                {
-                    m_channel[channel][s] = static_cast<float>(flacStreamChannels[channel][s]);
-                }
-            }
-        }
 
-        mem::free16( flacStreamChannels[0] );
-        mem::free16( flacStreamChannels[1] );
+        m_sampleCount = static_cast<int32_t>( stemWriter->finish() );
 
         m_compressionFormat = Compression::FLAC;
 
         // if the decode worked, stash the original data in the cache
-        {
-            std::basic_ofstream<char> ofs( cacheFile, std::ios::out | std::ios::binary );
-            ofs.write( (char*)audioMemory.m_rawAudio, audioMemory.m_rawReceived );
-        }
+        if ( fetched->m_writeToCache )
+            writeToCache( cacheFile, audioMemory, stemCouchSnip );
     }
 
     // immediate post-processing steps that modify samples
     applyLoopSewingBlend();
 
+    // .. and then, optionally, pack them down for storage
+    applySampleStorageCompaction();
+
     m_state = State::Complete;
 
     // report on our hard work
@@ -616,100 +774,188 @@ void Stem::fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath )
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-bool Stem::attemptRemoteFetch( const api::NetConfiguration& ncfg, const uint32_t attemptUID, RawAudioMemory& audioMemory )
+// pull the full resource length out of a Content-Range header, eg. "bytes 1000-4999/5000" -> 5000; 0 if unknown
+static std::size_t parseContentRangeTotal( const std::string& contentRange )
+{
+    const auto slashPos = contentRange.rfind( '/' );
+    if ( slashPos == std::string::npos || slashPos + 1 >= contentRange.size() || contentRange[slashPos + 1] == '*' )
+        return 0;
+
+    return static_cast<std::size_t>( std::atoll( contentRange.c_str() + slashPos + 1 ) );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// pull the first byte offset out of a Content-Range header, eg. "bytes 1000-4999/5000" -> 1000
+static std::size_t parseContentRangeStart( const std::string& contentRange )
+{
+    const auto spacePos = contentRange.find( ' ' );
+    if ( spacePos == std::string::npos )
+        return 0;
+
+    return static_cast<std::size_t>( std::atoll( contentRange.c_str() + spacePos + 1 ) );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Stem::attemptRemoteFetch(
+    const api::NetConfiguration& ncfg,
+    const types::Stem& stemData,
+    const uint32_t attemptUID,
+    RawAudioMemory& audioMemory,
+    State& state,
+    uint32_t& httpStatus )
 {
     // log network traffic
     ncfg.metricsActivitySend();
 
     // create client to fetch audio stream from the CDN
-    const auto& httpUrl = m_data.fullEndpoint();
-    auto cdnClient      = std::make_unique< httplib::SSLClient >( httpUrl.c_str() );
+    const auto& httpUrl = stemData.fullEndpoint();
+    auto cdnClient      = std::make_unique< httplib::Client >( ncfg.resolveOrigin( httpUrl ) );
 
     cdnClient->set_ca_cert_path( ncfg.api().certBundleRelative.c_str() );
     cdnClient->enable_server_certificate_verification( true );
 
+    // no content-encoding; the audio is already compressed and byte ranges have to line up with the stored file
     cdnClient->set_default_headers(
         {
             { "Host",            httpUrl },
             { "User-Agent",      ncfg.api().userAgentApp.c_str() },
             { "Accept",          "audio/ogg" },
-            { "Accept-Encoding", "gzip, deflate, br" }
+            { "Accept-Encoding", "identity" }
         } );
 
-    auto slashedKey = fmt::format( "/{}", m_data.fileKey );
+    auto slashedKey = fmt::format( "/{}", stemData.fileKey );
 
-    
-    auto precheckResult = cdnClient->Head( slashedKey.c_str() );
-    auto precheckError = precheckResult.error();
-    
-    if ( precheckError != httplib::Error::Success )
-    {
-        blog::error::stem( "HEAD [{}] client failure with error : {}", slashedKey, endlesss::api::getHttpLibErrorString(precheckError) );
-        m_state = State::Failed_Http;
-        m_stateHttpStatus = precheckResult->status;
-        return false;
-    }
+    // if a previous attempt got part of the way, ask only for the rest
+    const std::size_t resumeFrom = audioMemory.m_rawReceived;
 
-    if ( precheckResult->status != 200 )
+    httplib::Headers requestHeaders;
+    if ( resumeFrom > 0 )
     {
-        blog::error::stem( "HEAD [{}] response [{}]", slashedKey, precheckResult->status );
-        m_state = State::Failed_Http;
-        m_stateHttpStatus = precheckResult->status;
-        return false;
+        requestHeaders.emplace( "Range", fmt::format( FMTX( "bytes={}-" ), resumeFrom ) );
+        blog::stem( "GET [{}] resuming from byte {} of {}", slashedKey, resumeFrom, audioMemory.m_rawLength );
     }
 
-    size_t precheckDataLength = 0;
-    if ( precheckResult->has_header( "content-length" ) )
-    {
-        auto val = precheckResult->get_header_value( "content-length" );
-        if ( !val.empty() )
-            precheckDataLength = (size_t) std::atoll( val.c_str() );
-    }
+    std::size_t receivedThisAttempt = 0;
 
-    if ( precheckDataLength != audioMemory.m_rawLength )
-    {
-        // check if we should just accept discrepancies in the db/CDN size reports
-        if ( precheckDataLength > 0 && 
-            ncfg.api().hackAllowStemSizeMismatch )
+    // validate status and size as soon as the response headers arrive, before any of the body is accepted
+    const auto responseHandler = [&]( const httplib::Response& response ) -> bool
         {
-            blog::stem( "HEAD [{}] allowing content-length mismatch; got [{}], DB expected [{}]", slashedKey, precheckDataLength, audioMemory.m_rawLength );
+            std::size_t remoteDataLength = 0;
 
-            // rebuild the audio memory block to cope
-            audioMemory.allocate( precheckDataLength );
-        }
-        else
-        {
-            blog::error::stem( "HEAD [{}] content-length mismatch; got [{}], DB expected [{}]", slashedKey, precheckDataLength, audioMemory.m_rawLength );
-            m_state = State::Failed_Http;
-            return false;
-        }
-    }
+            if ( response.status == 206 && resumeFrom > 0 )
+            {
+                const std::string contentRange = response.get_header_value( "content-range" );
+                if ( parseContentRangeStart( contentRange ) != resumeFrom )
+                {
+                    blog::error::stem( "GET [{}] unexpected content-range [{}] resuming from {}", slashedKey, contentRange, resumeFrom );
+                    audioMemory.m_rawReceived = 0;
+                    state = State::Failed_Http;
+                    return false;
+                }
+
+                remoteDataLength = parseContentRangeTotal( contentRange );
+                if ( remoteDataLength == 0 && response.has_header( "content-length" ) )
+                    remoteDataLength = resumeFrom + static_cast<std::size_t>( std::atoll( response.get_header_value( "content-length" ).c_str() ) );
+            }
+            else if ( response.status == 200 )
+            {
+                // either a fresh request or the server ignored our Range; either way, the body is the whole file
+                if ( resumeFrom > 0 )
+                {
+                    blog::stem( "GET [{}] range not honoured, restarting download", slashedKey );
+                    audioMemory.m_rawReceived = 0;
+                }
+
+                if ( response.has_header( "content-length" ) )
+                    remoteDataLength = static_cast<std::size_t>( std::atoll( response.get_header_value( "content-length" ).c_str() ) );
+            }
+            else
+            {
+                // 416 means our partial data doesn't line up with what's on the CDN any more; start over next time
+                if ( response.status == 416 )
+                    audioMemory.m_rawReceived = 0;
+
+                blog::error::stem( "GET [{}] response [{}]", slashedKey, response.status );
+                state = State::Failed_Http;
+                httpStatus = response.status;
+                return false;
+            }
+
+            if ( remoteDataLength != audioMemory.m_rawLength )
+            {
+                // check if we should just accept discrepancies in the db/CDN size reports
+                if ( remoteDataLength > 0 && 
+                    ncfg.api().hackAllowStemSizeMismatch )
+                {
+                    blog::stem( "GET [{}] allowing content-length mismatch; got [{}], DB expected [{}]", slashedKey, remoteDataLength, audioMemory.m_rawLength );
+
+                    // rebuild the audio memory block to cope, keeping anything already received
+                    audioMemory.allocate( remoteDataLength );
+                }
+                else
+                {
+                    blog::error::stem( "GET [{}] content-length mismatch; got [{}], DB expected [{}]", slashedKey, remoteDataLength, audioMemory.m_rawLength );
+                    state = State::Failed_Http;
+                    return false;
+                }
+            }
+
+            return true;
+        };
 
-    auto res = cdnClient->Get( slashedKey.c_str(), [&]( const char* data, size_t data_length )
+    auto res = cdnClient->Get( slashedKey.c_str(), requestHeaders, responseHandler, [&]( const char* data, size_t data_length )
         {
             if ( audioMemory.m_rawReceived + data_length > audioMemory.m_rawLength )
             {
-                m_state = State::Failed_DataOverflow;
+                state = State::Failed_DataOverflow;
                 return false;
             }
 
             memcpy( &audioMemory.m_rawAudio[audioMemory.m_rawReceived], data, data_length );
             audioMemory.m_rawReceived += data_length;
+            receivedThisAttempt += data_length;
 
             return true;
         });
 
     // log network traffic
-    ncfg.metricsActivityRecv( audioMemory.m_rawReceived );
+    ncfg.metricsActivityRecv( receivedThisAttempt );
 
-    if ( audioMemory.m_rawReceived != audioMemory.m_rawLength )
+    if ( state == State::Failed_DataOverflow )
+    {
+        blog::error::stem( "fetch ogg overflow [{}{}]", httpUrl, slashedKey );
+
+        // can't trust what we have, start from scratch next time
+        audioMemory.m_rawReceived = 0;
+        return false;
+    }
+
+    // rejected by the response handler; it will have logged why and set the state
+    if ( state == State::Failed_Http )
+        return false;
+
+    const auto requestError = res.error();
+    if ( requestError != httplib::Error::Success )
     {
-        // auto result = cdnClient->get_openssl_verify_result();
+        // any data that did arrive is kept, the next attempt will ask for the remainder
+        blog::error::stem( "fetch ogg failed [{}{}] with error : {} ({} of {} bytes received)",
+            httpUrl,
+            slashedKey,
+            endlesss::api::getHttpLibErrorString( requestError ),
+            audioMemory.m_rawReceived,
+            audioMemory.m_rawLength );
+
+        state = State::Failed_Http;
+        return false;
+    }
 
+    if ( audioMemory.m_rawReceived != audioMemory.m_rawLength )
+    {
         if ( !ncfg.api().hackAllowStemUnderflow )
         {
+            // as above, keep what we have and resume from there on the next attempt
             blog::error::stem( "ogg data size mismatch [{}{}] (expected {}, got {})", httpUrl, slashedKey, audioMemory.m_rawLength, audioMemory.m_rawReceived );
-            m_state = State::Failed_DataUnderflow;
+            state = State::Failed_DataUnderflow;
             return false;
         }
 
@@ -717,24 +963,181 @@ bool Stem::attemptRemoteFetch( const api::NetConfiguration& ncfg, const uint32_t
         audioMemory.m_rawLength = audioMemory.m_rawReceived;
     }
 
-    if ( m_state == State::Failed_DataOverflow )
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Stem::fetchRemoteWithRetries(
+    const api::NetConfiguration& ncfg,
+    const types::Stem& stemData,
+    const fs::path& cacheFile,
+    RawAudioMemory& audioMemory,
+    State& state,
+    uint32_t& httpStatus )
+{
+    const std::string stemCouchSnip = stemData.couchID.substr( 8 );
+
+    // partial data from an earlier interrupted download is stashed next to where the finished stem will go, under a
+    // suffix of its own so it can't be mixed up with the temporaries used while moving complete files into the cache
+    fs::path resumeFile = cacheFile;
+    resumeFile += ".resume";
+
     {
-        blog::error::stem( "fetch ogg overflow [{}{}]", httpUrl, slashedKey );
-        return false;
+        std::error_code resumeError;
+        const auto resumeSize = fs::file_size( resumeFile, resumeError );
+        if ( !resumeError && resumeSize > 0 )
+        {
+            // only ever a strict prefix of the stem we're after; anything at or past the full length isn't ours to trust
+            if ( resumeSize < stemData.fileLengthBytes && resumeSize < audioMemory.m_rawLength )
+            {
+                std::basic_ifstream<char> ifs( resumeFile, std::ios::in | std::ios::binary );
+                ifs.read( (char*)audioMemory.m_rawAudio, resumeSize );
+
+                if ( ifs.gcount() == static_cast<std::streamsize>( resumeSize ) )
+                {
+                    audioMemory.m_rawReceived = static_cast<std::size_t>( resumeSize );
+                    blog::stem( FMTX( "[s:{}..] found {} bytes of an interrupted download" ), stemCouchSnip, resumeSize );
+                }
+            }
+            else
+            {
+                blog::stem( FMTX( "[s:{}..] discarding {} bytes of resume data, expected under {}" ), stemCouchSnip, resumeSize, stemData.fileLengthBytes );
+
+                std::error_code removeError;
+                fs::remove( resumeFile, removeError );
+            }
+        }
     }
 
-    if ( res == nullptr )
+    math::RNG32 lRng;
+
+    // things can take a while to propogate to the CDN; wait longer each cycle and try repeatedly
+    for ( auto remoteFetchAttempst = 0; remoteFetchAttempst < ncfg.getRequestRetries(); remoteFetchAttempst++ )
     {
-        blog::error::stem( "fetch ogg failed [{}{}]", httpUrl, slashedKey );
-        m_state = State::Failed_Http;
-        return false;
+        // extend & jitter fetch delay each time we start a full fetch attempt, up to 1s
+        const auto fetchDelayMs = std::min( lRng.genInt32( 0, 500 ) + ( remoteFetchAttempst * 250 ), 1000 );
+
+        std::this_thread::sleep_for( std::chrono::milliseconds( fetchDelayMs ) );
+
+        state = State::WorkEnqueued;
+
+        if ( !attemptRemoteFetch( ncfg, stemData, lRng.genUInt32(), audioMemory, state, httpStatus ) )
+        {
+            blog::stem( FMTX( "[s:{}..] failed attempt {} for [{}], will retry" ),
+                stemCouchSnip,
+                remoteFetchAttempst + 1,
+                stemData.fileKey );
+        }
+        else
+        {
+            std::error_code removeError;
+            fs::remove( resumeFile, removeError );
+
+            return true;
+        }
+    }
+
+    blog::stem( FMTX( "[s:{}..] unable to acquire [{}]"),
+        stemCouchSnip,
+        stemData.fileKey );
+
+    // keep whatever we managed to get so a later fetch can pick up from there rather than starting again; if the server
+    // rejected the range we resumed from, nothing is held any more and the old stash has to go too
+    if ( audioMemory.m_rawReceived > 0 && audioMemory.m_rawReceived < audioMemory.m_rawLength )
+    {
+        std::basic_ofstream<char> ofs( resumeFile, std::ios::out | std::ios::binary );
+        ofs.write( (char*)audioMemory.m_rawAudio, audioMemory.m_rawReceived );
+    }
+    else
+    {
+        std::error_code removeError;
+        fs::remove( resumeFile, removeError );
+    }
+
+    return false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+Stem::State Stem::downloadToCache( const api::NetConfiguration& ncfg, const types::Stem& stemData, const fs::path& cachePath, uint32_t& httpStatus )
+{
+    httpStatus = 0;
+
+    const absl::Status cachePathAvailable = filesys::ensureDirectoryExists( cachePath );
+    if ( !cachePathAvailable.ok() )
+    {
+        blog::error::stem( FMTX( "Unable to create sub-directory in stem cache [{}], {}" ),
+            cachePath.string(),
+            cachePathAvailable.ToString() );
+
+        return State::Failed_CacheDirectory;
+    }
+
+    const std::string stemCouchSnip = stemData.couchID.substr( 8 );
+
+    const fs::path cacheFile = cachePath / stemData.couchID.value();
+
+    RawAudioMemory audioMemory( stemData.fileLengthBytes );
+    State downloadState = State::WorkEnqueued;
+
+    if ( !fetchRemoteWithRetries( ncfg, stemData, cacheFile, audioMemory, downloadState, httpStatus ) )
+        return ( downloadState == State::WorkEnqueued ) ? State::Failed_Http : downloadState;
+
+    // same container check that fetch() does before decoding; enough to catch error pages and garbage from the CDN
+    const bool stemIsFLAC = (audioMemory.m_rawAudio[0] == 'f' && audioMemory.m_rawAudio[1] == 'L' && audioMemory.m_rawAudio[2] == 'a' && audioMemory.m_rawAudio[3] == 'C');
+    const bool stemIsOGG  = (audioMemory.m_rawAudio[0] == 'O' && audioMemory.m_rawAudio[1] == 'g' && audioMemory.m_rawAudio[2] == 'g' && audioMemory.m_rawAudio[3] == 'S');
+    if ( !stemIsFLAC && !stemIsOGG )
+    {
+        blog::error::stem( FMTX( "[s:{}..] audio compression format not recognised" ), stemCouchSnip );
+        return State::Failed_Decompression;
+    }
+
+    if ( !writeToCache( cacheFile, audioMemory, stemCouchSnip ) )
+        return State::Failed_CacheDirectory;
+
+    return State::Complete;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Stem::writeToCache( const fs::path& cacheFile, const RawAudioMemory& audioMemory, const std::string& stemCouchSnip )
+{
+    // another fetch of the same stem may have beaten us to it
+    {
+        std::error_code existingError;
+        const auto existingSize = fs::file_size( cacheFile, existingError );
+        if ( !existingError && existingSize == audioMemory.m_rawReceived )
+            return true;
     }
 
-    if ( res->status != 200 )
+    // write via a temporary so a concurrent reader of the cache never sees a partially written stem; renaming over the
+    // old file leaves any existing mapping of it intact on POSIX, whereas truncating it would SIGBUS the reader
+    // the temporary is named per-thread, so two fetches of the same stem finishing together don't write over each other
+    fs::path incomingFile = cacheFile;
+    incomingFile += fmt::format( FMTX( ".{:x}.incoming" ), std::hash< std::thread::id >{}( std::this_thread::get_id() ) );
     {
-        blog::error::stem( "fetch ogg failed [{}{}] | {}", httpUrl, slashedKey, res->status );
-        m_state = State::Failed_Http;
-        m_stateHttpStatus = res->status;
+        std::basic_ofstream<char> ofs( incomingFile, std::ios::out | std::ios::binary );
+        ofs.write( (char*)audioMemory.m_rawAudio, audioMemory.m_rawReceived );
+        if ( !ofs.good() )
+        {
+            blog::error::cache( FMTX( "[s:{}..] failed writing to cache [{}]" ), stemCouchSnip, incomingFile.string() );
+            return false;
+        }
+    }
+
+    std::error_code renameError;
+    fs::rename( incomingFile, cacheFile, renameError );
+    if ( renameError )
+    {
+        std::error_code removeError;
+        fs::remove( incomingFile, removeError );
+
+        // windows refuses to replace a file that is still mapped, even with FILE_SHARE_DELETE; if a complete copy
+        // turned up in the meantime then that's the one in use and ours wasn't needed
+        std::error_code existingError;
+        const auto existingSize = fs::file_size( cacheFile, existingError );
+        if ( !existingError && existingSize == audioMemory.m_rawReceived )
+            return true;
+
+        blog::error::cache( FMTX( "[s:{}..] failed to move stem into cache, {}" ), stemCouchSnip, renameError.message() );
         return false;
     }
 
@@ -791,153 +1194,378 @@ void Stem::applyLoopSewingBlend()
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
-bool Stem::analyse( const Processing& processing, StemAnalysisData& result ) const
+void Stem::applySampleStorageCompaction()
 {
-    using namespace dsp;
-    using namespace cycfi::q::literals;
+    if ( m_sampleStorage != SampleStorage::Int16 )
+        return;
 
-    // such a small stem that we can't really do much? shout out to Blackest Jammmmmmmmmmm for unearthing this
-    if ( m_sampleCount <= processing.m_fftWindowSize )
+    for ( auto channel = 0; channel < 2; channel++ )
     {
-        blog::stem( "bypassing stem processing, stem C:{} only has {} samples", m_data.couchID, m_sampleCount );
-        return false;
+        const float* floatSamples = m_channel[channel];
+        int16_t* compactSamples   = mem::alloc16<int16_t>( m_sampleCount );
+
+        for ( int32_t s = 0; s < m_sampleCount; s++ )
+        {
+            const float scaled = std::clamp( floatSamples[s] * cFloatToInt16, -32768.0f, 32767.0f );
+            compactSamples[s]  = static_cast<int16_t>( std::lrint( scaled ) );
+        }
+
+        m_channelCompact[channel] = compactSamples;
+
+        mem::free16( m_channel[channel] );
+        m_channel[channel] = nullptr;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Stem::gatherSamples( const uint32_t* sampleIndices, const uint32_t sampleCount, float* outLeft, float* outRight ) const
+{
+    if ( m_sampleStorage == SampleStorage::Int16 )
+    {
+        const int16_t* compactLeft  = m_channelCompact[0];
+        const int16_t* compactRight = m_channelCompact[1];
+
+        for ( uint32_t sI = 0; sI < sampleCount; sI++ )
+        {
+            const uint32_t sampleIndex = sampleIndices[sI];
+
+            outLeft[sI]  = static_cast<float>( compactLeft[sampleIndex] )  * cInt16ToFloat;
+            outRight[sI] = static_cast<float>( compactRight[sampleIndex] ) * cInt16ToFloat;
+        }
+    }
+    else
+    {
+        const float* channelLeft  = m_channel[0];
+        const float* channelRight = m_channel[1];
+
+        for ( uint32_t sI = 0; sI < sampleCount; sI++ )
+        {
+            const uint32_t sampleIndex = sampleIndices[sI];
+
+            outLeft[sI]  = channelLeft[sampleIndex];
+            outRight[sI] = channelRight[sampleIndex];
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// the envelope followers and peak tracker run across the signal during analysis; bundled so that each chunk of a
+// parallel analysis can stand up its own fresh set
+struct Stem::AnalysisFollowers
+{
+    AnalysisFollowers( const Processing& processing )
+        : m_beatFollower(   cycfi::q::duration( processing.m_tuning.m_beatFollowDuration ), processing.m_sampleRateF )
+        , m_waveFollower(   cycfi::q::duration( processing.m_tuning.m_waveFollowDuration ), processing.m_sampleRateF )
+        , m_waveFollowerLF( cycfi::q::duration( processing.m_tuning.m_waveFollowDuration ), processing.m_sampleRateF )
+        , m_waveFollowerHF( cycfi::q::duration( processing.m_tuning.m_waveFollowDuration ), processing.m_sampleRateF )
+        , m_peakTracker(
+            processing.m_tuning.m_trackerSensitivity,
+            processing.m_tuning.m_trackerHysteresis )
+    {}
+
+    // the fast rms followers drop their held peaks round-robin on a fixed sample cadence; a warm-started set has to
+    // have seen the same number of samples as a serial run, modulo this period, to land on the same staircase phase
+    ouro_nodiscard std::size_t getStaircasePeriod() const
+    {
+        const auto& staircase = m_waveFollower._fenv._fenv;
+        return ( static_cast<std::size_t>( staircase._reset ) + 1 ) * staircase.size;
     }
 
+    cycfi::q::peak_envelope_follower     m_beatFollower;
+    cycfi::q::fast_rms_envelope_follower m_waveFollower;
+    cycfi::q::fast_rms_envelope_follower m_waveFollowerLF;
+    cycfi::q::fast_rms_envelope_follower m_waveFollowerHF;
+    cycfi::q::peak                       m_peakTracker;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Stem::analyse( const Processing& processing, StemAnalysisData& result ) const
+{
+    return analyseImpl( processing, result, nullptr );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Stem::analyse( const Processing& processing, StemAnalysisData& result, tf::Subflow& subflow ) const
+{
+    return analyseImpl( processing, result, &subflow );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Stem::analyseFrequencyBands( const Processing& processing, const int32_t windowBegin, const int32_t windowEnd, float* outLowBand, float* outHighBand ) const
+{
+    using namespace dsp;
+
+    base::instr::ScopedEvent wte( "Stem::analyse::fft", base::instr::PresetColour::Emerald );
+
     // default spectrum data for normalising freq data; we could load this from disk potentially
     const config::Spectrum audioSpectrumConfig;
 
     const int32_t fftWindowSize = processing.m_fftWindowSize;
-    const int32_t fftTimeSlices = m_sampleCount / fftWindowSize;
 
     // fft output working buffers
     complexf* fftOutputL  = mem::alloc16<complexf>( fftWindowSize );
     complexf* fftOutputR  = mem::alloc16<complexf>( fftWindowSize );
 
-    // transient frequency band buffers that then get smoothed afterwards
-    auto* fftOutLowBand   = mem::alloc16<float>( fftTimeSlices );
-    auto* fftOutHighBand  = mem::alloc16<float>( fftTimeSlices );
-
-
-    // prepare the analysis output
-    result.resize( m_sampleCount );
+    // compact stems are unpacked a window at a time to feed the FFT
+    const bool compactStorage = ( m_sampleStorage == SampleStorage::Int16 );
+    float* fftInputL      = compactStorage ? mem::alloc16<float>( fftWindowSize ) : nullptr;
+    float* fftInputR      = compactStorage ? mem::alloc16<float>( fftWindowSize ) : nullptr;
 
+    for ( int64_t fftBandLimit = windowBegin; fftBandLimit < windowEnd; fftBandLimit++ )
     {
-        base::instr::ScopedEvent wte( "Stem::analyse::fft", base::instr::PresetColour::Emerald );
+        const int64_t sI = fftBandLimit * fftWindowSize;
 
-        for ( int64_t sI = 0, fftBandLimit = 0; sI <= m_sampleCount - fftWindowSize; sI += fftWindowSize, fftBandLimit++ )
+        const float* windowL = compactStorage ? fftInputL : &(m_channel[0][sI]);
+        const float* windowR = compactStorage ? fftInputR : &(m_channel[1][sI]);
+
+        if ( compactStorage )
         {
-            // perform FFT on each stereo channel
-            pffft_transform_ordered( processing.m_pffftPlan, &(m_channel[0][sI]), reinterpret_cast<float*>(fftOutputL), nullptr, PFFFT_FORWARD );
-            pffft_transform_ordered( processing.m_pffftPlan, &(m_channel[1][sI]), reinterpret_cast<float*>(fftOutputR), nullptr, PFFFT_FORWARD );
+            for ( int32_t wI = 0; wI < fftWindowSize; wI++ )
+            {
+                fftInputL[wI] = static_cast<float>( m_channelCompact[0][sI + wI] ) * cInt16ToFloat;
+                fftInputR[wI] = static_cast<float>( m_channelCompact[1][sI + wI] ) * cInt16ToFloat;
+            }
+        }
 
-            std::array< float, 3 > frequencyBuckets;
-            frequencyBuckets.fill( 0 );
+        // perform FFT on each stereo channel
+        pffft_transform_ordered( processing.m_pffftPlan, windowL, reinterpret_cast<float*>(fftOutputL), nullptr, PFFFT_FORWARD );
+        pffft_transform_ordered( processing.m_pffftPlan, windowR, reinterpret_cast<float*>(fftOutputR), nullptr, PFFFT_FORWARD );
 
-            // sum the resulting spectrum into the precomputed buckets
-            for ( std::size_t freqBin = 0; freqBin < fftWindowSize / 2; freqBin++ )
-            {
-                const float fftMagL = fftOutputL[freqBin].hypot();
-                const float fftMagR = fftOutputR[freqBin].hypot();
+        std::array< float, 3 > frequencyBuckets;
+        frequencyBuckets.fill( 0 );
+
+        // sum the resulting spectrum into the precomputed buckets
+        for ( std::size_t freqBin = 0; freqBin < fftWindowSize / 2; freqBin++ )
+        {
+            const float fftMagL = fftOutputL[freqBin].hypot();
+            const float fftMagR = fftOutputR[freqBin].hypot();
 
-                const float fftMag  = (fftMagL + fftMagR) * 0.5f; // #hdd average of magnitudes 'correct' here?
+            const float fftMag  = (fftMagL + fftMagR) * 0.5f; // #hdd average of magnitudes 'correct' here?
 
-                frequencyBuckets[processing.m_octaves.getBucketForFFTIndex( freqBin )] += fftMag;
-            }
+            frequencyBuckets[processing.m_octaves.getBucketForFFTIndex( freqBin )] += fftMag;
+        }
 
-            // reduce and normalise the buckets we're interested in
-            {
-                frequencyBuckets[0] *= processing.m_octaves.getRecpSizeOfBucketAt( 0 );
-                frequencyBuckets[0]  = audioSpectrumConfig.headroomNormaliseDb( frequencyBuckets[0] );
+        // reduce and normalise the buckets we're interested in
+        {
+            frequencyBuckets[0] *= processing.m_octaves.getRecpSizeOfBucketAt( 0 );
+            frequencyBuckets[0]  = audioSpectrumConfig.headroomNormaliseDb( frequencyBuckets[0] );
 
-                fftOutLowBand[fftBandLimit] = frequencyBuckets[0];
+            outLowBand[fftBandLimit] = frequencyBuckets[0];
 
-                frequencyBuckets[2] *= processing.m_octaves.getRecpSizeOfBucketAt( 2 );
-                frequencyBuckets[2]  = audioSpectrumConfig.headroomNormaliseDb( frequencyBuckets[2] );
+            frequencyBuckets[2] *= processing.m_octaves.getRecpSizeOfBucketAt( 2 );
+            frequencyBuckets[2]  = audioSpectrumConfig.headroomNormaliseDb( frequencyBuckets[2] );
 
-                fftOutHighBand[fftBandLimit] = frequencyBuckets[2];
-            }
+            outHighBand[fftBandLimit] = frequencyBuckets[2];
         }
     }
 
+    mem::free16( fftInputR );
+    mem::free16( fftInputL );
     mem::free16( fftOutputR );
     mem::free16( fftOutputL );
+}
 
-    const cycfi::q::duration beatFollowDuration( processing.m_tuning.m_beatFollowDuration );
-    const cycfi::q::duration waveFollowDuration( processing.m_tuning.m_waveFollowDuration );
+// ---------------------------------------------------------------------------------------------------------------------
+void Stem::analyseSignalFollowers(
+    AnalysisFollowers& followers,
+    const FollowerPass pass,
+    const int64_t sampleBegin,
+    const int64_t sampleEnd,
+    const int32_t fftWindowSize,
+    const int32_t fftTimeSlices,
+    const float* fftLowBand,
+    const float* fftHighBand,
+    StemAnalysisData& result ) const
+{
+    #define PSA_ENCODE( _v ) static_cast<uint8_t>( std::min( _v * 255.0f, 255.0f ) );
 
-    cycfi::q::peak_envelope_follower     beatFollower(   beatFollowDuration, processing.m_sampleRateF );
-    cycfi::q::fast_rms_envelope_follower waveFollower(   waveFollowDuration, processing.m_sampleRateF );
-    cycfi::q::fast_rms_envelope_follower waveFollowerLF( waveFollowDuration, processing.m_sampleRateF );
-    cycfi::q::fast_rms_envelope_follower waveFollowerHF( waveFollowDuration, processing.m_sampleRateF );
-    cycfi::q::peak peakTracker(
-        processing.m_tuning.m_trackerSensitivity,
-        processing.m_tuning.m_trackerHysteresis );
+    char scBuf[32];
+    base::itoa::i32toa( static_cast<int32_t>( sampleEnd - sampleBegin ), scBuf );
 
+    base::instr::ScopedEvent wte( "Stem::analyse::signal", scBuf, base::instr::PresetColour::Indigo );
 
-    #define PSA_ENCODE( _v ) static_cast<uint8_t>( std::min( _v * 255.0f, 255.0f ) );
+    for ( int64_t sI = sampleBegin; sI < sampleEnd; sI++ )
+    {
+        // one band value per [fftWindowSize] samples, matching how they were computed; as the last block of samples
+        // might not have had the FFT process run (as we just dumbly fit to N x WindowSize) it reuses the final band
+        const int64_t fftBandIndex = std::min< int64_t >( sI / fftWindowSize, fftTimeSlices - 1 );
+
+        // don't imagine max() here is terribly scientific
+        float signalLeft, signalRight;
+        getSamplePair( sI, signalLeft, signalRight );
+
+        const float signalInput     = std::max( signalLeft, signalRight );
+        const float signalFollow    = followers.m_waveFollower( signalInput );
+        const float signalFollowLF  = followers.m_waveFollowerLF( fftLowBand[fftBandIndex] );
+        const float signalFollowHF  = followers.m_waveFollowerHF( fftHighBand[fftBandIndex] );
+
+        float beatPeak = 0;
+
+        // priming just gets the followers up to speed, the tracker only runs once they are
+        if ( pass != FollowerPass::Prime )
+        {
+            if ( followers.m_peakTracker( signalInput, signalFollow ) )
+            {
+                if ( pass == FollowerPass::Output )
+                    result.setBeatAtSample( sI );
+
+                beatPeak = 1.0f;
+            }
+        }
+
+        const float beatFollow = followers.m_beatFollower( beatPeak );
+
+        if ( pass == FollowerPass::Output )
+        {
+            result.m_psaWave[sI]     = PSA_ENCODE( signalFollow   );
+            result.m_psaLowFreq[sI]  = PSA_ENCODE( signalFollowLF );
+            result.m_psaHighFreq[sI] = PSA_ENCODE( signalFollowHF );
+            result.m_psaBeat[sI]     = PSA_ENCODE( beatFollow     );
+        }
+    }
+
+    #undef PSA_ENCODE
+}
 
+// ---------------------------------------------------------------------------------------------------------------------
+// FFT windows are independent, so with a subflow to hand they are simply divided up between tasks, giving identical
+// results to a serial run.
+//
+// the signal followers are another matter; serially, they are primed with one full pass over the stem and then run
+// again to produce the output, so each sample depends on every one before it. long stems are instead cut into
+// chunks, each starting from a fresh set of followers warm-started over a few seconds of the audio just ahead of it
+// (or for the first chunk, the end of the loop, as it would be coming out of the priming pass). that is many times
+// the follower decay times, so envelopes converge on the serial values - but not exactly, as the rms followers
+// keep a running float sum. expect the occasional +/-1 in the 8-bit psa values and, rarely, a beat bit shifted or
+// dropped within the first moments of a chunk. stems too short to make chunking worthwhile are always run serially
+// and so match exactly
+//
+bool Stem::analyseImpl( const Processing& processing, StemAnalysisData& result, tf::Subflow* subflow ) const
+{
+    // such a small stem that we can't really do much? shout out to Blackest Jammmmmmmmmmm for unearthing this
+    if ( m_sampleCount <= processing.m_fftWindowSize )
     {
-        char scBuf[32];
-        base::itoa::i32toa( m_sampleCount, scBuf );
+        blog::stem( "bypassing stem processing, stem C:{} only has {} samples", m_data.couchID, m_sampleCount );
+        return false;
+    }
+
+    // smallest number of FFT windows worth handing to a task
+    static constexpr int32_t    cMinimumWindowsPerTask      = 64;
+    // how far ahead of each chunk the followers are warm-started, as a multiple of the slowest follower duration
+    static constexpr float      cWarmStartDurationScale     = 8.0f;
+
+    const int32_t fftWindowSize = processing.m_fftWindowSize;
+    const int32_t fftTimeSlices = m_sampleCount / fftWindowSize;
+    const int64_t sampleCount   = m_sampleCount;
+
+    // transient frequency band buffers that then get smoothed afterwards
+    auto* fftOutLowBand   = mem::alloc16<float>( fftTimeSlices );
+    auto* fftOutHighBand  = mem::alloc16<float>( fftTimeSlices );
+
+    // prepare the analysis output
+    result.resize( m_sampleCount );
+
+    // ensure the beat bits are fully zeroed out, saves doing it bit-by-bit as beats are found
+    std::fill( result.m_beatBitfield.begin(), result.m_beatBitfield.end(), 0 );
+
+    // slice to match the executor actually running the subflow, not the machine
+    const int64_t workerCount = ( subflow != nullptr ) ? std::max< int64_t >( 1, subflow->executor().num_workers() ) : 1;
 
-        // ensure the beat bits are fully zeroed out, saves doing it bit-by-bit on the first cycle through
-        std::fill( result.m_beatBitfield.begin(), result.m_beatBitfield.end(), 0 );
+    std::vector< std::function< void() > > fftJobs;
+    std::vector< std::function< void() > > signalJobs;
 
-        // run two loops of the signal followers, ensuring that we get a good representation of the looping signal;
-        // this is also when we run peak-finding to get some beats extracted 
-        // NB. in profiling, this pair of loops through the samples is significantly more expensive than the FFT
-        for ( auto cycle = 0; cycle < 2; cycle++ )
+    // -----------------------------------------------------------------------------------------------------------------
+    {
+        const int64_t fftChunkCount = std::clamp< int64_t >( fftTimeSlices / cMinimumWindowsPerTask, 1, workerCount );
+        const int64_t fftChunkSize  = ( fftTimeSlices + fftChunkCount - 1 ) / fftChunkCount;
+
+        for ( int64_t windowBegin = 0; windowBegin < fftTimeSlices; windowBegin += fftChunkSize )
         {
-            base::instr::ScopedEvent wte( "Stem::analyse::signal", scBuf, base::instr::PresetColour::Indigo );
+            const int32_t windowEnd = static_cast<int32_t>( std::min< int64_t >( windowBegin + fftChunkSize, fftTimeSlices ) );
 
-            std::size_t fftBandIndex = 0;
-            for ( int64_t sI = 0, fftI = 0; sI < m_sampleCount; sI++, fftI++ )
-            {
-                // increment [fftBandIndex] every [fftWindowSize] samples, matching how they were computed above
-                if ( fftI == fftWindowSize )
+            fftJobs.emplace_back( [=, this, &processing]()
                 {
-                    fftBandIndex++;
-                    fftI = 0;
+                    analyseFrequencyBands( processing, static_cast<int32_t>( windowBegin ), windowEnd, fftOutLowBand, fftOutHighBand );
+                });
+        }
+    }
 
-                    // as the last block of samples might not have the FFT process run (as we just dumbly fit to N x WindowSize)
-                    // then allow this band index to lock to the top of the allowed limit, just copying the final values from the last bucket
-                    if ( fftBandIndex == fftTimeSlices )
-                        fftBandIndex = fftTimeSlices - 1;
-                }
+    // -----------------------------------------------------------------------------------------------------------------
+    {
+        const std::size_t staircasePeriod = AnalysisFollowers( processing ).getStaircasePeriod();
 
-                // don't imagine max() here is terribly scientific
-                const float signalInput     = std::max( m_channel[0][sI], m_channel[1][sI] );
-                const float signalFollow    = waveFollower( signalInput );
-                const float signalFollowLF  = waveFollowerLF( fftOutLowBand[fftBandIndex] );
-                const float signalFollowHF  = waveFollowerHF( fftOutHighBand[fftBandIndex] );
+        const float   warmStartSeconds  = std::max( processing.m_tuning.m_beatFollowDuration, processing.m_tuning.m_waveFollowDuration ) * cWarmStartDurationScale;
+        const int64_t warmStartBase     = static_cast<int64_t>( std::ceil( warmStartSeconds * processing.m_sampleRateF ) );
 
-                float beatPeak = 0;
+        // chunk starts are aligned to whole FFT windows, which also keeps each chunk's beat bits in their own words
+        const int64_t chunkAlignment    = std::max< int64_t >( fftWindowSize, int64_t( 1 ) << StemAnalysisData::BeatBitsShift );
+        const int64_t minimumChunkSize  = 2 * ( warmStartBase + static_cast<int64_t>( staircasePeriod ) );
 
-                if ( cycle == 0 )
-                {
-                    // do nothing on the first pass, m_beatBitfield has been cleared before and will only be set
-                    // once we've had the followers primed by the first pass
-                }
-                // run the tracker on second pass
-                else
+        const int64_t signalChunkCount  = std::clamp< int64_t >( sampleCount / minimumChunkSize, 1, workerCount );
+
+        if ( signalChunkCount <= 1 )
+        {
+            signalJobs.emplace_back( [=, this, &processing, &result]()
                 {
-                    result.m_psaWave[sI]     = PSA_ENCODE( signalFollow   );
-                    result.m_psaLowFreq[sI]  = PSA_ENCODE( signalFollowLF );
-                    result.m_psaHighFreq[sI] = PSA_ENCODE( signalFollowHF );
+                    AnalysisFollowers followers( processing );
+
+                    // run two loops of the signal followers, ensuring that we get a good representation of the looping signal;
+                    // this is also when we run peak-finding to get some beats extracted
+                    // NB. in profiling, this pair of loops through the samples is significantly more expensive than the FFT
+                    analyseSignalFollowers( followers, FollowerPass::Prime,  0, sampleCount, fftWindowSize, fftTimeSlices, fftOutLowBand, fftOutHighBand, result );
+                    analyseSignalFollowers( followers, FollowerPass::Output, 0, sampleCount, fftWindowSize, fftTimeSlices, fftOutLowBand, fftOutHighBand, result );
+                });
+        }
+        else
+        {
+            const int64_t signalChunkSize = ( ( ( sampleCount + signalChunkCount - 1 ) / signalChunkCount ) + chunkAlignment - 1 ) / chunkAlignment * chunkAlignment;
+
+            for ( int64_t chunkBegin = 0; chunkBegin < sampleCount; chunkBegin += signalChunkSize )
+            {
+                const int64_t chunkEnd = std::min( chunkBegin + signalChunkSize, sampleCount );
+
+                // a serial run has stepped the followers over the whole priming pass and then up to chunkBegin
+                const int64_t samplesBeforeChunk = sampleCount + chunkBegin;
+                const int64_t warmStartLength    = warmStartBase + ( ( samplesBeforeChunk - warmStartBase ) % static_cast<int64_t>( staircasePeriod ) );
 
-                    if ( peakTracker( signalInput, signalFollow ) )
+                signalJobs.emplace_back( [=, this, &processing, &result]()
                     {
-                        result.setBeatAtSample( sI );
-                        beatPeak = 1.0f;
-                    }
-                }
+                        AnalysisFollowers followers( processing );
 
-                result.m_psaBeat[sI] = PSA_ENCODE( beatFollower( beatPeak ) );
+                        // the first chunk follows on from the priming pass, so warm up on the tail of the loop without
+                        // beat tracking; anything later is warmed up exactly as the output pass would have run
+                        if ( chunkBegin == 0 )
+                            analyseSignalFollowers( followers, FollowerPass::Prime, sampleCount - warmStartLength, sampleCount, fftWindowSize, fftTimeSlices, fftOutLowBand, fftOutHighBand, result );
+                        else
+                            analyseSignalFollowers( followers, FollowerPass::Track, chunkBegin - warmStartLength, chunkBegin, fftWindowSize, fftTimeSlices, fftOutLowBand, fftOutHighBand, result );
+
+                        analyseSignalFollowers( followers, FollowerPass::Output, chunkBegin, chunkEnd, fftWindowSize, fftTimeSlices, fftOutLowBand, fftOutHighBand, result );
+                    });
             }
         }
     }
 
-    #undef PSA_ENCODE
+    // -----------------------------------------------------------------------------------------------------------------
+    // with only one of each, there's nothing to be gained from spinning up tasks
+    if ( subflow != nullptr && ( fftJobs.size() > 1 || signalJobs.size() > 1 ) )
+    {
+        tf::Task fftComplete = subflow->placeholder();
+
+        for ( auto& fftJob : fftJobs )
+            subflow->emplace( std::move( fftJob ) ).precede( fftComplete );
+
+        for ( auto& signalJob : signalJobs )
+            subflow->emplace( std::move( signalJob ) ).succeed( fftComplete );
+
+        subflow->join();
+    }
+    else
+    {
+        for ( auto& fftJob : fftJobs )
+            fftJob();
+        for ( auto& signalJob : signalJobs )
+            signalJob();
+    }
 
     mem::free16( fftOutHighBand );
     mem::free16( fftOutLowBand );
@@ -954,6 +1582,15 @@ bool Stem::analyse( const Processing& processing )
     return result;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+bool Stem::analyse( const Processing& processing, tf::Subflow& subflow )
+{
+    const bool result = analyse( processing, m_analysisData, subflow );
+    m_analysisState = result ? AnalysisState::AnalysisValid : AnalysisState::AnalysisEmpty;
+
+    return result;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 Stem::RawAudioMemory::RawAudioMemory( size_t size )
     : m_rawLength( size )
@@ -974,13 +1611,20 @@ Stem::RawAudioMemory::~RawAudioMemory()
 // ---------------------------------------------------------------------------------------------------------------------
 void Stem::RawAudioMemory::allocate( size_t newSize )
 {
-    ABSL_ASSERT( m_rawReceived == 0 );
+    uint8_t* newRawAudio = mem::alloc16To< uint8_t >( newSize + 4, 0 );   // +4 supports header read check in worst case of empty buf
+
+    // carry over anything already received, eg. from a partial download that's being resumed
+    m_rawReceived = std::min( m_rawReceived, newSize );
+    if ( m_rawAudio != nullptr )
+    {
+        if ( m_rawReceived > 0 )
+            memcpy( newRawAudio, m_rawAudio, m_rawReceived );
 
-    if ( m_rawAudio == nullptr )
         mem::free16( m_rawAudio );
+    }
 
     m_rawLength = newSize;
-    m_rawAudio = mem::alloc16To< uint8_t >( m_rawLength + 4, 0 );   // +4 supports header read check in worst case of empty buf
+    m_rawAudio  = newRawAudio;
 }
 
 } // namespace live
@@ -16,6 +16,8 @@
 
 struct PFFFT_Setup;
 
+namespace io { struct MountedTar; }
+
 namespace config { namespace endlesss { struct rAPI; } }
 
 namespace endlesss {
@@ -124,6 +126,14 @@ struct Stem
         Failed_CacheDirectory,      // failed to create or interact with the stem cache
     };
 
+    // how decoded samples are held in memory once loading is complete; compact storage halves the footprint
+    // of each stem (source data is 16-bit anyway) at the cost of a conversion back to float as samples are read
+    enum class SampleStorage
+    {
+        Float32,
+        Int16
+    };
+
     enum class AnalysisState
     {
         InProgress,                 // data is being processed in the background
@@ -163,19 +173,45 @@ struct Stem
     static Processing::UPtr createStemProcessing( const uint32_t targetSampleRate );
 
 
-    Stem( const types::Stem& stemData, const uint32_t targetSampleRate );
+    Stem( const types::Stem& stemData, const uint32_t targetSampleRate, const SampleStorage sampleStorage = SampleStorage::Float32 );
     ~Stem();
 
 
     // instigate a fetch of the stem data from either the cache or the network
     // note this is a blocking call and is designed to be called from a background thread in most cases
-    void fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath );
+    // if archivedData is provided, it is the compressed stem read from a mounted archive; it is decoded in place and
+    // neither the cache directory nor the network are touched
+    void fetch( const api::NetConfiguration& ncfg, const fs::path& cachePath, std::span< const uint8_t > archivedData = {} );
+
+    // fetch() is these two halves run back to back; split so that the blocking cache / network side can run on the
+    // I/O executor and the decoding on the compute one. fetchCompressed() returns true if the compressed data was
+    // acquired, in which case decodeFetched() must be called next to finish the job; on false, m_state holds the failure.
+    // as decoding happens later, possibly on another thread, pass the archive that archivedData points into so it can
+    // be kept mounted until then
+    ouro_nodiscard bool fetchCompressed(
+        const api::NetConfiguration& ncfg,
+        const fs::path& cachePath,
+        std::span< const uint8_t > archivedData = {},
+        std::shared_ptr< io::MountedTar > archive = {} );
+    void decodeFetched();
+
+    // download the compressed stem data straight into the cache without decoding, resampling or analysing it; the only
+    // validation is the size check against the database and that the data starts with a container header we recognise.
+    // for bulk cache filling where building a full live Stem would just be thrown away. blocking, as with fetch()
+    // returns State::Complete on success, otherwise the failure state a full fetch() would have ended in, with the
+    // HTTP status written to httpStatus where relevant
+    static State downloadToCache( const api::NetConfiguration& ncfg, const types::Stem& stemData, const fs::path& cachePath, uint32_t& httpStatus );
 
     // run analysis pass, producing things like onsets / peak-following / etc into the given result;
     // this result is passed as an argument so that we can also run this in debug tools to tune the processing
     bool analyse( const Processing& processing, StemAnalysisData& result ) const;
     bool analyse( const Processing& processing );   // convenience function that calls the above on current instance, also then toggling m_hasValidAnalysis
 
+    // as above, but long stems are split into chunks analysed by tasks spawned on the given subflow, which is joined
+    // before returning; see analyseImpl() for how results can differ from the serial version
+    bool analyse( const Processing& processing, StemAnalysisData& result, tf::Subflow& subflow ) const;
+    bool analyse( const Processing& processing, tf::Subflow& subflow );
+
 
     // stem needs a copy of the analysis task future to ensure that in the unlikely case
     // of destruction arriving before the task is done, we wait to avoid the analysis working with a deleted object
@@ -205,6 +241,30 @@ struct Stem
         return m_compressionFormat;
     }
 
+    ouro_nodiscard constexpr SampleStorage getSampleStorage() const
+    {
+        return m_sampleStorage;
+    }
+
+    // read a single stereo sample pair, converting from compact storage if required
+    inline void getSamplePair( const std::size_t sampleIndex, float& left, float& right ) const
+    {
+        if ( m_sampleStorage == SampleStorage::Int16 )
+        {
+            left  = static_cast<float>( m_channelCompact[0][sampleIndex] ) * cInt16ToFloat;
+            right = static_cast<float>( m_channelCompact[1][sampleIndex] ) * cInt16ToFloat;
+        }
+        else
+        {
+            left  = m_channel[0][sampleIndex];
+            right = m_channel[1][sampleIndex];
+        }
+    }
+
+    // fill a block of output samples from the given list of sample indices; the storage format is resolved once
+    // for the whole block rather than per-sample, leaving tight loops for the compiler to vectorise
+    void gatherSamples( const uint32_t* sampleIndices, const uint32_t sampleCount, float* outLeft, float* outRight ) const;
+
     ouro_nodiscard inline std::size_t estimateMemoryUsageBytes() const
     {
         std::size_t result = sizeof( Stem );
@@ -213,7 +273,8 @@ struct Stem
             return result;
 
         // buffer data
-        result += ( static_cast<std::size_t>(m_sampleCount) * 2 ) * sizeof( float );
+        const std::size_t bytesPerSample = ( m_sampleStorage == SampleStorage::Int16 ) ? sizeof( int16_t ) : sizeof( float );
+        result += ( static_cast<std::size_t>(m_sampleCount) * 2 ) * bytesPerSample;
 
         // add analysis chunk if it is ready
         if ( getAnalysisState() == AnalysisState::AnalysisValid )
@@ -247,15 +308,76 @@ private:
 
     // make an attempt to download the stem from the Endlesss CDN; this may fail and that may be because the CDN
     // hasn't actually got the data yet - so we can call this function repeatedly to see if success is possible 
-    // after a little delay
-    // returns false if something broke; sets the m_state appropriately in that case
-    ouro_nodiscard bool attemptRemoteFetch( const api::NetConfiguration& ncfg, const uint32_t attemptUID, RawAudioMemory& audioMemory );
+    // after a little delay. if audioMemory already holds some received data, only the remainder is requested
+    // returns false if something broke; sets state (and httpStatus, if useful) appropriately in that case
+    ouro_nodiscard static bool attemptRemoteFetch(
+        const api::NetConfiguration& ncfg,
+        const types::Stem& stemData,
+        const uint32_t attemptUID,
+        RawAudioMemory& audioMemory,
+        State& state,
+        uint32_t& httpStatus );
+
+    // call attemptRemoteFetch repeatedly with increasing, jittered delays between tries; each retry continues from
+    // wherever the last one got to. if all attempts fail, what was received is kept in a .resume file alongside
+    // cacheFile so the next fetch of this stem can resume rather than start again
+    ouro_nodiscard static bool fetchRemoteWithRetries(
+        const api::NetConfiguration& ncfg,
+        const types::Stem& stemData,
+        const fs::path& cacheFile,
+        RawAudioMemory& audioMemory,
+        State& state,
+        uint32_t& httpStatus );
+
+    // move freshly downloaded data into the cache; written to a temporary then renamed over cacheFile, never rewritten
+    // in place, as other stems may have the existing file mapped (see FetchedData). a cache file that is already there
+    // at the right size is left alone, its contents are the same stem. failures are logged, returns false
+    static bool writeToCache(
+        const fs::path& cacheFile,
+        const RawAudioMemory& audioMemory,
+        const std::string& stemCouchSnip );
 
     // blend a small window of samples at each end of the stem to reduce clicks on looping
     // (as best we can tell Endlesss also does something like this)
     void applyLoopSewingBlend();
 
+    // if requested, convert the decoded float channels down to SampleStorage::Int16 and release the originals
+    void applySampleStorageCompaction();
+
+    // analysis is split into two phases; FFT band extraction, where each window is independent, and then running
+    // a set of signal followers over every sample, which carry state from one sample to the next
+    struct AnalysisFollowers;
+    enum class FollowerPass
+    {
+        Prime,                      // step the followers only, with no beat tracking
+        Track,                      // step followers and beat tracking, but write nothing out
+        Output                      // as Track, also writing into the analysis result
+    };
+
+    bool analyseImpl( const Processing& processing, StemAnalysisData& result, tf::Subflow* subflow ) const;
+
+    // compute low and high frequency band values for FFT windows [windowBegin, windowEnd)
+    void analyseFrequencyBands( const Processing& processing, const int32_t windowBegin, const int32_t windowEnd, float* outLowBand, float* outHighBand ) const;
+
+    // run the given followers over samples [sampleBegin, sampleEnd)
+    void analyseSignalFollowers(
+        AnalysisFollowers& followers,
+        const FollowerPass pass,
+        const int64_t sampleBegin,
+        const int64_t sampleEnd,
+        const int32_t fftWindowSize,
+        const int32_t fftTimeSlices,
+        const float* fftLowBand,
+        const float* fftHighBand,
+        StemAnalysisData& result ) const;
+
+    static constexpr float          cInt16ToFloat = 1.0f / 32768.0f;
+    static constexpr float          cFloatToInt16 = 32768.0f;
+
+
 
+    struct FetchedData;
+    std::unique_ptr< FetchedData >  m_fetched;      // handed from fetchCompressed() to decodeFetched()
 
     std::shared_future<void>        m_analysisFuture;
     std::atomic< AnalysisState >    m_analysisState; // set in async analysis if analysis data is to be trusted
@@ -271,7 +393,9 @@ public:
 
     uint32_t                        m_sampleRate;
     int32_t                         m_sampleCount;
-    std::array<float*, 2>           m_channel;
+    const SampleStorage             m_sampleStorage;
+    std::array<float*, 2>           m_channel;              // sample data when using SampleStorage::Float32, otherwise null
+    std::array<int16_t*, 2>         m_channelCompact;       // sample data when using SampleStorage::Int16, otherwise null
 
 private:
     StemAnalysisData                m_analysisData;
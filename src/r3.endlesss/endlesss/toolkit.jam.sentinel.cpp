@@ -22,8 +22,11 @@ Sentinel::Sentinel( const services::RiffFetchProvider& riffFetchProvider, const
     : m_riffFetchProvider( riffFetchProvider )
     , m_runThread( false )
     , m_threadFailed( false )
+    , m_threadFinished( true )
     , m_callback( riffLoadCallback )
     , m_pollRateDelaySecs( riffFetchProvider->getNetConfiguration().api().jamSentinelPollRateInSeconds )
+    , m_useLongpoll( riffFetchProvider->getNetConfiguration().api().jamSentinelUseLongpoll )
+    , m_longpollTimeoutSecs( std::max( 1, riffFetchProvider->getNetConfiguration().api().jamSentinelLongpollTimeoutInSeconds ) )
 {
 }
 
@@ -36,88 +39,207 @@ Sentinel::~Sentinel()
 // ---------------------------------------------------------------------------------------------------------------------
 void Sentinel::startTracking( const types::Jam& jamToTrack )
 {
-    if ( m_runThread )
-    {
-        stopTracking();
-    }
+    stopTracking();
 
     blog::app( FMTX( "[ SNTL ] starting jam tracker thread @ {} [{}]" ), jamToTrack.displayName, jamToTrack.couchID );
-    blog::app( FMTX( "[ SNTL ] manual polling every {} seconds" ), m_pollRateDelaySecs );
+    if ( m_useLongpoll )
+        blog::app( FMTX( "[ SNTL ] using longpoll changes feed, {} second timeout" ), m_longpollTimeoutSecs );
+    else
+        blog::app( FMTX( "[ SNTL ] manual polling every {} seconds" ), m_pollRateDelaySecs );
 
     m_trackedJam    = jamToTrack;
 
-    m_runThread     = true;
-    m_threadFailed  = false;
+    m_runThread         = true;
+    m_threadFailed      = false;
+    m_threadFinished    = false;
     m_thread        = std::make_unique<std::thread>( &Sentinel::sentinelThreadLoop, this );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 void Sentinel::stopTracking()
 {
-    if ( m_runThread )
+    // the thread may have already given up on its own (see m_threadFailed) but it still needs joining
+    if ( m_thread != nullptr )
     {
         blog::app( FMTX( "[ SNTL ] halting jam tracker ..." ) );
 
         m_runThread = false;
+
+        // kick any blocking longpoll request loose so we don't have to wait out the server timeout; stop() has no
+        // effect on a client that hasn't opened its socket yet, so keep at it until the thread has actually finished
+        while ( !m_threadFinished )
+        {
+            {
+                std::scoped_lock<std::mutex> clientLock( m_longpollClientMutex );
+                if ( m_longpollClient != nullptr )
+                    m_longpollClient->stop();
+            }
+            std::this_thread::sleep_for( 50ms );
+        }
+
         m_thread->join();
         m_thread = nullptr;
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+bool Sentinel::sentinelThreadWait( const std::chrono::milliseconds duration ) const
+{
+    // we chunk up the sleep so the thread can die more reactively
+    auto remaining = duration;
+    while ( remaining.count() > 0 )
+    {
+        const auto step = std::min( remaining, std::chrono::milliseconds( 250 ) );
+        std::this_thread::sleep_for( step );
+        remaining -= step;
+
+        if ( !m_runThread )
+            return false;
+    }
+    return m_runThread;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Sentinel::sentinelThreadFetchChanges( endlesss::api::JamChanges& jamChange )
+{
+    const auto& netConfig = m_riffFetchProvider->getNetConfiguration();
+
+    if ( m_useLongpoll )
+    {
+        return jamChange.fetchLongpoll(
+            netConfig,
+            m_trackedJam.couchID,
+            m_lastSeenSequence,
+            std::chrono::seconds( m_longpollTimeoutSecs ),
+            [this]( httplib::Client* client ) -> bool
+            {
+                std::scoped_lock<std::mutex> clientLock( m_longpollClientMutex );
+
+                // stopTracking() may already be underway; don't start a wait it would only have to come and break
+                if ( client != nullptr && !m_runThread )
+                {
+                    m_longpollClient = nullptr;
+                    return false;
+                }
+
+                m_longpollClient = client;
+                return true;
+            });
+    }
+    else
+    {
+        // every N seconds, fetch changes again
+        if ( !sentinelThreadWait( std::chrono::seconds( m_pollRateDelaySecs ) ) )
+            return false;
+
+        return jamChange.fetchSince( netConfig, m_trackedJam.couchID, m_lastSeenSequence );
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 void Sentinel::sentinelThreadLoop()
 {
-    OuroveonThreadScope ots( "JamSentinel" );
+    OuroveonThreadScope ots( OURO_THREAD_PREFIX "JamSentinel" );
 
-    // now we should be doing this with couch longpoll and such but ah well
-    // pull the current sequence ID
+    // stopTracking() waits on this rather than the join so it can keep poking the longpoll client in the meantime
+    absl::Cleanup markFinished = [this]() noexcept { m_threadFinished = true; };
+
+    const auto& netConfig = m_riffFetchProvider->getNetConfiguration();
+
+    int32_t                     failureCount = 0;
+    std::chrono::milliseconds   reconnectBackoff = cReconnectBackoffInit;
+
+    // returns false if we've run out of patience and the thread should bail
+    const auto handleFailure = [&]( std::string_view context ) -> bool
     {
-        endlesss::api::JamChanges jamChange;
-        if ( !jamChange.fetch( m_riffFetchProvider->getNetConfiguration(), m_trackedJam.couchID ) )
+        failureCount++;
+        if ( failureCount >= cReconnectAttemptLimit )
         {
+            blog::error::app( FMTX( "[ SNTL ] {} failed {} times in a row, aborting tracker thread" ), context, failureCount );
             m_threadFailed = true;
-            return;
+            m_runThread = false;
+            return false;
         }
 
-        m_lastSeenSequence = jamChange.last_seq;
-        blog::app( FMTX( "[ SNTL ] captured initial change sequence" ) );
+        blog::app( FMTX( "[ SNTL ] {} failed, retrying in {}ms ({}/{})" ), context, reconnectBackoff.count(), failureCount, cReconnectAttemptLimit );
+        if ( !sentinelThreadWait( reconnectBackoff ) )
+            return false;
 
-        // initial arrival, trigger callback
-        sentinelThreadFetchLatest();
+        reconnectBackoff = std::min( reconnectBackoff * 2, cReconnectBackoffMax );
+        return true;
+    };
+    const auto handleSuccess = [&]()
+    {
+        failureCount = 0;
+        reconnectBackoff = cReconnectBackoffInit;
+    };
+
+    // pull the current sequence ID
+    for ( ;; )
+    {
+        endlesss::api::JamChanges jamChange;
+        if ( jamChange.fetch( netConfig, m_trackedJam.couchID ) )
+        {
+            m_lastSeenSequence = jamChange.last_seq;
+            blog::app( FMTX( "[ SNTL ] captured initial change sequence" ) );
+            handleSuccess();
+            break;
+        }
+        if ( !handleFailure( "initial fetch()" ) )
+            return;
     }
 
-    // every N seconds, fetch the riff again and trigger if we see a new sequence ID
+    // initial arrival, trigger callback
+    sentinelThreadFetchLatest();
+
+    // wait on the changes feed and trigger if we see a new sequence ID
     // note this can be a chat message or whatnot, it's just tracking the database shifting 
     while ( m_runThread )
     {
-        // we chunk up the polling sleep so the thread can die more reactively
-        const int32_t waitStepSubdiv = 1 + ( m_pollRateDelaySecs * 4 );
-        for ( int waitSteps = 0; waitSteps < waitStepSubdiv; waitSteps++ )
+        endlesss::api::JamChanges jamChange;
+        if ( !sentinelThreadFetchChanges( jamChange ) )
         {
-            std::this_thread::sleep_for( 250ms );
+            // stopTracking() aborting an in-flight request is not a failure
             if ( !m_runThread )
                 return;
-        }
 
-        endlesss::api::JamChanges jamChange;
-        if ( !jamChange.fetchSince( m_riffFetchProvider->getNetConfiguration(), m_trackedJam.couchID, m_lastSeenSequence ) )
-        {
-            blog::app( FMTX( "[ SNTL ] fetchSince() failed, aborting tracker thread" ) );
-            m_threadFailed = true;
-            m_runThread = false;
-            return;
+            if ( !handleFailure( "changes feed" ) )
+                return;
+
+            continue;
         }
+        handleSuccess();
 
-        const auto numberOfNewSeq = jamChange.results.size();
-        const bool difference = ( numberOfNewSeq > 0 ) && 
+        // longpoll timed out with nothing new, just re-arm
+        const bool difference = ( jamChange.results.empty() == false ) &&
                                 ( jamChange.last_seq != m_lastSeenSequence );
-        if ( difference )
+        if ( !difference )
         {
-            blog::app( FMTX( "[ SNTL ] {} change(s) detected" ), numberOfNewSeq );
-            sentinelThreadFetchLatest();
+            if ( !jamChange.last_seq.empty() )
+                m_lastSeenSequence = jamChange.last_seq;
+            continue;
         }
 
+        auto numberOfNewSeq = jamChange.results.size();
         m_lastSeenSequence = jamChange.last_seq;
+
+        // a new riff lands as a handful of separate documents; give the burst a moment to finish arriving and
+        // then sweep up anything else that turned up so it all gets answered with one fetch
+        if ( !sentinelThreadWait( cChangeSettleWindow ) )
+            return;
+
+        endlesss::api::JamChanges trailingChanges;
+        if ( trailingChanges.fetchSince( netConfig, m_trackedJam.couchID, m_lastSeenSequence ) )
+        {
+            if ( !trailingChanges.last_seq.empty() )
+            {
+                numberOfNewSeq += trailingChanges.results.size();
+                m_lastSeenSequence = trailingChanges.last_seq;
+            }
+        }
+
+        blog::app( FMTX( "[ SNTL ] {} change(s) detected" ), numberOfNewSeq );
+        sentinelThreadFetchLatest();
     }
 }
 
@@ -126,8 +248,6 @@ void Sentinel::sentinelThreadFetchLatest()
 {
     //riffSyncInProgress = true;
 
-    std::this_thread::sleep_for( 1000ms );
-
     // get the current riff from the jam
     endlesss::api::pull::LatestRiffInJam latestRiff( m_trackedJam.couchID, m_trackedJam.displayName );
 
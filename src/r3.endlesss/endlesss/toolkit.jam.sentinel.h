@@ -17,14 +17,18 @@
 #include "endlesss/live.riff.h"
 
 namespace endlesss {
-namespace api { struct NetConfiguration; }
+namespace api { struct NetConfiguration; struct JamChanges; }
 namespace toolkit {
 
 // ---------------------------------------------------------------------------------------------------------------------
 // watching jams, watching jams, it's a jam watcher
 //
-// the better approach would be to use longpoll couch connections to avoid polling, but for now
-// we just poke the server every N seconds and see what it's thinking; keep this high enough to not be a bother
+// holds open a longpoll couch _changes request against the tracked jam, tracking the `since` sequence so we wake up
+// as soon as anything in the database shifts. bursts of changes (a riff commit tends to arrive as several documents)
+// are gathered up over a short settling window and answered with a single fetch + callback. dropped connections
+// are re-armed with exponential backoff; only after a run of consecutive failures is the tracker marked as broken
+//
+// if longpoll is disabled in the API config, falls back to poking the server every N seconds instead
 //
 struct Sentinel
 {
@@ -33,6 +37,14 @@ struct Sentinel
     // callback fired when there's a new riff in town
     using RiffLoadCallback = std::function<void( endlesss::live::RiffPtr& riffPtr )>;
 
+    // how long to let a burst of changes settle before we go and fetch the latest riff
+    static constexpr std::chrono::milliseconds  cChangeSettleWindow     = std::chrono::milliseconds( 750 );
+
+    // reconnection backoff, doubling from initial up to max on each consecutive failure
+    static constexpr std::chrono::milliseconds  cReconnectBackoffInit   = std::chrono::milliseconds( 500 );
+    static constexpr std::chrono::milliseconds  cReconnectBackoffMax    = std::chrono::seconds( 30 );
+    static constexpr int32_t                    cReconnectAttemptLimit  = 8;
+
     Sentinel( const services::RiffFetchProvider& riffFetchProvider, const RiffLoadCallback& riffLoadCallback );
     ~Sentinel();
 
@@ -47,16 +59,29 @@ private:
     void sentinelThreadLoop();
     void sentinelThreadFetchLatest();
 
+    // sleep for the given duration in small steps, returns false if the thread was asked to stop in the meantime
+    bool sentinelThreadWait( const std::chrono::milliseconds duration ) const;
+
+    // fetch whatever changed since m_lastSeenSequence, blocking on longpoll if enabled
+    bool sentinelThreadFetchChanges( endlesss::api::JamChanges& jamChange );
+
     services::RiffFetchProvider         m_riffFetchProvider;
     types::Jam                          m_trackedJam;
 
     std::unique_ptr< std::thread >      m_thread;
     std::atomic_bool                    m_runThread;
     std::atomic_bool                    m_threadFailed;
+    std::atomic_bool                    m_threadFinished;   // set as sentinelThreadLoop() exits, however it exits
     std::string                         m_lastSeenSequence;
     endlesss::types::RiffCouchID        m_lastFetchedRiffCouchID;
     RiffLoadCallback                    m_callback;
     int32_t                             m_pollRateDelaySecs;
+    bool                                m_useLongpoll;
+    int32_t                             m_longpollTimeoutSecs;
+
+    // the in-flight longpoll client, if any; stopTracking() will stop() it to unblock the thread
+    std::mutex                          m_longpollClientMutex;
+    httplib::Client*                    m_longpollClient = nullptr;
 };
 
 } // namespace toolkit
@@ -11,6 +11,8 @@
 #include "endlesss/toolkit.population.h"
 #include "endlesss/config.h"
 
+#include "base/text.transform.h"
+
 
 namespace endlesss {
 namespace toolkit {
@@ -63,5 +65,250 @@ bool PopulationQuery::prefixQuery( const std::string_view prefix, Result& result
     return result.m_validCount > 0;
 }
 
+namespace {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// fixed header at the front of the compiled population file; the source file size and write time are stashed so that
+// a newer JSON snapshot (eg. from an app update) causes a rebuild
+struct CompiledPopulationHeader
+{
+    static constexpr uint32_t cMagic    = 0x504F5055;   // 'UPOP'
+    static constexpr uint32_t cVersion  = 1;
+
+    uint32_t    m_magic         = cMagic;
+    uint32_t    m_version       = cVersion;
+    uint64_t    m_sourceSize    = 0;
+    int64_t     m_sourceTime    = 0;
+    uint32_t    m_stringBytes   = 0;
+    uint32_t    m_jamCount      = 0;
+    uint32_t    m_userCount     = 0;
+    uint32_t    m_userJamCount  = 0;
+};
+
+template< typename _T >
+void writeArray( std::ofstream& ofs, const std::vector< _T >& data )
+{
+    ofs.write( reinterpret_cast<const char*>( data.data() ), data.size() * sizeof( _T ) );
+}
+
+template< typename _T >
+bool readArray( std::ifstream& ifs, std::vector< _T >& data, const std::size_t count )
+{
+    data.resize( count );
+    ifs.read( reinterpret_cast<char*>( data.data() ), count * sizeof( _T ) );
+    return ifs.good();
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status PopulationPublicsIndex::load( const config::IPathProvider& pathProvider )
+{
+    m_valid = false;
+
+    const fs::path sourceFile = config::getFullPath< config::endlesss::PopulationPublics >( pathProvider );
+
+    std::error_code sourceError;
+    const uint64_t sourceSize = fs::file_size( sourceFile, sourceError );
+    if ( sourceError )
+        return absl::NotFoundError( fmt::format( FMTX( "unable to find population data [{}] ({})" ), sourceFile.string(), sourceError.message() ) );
+
+    const int64_t sourceTime = fs::last_write_time( sourceFile, sourceError ).time_since_epoch().count();
+
+    fs::path compiledFile = pathProvider.getPath( config::IPathProvider::PathFor::SharedConfig );
+    compiledFile.append( cFilename );
+
+    if ( fs::exists( compiledFile ) )
+    {
+        const auto compiledStatus = loadCompiled( compiledFile, sourceSize, sourceTime );
+        if ( compiledStatus.ok() )
+            return compiledStatus;
+
+        blog::cache( FMTX( "rebuilding compiled population data; {}" ), compiledStatus.message() );
+    }
+
+    return compileFromSource( pathProvider, compiledFile, sourceSize, sourceTime );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::span< const PopulationPublicsIndex::UserJam > PopulationPublicsIndex::findUserContributions( const std::string_view username ) const
+{
+    if ( !m_valid )
+        return {};
+
+    // binary search the sorted username table
+    std::size_t lo = 0;
+    std::size_t hi = m_userJamStart.size() - 1;
+    while ( lo < hi )
+    {
+        const std::size_t mid = lo + ( ( hi - lo ) / 2 );
+        const int32_t order = getString( m_userNameOffsets, (uint32_t)mid ).compare( username );
+
+        if ( order == 0 )
+            return std::span< const UserJam >( m_userJams.data() + m_userJamStart[mid], m_userJamStart[mid + 1] - m_userJamStart[mid] );
+
+        if ( order < 0 )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return {};
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status PopulationPublicsIndex::loadCompiled( const fs::path& compiledFile, const uint64_t sourceSize, const int64_t sourceTime )
+{
+    std::ifstream ifs( compiledFile, std::ios::in | std::ios::binary );
+    if ( !ifs.is_open() )
+        return absl::UnavailableError( "cannot open compiled file" );
+
+    CompiledPopulationHeader header;
+    ifs.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+
+    if ( !ifs.good() ||
+         header.m_magic != CompiledPopulationHeader::cMagic ||
+         header.m_version != CompiledPopulationHeader::cVersion )
+        return absl::DataLossError( "compiled file has unknown format" );
+
+    if ( header.m_sourceSize != sourceSize ||
+         header.m_sourceTime != sourceTime )
+        return absl::FailedPreconditionError( "source data has changed" );
+
+    const bool bReadOk =
+        readArray( ifs, m_strings,          header.m_stringBytes )      &&
+        readArray( ifs, m_jamIDOffsets,     header.m_jamCount + 1 )     &&
+        readArray( ifs, m_jamNameOffsets,   header.m_jamCount + 1 )     &&
+        readArray( ifs, m_jamRiffsScanned,  header.m_jamCount )         &&
+        readArray( ifs, m_userNameOffsets,  header.m_userCount + 1 )    &&
+        readArray( ifs, m_userJamStart,     header.m_userCount + 1 )    &&
+        readArray( ifs, m_userJams,         header.m_userJamCount );
+
+    if ( !bReadOk )
+        return absl::DataLossError( "compiled file is truncated" );
+
+    blog::cache( FMTX( "loaded compiled population data, {} jams / {} users" ), header.m_jamCount, header.m_userCount );
+
+    m_valid = true;
+    return absl::OkStatus();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status PopulationPublicsIndex::compileFromSource(
+    const config::IPathProvider& pathProvider,
+    const fs::path& compiledFile,
+    const uint64_t sourceSize,
+    const int64_t sourceTime )
+{
+    config::endlesss::PopulationPublics populationData;
+    const auto dataLoad = config::load( pathProvider, populationData );
+    if ( dataLoad != config::LoadResult::Success )
+    {
+        return absl::UnavailableError( fmt::format( FMTX( "unable to load {} ({})" ),
+            config::endlesss::PopulationPublics::StorageFilename,
+            config::LoadResultToString( dataLoad ) ) );
+    }
+
+    // order jams by name, lowercasing each one once up-front rather than inside the sort
+    struct JamEntry
+    {
+        const std::string*                                          m_jamID;
+        const config::endlesss::PopulationPublics::JamScan*         m_scan;
+        std::string                                                 m_sortName;
+    };
+    std::vector< JamEntry > jamEntries;
+    jamEntries.reserve( populationData.jampop.size() );
+    for ( const auto& jamPair : populationData.jampop )
+    {
+        jamEntries.emplace_back( JamEntry{ &jamPair.first, &jamPair.second, base::StrToLwrExt( jamPair.second.jam_name ) } );
+    }
+    std::sort( jamEntries.begin(), jamEntries.end(), []( const JamEntry& lhs, const JamEntry& rhs ) -> bool
+        {
+            return lhs.m_sortName < rhs.m_sortName;
+        });
+
+    m_strings.clear();
+    m_jamIDOffsets.clear();
+    m_jamNameOffsets.clear();
+    m_jamRiffsScanned.clear();
+    m_userNameOffsets.clear();
+    m_userJamStart.clear();
+    m_userJams.clear();
+
+    const auto internString = [this]( const std::string_view str, std::vector< uint32_t >& offsets )
+        {
+            offsets.emplace_back( (uint32_t)m_strings.size() );
+            m_strings.insert( m_strings.end(), str.begin(), str.end() );
+        };
+
+    // lay out jam data, inverting the per-jam user maps as we go; walking jams in index order means each
+    // user's contribution list comes out already sorted by jam name
+    absl::flat_hash_map< std::string_view, std::vector< UserJam > > contributionsByUser;
+
+    // jam IDs and names are interned in two passes so each offset table stays contiguous
+    for ( const auto& jamEntry : jamEntries )
+        internString( *jamEntry.m_jamID, m_jamIDOffsets );
+    m_jamIDOffsets.emplace_back( (uint32_t)m_strings.size() );
+
+    for ( uint32_t jamIndex = 0; jamIndex < (uint32_t)jamEntries.size(); jamIndex++ )
+    {
+        const auto& jamScan = *jamEntries[jamIndex].m_scan;
+
+        internString( jamScan.jam_name, m_jamNameOffsets );
+        m_jamRiffsScanned.emplace_back( jamScan.riff_scanned );
+
+        for ( const auto& userRiffPair : jamScan.user_and_riff_count )
+            contributionsByUser[userRiffPair.first].emplace_back( UserJam{ jamIndex, userRiffPair.second } );
+    }
+    m_jamNameOffsets.emplace_back( (uint32_t)m_strings.size() );
+
+    // intern usernames in sorted order for binary search
+    std::vector< std::string_view > sortedUsers;
+    sortedUsers.reserve( contributionsByUser.size() );
+    for ( const auto& userPair : contributionsByUser )
+        sortedUsers.emplace_back( userPair.first );
+    std::sort( sortedUsers.begin(), sortedUsers.end() );
+
+    for ( const auto& username : sortedUsers )
+    {
+        const auto& userJams = contributionsByUser[username];
+
+        internString( username, m_userNameOffsets );
+        m_userJamStart.emplace_back( (uint32_t)m_userJams.size() );
+        m_userJams.insert( m_userJams.end(), userJams.begin(), userJams.end() );
+    }
+    m_userNameOffsets.emplace_back( (uint32_t)m_strings.size() );
+    m_userJamStart.emplace_back( (uint32_t)m_userJams.size() );
+
+    m_valid = true;
+
+    blog::cache( FMTX( "compiled population data, {} jams / {} users / {} contributions" ), jamEntries.size(), sortedUsers.size(), m_userJams.size() );
+
+    // stash the compiled form; not being able to write it is non-fatal, we'll just pay for the parse again next time
+    {
+        CompiledPopulationHeader header;
+        header.m_sourceSize     = sourceSize;
+        header.m_sourceTime     = sourceTime;
+        header.m_stringBytes    = (uint32_t)m_strings.size();
+        header.m_jamCount       = (uint32_t)m_jamRiffsScanned.size();
+        header.m_userCount      = (uint32_t)sortedUsers.size();
+        header.m_userJamCount   = (uint32_t)m_userJams.size();
+
+        std::ofstream ofs( compiledFile, std::ios::out | std::ios::binary | std::ios::trunc );
+        ofs.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+        writeArray( ofs, m_strings );
+        writeArray( ofs, m_jamIDOffsets );
+        writeArray( ofs, m_jamNameOffsets );
+        writeArray( ofs, m_jamRiffsScanned );
+        writeArray( ofs, m_userNameOffsets );
+        writeArray( ofs, m_userJamStart );
+        writeArray( ofs, m_userJams );
+
+        if ( !ofs.good() )
+            blog::error::cache( FMTX( "unable to write compiled population data to [{}]" ), compiledFile.string() );
+    }
+
+    return absl::OkStatus();
+}
+
 } // namespace toolkit
 } // namespace endlesss
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <span>
 #include <tsl/htrie_set.h>
 #include "absl/hash/internal/city.h"
 
@@ -68,5 +69,65 @@ private:
     std::atomic_bool                        m_nameTrieValid = false;
 };
 
+// ---------------------------------------------------------------------------------------------------------------------
+// compiled form of the public jam population scan (config::endlesss::PopulationPublics); the JSON snapshot is parsed
+// once and written back out as a flat binary next to the shared config, which is then loaded directly on subsequent runs
+// until the source JSON changes. usernames are interned into a sorted table with an inverted user -> (jam, riff count)
+// index, so looking up one user's contributions is a binary search rather than a walk across every jam
+//
+struct PopulationPublicsIndex
+{
+    static constexpr auto cFilename = "endlesss.population-publics.bin";
+
+    struct UserJam
+    {
+        uint32_t    m_jamIndex;
+        uint32_t    m_riffCount;
+    };
+
+    // load the compiled snapshot, rebuilding it from the shipped JSON if missing or out of date
+    absl::Status load( const config::IPathProvider& pathProvider );
+
+    ouro_nodiscard inline bool isValid() const { return m_valid; }
+
+    // jams are stored in case-insensitive name order, so jam index doubles as the by-name sort key
+    ouro_nodiscard inline std::size_t getJamCount() const { return m_jamRiffsScanned.size(); }
+
+    ouro_nodiscard inline std::string_view getJamCouchID( const uint32_t jamIndex ) const
+    {
+        return getString( m_jamIDOffsets, jamIndex );
+    }
+    ouro_nodiscard inline std::string_view getJamName( const uint32_t jamIndex ) const
+    {
+        return getString( m_jamNameOffsets, jamIndex );
+    }
+    ouro_nodiscard inline uint32_t getJamRiffsScanned( const uint32_t jamIndex ) const
+    {
+        return m_jamRiffsScanned[jamIndex];
+    }
+
+    // fetch all jams the given user contributed to, in jam index (and so name) order; empty if user unknown
+    std::span< const UserJam > findUserContributions( const std::string_view username ) const;
+
+private:
+
+    absl::Status loadCompiled( const fs::path& compiledFile, const uint64_t sourceSize, const int64_t sourceTime );
+    absl::Status compileFromSource( const config::IPathProvider& pathProvider, const fs::path& compiledFile, const uint64_t sourceSize, const int64_t sourceTime );
+
+    ouro_nodiscard inline std::string_view getString( const std::vector< uint32_t >& offsets, const uint32_t index ) const
+    {
+        return std::string_view( m_strings.data() + offsets[index], offsets[index + 1] - offsets[index] );
+    }
+
+    std::vector< char >             m_strings;              // all jam IDs, jam names and usernames, back to back
+    std::vector< uint32_t >         m_jamIDOffsets;         // [jam count + 1] offsets into m_strings
+    std::vector< uint32_t >         m_jamNameOffsets;       // [jam count + 1]
+    std::vector< uint32_t >         m_jamRiffsScanned;      // [jam count]
+    std::vector< uint32_t >         m_userNameOffsets;      // [user count + 1], names in byte-wise sorted order
+    std::vector< uint32_t >         m_userJamStart;         // [user count + 1] ranges into m_userJams
+    std::vector< UserJam >          m_userJams;
+    bool                            m_valid = false;
+};
+
 } // namespace toolkit
 } // namespace endlesss
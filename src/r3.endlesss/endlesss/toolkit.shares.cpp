@@ -11,6 +11,8 @@
 
 #include "spacetime/moment.h"
 
+#include "optional_binary.hpp"
+
 #include "endlesss/api.h"
 #include "endlesss/toolkit.shares.h"
 #include "endlesss/config.h"
@@ -20,54 +22,108 @@ using namespace std::chrono_literals;
 namespace endlesss {
 namespace toolkit {
 
+namespace {
+
+// the journal is a sequence of blocks, each [ header | cereal binary SharedRiffsCache holding just the appended shares ]
+// the header records how many shares the cache held before the block was written, so blocks that don't line up
+// with the snapshot on disk (eg. from a stale journal that failed to delete) are rejected on load
+struct JournalBlockHeader
+{
+    static constexpr uint32_t cMagic = 0x4A525324;  // $SRJ
+
+    uint32_t    m_magic         = cMagic;
+    uint32_t    m_payloadBytes  = 0;
+    uint64_t    m_baseCount     = 0;
+};
+static_assert( sizeof( JournalBlockHeader ) == 16 );
+
+fs::path getJournalPath( const config::IPathProvider& pathProvider )
+{
+    fs::path journalPath = pathProvider.getPath( config::endlesss::SharedRiffsCache::StoragePath );
+    journalPath.append( Shares::cJournalFilename );
+    return journalPath;
+}
+
+} // anonymous namespace
+
 // ---------------------------------------------------------------------------------------------------------------------
 tf::Taskflow Shares::taskFetchLatest(
     const endlesss::api::NetConfiguration& apiCfg,
     std::string username,
+    SharedData existingData,
     std::function< void( StatusOrData ) > completionFunc )
 {
     tf::Taskflow taskResult;
-    taskResult.emplace( [&apiCfg, usernameToFetch = std::move( username ), this, onCompletion = std::move( completionFunc )]()
+    taskResult.emplace( [&apiCfg, usernameToFetch = std::move( username ), existing = std::move( existingData ), this, onCompletion = std::move( completionFunc )]()
     {
         const int32_t count = 5;    // how many shared riffs to pull each time (5 is what the website uses at time of writing)
         int32_t offset = 0;
+        int32_t requestsIssued = 0;
 
-        SharedData newData = std::make_shared<config::endlesss::SharedRiffsCache>();
+        const uint64_t syncTimeUnix = spacetime::getUnixTimeNow().count();
 
-        newData->m_username     = usernameToFetch;
-        newData->m_lastSyncTime = spacetime::getUnixTimeNow().count();
+        // shares are served newest-first; if we already have data for this user we can stop paging as soon as
+        // we see a share we know about, everything after it will be older. that never notices shares that have been
+        // removed though, so once the last full pass is old enough (or from the future, clock changes) do another
+        const bool bFullSyncIsRecent = ( existing != nullptr &&
+                                         existing->m_lastFullSyncTime <= syncTimeUnix &&
+                                         syncTimeUnix - existing->m_lastFullSyncTime < cFullSyncIntervalSeconds );
+
+        const bool bIncremental = ( existing != nullptr &&
+                                    existing->m_username == usernameToFetch &&
+                                    existing->m_count > 0 &&
+                                    bFullSyncIsRecent );
 
-        while ( true )
+        absl::flat_hash_set< config::endlesss::SharedRiffsCache::SharedRiffID > knownShares;
+        if ( bIncremental )
+        {
+            knownShares.reserve( existing->m_count );
+            for ( const auto& sharedRiffID : existing->m_sharedRiffIDs )
+                knownShares.emplace( sharedRiffID );
+        }
+
+        // newly discovered shares, collected newest-first and then flipped before being appended
+        config::endlesss::SharedRiffsCache fetchedData;
+
+        bool bReachedKnownShare = false;
+        while ( !bReachedKnownShare )
         {
             api::SharedRiffsByUser sharedRiffs;
+            requestsIssued++;
             if ( sharedRiffs.fetch( apiCfg, usernameToFetch, count, offset ) )
             {
                 for ( const auto& riffData : sharedRiffs.data )
                 {
+                    if ( knownShares.contains( config::endlesss::SharedRiffsCache::SharedRiffID{ riffData._id } ) )
+                    {
+                        bReachedKnownShare = true;
+                        break;
+                    }
+
                     std::string jamCID = m_riffBandExtractor.estimateJamCouchID( riffData );
                     
                     // remove any invalid UTF8 characters from the title string before storage
                     std::string sanitisedTitle;
                     utf8::replace_invalid( riffData.title.begin(), riffData.title.end(), back_inserter( sanitisedTitle ) );
 
-                    newData->m_names.emplace_back( sanitisedTitle );
-                    newData->m_images.emplace_back( riffData.image_url );
-                    newData->m_sharedRiffIDs.emplace_back( riffData._id );
-                    newData->m_riffIDs.emplace_back( riffData.doc_id );
-                    newData->m_jamIDs.emplace_back( jamCID );
-                    newData->m_private.emplace_back( riffData.is_private );
+                    fetchedData.m_names.emplace_back( sanitisedTitle );
+                    fetchedData.m_images.emplace_back( riffData.image_url );
+                    fetchedData.m_sharedRiffIDs.emplace_back( riffData._id );
+                    fetchedData.m_riffIDs.emplace_back( riffData.doc_id );
+                    fetchedData.m_jamIDs.emplace_back( jamCID );
+                    fetchedData.m_private.emplace_back( riffData.is_private );
 
                     // public jams are all prefixed 'band'; personal ones are just the usename
                     const bool bFromPersonalJam = ( jamCID == usernameToFetch || jamCID.rfind( "band", 0 ) != 0 );
-                    newData->m_personal.emplace_back( bFromPersonalJam );
+                    fetchedData.m_personal.emplace_back( bFromPersonalJam );
 
                     const uint64_t timestampUnix = riffData.action_timestamp / 1000; // from unix nano
                     
-                    newData->m_timestamps.emplace_back( timestampUnix );
+                    fetchedData.m_timestamps.emplace_back( timestampUnix );
 
-                    newData->m_stems.emplace_back( riffData.loops );
+                    fetchedData.m_stems.emplace_back( riffData.loops );
 
-                    newData->m_count++;
+                    fetchedData.m_count++;
                 }
             }
             else
@@ -88,8 +144,45 @@ tf::Taskflow Shares::taskFetchLatest(
             offset += count;
         }
 
+        fetchedData.reverseEntries();
+
+        // build on a copy of the existing data (if any), the original may still be in use by the UI
+        SharedData newData = bIncremental ?
+            std::make_shared<config::endlesss::SharedRiffsCache>( *existing ) :
+            std::make_shared<config::endlesss::SharedRiffsCache>();
+
+        newData->m_username     = usernameToFetch;
+        newData->m_lastSyncTime = syncTimeUnix;
+        newData->append( fetchedData );
+
+        if ( bIncremental )
+        {
+            blog::api( FMTX( "shared riffs for '{}' : incremental, {} new, {} total, {} request(s)" ), usernameToFetch, fetchedData.m_count, newData->m_count, requestsIssued );
+        }
+        else
+        {
+            newData->m_lastFullSyncTime = syncTimeUnix;
+
+            // report how many of the shares we had before have since disappeared
+            std::size_t sharesRemoved = 0;
+            if ( existing != nullptr && existing->m_username == usernameToFetch )
+            {
+                const absl::flat_hash_set< config::endlesss::SharedRiffsCache::SharedRiffID > currentShares(
+                    newData->m_sharedRiffIDs.begin(),
+                    newData->m_sharedRiffIDs.end() );
+
+                for ( const auto& sharedRiffID : existing->m_sharedRiffIDs )
+                {
+                    if ( !currentShares.contains( sharedRiffID ) )
+                        sharesRemoved++;
+                }
+            }
+
+            blog::api( FMTX( "shared riffs for '{}' : full, {} total, {} removed, {} request(s)" ), usernameToFetch, newData->m_count, sharesRemoved, requestsIssued );
+        }
+
         // successfully got some data
-        if ( offset > 0 )
+        if ( newData->m_count > 0 )
         {
             if ( onCompletion != nullptr )
                 onCompletion( newData );
@@ -104,6 +197,140 @@ tf::Taskflow Shares::taskFetchLatest(
     return taskResult;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+Shares::StatusOrData Shares::loadCache( const config::IPathProvider& pathProvider )
+{
+    SharedData cacheData = std::make_shared<config::endlesss::SharedRiffsCache>();
+
+    const auto cacheLoadResult = config::load( pathProvider, *cacheData );
+    if ( cacheLoadResult == config::LoadResult::CannotFindConfigFile )
+        return absl::NotFoundError( "no shared riff cache found" );
+    if ( cacheLoadResult != config::LoadResult::Success )
+        return absl::DataLossError( config::LoadResultToString( cacheLoadResult ) );
+
+    m_journalBlocks = 0;
+
+    const fs::path journalPath = getJournalPath( pathProvider );
+    if ( fs::exists( journalPath ) )
+    {
+        std::ifstream journalStream( journalPath, std::ios::binary );
+
+        bool bJournalIntact = true;
+        while ( journalStream.peek() != std::ifstream::traits_type::eof() )
+        {
+            JournalBlockHeader blockHeader;
+            journalStream.read( reinterpret_cast<char*>( &blockHeader ), sizeof( blockHeader ) );
+
+            if ( !journalStream ||
+                 blockHeader.m_magic != JournalBlockHeader::cMagic ||
+                 blockHeader.m_baseCount != cacheData->m_count )
+            {
+                bJournalIntact = false;
+                break;
+            }
+
+            std::string blockPayload( blockHeader.m_payloadBytes, '\0' );
+            journalStream.read( blockPayload.data(), blockHeader.m_payloadBytes );
+            if ( !journalStream )
+            {
+                bJournalIntact = false;
+                break;
+            }
+
+            config::endlesss::SharedRiffsCache journalBlock;
+            try
+            {
+                std::istringstream is( blockPayload, std::ios::binary );
+                cereal::BinaryInputArchive archive( is );
+
+                journalBlock.serialize( archive );
+            }
+            catch ( cereal::Exception& cEx )
+            {
+                blog::error::cfg( "shared riff journal block failed to parse : {}", cEx.what() );
+                bJournalIntact = false;
+                break;
+            }
+
+            if ( journalBlock.m_username != cacheData->m_username || !journalBlock.postLoad() )
+            {
+                bJournalIntact = false;
+                break;
+            }
+
+            cacheData->append( journalBlock );
+            cacheData->m_lastSyncTime = journalBlock.m_lastSyncTime;
+
+            m_journalBlocks++;
+        }
+
+        // anything we couldn't replay will be discarded by forcing a full rewrite on the next save
+        if ( !bJournalIntact )
+        {
+            blog::error::cfg( FMTX( "shared riff journal damaged or stale after {} block(s), ignoring the remainder" ), m_journalBlocks );
+            m_journalBlocks = cMaxJournalBlocks;
+        }
+    }
+
+    cacheData->m_persistedCount = cacheData->m_count;
+    return cacheData;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status Shares::saveCache( const config::IPathProvider& pathProvider, config::endlesss::SharedRiffsCache& data )
+{
+    const fs::path journalPath = getJournalPath( pathProvider );
+
+    // nothing on disk to build on (first sync, different user, manual import) or the journal has grown long enough
+    // that it's worth folding back into the snapshot
+    if ( data.m_persistedCount == 0 ||
+         data.m_persistedCount > data.m_count ||
+         m_journalBlocks >= cMaxJournalBlocks )
+    {
+        const auto cacheSaveResult = config::save( pathProvider, data );
+        if ( cacheSaveResult != config::SaveResult::Success )
+            return absl::InternalError( "unable to save shared riff cache snapshot" );
+
+        // any leftover journal will fail the base-count check on load if this doesn't work, so just note it
+        std::error_code removeError;
+        fs::remove( journalPath, removeError );
+        if ( removeError )
+            blog::error::cfg( FMTX( "unable to remove shared riff journal [{}] : {}" ), journalPath.string(), removeError.message() );
+
+        m_journalBlocks       = 0;
+        data.m_persistedCount = data.m_count;
+        return absl::OkStatus();
+    }
+
+    // package up just the shares we haven't written yet; may be empty, in which case it just records the sync time
+    config::endlesss::SharedRiffsCache journalBlock;
+    journalBlock.m_username     = data.m_username;
+    journalBlock.m_lastSyncTime = data.m_lastSyncTime;
+    journalBlock.append( data, data.m_persistedCount );
+
+    std::ostringstream blockStream( std::ios::binary );
+    {
+        cereal::BinaryOutputArchive archive( blockStream );
+        journalBlock.serialize( archive );
+    }
+    const std::string blockPayload = blockStream.str();
+
+    JournalBlockHeader blockHeader;
+    blockHeader.m_payloadBytes  = static_cast<uint32_t>( blockPayload.size() );
+    blockHeader.m_baseCount     = data.m_persistedCount;
+
+    std::ofstream journalStream( journalPath, std::ios::binary | std::ios::app );
+    journalStream.write( reinterpret_cast<const char*>( &blockHeader ), sizeof( blockHeader ) );
+    journalStream.write( blockPayload.data(), blockPayload.size() );
+
+    if ( !journalStream )
+        return absl::InternalError( fmt::format( FMTX( "failed writing shared riff journal [{}]" ), journalPath.string() ) );
+
+    m_journalBlocks++;
+    data.m_persistedCount = data.m_count;
+    return absl::OkStatus();
+}
+
 static constexpr auto cRegexBandNameExtract = "/(band[a-f0-9]+)/";
 
 // ---------------------------------------------------------------------------------------------------------------------
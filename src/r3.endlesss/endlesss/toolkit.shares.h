@@ -37,16 +37,38 @@ struct Shares
     using SharedData    = std::shared_ptr< config::endlesss::SharedRiffsCache >;
     using StatusOrData  = absl::StatusOr<SharedData>;
 
+    // new shares are appended to this file after each sync rather than rewriting the whole (large) JSON snapshot
+    static constexpr auto cJournalFilename = "endlesss.shared-riffs.journal.bin";
+
+    // how many journal blocks we allow to build up before folding everything back into the main snapshot
+    static constexpr std::size_t cMaxJournalBlocks = 32;
+
+    // incremental syncs only ever see new shares, so riffs that get un-shared would linger in the cache; this often
+    // we ignore the existing data and pull every page again, which rebuilds the list from scratch
+    static constexpr uint64_t cFullSyncIntervalSeconds = 60 * 60 * 24;
+
     // produce Tf graph to execute; requests a download of new shared riff data for the given Endlesss username;
-    // pulls all the pages of data, crunches them down and calls completionFunc() with the result 
+    // if `existingData` holds shares for the same user and had a full sync within cFullSyncIntervalSeconds, only pages
+    // newer than the newest known share are pulled and appended to a copy of it, otherwise all the pages are fetched
+    // and replace it. calls completionFunc() with the result 
     tf::Taskflow taskFetchLatest(
         const endlesss::api::NetConfiguration& apiCfg,
         std::string username,
+        SharedData existingData,
         std::function< void( StatusOrData ) > completionFunc );
 
+    // load the snapshot from disk and replay any journalled shares on top; returns NotFound if there is no cache
+    StatusOrData loadCache( const config::IPathProvider& pathProvider );
+
+    // write any shares added since the last load/save to the journal, or rewrite the full snapshot (clearing the
+    // journal) if the data is new or the journal has grown too long
+    absl::Status saveCache( const config::IPathProvider& pathProvider, config::endlesss::SharedRiffsCache& data );
+
 protected:
 
     RiffBandExtractor    m_riffBandExtractor;
+
+    std::size_t          m_journalBlocks = 0;
 };
 
 
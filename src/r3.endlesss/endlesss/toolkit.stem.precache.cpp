@@ -0,0 +1,245 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "endlesss/toolkit.stem.precache.h"
+#include "endlesss/toolkit.warehouse.h"
+#include "endlesss/cache.stems.h"
+#include "endlesss/live.stem.h"
+
+namespace endlesss {
+namespace toolkit {
+
+// ---------------------------------------------------------------------------------------------------------------------
+StemPrecache::StemPrecache( const Warehouse& warehouse, const services::RiffFetchProvider& riffFetchProvider )
+    : m_warehouse( warehouse )
+    , m_riffFetchProvider( riffFetchProvider )
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+StemPrecache::~StemPrecache()
+{
+    stop();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void StemPrecache::start(
+    const types::StemCouchIDs& stemIDs,
+    const int32_t downloadWorkerCount,
+    const bool dryRun,
+    const FailureCallback& failureCallback )
+{
+    stop();
+
+    // work from the newest stems backwards, they're the ones most likely to be wanted first
+    m_stemIDs.assign( stemIDs.rbegin(), stemIDs.rend() );
+    m_dryRun            = dryRun;
+    m_failureCallback   = failureCallback;
+
+    m_statistics.m_stemsProcessed                   = 0;
+    m_statistics.m_stemsAlreadyInCache              = 0;
+    m_statistics.m_stemsDownloaded                  = 0;
+    m_statistics.m_stemsMissingFromDb               = 0;
+    m_statistics.m_stemsFailedToDownload            = 0;
+    m_statistics.m_stemsFailedToDownloadTerminal    = 0;
+    m_statistics.m_bytesDownloaded                  = 0;
+
+    m_stopRequested     = false;
+    m_lookupFinished    = false;
+    m_complete          = false;
+
+    const int32_t downloadThreadCount = dryRun ? 0 : std::max( downloadWorkerCount, 1 );
+
+    // drain anything left over from a previous stopped run
+    {
+        types::Stem discard;
+        while ( m_downloadQueue.try_dequeue( discard ) ) {}
+        while ( m_queueSlots.tryWait() ) {}
+    }
+    m_queueSlots.signal( static_cast<int>( std::max( downloadThreadCount, 1 ) * cQueueDepthPerWorker ) );
+
+    blog::app( FMTX( "[ PRECACHE ] starting on {} stems with {} download workers{}" ), m_stemIDs.size(), downloadThreadCount, dryRun ? " (dry run)" : "" );
+
+    m_startedAt.setToNow();
+
+    m_workersLive = 1 + downloadThreadCount;
+    m_lookupThread = std::make_unique<std::thread>( &StemPrecache::lookupThreadLoop, this );
+    for ( int32_t workerI = 0; workerI < downloadThreadCount; workerI++ )
+        m_downloadThreads.emplace_back( &StemPrecache::downloadThreadLoop, this );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void StemPrecache::stop()
+{
+    if ( m_lookupThread == nullptr )
+        return;
+
+    m_stopRequested = true;
+
+    m_lookupThread->join();
+    m_lookupThread = nullptr;
+
+    for ( auto& downloadThread : m_downloadThreads )
+        downloadThread.join();
+    m_downloadThreads.clear();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool StemPrecache::estimateTimeRemaining( std::chrono::seconds& result ) const
+{
+    // need a reasonable number of samples to avoid wild guesses at the start
+    static constexpr uint32_t cMinimumProcessedForEstimate = 32;
+
+    const uint32_t processed = m_statistics.m_stemsProcessed;
+    if ( processed < cMinimumProcessedForEstimate )
+        return false;
+
+    const auto elapsedMs = m_startedAt.delta< std::chrono::milliseconds >();
+    const auto remaining = m_stemIDs.size() - std::min<std::size_t>( processed, m_stemIDs.size() );
+
+    result = std::chrono::duration_cast<std::chrono::seconds>( ( elapsedMs / processed ) * remaining );
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void StemPrecache::workerExited()
+{
+    // last one out marks the whole process as done, unless we were asked to stop early
+    if ( --m_workersLive == 0 )
+    {
+        m_complete = !m_stopRequested;
+
+        blog::app( FMTX( "[ PRECACHE ] {} ({} downloaded, {} already cached, {} failed)" ),
+            m_complete ? "complete" : "stopped",
+            m_statistics.m_stemsDownloaded.load(),
+            m_statistics.m_stemsAlreadyInCache.load(),
+            m_statistics.m_stemsFailedToDownload.load() );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void StemPrecache::lookupThreadLoop()
+{
+    OuroveonThreadScope ots( OURO_THREAD_PREFIX "StemPrecache::Lookup" );
+
+    auto& stemCache = m_riffFetchProvider->getStemCache();
+
+    types::StemCouchIDs         batchIDs;
+    std::vector< types::Stem >  batchData;
+
+    batchIDs.reserve( cLookupBatchSize );
+
+    for ( std::size_t batchStart = 0; batchStart < m_stemIDs.size() && !m_stopRequested; batchStart += cLookupBatchSize )
+    {
+        const std::size_t batchEnd = std::min( batchStart + cLookupBatchSize, m_stemIDs.size() );
+
+        batchIDs.assign( m_stemIDs.begin() + batchStart, m_stemIDs.begin() + batchEnd );
+        m_warehouse.batchFetchStemsByID( batchIDs, batchData );
+
+        for ( std::size_t stemI = 0; stemI < batchData.size() && !m_stopRequested; stemI++ )
+        {
+            types::Stem& stemData = batchData[stemI];
+
+            if ( stemData.couchID.empty() )
+            {
+                blog::error::app( FMTX( "was unable to fetch stem data from warehouse during precache : [{}]" ), batchIDs[stemI] );
+
+                m_statistics.m_stemsMissingFromDb++;
+                m_statistics.m_stemsProcessed++;
+                continue;
+            }
+
+            const fs::path stemCachePath = stemCache.getCachePathForStem( stemData );
+            if ( fs::exists( stemCachePath / stemData.couchID.value() ) )
+            {
+                m_statistics.m_stemsAlreadyInCache++;
+                m_statistics.m_stemsProcessed++;
+                continue;
+            }
+
+            if ( m_dryRun )
+            {
+                m_statistics.m_stemsProcessed++;
+                continue;
+            }
+
+            // wait for space in the download queue, checking periodically if we've been told to stop
+            while ( !m_queueSlots.wait( 100 * 1000 ) )
+            {
+                if ( m_stopRequested )
+                    break;
+            }
+            if ( m_stopRequested )
+                break;
+
+            m_downloadQueue.enqueue( std::move( stemData ) );
+        }
+    }
+
+    m_lookupFinished = true;
+    workerExited();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void StemPrecache::downloadThreadLoop()
+{
+    OuroveonThreadScope ots( OURO_THREAD_PREFIX "StemPrecache::Download" );
+
+    const auto& netConfig = m_riffFetchProvider->getNetConfiguration();
+    auto& stemCache = m_riffFetchProvider->getStemCache();
+
+    types::Stem stemData;
+    while ( !m_stopRequested )
+    {
+        if ( !m_downloadQueue.wait_dequeue_timed( stemData, std::chrono::milliseconds( 100 ) ) )
+        {
+            // nothing more is coming and the queue is dry, we're done
+            if ( m_lookupFinished && m_downloadQueue.size_approx() == 0 )
+                break;
+
+            continue;
+        }
+        m_queueSlots.signal();
+
+        uint32_t httpStatus = 0;
+        const auto downloadResult = live::Stem::downloadToCache(
+            netConfig,
+            stemData,
+            stemCache.getCachePathForStem( stemData ),
+            httpStatus );
+
+        if ( downloadResult == live::Stem::State::Complete )
+        {
+            m_statistics.m_stemsDownloaded++;
+            m_statistics.m_bytesDownloaded += stemData.fileLengthBytes;
+        }
+        else
+        {
+            blog::error::app( FMTX( "failed to download stem to cache : [{}]" ), stemData.couchID );
+
+            m_statistics.m_stemsFailedToDownload++;
+
+            // a permission failure shows the bug we have had where some stems on the CDN have become permanently unreachable
+            if ( httpStatus == 403 )
+                m_statistics.m_stemsFailedToDownloadTerminal++;
+
+            if ( m_failureCallback != nullptr )
+                m_failureCallback( stemData, httpStatus );
+        }
+
+        m_statistics.m_stemsProcessed++;
+    }
+
+    workerExited();
+}
+
+} // namespace toolkit
+} // namespace endlesss
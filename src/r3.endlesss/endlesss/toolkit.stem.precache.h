@@ -0,0 +1,109 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#pragma once
+
+#include "base/construction.h"
+
+#include "endlesss/core.types.h"
+#include "endlesss/core.services.h"
+
+#include "spacetime/moment.h"
+
+namespace endlesss {
+namespace toolkit {
+
+struct Warehouse;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// bulk stem cache filling
+//
+// given a list of stem IDs, a lookup thread resolves their details from the warehouse in batches and checks which are
+// already on disk; anything missing is handed to a pool of download threads that stream the compressed data straight
+// into the stem cache (see live::Stem::downloadToCache) - no decoding, resampling or analysis. all work happens on
+// threads owned by this object, callers just poll getStatistics() for progress at whatever rate suits them
+//
+struct StemPrecache
+{
+    DECLARE_NO_COPY_NO_MOVE( StemPrecache );
+
+    // how many stem records are resolved from the warehouse per transaction
+    static constexpr std::size_t    cLookupBatchSize        = 128;
+
+    // how many resolved stems can be queued up per download worker before the lookup thread waits for them to catch up
+    static constexpr std::size_t    cQueueDepthPerWorker    = 4;
+
+    // progress counters; written by the worker threads, safe to read at any time
+    struct Statistics
+    {
+        std::atomic_uint32_t        m_stemsProcessed                = 0;    // dealt with in any way, including failures
+        std::atomic_uint32_t        m_stemsAlreadyInCache           = 0;
+        std::atomic_uint32_t        m_stemsDownloaded               = 0;
+        std::atomic_uint32_t        m_stemsMissingFromDb            = 0;
+        std::atomic_uint32_t        m_stemsFailedToDownload         = 0;    // some kind of stem download error, may be resolveable with re-download
+        std::atomic_uint32_t        m_stemsFailedToDownloadTerminal = 0;    // 403 errors - the stem is gone forever
+        std::atomic_uint64_t        m_bytesDownloaded               = 0;
+    };
+
+    // optional hook, called from a download thread for each stem that fails to download
+    using FailureCallback = std::function<void( const types::Stem& stemData, const uint32_t httpStatus )>;
+
+    StemPrecache( const Warehouse& warehouse, const services::RiffFetchProvider& riffFetchProvider );
+    ~StemPrecache();
+
+    // begin working through the given stems, newest first; in dry-run mode the cache is checked but nothing is downloaded
+    void start(
+        const types::StemCouchIDs& stemIDs,
+        const int32_t downloadWorkerCount,
+        const bool dryRun,
+        const FailureCallback& failureCallback = nullptr );
+
+    // ask all workers to finish their current download and exit, then wait for them
+    void stop();
+
+    ouro_nodiscard bool isRunning() const  { return m_workersLive > 0; }
+    ouro_nodiscard bool isComplete() const { return m_complete; }
+
+    ouro_nodiscard std::size_t getTotalStems() const { return m_stemIDs.size(); }
+    ouro_nodiscard const Statistics& getStatistics() const { return m_statistics; }
+
+    // extrapolate time remaining from the rate of progress so far; returns false until there's enough to go on
+    ouro_nodiscard bool estimateTimeRemaining( std::chrono::seconds& result ) const;
+
+private:
+
+    void lookupThreadLoop();
+    void downloadThreadLoop();
+    void workerExited();
+
+    const Warehouse&                        m_warehouse;
+    services::RiffFetchProvider             m_riffFetchProvider;
+
+    types::StemCouchIDs                     m_stemIDs;
+    bool                                    m_dryRun = false;
+    FailureCallback                         m_failureCallback;
+
+    Statistics                              m_statistics;
+    spacetime::Moment                       m_startedAt;
+
+    // resolved stems waiting to be downloaded; m_queueSlots bounds how far ahead the lookup thread can get
+    mcc::BlockingConcurrentQueue< types::Stem > m_downloadQueue;
+    mcc::LightweightSemaphore               m_queueSlots;
+
+    std::unique_ptr< std::thread >          m_lookupThread;
+    std::vector< std::thread >              m_downloadThreads;
+
+    std::atomic_bool                        m_stopRequested     = false;
+    std::atomic_bool                        m_lookupFinished    = false;
+    std::atomic_bool                        m_complete          = false;
+    std::atomic_int32_t                     m_workersLive       = 0;
+};
+
+} // namespace toolkit
+} // namespace endlesss
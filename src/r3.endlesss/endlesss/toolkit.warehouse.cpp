@@ -189,8 +189,9 @@ struct JamPurgeTask final : Warehouse::ITask
 {
     static constexpr std::string_view Tag = "PURGE";
 
-    JamPurgeTask( const types::JamCouchID& jamCID )
+    JamPurgeTask( Warehouse::HotTables& hotTables, const types::JamCouchID& jamCID )
         : Warehouse::ITask()
+        , m_hotTables( hotTables )
         , m_jamCID( jamCID )
     {}
 
@@ -205,7 +206,8 @@ struct JamPurgeTask final : Warehouse::ITask
     }
 
 
-    types::JamCouchID m_jamCID;
+    Warehouse::HotTables&   m_hotTables;
+    types::JamCouchID       m_jamCID;
 
     const char* getTag() const override { return Tag.data(); }
     std::string Describe() const override { return fmt::format( "[{}] deleting all records for [{}]", Tag, m_jamCID ); }
@@ -269,6 +271,9 @@ struct JamImportTask final : Warehouse::ITask
         , m_operationID( opID )
     {}
 
+    // number of riff/stem rows inserted per transaction; also the granularity of resume checkpoints
+    static constexpr std::size_t cImportRowsPerBatch = 500;
+
     base::EventBusClient    m_eventBusClient;
     fs::path                m_fileToImport;
     base::OperationID       m_operationID;
@@ -286,12 +291,14 @@ struct GetRiffDataTask final : Warehouse::INetworkTask
 {
     static constexpr std::string_view Tag = "RIFFDATA";
 
-    GetRiffDataTask( const api::NetConfiguration& ncfg, const types::JamCouchID& jamCID, const std::vector< types::RiffCouchID >& riffCIDs )
+    GetRiffDataTask( const api::NetConfiguration& ncfg, Warehouse::HotTables& hotTables, const types::JamCouchID& jamCID, const std::vector< types::RiffCouchID >& riffCIDs )
         : Warehouse::INetworkTask( ncfg )
+        , m_hotTables( hotTables )
         , m_jamCID( jamCID )
         , m_riffCIDs( riffCIDs )
     {}
 
+    Warehouse::HotTables&             m_hotTables;
     types::JamCouchID                 m_jamCID;
     std::vector< types::RiffCouchID > m_riffCIDs;
 
@@ -364,6 +371,131 @@ struct Warehouse::TaskSchedule
     }
 };
 
+// ---------------------------------------------------------------------------------------------------------------------
+// in-memory mirror of the small tables that get read synchronously from UI code - tags, the stem ledger and jam
+// names. filled once as the warehouse opens and then updated by every path that writes to those tables, so lookups
+// only ever take a shared lock here rather than queueing up behind the worker thread for the database
+struct Warehouse::HotTables
+{
+    using TagMap    = absl::flat_hash_map< types::RiffCouchID, types::RiffTag >;
+    using LedgerMap = absl::flat_hash_map< types::StemCouchID, Warehouse::StemLedgerType >;
+
+    void load();
+
+    // -----------------------------------------------------------------------------------------------------------------
+    void upsertTag( const types::RiffTag& tag )
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_lock );
+        m_tags.insert_or_assign( tag.m_riff, tag );
+    }
+
+    void removeTag( const types::RiffCouchID& riffID )
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_lock );
+        m_tags.erase( riffID );
+    }
+
+    void removeAllTagsForJam( const types::JamCouchID& jamCID )
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_lock );
+        for ( auto tagIt = m_tags.begin(); tagIt != m_tags.end(); )
+        {
+            if ( tagIt->second.m_jam == jamCID )
+                m_tags.erase( tagIt++ );
+            else
+                ++tagIt;
+        }
+    }
+
+    bool findTag( const types::RiffCouchID& riffID, types::RiffTag* tagOutput ) const
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_lock );
+        const auto tagIt = m_tags.find( riffID );
+        if ( tagIt == m_tags.end() )
+            return false;
+
+        if ( tagOutput != nullptr )
+            *tagOutput = tagIt->second;
+        return true;
+    }
+
+    std::size_t tagsForJam( const types::JamCouchID& jamCID, std::vector<types::RiffTag>& outputTags ) const
+    {
+        outputTags.clear();
+        {
+            std::shared_lock<std::shared_mutex> readLock( m_lock );
+            for ( const auto& tagPair : m_tags )
+            {
+                if ( tagPair.second.m_jam == jamCID )
+                    outputTags.emplace_back( tagPair.second );
+            }
+        }
+        // match the database query, which returns them by ascending ordering value
+        std::sort( outputTags.begin(), outputTags.end(), []( const types::RiffTag& lhs, const types::RiffTag& rhs )
+            {
+                return lhs.m_order < rhs.m_order;
+            });
+        return outputTags.size();
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // first note for a stem wins, as with the INSERT OR IGNORE that writes the ledger
+    void addStemNote( const types::StemCouchID& stemCID, const Warehouse::StemLedgerType type )
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_lock );
+        m_stemLedger.try_emplace( stemCID, type );
+    }
+
+    bool findStemNote( const types::StemCouchID& stemCID, Warehouse::StemLedgerType& typeResult ) const
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_lock );
+        const auto ledgerIt = m_stemLedger.find( stemCID );
+        if ( ledgerIt == m_stemLedger.end() )
+            return false;
+
+        typeResult = ledgerIt->second;
+        return true;
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    void upsertJamName( const types::JamCouchID& jamCID, const std::string& displayName )
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_lock );
+        m_jamNames.insert_or_assign( jamCID, displayName );
+    }
+
+    void removeJamName( const types::JamCouchID& jamCID )
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_lock );
+        m_jamNames.erase( jamCID );
+    }
+
+    bool findJamName( const types::JamCouchID& jamCID, std::string& displayName ) const
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_lock );
+        const auto jamIt = m_jamNames.find( jamCID );
+        if ( jamIt == m_jamNames.end() )
+            return false;
+
+        displayName = jamIt->second;
+        return true;
+    }
+
+    void copyJamNames( types::JamIDToNameMap& jamDictionary ) const
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_lock );
+        jamDictionary = m_jamNames;
+    }
+
+private:
+
+    mutable std::shared_mutex   m_lock;
+
+    TagMap                      m_tags;
+    LedgerMap                   m_stemLedger;
+    types::JamIDToNameMap       m_jamNames;
+};
+
 namespace sql {
 
 #define DEPRECATE_INDEX     R"( DROP INDEX IF EXISTS )"
@@ -393,18 +525,6 @@ namespace jams {
         Warehouse::SqlDB::query<deprecated_0>();
     }
 
-    // -----------------------------------------------------------------------------------------------------------------
-    static bool getPublicNameForID( const types::JamCouchID& jamCID, std::string& publicName )
-    {
-        static constexpr char _sqlGetJamByID[] = R"(
-            select PublicName from jams where JamCID is ?1;
-        )";
-
-        auto query = Warehouse::SqlDB::query<_sqlGetJamByID>( jamCID.value() );
-
-        return query( publicName );
-    }
-
 } // namespace jams
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -717,7 +837,7 @@ namespace tags {
     // version of upsert without inline transaction guard - so other functions can choose how to wrap or batch
     namespace details
     {
-        static void upsert_unguarded( endlesss::types::RiffTag tag, Warehouse::TagUpdateCallback& tagUpdateCb )
+        static void upsert_unguarded( endlesss::types::RiffTag tag, Warehouse::HotTables& hotTables, Warehouse::TagUpdateCallback& tagUpdateCb )
         {
             int32_t orderingValue = tag.m_order;
 
@@ -765,19 +885,21 @@ namespace tags {
                 tag.m_note
             );
 
+            hotTables.upsertTag( tag );
+
             if ( tagUpdateCb != nullptr )
                 tagUpdateCb( tag );
         }
     }
 
-    static void upsert( const endlesss::types::RiffTag& tag, Warehouse::TagUpdateCallback& tagUpdateCb )
+    static void upsert( const endlesss::types::RiffTag& tag, Warehouse::HotTables& hotTables, Warehouse::TagUpdateCallback& tagUpdateCb )
     {
         Warehouse::SqlDB::TransactionGuard txn;
-        details::upsert_unguarded( tag, tagUpdateCb );
+        details::upsert_unguarded( tag, hotTables, tagUpdateCb );
     }
 
     // -----------------------------------------------------------------------------------------------------------------
-    static void remove( const endlesss::types::RiffTag& tag, Warehouse::TagRemovedCallback& tagRemoveCb )
+    static void remove( const endlesss::types::RiffTag& tag, Warehouse::HotTables& hotTables, Warehouse::TagRemovedCallback& tagRemoveCb )
     {
         if ( bVerboseLog )
         {
@@ -790,92 +912,32 @@ namespace tags {
 
         Warehouse::SqlDB::query<_deleteTagData>( tag.m_riff.value() );
 
+        hotTables.removeTag( tag.m_riff );
+
         if ( tagRemoveCb != nullptr )
             tagRemoveCb( tag.m_riff );
     }
 
     // -----------------------------------------------------------------------------------------------------------------
-    static bool isRiffTagged( const endlesss::types::RiffCouchID& riffID, endlesss::types::RiffTag* tagOutput /*= nullptr */ )
-    {
-        static constexpr char findSingleTagForRiffID[] = R"(
-            select OwnerJamCID, riffCID, Ordering, Timestamp, Favour, Note from Tags where riffCID is ?1 
-            )";
-
-        auto query = Warehouse::SqlDB::query<findSingleTagForRiffID>( riffID.value() );
-
-        std::string_view outJamCID;
-        std::string_view outRiffCID;
-        int32_t          outOrdering;
-        uint64_t         outTimestamp;
-        int32_t          outFavour;
-        std::string_view outNote;
-
-        if ( query( outJamCID, outRiffCID, outOrdering, outTimestamp, outFavour, outNote ) )
-        {
-            if ( tagOutput != nullptr )
-            {
-                *tagOutput = endlesss::types::RiffTag(
-                    types::JamCouchID( outJamCID ),
-                    types::RiffCouchID( outRiffCID ),
-                    outOrdering,
-                    outTimestamp,
-                    outFavour,
-                    outNote );
-            }
-            return true;
-        }
-        return false;
-    }
-
-    // -----------------------------------------------------------------------------------------------------------------
-    static std::size_t forJam( const types::JamCouchID& jamCID, std::vector<types::RiffTag>& outputTags )
-    {
-        static constexpr char findAllTagsForJam[] = R"(
-            select OwnerJamCID, riffCID, Ordering, Timestamp, Favour, Note from Tags where OwnerJamCID is ?1 order by Ordering asc
-            )";
-
-        auto query = Warehouse::SqlDB::query<findAllTagsForJam>( jamCID.value() );
-
-        outputTags.clear();
-
-        std::string_view outJamCID;
-        std::string_view outRiffCID;
-        int32_t          outOrdering;
-        uint64_t         outTimestamp;
-        int32_t          outFavour;
-        std::string_view outNote;
-
-        while ( query( outJamCID, outRiffCID, outOrdering, outTimestamp, outFavour, outNote ) )
-        {
-            outputTags.emplace_back(
-                types::JamCouchID( outJamCID ),
-                types::RiffCouchID( outRiffCID ),
-                outOrdering,
-                outTimestamp,
-                outFavour,
-                outNote );
-        }
-        return outputTags.size();
-    }
-
-    // -----------------------------------------------------------------------------------------------------------------
-    static void batchUpdate( const std::vector<endlesss::types::RiffTag>& inputTags, Warehouse::TagUpdateCallback& tagUpdateCb )
+    static void batchUpdate( const std::vector<endlesss::types::RiffTag>& inputTags, Warehouse::HotTables& hotTables, Warehouse::TagUpdateCallback& tagUpdateCb )
     {
         Warehouse::SqlDB::TransactionGuard txn;
         for ( const auto& tag : inputTags )
         {
-            details::upsert_unguarded( tag, tagUpdateCb );
+            details::upsert_unguarded( tag, hotTables, tagUpdateCb );
         }
     }
 
     // -----------------------------------------------------------------------------------------------------------------
-    static void batchRemoveAll( const endlesss::types::JamCouchID& jamCID )
+    static void batchRemoveAll( const endlesss::types::JamCouchID& jamCID, Warehouse::HotTables& hotTables )
     {
         static constexpr char _deleteAllTags[] = R"(
             delete from Tags where OwnerJamCID = ?1;
             )";
 
         Warehouse::SqlDB::query<_deleteAllTags>( jamCID.value() );
+
+        hotTables.removeAllTagsForJam( jamCID );
     }
 
 } // namespace tags
@@ -1106,44 +1168,158 @@ namespace ledger {
     }
 
     // -----------------------------------------------------------------------------------------------------------------
-    static void storeStemNote( const types::StemCouchID& stemCID, const Warehouse::StemLedgerType& type, const std::string& note )
+    static void storeStemNote( Warehouse::HotTables& hotTables, const types::StemCouchID& stemCID, const Warehouse::StemLedgerType& type, const std::string& note )
     {
         static constexpr char _sqlAddLedger[] = R"(
             INSERT OR IGNORE INTO StemLedger( StemCID, Type, Note ) VALUES( ?1, ?2, ?3 );
         )";
 
         Warehouse::SqlDB::query<_sqlAddLedger>( stemCID.value(), (int32_t)type, note );
+
+        hotTables.addStemNote( stemCID, type );
+    }
+
+} // namespace ledger
+
+// ---------------------------------------------------------------------------------------------------------------------
+// resume points for long-running jam imports; the byte offset is written inside the same transaction as the rows it
+// covers, so an interrupted import can pick up exactly where the last committed batch ended
+namespace imports {
+
+    static constexpr char createTable[] = R"(
+        CREATE TABLE IF NOT EXISTS "ImportProgress" (
+            "SourcePath"    TEXT NOT NULL UNIQUE,
+            "SourceSize"    INTEGER,
+            "SourceTime"    INTEGER,
+            "ByteOffset"    INTEGER,
+            "Section"       INTEGER,
+            PRIMARY KEY("SourcePath")
+        );)";
+
+    // -----------------------------------------------------------------------------------------------------------------
+    static void runInit()
+    {
+        Warehouse::SqlDB::query<createTable>();
     }
 
     // -----------------------------------------------------------------------------------------------------------------
-    static bool getStemNoteType( const types::StemCouchID& stemCID, Warehouse::StemLedgerType& typeResult )
+    // returns false if there's no checkpoint or if the source file has changed since it was written
+    static bool getResumePoint( const std::string& sourcePath, const uint64_t sourceSize, const int64_t sourceTime, uint64_t& byteOffset, int32_t& section )
     {
-        static constexpr char _sqlGetLedger[] = R"(
-            select Type, Note from StemLedger where StemCID = ?1
+        static constexpr char _sqlGetProgress[] = R"(
+            select SourceSize, SourceTime, ByteOffset, Section from ImportProgress where SourcePath = ?1
         )";
 
-        auto query = Warehouse::SqlDB::query<_sqlGetLedger>( stemCID.value() );
+        auto query = Warehouse::SqlDB::query<_sqlGetProgress>( sourcePath );
 
-        int32_t          noteType = 0;
-        std::string_view noteText;
+        uint64_t storedSize = 0;
+        int64_t  storedTime = 0;
 
-        if ( query( noteType, noteText ) )
+        if ( query( storedSize, storedTime, byteOffset, section ) )
         {
-            ABSL_ASSERT( noteType > 0 && noteType < 4 ); // just check the range before we cast
-            typeResult = static_cast<Warehouse::StemLedgerType>(noteType);
-
-            return true;
+            return ( storedSize == sourceSize && storedTime == sourceTime );
         }
         return false;
     }
 
-} // namespace ledger
+    // -----------------------------------------------------------------------------------------------------------------
+    static void storeResumePoint( const std::string& sourcePath, const uint64_t sourceSize, const int64_t sourceTime, const uint64_t byteOffset, const int32_t section )
+    {
+        static constexpr char _sqlSetProgress[] = R"(
+            INSERT OR REPLACE INTO ImportProgress( SourcePath, SourceSize, SourceTime, ByteOffset, Section ) VALUES( ?1, ?2, ?3, ?4, ?5 );
+        )";
+
+        Warehouse::SqlDB::query<_sqlSetProgress>( sourcePath, sourceSize, sourceTime, byteOffset, section );
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    static void clearResumePoint( const std::string& sourcePath )
+    {
+        static constexpr char _sqlClearProgress[] = R"(
+            DELETE FROM ImportProgress where SourcePath = ?1;
+        )";
+
+        Warehouse::SqlDB::query<_sqlClearProgress>( sourcePath );
+    }
+
+} // namespace imports
 
 namespace constants {
 } // namespace constants
 
 } // namespace sql
 
+// ---------------------------------------------------------------------------------------------------------------------
+void Warehouse::HotTables::load()
+{
+    spacetime::ScopedTimer loadTiming( "warehouse [hot tables]" );
+
+    static constexpr char _loadAllTags[] = R"(
+        select OwnerJamCID, riffCID, Ordering, Timestamp, Favour, Note from Tags;
+        )";
+    static constexpr char _loadAllLedger[] = R"(
+        select StemCID, Type from StemLedger;
+        )";
+    static constexpr char _loadAllJamNames[] = R"(
+        select JamCID, PublicName from jams;
+        )";
+
+    std::unique_lock<std::shared_mutex> writeLock( m_lock );
+
+    m_tags.clear();
+    {
+        auto query = Warehouse::SqlDB::query<_loadAllTags>();
+
+        std::string_view outJamCID;
+        std::string_view outRiffCID;
+        int32_t          outOrdering;
+        uint64_t         outTimestamp;
+        int32_t          outFavour;
+        std::string_view outNote;
+
+        while ( query( outJamCID, outRiffCID, outOrdering, outTimestamp, outFavour, outNote ) )
+        {
+            types::RiffCouchID riffCID( outRiffCID );
+            m_tags.insert_or_assign( riffCID, types::RiffTag(
+                types::JamCouchID( outJamCID ),
+                riffCID,
+                outOrdering,
+                outTimestamp,
+                outFavour,
+                outNote ) );
+        }
+    }
+
+    m_stemLedger.clear();
+    {
+        auto query = Warehouse::SqlDB::query<_loadAllLedger>();
+
+        std::string_view outStemCID;
+        int32_t          outType = 0;
+
+        while ( query( outStemCID, outType ) )
+        {
+            ABSL_ASSERT( outType > 0 && outType < 4 ); // just check the range before we cast
+            m_stemLedger.try_emplace( types::StemCouchID( outStemCID ), static_cast<Warehouse::StemLedgerType>( outType ) );
+        }
+    }
+
+    m_jamNames.clear();
+    {
+        auto query = Warehouse::SqlDB::query<_loadAllJamNames>();
+
+        std::string_view outJamCID;
+        std::string_view outPublicName;
+
+        while ( query( outJamCID, outPublicName ) )
+        {
+            m_jamNames.emplace( outJamCID, outPublicName );
+        }
+    }
+
+    blog::database( FMTX( "hot tables loaded; {} tags, {} ledger entries, {} jam names" ), m_tags.size(), m_stemLedger.size(), m_jamNames.size() );
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // add a custom seeded RANDOM function to sqlite, allowing us to feed through specific random sequences
 //
@@ -1201,6 +1377,17 @@ Warehouse::Warehouse( const app::StoragePaths& storagePaths, api::NetConfigurati
         // https://www.sqlite.org/pragma.html#pragma_temp_store
         sqlite3_exec( db_handle, "pragma temp_store = memory", nullptr, nullptr, nullptr );
 
+        // https://www.sqlite.org/wal.html
+        // readers no longer block on (or block) the writer; this is persistent in the database file but cheap to re-assert.
+        // synchronous=normal is durable in WAL mode bar power loss, which at worst loses the last few synced transactions
+        int32_t walRes = sqlite3_exec( db_handle, "pragma journal_mode = wal", nullptr, nullptr, nullptr );
+        blog::database( FMTX( "pragma journal_mode = wal : {} ({})" ), walRes == SQLITE_OK ? "OK" : "Error", walRes );
+        sqlite3_exec( db_handle, "pragma synchronous = normal", nullptr, nullptr, nullptr );
+        sqlite3_exec( db_handle, fmt::format( FMTX( "pragma journal_size_limit = {}" ), cSqliteJournalSizeLimit ).c_str(), nullptr, nullptr, nullptr );
+
+        // https://www.sqlite.org/mmap.html
+        sqlite3_exec( db_handle, fmt::format( FMTX( "pragma mmap_size = {}" ), cSqliteMmapSizeBytes ).c_str(), nullptr, nullptr, nullptr );
+
         // add our RANDOM variant that takes a seed to allow for deterministic random queries
         int32_t seededRes = sqlite3_create_function( db_handle, "SEEDED_RANDOM", 1, SQLITE_UTF8, NULL, &sqlite_SEEDED_RANDOM, NULL, NULL );
         blog::database( FMTX( "sqlite3_create_function(SEEDED_RANDOM) = {} ({})" ), seededRes == SQLITE_OK ? "OK" : "Error", seededRes );
@@ -1219,8 +1406,12 @@ Warehouse::Warehouse( const app::StoragePaths& storagePaths, api::NetConfigurati
         sql::tags::runInit();
         sql::stems::runInit();
         sql::ledger::runInit();
+        sql::imports::runInit();
     }
 
+    m_hotTables = std::make_unique<HotTables>();
+    m_hotTables->load();
+
 
     // optimize on startup
     {
@@ -1250,6 +1441,13 @@ Warehouse::~Warehouse()
     m_taskSchedule->signal();
     m_workerThread->join();
     m_workerThread.reset();
+
+    // fold the write-ahead log back into the main database so we don't leave a large -wal file lying around
+    {
+        spacetime::ScopedTimer stemTiming( "warehouse [checkpoint]" );
+        static constexpr char sqlCheckpoint[] = R"(pragma wal_checkpoint(truncate);)";
+        SqlDB::query<sqlCheckpoint>();
+    }
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1326,6 +1524,8 @@ void Warehouse::upsertSingleJamIDToName( const endlesss::types::JamCouchID& jamC
     )";
 
     Warehouse::SqlDB::query<_insertOrUpdateJamData>( jamCID.value(), displayName );
+
+    m_hotTables->upsertJamName( jamCID, displayName );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1360,22 +1560,7 @@ void Warehouse::upsertJamDictionaryFromBNS( const config::endlesss::BandNameServ
 // ---------------------------------------------------------------------------------------------------------------------
 void Warehouse::extractJamDictionary( types::JamIDToNameMap& jamDictionary ) const
 {
-    static constexpr char _extractJamData[] = R"(
-                select JamCID, PublicName from jams;
-            )";
-
-    auto query = Warehouse::SqlDB::query<_extractJamData>();
-
-    jamDictionary.clear();
-
-    std::string_view jamCID;
-    std::string_view publicName;
-
-    while ( query( jamCID,
-                   publicName ) )
-    {
-        jamDictionary.emplace( jamCID, publicName );
-    }
+    m_hotTables->copyJamNames( jamDictionary );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1422,7 +1607,7 @@ void Warehouse::requestJamPurge( const types::JamCouchID& jamCouchID )
         return;
     }
 
-    m_taskSchedule->enqueueWorkTask<JamPurgeTask>( jamCouchID );
+    m_taskSchedule->enqueueWorkTask<JamPurgeTask>( *m_hotTables, jamCouchID );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1498,7 +1683,7 @@ bool Warehouse::fetchSingleRiffByID( const endlesss::types::RiffCouchID& riffID,
 
     result.jam.couchID = result.riff.jamCouchID;
 
-    if ( sql::jams::getPublicNameForID( result.jam.couchID, result.jam.displayName ) == false )
+    if ( m_hotTables->findJamName( result.jam.couchID, result.jam.displayName ) == false )
     {
         // on failure, check if the couch ID does NOT start with "band..." indicating this is probably a personal jam
         // (at time of writing there's no other variants we support at this level)
@@ -1910,6 +2095,30 @@ bool Warehouse::fetchSingleStemByID( const types::StemCouchID& stemCouchID, endl
     return sql::stems::getSingleStemByID( stemCouchID, result );
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+std::size_t Warehouse::batchFetchStemsByID( const endlesss::types::StemCouchIDs& stems, std::vector< endlesss::types::Stem >& result ) const
+{
+    result.clear();
+    result.resize( stems.size() );
+
+    std::size_t stemsFound = 0;
+
+    Warehouse::SqlDB::TransactionGuard txn;
+    for ( std::size_t stemI = 0; stemI < stems.size(); stemI++ )
+    {
+        if ( sql::stems::getSingleStemByID( stems[stemI], result[stemI] ) )
+        {
+            stemsFound++;
+        }
+        else
+        {
+            result[stemI] = {};
+        }
+    }
+
+    return stemsFound;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // this isn't really for normal use. potentially this could return 100k+ stem IDs on a decently populated warehouse
 //
@@ -1960,31 +2169,31 @@ bool Warehouse::fetchAllStems( endlesss::types::StemCouchIDs& result, std::size_
 // ---------------------------------------------------------------------------------------------------------------------
 bool Warehouse::getNoteTypeForStem( const types::StemCouchID& stemCID, StemLedgerType& typeResult )
 {
-    return sql::ledger::getStemNoteType( stemCID, typeResult );
+    return m_hotTables->findStemNote( stemCID, typeResult );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 void Warehouse::upsertTag( const endlesss::types::RiffTag& tag )
 {
-    sql::tags::upsert( tag, m_cbTagUpdate );
+    sql::tags::upsert( tag, *m_hotTables, m_cbTagUpdate );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 void Warehouse::removeTag( const endlesss::types::RiffTag& tag )
 {
-    sql::tags::remove( tag, m_cbTagRemoved );
+    sql::tags::remove( tag, *m_hotTables, m_cbTagRemoved );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 bool Warehouse::isRiffTagged( const endlesss::types::RiffCouchID& riffID, endlesss::types::RiffTag* tagOutput /*= nullptr */ ) const
 {
-    return sql::tags::isRiffTagged( riffID, tagOutput );
+    return m_hotTables->findTag( riffID, tagOutput );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 std::size_t Warehouse::fetchTagsForJam( const endlesss::types::JamCouchID& jamCID, std::vector<endlesss::types::RiffTag>& outputTags ) const
 {
-    return sql::tags::forJam( jamCID, outputTags );
+    return m_hotTables->tagsForJam( jamCID, outputTags );
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1992,7 +2201,7 @@ void Warehouse::batchUpdateTags( const std::vector<endlesss::types::RiffTag>& in
 {
     blog::database( FMTX( "tags : batch updating {} items" ), inputTags.size() );
     m_cbTagBatching( true );
-    sql::tags::batchUpdate( inputTags, m_cbTagUpdate );
+    sql::tags::batchUpdate( inputTags, *m_hotTables, m_cbTagUpdate );
     m_cbTagBatching( false );
 }
 
@@ -2001,7 +2210,7 @@ void Warehouse::batchRemoveAllTags( const endlesss::types::JamCouchID& jamCID )
 {
     blog::database( FMTX( "tags : removing all tags for {}" ), jamCID );
     m_cbTagBatching( true );
-    sql::tags::batchRemoveAll( jamCID );
+    sql::tags::batchRemoveAll( jamCID, *m_hotTables );
     m_cbTagBatching( false );
 }
 
@@ -2275,7 +2484,7 @@ void Warehouse::threadWorker()
                         incrementChangeIndexForJam( owningJamCID );
 
                         // off to riff town
-                        m_taskSchedule->enqueueWorkTask<GetRiffDataTask>( *m_networkConfiguration, owningJamCID, emptyRiffs );
+                        m_taskSchedule->enqueueWorkTask<GetRiffDataTask>( *m_networkConfiguration, *m_hotTables, owningJamCID, emptyRiffs );
 
                         tryEnqueueReport( false );
 
@@ -2343,13 +2552,13 @@ void Warehouse::event_RiffTagAction( const events::RiffTagAction* eventData )
     {
         case events::RiffTagAction::Action::Upsert:
         {
-            sql::tags::upsert( eventData->m_tag, m_cbTagUpdate );
+            sql::tags::upsert( eventData->m_tag, *m_hotTables, m_cbTagUpdate );
         }
         break;
 
         case events::RiffTagAction::Action::Remove:
         {
-            sql::tags::remove( eventData->m_tag, m_cbTagRemoved );
+            sql::tags::remove( eventData->m_tag, *m_hotTables, m_cbTagRemoved );
         }
         break;
 
@@ -2475,6 +2684,7 @@ bool JamPurgeTask::Work( TaskQueue& currentTasks )
         Warehouse::SqlDB::query<deleteRiffs>( m_jamCID.value() );
         Warehouse::SqlDB::query<deleteStems>( m_jamCID.value() );
     }
+    m_hotTables.removeJamName( m_jamCID );
 
     blog::database( "[{}] wiped [{}] from Db", Tag, m_jamCID.value() );
     return true;
@@ -2634,12 +2844,13 @@ bool JamExportTask::Work( TaskQueue& currentTasks )
 
 
 // ---------------------------------------------------------------------------------------------------------------------
+// exports are written with one riff or stem per line (see JamExportTask) so rather than loading the whole file into a
+// single yaml tree we stream it, parsing each entry on its own and committing in bounded batches. each batch also
+// records how far through the file we got, so an interrupted import of a large jam can resume from the last commit
 bool JamImportTask::Work( TaskQueue& currentTasks )
 {
     OperationCompleteOnScopeExit( m_operationID );
 
-    auto loadStatus = base::readTextFile( m_fileToImport );
-
     auto handleFailure = [this]( const absl::Status& failureStatus ) -> bool
         {
             blog::error::database( FMTX( "Failed to import jam data from [{}]" ), m_fileToImport.string() );
@@ -2657,23 +2868,62 @@ bool JamImportTask::Work( TaskQueue& currentTasks )
     if ( !_valueName.ok() )                                                                 \
         return handleFailure( _valueName.status() );
 
-    if ( !loadStatus.ok() )
+    // identify the source file by size and modification time so that a stale checkpoint can't be applied to a
+    // different export that happens to have been written to the same path
+    std::error_code sourceError;
+    const uint64_t sourceSize = fs::file_size( m_fileToImport, sourceError );
+    if ( sourceError )
+    {
+        return handleFailure( absl::NotFoundError( fmt::format( FMTX( "unable to read [{}] ({})" ), m_fileToImport.string(), sourceError.message() ) ) );
+    }
+    const int64_t sourceTime = static_cast<int64_t>( fs::last_write_time( m_fileToImport, sourceError ).time_since_epoch().count() );
+    const std::string checkpointKey = fs::absolute( m_fileToImport, sourceError ).string();
+
+    std::ifstream yamlInput( m_fileToImport, std::ios::in | std::ios::binary );
+    if ( !yamlInput.is_open() )
     {
-        return handleFailure( loadStatus.status() );
+        return handleFailure( absl::NotFoundError( fmt::format( FMTX( "unable to open [{}]" ), m_fileToImport.string() ) ) );
     }
 
+    // read a line, dropping any trailing CR from files written in text mode on Windows
+    std::string yamlLine;
+    const auto readLine = [&]() -> bool
+        {
+            if ( !std::getline( yamlInput, yamlLine ) )
+                return false;
+            if ( !yamlLine.empty() && yamlLine.back() == '\r' )
+                yamlLine.pop_back();
+            return true;
+        };
+
     ryml::Tree yamlTree;
     ryml::Parser yamlParser;
 
     std::string parseName = m_fileToImport.filename().string();
 
     auto nameView = ryml::csubstr( std::data( parseName ), std::size( parseName ) );
-    auto bufferView = ryml::substr( std::data( loadStatus.value() ), std::size( loadStatus.value() ) );
 
-    yamlParser.parse_in_place( nameView, bufferView, &yamlTree );
+    // the header block is everything up to the start of the riffs list; parse that as a small document of its own
+    std::string headerText;
+    {
+        bool foundRiffsList = false;
+        while ( readLine() )
+        {
+            if ( yamlLine.rfind( "riffs:", 0 ) == 0 )
+            {
+                foundRiffsList = true;
+                break;
+            }
+            headerText += yamlLine;
+            headerText += '\n';
+        }
+        if ( !foundRiffsList )
+        {
+            return handleFailure( absl::InvalidArgumentError( fmt::format( FMTX( "[{}] has no riffs list, not a jam export?" ), parseName ) ) );
+        }
+    }
 
-    // begin a single mass transaction for adding the whole jam
-    Warehouse::SqlDB::TransactionGuard txn;
+    yamlParser.parse_in_place( nameView, ryml::substr( std::data( headerText ), std::size( headerText ) ), &yamlTree );
 
     // fetch required header entries that identify what we're about to load; any missing are considered import failures
     PARSE_AND_CHECK( headerExportTimeUnix,  double,         "export_time_unix" );
@@ -2689,186 +2939,268 @@ bool JamImportTask::Work( TaskQueue& currentTasks )
         blog::database( FMTX( "Export data from v.{}; {}" ), headerExportOuroVer.value(), exportTimeDelta );
     }
 
+    enum class ImportSection : int32_t
+    {
+        Riffs = 0,
+        Stems = 1
+    };
+    ImportSection importSection = ImportSection::Riffs;
+
+    // jump forward if a previous run of this import committed some batches before being interrupted
+    {
+        const uint64_t listStartOffset = static_cast<uint64_t>( yamlInput.tellg() );
+
+        uint64_t resumeOffset  = 0;
+        int32_t  resumeSection = 0;
+        if ( sql::imports::getResumePoint( checkpointKey, sourceSize, sourceTime, resumeOffset, resumeSection ) &&
+             resumeOffset > listStartOffset &&
+             resumeOffset < sourceSize )
+        {
+            blog::database( FMTX( "Resuming import of [{}] from byte {} of {}" ), parseName, resumeOffset, sourceSize );
+
+            yamlInput.seekg( static_cast<std::streamoff>( resumeOffset ) );
+            importSection = static_cast<ImportSection>( resumeSection );
+        }
+    }
+
+    std::size_t riffsImported = 0;
+    std::size_t stemsImported = 0;
+
+    // rows are written in batches, each closed out by a checkpoint of the byte offset of the next unread line
+    std::size_t rowsInBatch = 0;
+    std::optional< Warehouse::SqlDB::TransactionGuard > batchTxn;
+    batchTxn.emplace();
+
     // -----------------------------------------------------------------------------------------------------------------
-    ryml::ConstNodeRef yamlRiffsList = yamlTree["riffs"];
-    for ( ryml::ConstNodeRef const& yamlRiff : yamlRiffsList.children() )
+    while ( readLine() )
     {
-        const auto riffID = std::string( yamlRiff.key().data(), yamlRiff.key().size() );
+        if ( yamlLine.empty() || yamlLine[0] == '#' )
+            continue;
 
-        PARSE_AND_CHECK( rUser,         std::string,        "riff-user",    yamlRiff[0].val()  );
-        PARSE_AND_CHECK( rTimeUnix,     double,             "riff-ts",      yamlRiff[1].val()  );
-        PARSE_AND_CHECK( rRoot,         double,             "riff-root",    yamlRiff[2].val()  );
-        PARSE_AND_CHECK( rScale,        double,             "riff-scale",   yamlRiff[4].val()  );
-        PARSE_AND_CHECK( rBPS,          data::HexFloat,     "riff-bps",     yamlRiff[7].val()  );
-        PARSE_AND_CHECK( rBPMrnd,       data::HexFloat,     "riff-bpm-rnd", yamlRiff[9].val()  );
-        PARSE_AND_CHECK( rBarLength,    double,             "riff-bar-len", yamlRiff[10].val() );
-        PARSE_AND_CHECK( rAppVersion,   double,             "riff-appver",  yamlRiff[11].val() );
-        PARSE_AND_CHECK( rMagnitude,    double,             "riff-mag",     yamlRiff[20].val() );
+        if ( yamlLine.rfind( "stems:", 0 ) == 0 )
+        {
+            importSection = ImportSection::Stems;
+            continue;
+        }
 
-        std::array< std::string, 8 > stemCouchIDs;
-        std::array< float, 8 > stemGains;
-        std::array< bool, 8 > stemOn;
-        for ( int32_t stemIndex = 0; stemIndex < 8; stemIndex++ )
+        // list entries are indented by a single space; anything else at the top level is not something we know about
+        if ( yamlLine[0] != ' ' )
         {
-            const auto stemArrayValid = yamlRiff[12 + stemIndex].is_seq();
-            const auto stemArray = yamlRiff[12 + stemIndex];
+            blog::database( FMTX( "Ignoring unexpected line in [{}] : {}" ), parseName, yamlLine );
+            continue;
+        }
 
-            PARSE_AND_CHECK( stem_id,   std::string,        fmt::format( FMTX("stem{}-id"),     stemIndex ), stemArray[0].val() );
-            PARSE_AND_CHECK( stem_gain, data::HexFloat,     fmt::format( FMTX("stem{}-gain"),   stemIndex ), stemArray[2].val() );
-            PARSE_AND_CHECK( stem_on,   bool,               fmt::format( FMTX("stem{}-on"),     stemIndex ), stemArray[3].val() );
+        // each entry line is a complete single-key mapping, so it can be parsed in isolation
+        yamlTree.clear();
+        yamlTree.clear_arena();
+        yamlParser.parse_in_place( nameView, ryml::substr( std::data( yamlLine ) + 1, std::size( yamlLine ) - 1 ), &yamlTree );
 
-            stemCouchIDs[stemIndex] = std::move( stem_id.value() );
-            stemGains[stemIndex]    = stem_gain.value().result;
-            stemOn[stemIndex]       = stem_on.value();
+        ryml::ConstNodeRef yamlEntry = yamlTree.crootref().first_child();
+        if ( !yamlEntry.valid() || !yamlEntry.is_seq() )
+        {
+            return handleFailure( absl::InvalidArgumentError( fmt::format( FMTX( "unable to parse entry in [{}] : {}" ), parseName, yamlLine ) ) );
         }
 
-        auto gainsJsonText = fmt::format( R"([ {} ])", fmt::join( stemGains, ", " ) );
+        if ( importSection == ImportSection::Riffs )
+        {
+            const auto riffID = std::string( yamlEntry.key().data(), yamlEntry.key().size() );
 
-        static constexpr char injectNewRiff[] = R"(
-            INSERT OR IGNORE INTO riffs(
-                riffCID,
-                OwnerJamCID ) VALUES( ?1, ?2 );
-        )";
+            PARSE_AND_CHECK( rUser,         std::string,        "riff-user",    yamlEntry[0].val()  );
+            PARSE_AND_CHECK( rTimeUnix,     double,             "riff-ts",      yamlEntry[1].val()  );
+            PARSE_AND_CHECK( rRoot,         double,             "riff-root",    yamlEntry[2].val()  );
+            PARSE_AND_CHECK( rScale,        double,             "riff-scale",   yamlEntry[4].val()  );
+            PARSE_AND_CHECK( rBPS,          data::HexFloat,     "riff-bps",     yamlEntry[7].val()  );
+            PARSE_AND_CHECK( rBPMrnd,       data::HexFloat,     "riff-bpm-rnd", yamlEntry[9].val()  );
+            PARSE_AND_CHECK( rBarLength,    double,             "riff-bar-len", yamlEntry[10].val() );
+            PARSE_AND_CHECK( rAppVersion,   double,             "riff-appver",  yamlEntry[11].val() );
+            PARSE_AND_CHECK( rMagnitude,    double,             "riff-mag",     yamlEntry[20].val() );
 
-        static constexpr char populateRiffData[] = R"(
-            UPDATE riffs SET
-                CreationTime=?2,
-                Root=?3,
-                Scale=?4,
-                BPS=?5,
-                BPMrnd=?6,
-                BarLength=?7,
-                AppVersion=?8,
-                Magnitude=?9,
-                UserName=?10,
-                StemCID_1=?11,
-                StemCID_2=?12,
-                StemCID_3=?13,
-                StemCID_4=?14,
-                StemCID_5=?15,
-                StemCID_6=?16,
-                StemCID_7=?17,
-                StemCID_8=?18,
-                GainsJSON=?19
-                WHERE riffCID=?1
-        )";
+            std::array< std::string, 8 > stemCouchIDs;
+            std::array< float, 8 > stemGains;
+            std::array< bool, 8 > stemOn;
+            for ( int32_t stemIndex = 0; stemIndex < 8; stemIndex++ )
+            {
+                const auto stemArrayValid = yamlEntry[12 + stemIndex].is_seq();
+                const auto stemArray = yamlEntry[12 + stemIndex];
 
-        Warehouse::SqlDB::query<injectNewRiff>(
-            riffID.c_str(),
-            headerJamCouchID.value()
-        );
+                PARSE_AND_CHECK( stem_id,   std::string,        fmt::format( FMTX("stem{}-id"),     stemIndex ), stemArray[0].val() );
+                PARSE_AND_CHECK( stem_gain, data::HexFloat,     fmt::format( FMTX("stem{}-gain"),   stemIndex ), stemArray[2].val() );
+                PARSE_AND_CHECK( stem_on,   bool,               fmt::format( FMTX("stem{}-on"),     stemIndex ), stemArray[3].val() );
 
-        Warehouse::SqlDB::query<populateRiffData>(
-            riffID.c_str(),
-            static_cast<uint64_t>( rTimeUnix.value() ),
-            static_cast<uint32_t>( rRoot.value() ),
-            static_cast<uint32_t>( rScale.value() ),
-            rBPS.value().result,
-            rBPMrnd.value().result,
-            static_cast<uint32_t>(rBarLength.value()),
-            static_cast<uint32_t>(rAppVersion.value()),
-            static_cast<float>(rMagnitude.value()),
-            rUser.value().c_str(),
-            stemOn[0] ? stemCouchIDs[0].c_str() : "",
-            stemOn[1] ? stemCouchIDs[1].c_str() : "",
-            stemOn[2] ? stemCouchIDs[2].c_str() : "",
-            stemOn[3] ? stemCouchIDs[3].c_str() : "",
-            stemOn[4] ? stemCouchIDs[4].c_str() : "",
-            stemOn[5] ? stemCouchIDs[5].c_str() : "",
-            stemOn[6] ? stemCouchIDs[6].c_str() : "",
-            stemOn[7] ? stemCouchIDs[7].c_str() : "",
-            gainsJsonText.c_str()
-        );
-    }
+                stemCouchIDs[stemIndex] = std::move( stem_id.value() );
+                stemGains[stemIndex]    = stem_gain.value().result;
+                stemOn[stemIndex]       = stem_on.value();
+            }
 
-    // -----------------------------------------------------------------------------------------------------------------
-    ryml::ConstNodeRef yamlStemsList = yamlTree["stems"];
-    for ( ryml::ConstNodeRef const& yamlStem : yamlStemsList.children() )
-    {
-        const auto stemID = std::string( yamlStem.key().data(), yamlStem.key().size() );
-
-        PARSE_AND_CHECK( sFileEnd,      std::string,        "stem-endpoint",yamlStem[0].val()  );
-        PARSE_AND_CHECK( sFileBucket,   std::string,        "stem-bucket",  yamlStem[1].val()  );
-        PARSE_AND_CHECK( sFileKey,      std::string,        "stem-key",     yamlStem[2].val()  );
-        PARSE_AND_CHECK( sFileMIME,     std::string,        "stem-mime",    yamlStem[3].val()  );
-        PARSE_AND_CHECK( sFileLenByte,  double,             "stem-f-len",   yamlStem[4].val()  );
-        PARSE_AND_CHECK( sSampleRate,   double,             "stem-s-rate",  yamlStem[5].val()  );
-        PARSE_AND_CHECK( sTimeUnix,     double,             "stem-ts",      yamlStem[6].val()  );
-        PARSE_AND_CHECK( sPreset,       std::string,        "stem-preset",  yamlStem[7].val()  );
-        PARSE_AND_CHECK( sUser,         std::string,        "stem-user",    yamlStem[8].val()  );
-        PARSE_AND_CHECK( sColour,       std::string,        "stem-colour",  yamlStem[9].val()  );
-        PARSE_AND_CHECK( sBPS,          data::HexFloat,     "stem-bps",     yamlStem[11].val() );
-        PARSE_AND_CHECK( sBPMrnd,       data::HexFloat,     "stem-bpm-rnd", yamlStem[13].val() );
-        PARSE_AND_CHECK( sLength16s,    double,             "stem-len16",   yamlStem[14].val() );
-        PARSE_AND_CHECK( sPitch,        double,             "stem-pitch",   yamlStem[15].val() );
-        PARSE_AND_CHECK( sBarLength,    double,             "stem-bar-len", yamlStem[16].val() );
-        PARSE_AND_CHECK( sIsDrum,       bool,               "stem-is-drum", yamlStem[17].val() );
-        PARSE_AND_CHECK( sIsNote,       bool,               "stem-is-note", yamlStem[18].val() );
-        PARSE_AND_CHECK( sIsBass,       bool,               "stem-is-bass", yamlStem[19].val() );
-        PARSE_AND_CHECK( sIsMic,        bool,               "stem-is-mic",  yamlStem[20].val() );
+            auto gainsJsonText = fmt::format( R"([ {} ])", fmt::join( stemGains, ", " ) );
 
-        int32_t instrumentMask = 0;
-        if ( sIsDrum.value() )
-            instrumentMask |= 1 << 1;
-        if ( sIsNote.value() )
-            instrumentMask |= 1 << 2;
-        if ( sIsBass.value() )
-            instrumentMask |= 1 << 3;
-        if ( sIsMic.value() )
-            instrumentMask |= 1 << 4;
+            static constexpr char injectNewRiff[] = R"(
+                INSERT OR IGNORE INTO riffs(
+                    riffCID,
+                    OwnerJamCID ) VALUES( ?1, ?2 );
+            )";
 
-        static constexpr char injectNewStem[] = R"(
-            INSERT OR IGNORE INTO stems(
-                stemCID, OwnerJamCID ) VALUES( ?1, ?2 );
-        )";
+            static constexpr char populateRiffData[] = R"(
+                UPDATE riffs SET
+                    CreationTime=?2,
+                    Root=?3,
+                    Scale=?4,
+                    BPS=?5,
+                    BPMrnd=?6,
+                    BarLength=?7,
+                    AppVersion=?8,
+                    Magnitude=?9,
+                    UserName=?10,
+                    StemCID_1=?11,
+                    StemCID_2=?12,
+                    StemCID_3=?13,
+                    StemCID_4=?14,
+                    StemCID_5=?15,
+                    StemCID_6=?16,
+                    StemCID_7=?17,
+                    StemCID_8=?18,
+                    GainsJSON=?19
+                    WHERE riffCID=?1
+            )";
 
-        static constexpr char updateStemDetails[] = R"(
-            UPDATE stems SET 
-                CreationTime=?2,
-                FileEndpoint=?3,
-                FileBucket=?4,
-                FileKey=?5,
-                FileMIME=?6,
-                FileLength=?7,
-                BPS=?8,
-                BPMrnd=?9,
-                Instrument=?10,
-                Length16s=?11,
-                OriginalPitch=?12,
-                BarLength=?13,
-                PresetName=?14,
-                CreatorUserName=?15,
-                SampleRate=?16,
-                PrimaryColour=?17
-                WHERE stemCID=?1
-        )";
+            Warehouse::SqlDB::query<injectNewRiff>(
+                riffID.c_str(),
+                headerJamCouchID.value()
+            );
 
-        Warehouse::SqlDB::query<injectNewStem>(
-            stemID.c_str(),
-            headerJamCouchID.value()
-        );
+            Warehouse::SqlDB::query<populateRiffData>(
+                riffID.c_str(),
+                static_cast<uint64_t>( rTimeUnix.value() ),
+                static_cast<uint32_t>( rRoot.value() ),
+                static_cast<uint32_t>( rScale.value() ),
+                rBPS.value().result,
+                rBPMrnd.value().result,
+                static_cast<uint32_t>(rBarLength.value()),
+                static_cast<uint32_t>(rAppVersion.value()),
+                static_cast<float>(rMagnitude.value()),
+                rUser.value().c_str(),
+                stemOn[0] ? stemCouchIDs[0].c_str() : "",
+                stemOn[1] ? stemCouchIDs[1].c_str() : "",
+                stemOn[2] ? stemCouchIDs[2].c_str() : "",
+                stemOn[3] ? stemCouchIDs[3].c_str() : "",
+                stemOn[4] ? stemCouchIDs[4].c_str() : "",
+                stemOn[5] ? stemCouchIDs[5].c_str() : "",
+                stemOn[6] ? stemCouchIDs[6].c_str() : "",
+                stemOn[7] ? stemCouchIDs[7].c_str() : "",
+                gainsJsonText.c_str()
+            );
 
-        Warehouse::SqlDB::query<updateStemDetails>(
-            stemID.c_str(),
-            static_cast<uint64_t>( sTimeUnix.value() ),
-            sFileEnd.value().c_str(),
-            sFileBucket.value().c_str(),
-            sFileKey.value().c_str(),
-            sFileMIME.value().c_str(),
-            static_cast<uint64_t>( sFileLenByte.value() ),
-            sBPS.value().result,
-            sBPMrnd.value().result,
-            instrumentMask,
-            static_cast<uint64_t>( sLength16s.value() ),
-            static_cast<uint64_t>( sPitch.value() ),
-            static_cast<uint64_t>( sBarLength.value() ),
-            sPreset.value().c_str(),
-            sUser.value().c_str(),
-            static_cast<uint64_t>(sSampleRate.value()),
-            sColour.value().c_str()
-        );
+            riffsImported++;
+        }
+        else
+        {
+            const auto stemID = std::string( yamlEntry.key().data(), yamlEntry.key().size() );
+
+            PARSE_AND_CHECK( sFileEnd,      std::string,        "stem-endpoint",yamlEntry[0].val()  );
+            PARSE_AND_CHECK( sFileBucket,   std::string,        "stem-bucket",  yamlEntry[1].val()  );
+            PARSE_AND_CHECK( sFileKey,      std::string,        "stem-key",     yamlEntry[2].val()  );
+            PARSE_AND_CHECK( sFileMIME,     std::string,        "stem-mime",    yamlEntry[3].val()  );
+            PARSE_AND_CHECK( sFileLenByte,  double,             "stem-f-len",   yamlEntry[4].val()  );
+            PARSE_AND_CHECK( sSampleRate,   double,             "stem-s-rate",  yamlEntry[5].val()  );
+            PARSE_AND_CHECK( sTimeUnix,     double,             "stem-ts",      yamlEntry[6].val()  );
+            PARSE_AND_CHECK( sPreset,       std::string,        "stem-preset",  yamlEntry[7].val()  );
+            PARSE_AND_CHECK( sUser,         std::string,        "stem-user",    yamlEntry[8].val()  );
+            PARSE_AND_CHECK( sColour,       std::string,        "stem-colour",  yamlEntry[9].val()  );
+            PARSE_AND_CHECK( sBPS,          data::HexFloat,     "stem-bps",     yamlEntry[11].val() );
+            PARSE_AND_CHECK( sBPMrnd,       data::HexFloat,     "stem-bpm-rnd", yamlEntry[13].val() );
+            PARSE_AND_CHECK( sLength16s,    double,             "stem-len16",   yamlEntry[14].val() );
+            PARSE_AND_CHECK( sPitch,        double,             "stem-pitch",   yamlEntry[15].val() );
+            PARSE_AND_CHECK( sBarLength,    double,             "stem-bar-len", yamlEntry[16].val() );
+            PARSE_AND_CHECK( sIsDrum,       bool,               "stem-is-drum", yamlEntry[17].val() );
+            PARSE_AND_CHECK( sIsNote,       bool,               "stem-is-note", yamlEntry[18].val() );
+            PARSE_AND_CHECK( sIsBass,       bool,               "stem-is-bass", yamlEntry[19].val() );
+            PARSE_AND_CHECK( sIsMic,        bool,               "stem-is-mic",  yamlEntry[20].val() );
+
+            int32_t instrumentMask = 0;
+            if ( sIsDrum.value() )
+                instrumentMask |= 1 << 1;
+            if ( sIsNote.value() )
+                instrumentMask |= 1 << 2;
+            if ( sIsBass.value() )
+                instrumentMask |= 1 << 3;
+            if ( sIsMic.value() )
+                instrumentMask |= 1 << 4;
+
+            static constexpr char injectNewStem[] = R"(
+                INSERT OR IGNORE INTO stems(
+                    stemCID, OwnerJamCID ) VALUES( ?1, ?2 );
+            )";
+
+            static constexpr char updateStemDetails[] = R"(
+                UPDATE stems SET 
+                    CreationTime=?2,
+                    FileEndpoint=?3,
+                    FileBucket=?4,
+                    FileKey=?5,
+                    FileMIME=?6,
+                    FileLength=?7,
+                    BPS=?8,
+                    BPMrnd=?9,
+                    Instrument=?10,
+                    Length16s=?11,
+                    OriginalPitch=?12,
+                    BarLength=?13,
+                    PresetName=?14,
+                    CreatorUserName=?15,
+                    SampleRate=?16,
+                    PrimaryColour=?17
+                    WHERE stemCID=?1
+            )";
+
+            Warehouse::SqlDB::query<injectNewStem>(
+                stemID.c_str(),
+                headerJamCouchID.value()
+            );
+
+            Warehouse::SqlDB::query<updateStemDetails>(
+                stemID.c_str(),
+                static_cast<uint64_t>( sTimeUnix.value() ),
+                sFileEnd.value().c_str(),
+                sFileBucket.value().c_str(),
+                sFileKey.value().c_str(),
+                sFileMIME.value().c_str(),
+                static_cast<uint64_t>( sFileLenByte.value() ),
+                sBPS.value().result,
+                sBPMrnd.value().result,
+                instrumentMask,
+                static_cast<uint64_t>( sLength16s.value() ),
+                static_cast<uint64_t>( sPitch.value() ),
+                static_cast<uint64_t>( sBarLength.value() ),
+                sPreset.value().c_str(),
+                sUser.value().c_str(),
+                static_cast<uint64_t>(sSampleRate.value()),
+                sColour.value().c_str()
+            );
+
+            stemsImported++;
+        }
+
+        if ( ++rowsInBatch >= cImportRowsPerBatch )
+        {
+            const auto nextLineOffset = yamlInput.tellg();
+            if ( nextLineOffset >= 0 )
+            {
+                sql::imports::storeResumePoint( checkpointKey, sourceSize, sourceTime, static_cast<uint64_t>( nextLineOffset ), static_cast<int32_t>( importSection ) );
+            }
+
+            // commit and immediately open the next batch
+            batchTxn.reset();
+            batchTxn.emplace();
+            rowsInBatch = 0;
+        }
     }
 
+    // all done, nothing to resume from next time
+    sql::imports::clearResumePoint( checkpointKey );
+    batchTxn.reset();
+
+    blog::database( FMTX( "Imported {} riffs, {} stems into [{}]" ), riffsImported, stemsImported, headerJamName.value() );
+
     // toss the imported jam name into the name stash
     m_eventBusClient.Send<::events::BNSJamNameUpdate>( endlesss::types::JamCouchID( headerJamCouchID.value() ), headerJamName.value() );
 
@@ -3100,6 +3432,7 @@ bool GetRiffDataTask::Work( TaskQueue& currentTasks )
             blog::database( "[{}] Found stem with a retreival error ({}), ignoring ID [{}]", Tag, stemCheck.error, stemCheck.key );
 
             sql::ledger::storeStemNote(
+                m_hotTables,
                 stemCheck.key,
                 Warehouse::StemLedgerType::REMOVED_ID,
                 fmt::format( "[{}]", stemCheck.error ) );
@@ -3120,6 +3453,7 @@ bool GetRiffDataTask::Work( TaskQueue& currentTasks )
             blog::database( "[{}] Found stem without app version ({}), ignoring ID [{}]", Tag, stemCheck.doc._attachments.oggAudio.digest, stemCheck.key );
 
             sql::ledger::storeStemNote(
+                m_hotTables,
                 stemCheck.key,
                 Warehouse::StemLedgerType::REMOVED_ID,
                 fmt::format( "[{}]", stemCheck.error ) );
@@ -3133,6 +3467,7 @@ bool GetRiffDataTask::Work( TaskQueue& currentTasks )
             blog::database( "[{}] Found stem that was deleted ({}), ignoring ID [{}]", Tag, stemCheck.error, stemCheck.key );
 
             sql::ledger::storeStemNote(
+                m_hotTables,
                 stemCheck.key,
                 Warehouse::StemLedgerType::REMOVED_ID,
                 fmt::format( "[{}]", stemCheck.error ) );
@@ -3147,6 +3482,7 @@ bool GetRiffDataTask::Work( TaskQueue& currentTasks )
             blog::database( "[{}] Found stem that isn't a stem ({}), ignoring ID [{}]", Tag, stemCheck.doc.type, stemCheck.doc._id );
 
             sql::ledger::storeStemNote(
+                m_hotTables,
                 stemCheck.doc._id,
                 Warehouse::StemLedgerType::DAMAGED_REFERENCE,
                 fmt::format( "[Ver:{}] Wrong type [{}]", stemCheck.doc.app_version, stemCheck.doc.type ) );
@@ -3161,6 +3497,7 @@ bool GetRiffDataTask::Work( TaskQueue& currentTasks )
             blog::database( "[{}] Found stem that is damaged, ignoring ID [{}]", Tag, stemCheck.doc._id );
 
             sql::ledger::storeStemNote(
+                m_hotTables,
                 stemCheck.doc._id,
                 Warehouse::StemLedgerType::MISSING_OGG,   // previously this only happened with OGG sources.. potentially we could have missing FLAC here too
                 fmt::format( "[Ver:{}]", stemCheck.doc.app_version ) );
@@ -165,6 +165,7 @@ struct Warehouse
 
     struct ITask;
     struct INetworkTask;
+    struct HotTables;
 
     using WorkUpdateCallback    = std::function<void( const bool tasksRunning, const std::string& currentTask ) >;
 
@@ -179,6 +180,11 @@ struct Warehouse
     static std::string  m_databaseFile;
     using SqlDB = sqlite::Database<m_databaseFile>;
 
+    // SqlDB hands each thread its own connection (and its own cache of prepared statements), so with the database
+    // in WAL mode UI-side reads can proceed while the worker thread holds a write transaction open
+    static constexpr int64_t cSqliteMmapSizeBytes       = 256 * 1024 * 1024;    // per-connection memory-mapped read window
+    static constexpr int64_t cSqliteJournalSizeLimit    = 64 * 1024 * 1024;     // trim the -wal file back to this after checkpoints
+
     // -----------------------------------------------------------------------------------------------------------------
 
 
@@ -209,7 +215,7 @@ struct Warehouse
     // upsert all jamID -> display name records from the Band Name Service record, similar to above
     void upsertJamDictionaryFromBNS( const config::endlesss::BandNameService& bnsData );
 
-    // fetch a list of all the JamID -> display name rows we have as a lookup table
+    // fetch a list of all the JamID -> display name rows we have as a lookup table; served from memory
     void extractJamDictionary( types::JamIDToNameMap& jamDictionary ) const;
 
 
@@ -303,12 +309,16 @@ struct Warehouse
     // resolve a single stem data block from the database, if we can find it; returns false if we didn't
     bool fetchSingleStemByID( const types::StemCouchID& stemCouchID, endlesss::types::Stem& result ) const;
 
+    // resolve a batch of stem data blocks under a single transaction; result is index-matched to the input, with an
+    // empty couchID for any stem that couldn't be found. returns how many were found
+    std::size_t batchFetchStemsByID( const endlesss::types::StemCouchIDs& stems, std::vector< endlesss::types::Stem >& result ) const;
+
     // do you want all the stems? all of them? damn son alright
     bool fetchAllStems( endlesss::types::StemCouchIDs& result, std::size_t& estimatedTotalFileSize ) const;
 
 
     // see if we have any notes for a stem ID (if it was removed from the database during a sync for some reason)
-    // returns false if we have no record for this stem ID
+    // returns false if we have no record for this stem ID. served from memory, safe to call from any thread
     bool getNoteTypeForStem( const types::StemCouchID& stemCID, StemLedgerType& typeResult );
 
 
@@ -322,7 +332,8 @@ struct Warehouse
     // delete the tag from the database
     void removeTag( const endlesss::types::RiffTag& tag );
 
-    // returns true if the given riff has tag data, optionally also returning the tag data if a structure is passed in
+    // returns true if the given riff has tag data, optionally also returning the tag data if a structure is passed in;
+    // served from memory, safe to call from any thread
     bool isRiffTagged( const endlesss::types::RiffCouchID& riffID, endlesss::types::RiffTag* tagOutput = nullptr ) const;
 
     // get the current set of tags for a jam; returns the size of outputTags on return
@@ -397,6 +408,8 @@ protected:
     std::unique_ptr<TaskSchedule>           m_taskSchedule;
     std::unique_ptr<TaskSchedule>           m_taskSchedulePriority;     // parallel queue used to stage tasks that should be run before the default queue gets a look in
 
+    std::unique_ptr<HotTables>              m_hotTables;                // in-memory copy of the tags, stem ledger and jam name tables
+
     ChangeIndexMap                          m_changeIndexMap;
 
     WorkUpdateCallback                      m_cbWorkUpdate              = nullptr;
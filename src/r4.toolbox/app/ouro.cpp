@@ -900,6 +900,15 @@ int OuroApp::EntrypointGUI()
                         }
                         ImGui::PopItemWidth();
 
+                        {
+                            ImGui::AlignTextToFramePadding();
+                            ImGui::TextDisabled( "[?]" );
+                            ImGui::CompactTooltip( "Store loaded stems as 16-bit samples instead of 32-bit float.\nStem data is 16-bit at source so there is no audible\ndifference; this roughly doubles how many stems fit\ninside the Stem Cache Memory Target" );
+                            ImGui::SameLine();
+
+                            ImGui::Checkbox( " Compact Stem Storage", &m_configPerf.enableCompactStemStorage );
+                        }
+
 
                         ImGui::Unindent( perBlockIndent );
                         ImGui::Spacing();
@@ -1041,6 +1050,7 @@ int OuroApp::EntrypointGUI()
         }
     }
 
+    m_taskExecutorIO.wait_for_all();
     m_taskExecutor.wait_for_all();
 
     if ( m_mdFrontEnd->wasQuitRequested() )
@@ -1060,53 +1070,20 @@ int OuroApp::EntrypointGUI()
             }
         });
 
-    // events
-    {
-        APP_EVENT_REGISTER( ExportRiff );
-        APP_EVENT_REGISTER_SPECIFIC( MixerRiffChange, 16 * 4096 );
-
-        {
-            base::EventBusClient m_eventBusClient( m_appEventBus );
-            APP_EVENT_BIND_TO( ExportRiff );
-            APP_EVENT_BIND_TO( RequestToShareRiff );
-            APP_EVENT_BIND_TO( BNSCacheMiss );
-            APP_EVENT_BIND_TO( BNSJamNameUpdate );
-        }
-    }
+    registerSessionEvents();
 
     // audio init must run on the main thread, saves any COM issues when spinning up ASIO drivers on a new thread
     const auto audioInitStatus = m_mdAudio->initOutput( audioConfig, audioSpectrumConfig );
 
     // kick post-configuration session tasks, run off main thread so we don't stall the whole UI
-    auto sessionStartFuture = m_taskExecutor.async( "init_session", [this, audioInitStatus, &audioConfig, &audioSpectrumConfig]() -> absl::Status
+    auto sessionStartFuture = m_taskExecutor.async( "init_session", [this, audioInitStatus]() -> absl::Status
         {
             if ( !audioInitStatus.ok() )
             {
                 return audioInitStatus;
             }
 
-            // boot stem cache now we have paths & audio configured
-            const auto stemCacheStatus = m_stemCache.initialise( m_storagePaths->cacheCommon, m_mdAudio->getSampleRate() );
-            if ( !stemCacheStatus.ok() )
-            {
-                return stemCacheStatus;
-            }
-            m_stemCacheLastPruneCheck.setToFuture( c_stemCachePruneCheckDuration );
-            m_stemCachePruneTask.emplace( [this]() { m_stemCache.lockAndPrune( false ); } );
-
-            // create universal warehouse instance
-            {
-                m_warehouse = std::make_unique<endlesss::toolkit::Warehouse>(
-                    m_storagePaths.value(),
-                    m_networkConfiguration,
-                    m_appEventBus );
-
-                m_warehouse->upsertJamDictionaryFromCache( m_jamLibrary );              // update warehouse list of jam IDs -> names from the current cache
-                m_warehouse->upsertJamDictionaryFromBNS( m_jamNameService );            // .. and same with the BNS entries
-                m_warehouse->extractJamDictionary( m_jamHistoricalFromWarehouse );      // pull full list of jam IDs -> names from warehouse as "historical" list
-            }
-
-            return absl::OkStatus();
+            return initialiseSessionServices();
         });
 
     // run a short "please wait" UI loop while we let the above async task complete & display any errors found
@@ -1214,6 +1191,158 @@ int OuroApp::EntrypointGUI()
     //
     // =================================================================================================================
 
+    shutdownSession();
+
+    return appResult;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// bring up the same session as the GUI preflight does, but purely from configuration already saved to disk; anything
+// normally chosen interactively - storage root, audio device, Endlesss credentials - has to have been set up before,
+// usually by running the app once with its UI
+//
+int OuroApp::EntrypointHeadless()
+{
+    std::ignore = config::load( *this, m_configExportOutput );
+
+    if ( !m_configData.has_value() )
+    {
+        blog::error::cfg( FMTX( "headless mode requires a data storage configuration [{}]" ), config::Data::StorageFilename );
+        return -2;
+    }
+    m_storagePaths = StoragePaths( m_configData.value(), GetAppCacheName() );
+    if ( !m_storagePaths->tryToCreateAndValidate() )
+    {
+        blog::error::cfg( FMTX( "unable to validate storage paths under [{}]" ), m_configData->storageRoot );
+        return -2;
+    }
+
+    config::Audio audioConfig;
+    if ( config::load( *this, audioConfig ) != config::LoadResult::Success )
+    {
+        blog::error::cfg( "headless mode requires saved audio settings to choose an output device" );
+        return -2;
+    }
+
+    config::Spectrum audioSpectrumConfig;
+    std::ignore = config::load( *this, audioSpectrumConfig );
+
+#if OURO_HAS_NDLS_ONLINE
+    {
+        config::endlesss::Auth endlesssAuth;
+        const bool authLoaded = ( config::load( *this, endlesssAuth ) == config::LoadResult::Success );
+
+        // endlesss unix times are in nano precision
+        uint32_t expireDays, expireHours, expireMins, expireSecs;
+        const bool authValid = authLoaded &&
+            spacetime::datestampUnixExpiryFromNow( endlesssAuth.expires / 1000, expireDays, expireHours, expireMins, expireSecs );
+
+        if ( authValid )
+        {
+            m_networkConfiguration->initWithAuthentication( m_appEventBus, m_configEndlesssAPI, endlesssAuth );
+        }
+        else if ( supportsUnauthorisedEndlesssMode() )
+        {
+            blog::app( FMTX( "no valid Endlesss authentication found, continuing with public access only" ) );
+            m_networkConfiguration->initWithoutAuthentication( m_appEventBus, m_configEndlesssAPI );
+        }
+        else
+        {
+            blog::error::cfg( FMTX( "headless mode requires valid Endlesss authentication; missing or expired" ) );
+            return -2;
+        }
+    }
+#else
+    std::ignore = config::load( *this, m_configNoNet );
+    m_networkConfiguration->initWithoutAuthentication( m_appEventBus, m_configEndlesssAPI );
+#endif // OURO_HAS_NDLS_ONLINE
+
+    m_networkConfiguration->setQuality( m_configPerf.enableUnstableNetworkCompensation ?
+        endlesss::api::NetConfiguration::NetworkQuality::Unstable :
+        endlesss::api::NetConfiguration::NetworkQuality::Stable );
+
+    registerSessionEvents();
+
+    absl::Status sessionStatus = m_mdAudio->initOutput( audioConfig, audioSpectrumConfig );
+    if ( sessionStatus.ok() )
+        sessionStatus = initialiseSessionServices();
+
+    int appResult = -1;
+    if ( sessionStatus.ok() )
+    {
+        registerMainThreadCall( "name-resolution", [this]( float deltaTime )
+            {
+                updateJamNameResolutionTasks( deltaTime ); 
+            });
+
+        appResult = EntrypointOuroHeadless();
+    }
+    else
+    {
+        blog::error::app( FMTX( "session startup failed; {}" ), sessionStatus.ToString() );
+    }
+
+    shutdownSession();
+
+    return appResult;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+int OuroApp::EntrypointOuroHeadless()
+{
+    blog::error::app( FMTX( "{} has no headless mode" ), GetAppName() );
+    return -1;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void OuroApp::registerSessionEvents()
+{
+    APP_EVENT_REGISTER( ExportRiff );
+    APP_EVENT_REGISTER_SPECIFIC( MixerRiffChange, 16 * 4096 );
+
+    {
+        base::EventBusClient m_eventBusClient( m_appEventBus );
+        APP_EVENT_BIND_TO( ExportRiff );
+        APP_EVENT_BIND_TO( RequestToShareRiff );
+        APP_EVENT_BIND_TO( BNSCacheMiss );
+        APP_EVENT_BIND_TO( BNSJamNameUpdate );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status OuroApp::initialiseSessionServices()
+{
+    // boot stem cache now we have paths & audio configured
+    const auto stemSampleStorage = m_configPerf.enableCompactStemStorage ?
+        endlesss::live::Stem::SampleStorage::Int16 :
+        endlesss::live::Stem::SampleStorage::Float32;
+
+    const auto stemCacheStatus = m_stemCache.initialise( m_storagePaths->cacheCommon, m_mdAudio->getSampleRate(), stemSampleStorage );
+    if ( !stemCacheStatus.ok() )
+    {
+        return stemCacheStatus;
+    }
+    m_stemCacheLastPruneCheck.setToFuture( c_stemCachePruneCheckDuration );
+    m_stemCachePruneTask.emplace( [this]() { m_stemCache.lockAndPrune( false ); } );
+
+    // create universal warehouse instance
+    {
+        m_warehouse = std::make_unique<endlesss::toolkit::Warehouse>(
+            m_storagePaths.value(),
+            m_networkConfiguration,
+            m_appEventBus );
+
+        m_warehouse->upsertJamDictionaryFromCache( m_jamLibrary );              // update warehouse list of jam IDs -> names from the current cache
+        m_warehouse->upsertJamDictionaryFromBNS( m_jamNameService );            // .. and same with the BNS entries
+        m_warehouse->extractJamDictionary( m_jamHistoricalFromWarehouse );      // pull full list of jam IDs -> names from warehouse as "historical" list
+    }
+
+    return absl::OkStatus();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void OuroApp::shutdownSession()
+{
     // unhook events
     {
         base::EventBusClient m_eventBusClient( m_appEventBus );
@@ -1225,14 +1354,13 @@ int OuroApp::EntrypointGUI()
     // wrap up any dangling async work before teardown
     ensureStemCacheChecksComplete();
     
-    // ensure executor is drained
+    // ensure executors are drained; i/o first, as those tasks can still be handing work over to the compute side
+    m_taskExecutorIO.wait_for_all();
     m_taskExecutor.wait_for_all();
 
     {
         m_warehouse.reset();
     }
-
-    return appResult;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -1353,7 +1481,7 @@ void OuroApp::event_RequestToShareRiff( const events::RequestToShareRiff* eventD
         netCfg = getNetworkConfiguration(),
         state = ux::createModelRiffFeedShareState( eventData->m_identity ) ](const char* title)
     {
-        ux::modalRiffFeedShare( title, *state, netCfg, getTaskExecutor() );
+        ux::modalRiffFeedShare( title, *state, netCfg, getTaskExecutorIO() );
     });
 
 #else 
@@ -1373,7 +1501,7 @@ void OuroApp::event_BNSCacheMiss( const events::BNSCacheMiss* eventData )
 
     // kick a task that uses a few network calls to go from a band### id to a public name; this uses the permalink
     // endpoint (to get the extended ID) and the public riff API with that ID to snag the names
-    getTaskExecutor().silent_async( [this, jamID = eventData->m_jamID, netCfg = getNetworkConfiguration()]()
+    getTaskExecutorIO().silent_async( [this, jamID = eventData->m_jamID, netCfg = getNetworkConfiguration()]()
         {
             blog::api( FMTX( "name resolution for {}" ), jamID );
 
@@ -1485,7 +1613,12 @@ base::OperationID OuroApp::enqueueJamStemArchiveImportAsync( const fs::path& pat
             base::EventBusClient m_eventBusClient( m_appEventBus );
             OperationCompleteOnScopeExit( importOperationID );
 
-            std::size_t filesTouched = 0;
+            // stems already present in the cache at the right size are left alone; this also means re-running an
+            // import that was interrupted only pays for the stems it hadn't reached yet
+            io::UnarchiveOptions unarchiveOptions;
+            unarchiveOptions.m_skipExistingWithSameSize = true;
+
+            io::UnarchiveStats unarchiveStats;
 
             const auto tarArchiveStatus = io::unarchiveTARIntoDirectory(
                 inputTarFile,
@@ -1498,9 +1631,9 @@ base::OperationID OuroApp::enqueueJamStemArchiveImportAsync( const fs::path& pat
                         m_eventBusClient.Send< ::events::AsyncTaskActivity >();
                         std::this_thread::yield();
                     }
-
-                    filesTouched++;
-                });
+                },
+                unarchiveOptions,
+                &unarchiveStats );
 
             // deal with issues, tell user we bailed
             if ( !tarArchiveStatus.ok() )
@@ -1514,7 +1647,7 @@ base::OperationID OuroApp::enqueueJamStemArchiveImportAsync( const fs::path& pat
             {
                 m_appEventBus->send<::events::AddToastNotification>( ::events::AddToastNotification::Type::Info,
                     ICON_FA_BOXES_PACKING " Stem Import Success",
-                    fmt::format( FMTX( "Extracted {} stems" ), filesTouched ) );
+                    fmt::format( FMTX( "Extracted {} stems, {} already cached" ), unarchiveStats.m_filesWritten, unarchiveStats.m_filesSkipped ) );
             }
         });
 
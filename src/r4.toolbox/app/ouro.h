@@ -43,6 +43,7 @@ struct OuroApp : public CoreGUI,
     const endlesss::api::NetConfiguration&  getNetConfiguration() const override { return *m_networkConfiguration; }
     endlesss::cache::Stems&                 getStemCache() override { return m_stemCache; }
     tf::Executor&                           getTaskExecutor() override { return m_taskExecutor; }
+    tf::Executor&                           getTaskExecutorIO() override { return m_taskExecutorIO; }
 
 
     const StoragePaths* getStoragePaths() const override
@@ -69,6 +70,19 @@ protected:
     // inheritants implement this as app entrypoint
     virtual int EntrypointOuro() = 0;
 
+    // from CoreGUI
+    // boots the session from saved configuration without any UI, then passes to EntrypointOuroHeadless
+    virtual int EntrypointHeadless() override;
+
+    // inheritants that support headless running implement this as the entrypoint for it; by default, logs and exits
+    virtual int EntrypointOuroHeadless();
+
+
+    // shared session setup & teardown, used by both GUI and headless entrypoints
+    void registerSessionEvents();
+    ouro_nodiscard absl::Status initialiseSessionServices();
+    void shutdownSession();
+
 
 
     // validated storage locations for the app
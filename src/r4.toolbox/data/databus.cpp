@@ -9,6 +9,7 @@
 
 #include "pch.h"
 
+#include "base/mathematics.h"
 #include "data/databus.h"
 #include "app/module.frontend.h"
 
@@ -80,13 +81,18 @@ void DataBus::load( const fs::path& appStashPath )
             cereal::JSONInputArchive archive( is );
 
             std::array< std::string, cBusCount > busNames;
+            BusConfigurations busConfigs;
 
             archive(
                 CEREAL_NVP( busNames ),
-                CEREAL_NVP( m_busConfigs )
+                CEREAL_NVP( busConfigs )
             );
 
-            // build providers instances
+            // swap in the new configuration and build providers instances without the evaluation pass seeing a half-built set
+            std::scoped_lock<std::mutex> evaluationLock( m_evaluationMutex );
+
+            m_busConfigs = busConfigs;
+
             for ( int32_t bus = 0; bus < cBusCount; bus++ )
             {
                 strncpy( m_busNames[bus], busNames[bus].c_str(), 6 );
@@ -111,6 +117,7 @@ void DataBus::load( const fs::path& appStashPath )
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
 void DataBus::updateBus( const size_t bI, const float currentTime )
 {
     if ( m_busOutputsUpdated[bI] )
@@ -127,6 +134,7 @@ void DataBus::updateBus( const size_t bI, const float currentTime )
         Provider::Input input;
         input.m_value   = bc.m_value;
         input.m_time    = currentTime * bc.m_timeScale;
+        input.m_delta   = m_evaluationDelta;
 
         if ( bc.m_indexA >= 0 )
         {
@@ -152,20 +160,168 @@ void DataBus::updateBus( const size_t bI, const float currentTime )
     m_busOutputsUpdated[bI] = true;
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// expects m_evaluationMutex to be held, which also guarantees there is only ever one writer to the published data
+void DataBus::evaluateAndPublish( const double currentTime )
+{
+    m_evaluationDelta    = ( m_evaluationTick == 0 ) ? 0.0f : static_cast<float>( currentTime - m_lastEvaluationTime );
+    m_lastEvaluationTime = currentTime;
+    m_evaluationTick++;
+
+    m_busOutputsUpdated.fill( false );
+
+    for ( auto bI = 0U; bI < cBusCount; bI++ )
+    {
+        updateBus( bI, static_cast<float>( currentTime ) );
+    }
+
+    // mark as mid-write, shuffle the latest results down into the 'previous' slots and write the new ones
+    const uint64_t sequence = m_publishSequence.load( std::memory_order_relaxed );
+    m_publishSequence.store( sequence + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    for ( auto bI = 0U; bI < cBusCount; bI++ )
+    {
+        m_published[cBusCount + bI].store( m_published[bI].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+        m_published[bI].store( m_busOutputs[bI], std::memory_order_relaxed );
+    }
+    m_publishedTime[1].store( m_publishedTime[0].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+    m_publishedTick[1].store( m_publishedTick[0].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+    m_publishedTime[0].store( currentTime, std::memory_order_relaxed );
+    m_publishedTick[0].store( m_evaluationTick, std::memory_order_relaxed );
+
+    m_publishSequence.store( sequence + 2, std::memory_order_release );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void DataBus::workerThread( const uint32_t evaluationRateHz )
+{
+    OuroveonThreadScope ots( OURO_THREAD_PREFIX "DataBus" );
+
+    const auto evaluationPeriod = std::chrono::nanoseconds( 1'000'000'000 / std::max( evaluationRateHz, 1U ) );
+
+    auto nextEvaluation = std::chrono::steady_clock::now();
+    while ( m_workerThreadAlive )
+    {
+        {
+            std::scoped_lock<std::mutex> evaluationLock( m_evaluationMutex );
+            evaluateAndPublish( now() );
+        }
+
+        // keep to a fixed cadence rather than a fixed sleep so evaluation cost doesn't drift the rate; if we fell well
+        // behind (system suspend, debugger) just restart the clock rather than running a burst of catch-up passes
+        nextEvaluation += evaluationPeriod;
+
+        const auto timeNow = std::chrono::steady_clock::now();
+        if ( nextEvaluation < timeNow )
+            nextEvaluation = timeNow + evaluationPeriod;
+
+        std::this_thread::sleep_until( nextEvaluation );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void DataBus::startWorker( const uint32_t evaluationRateHz )
+{
+    if ( m_workerThread != nullptr )
+        return;
+
+    blog::app( FMTX( "DataBus evaluation running at {} Hz" ), evaluationRateHz );
+
+    m_workerThreadAlive = true;
+    m_workerThread      = std::make_unique<std::thread>( &DataBus::workerThread, this, evaluationRateHz );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void DataBus::stopWorker()
+{
+    if ( m_workerThread == nullptr )
+        return;
+
+    m_workerThreadAlive = false;
+    if ( m_workerThread->joinable() )
+        m_workerThread->join();
+    m_workerThread.reset();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
 void DataBus::update()
 {
-    const float currentTime = (float)ImGui::GetTime();
+    if ( isWorkerRunning() )
+        return;
+
+    std::scoped_lock<std::mutex> evaluationLock( m_evaluationMutex );
+    evaluateAndPublish( now() );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+double DataBus::now() const
+{
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - m_clockStart ).count();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void DataBus::readSnapshots( Snapshot& latest, Snapshot& previous ) const
+{
+    uint64_t sequenceBefore;
+    uint64_t sequenceAfter;
+    do
+    {
+        sequenceBefore = m_publishSequence.load( std::memory_order_acquire );
+        if ( sequenceBefore & 1 )
+        {
+            // writer is mid-publish, which takes a handful of stores; spin until it's done
+            sequenceAfter = sequenceBefore + 1;
+            continue;
+        }
+
+        for ( auto bI = 0U; bI < cBusCount; bI++ )
+        {
+            latest.m_values[bI]   = m_published[bI].load( std::memory_order_relaxed );
+            previous.m_values[bI] = m_published[cBusCount + bI].load( std::memory_order_relaxed );
+        }
+        latest.m_time   = m_publishedTime[0].load( std::memory_order_relaxed );
+        latest.m_tick   = m_publishedTick[0].load( std::memory_order_relaxed );
+        previous.m_time = m_publishedTime[1].load( std::memory_order_relaxed );
+        previous.m_tick = m_publishedTick[1].load( std::memory_order_relaxed );
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+        sequenceAfter = m_publishSequence.load( std::memory_order_relaxed );
+
+    } while ( sequenceBefore != sequenceAfter );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+float DataBus::getBusValue( const size_t bI ) const
+{
+    ABSL_ASSERT( bI < cBusCount );
+    return m_published[bI].load( std::memory_order_relaxed );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+float DataBus::sampleBusValue( const size_t bI, const double atTime ) const
+{
+    ABSL_ASSERT( bI < cBusCount );
 
-     m_busOutputsUpdated.fill( false );
+    Snapshot latest, previous;
+    readSnapshots( latest, previous );
 
-     for ( auto bI = 0U; bI < cBusCount; bI++ )
-     {
-         updateBus( bI, currentTime );
-     }
+    const double span = latest.m_time - previous.m_time;
+    if ( previous.m_tick == 0 || span <= 0.0 || atTime >= latest.m_time )
+        return latest.m_values[bI];
+    if ( atTime <= previous.m_time )
+        return previous.m_values[bI];
+
+    const float t = static_cast<float>( ( atTime - previous.m_time ) / span );
+    return base::lerp( previous.m_values[bI], latest.m_values[bI], t );
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
 void DataBus::imgui()
 {
+    // configuration and providers are edited in-place below; hold off evaluation while we're in here, it's brief
+    std::scoped_lock<std::mutex> evaluationLock( m_evaluationMutex );
+
     ImGui::Begin( "Data Bus" );
 
     const float controlKnobRadius = 30.0f;
@@ -195,7 +351,10 @@ void DataBus::imgui()
                 if ( m_busProviders[bus] == nullptr )
                     ImGui::KnobFloat( "##knob", 30.0f, &m_busConfigs[bus].m_value, 0.0f, 1.0f, 100.0f, 0.0f );
                 else
-                    ImGui::KnobFloat( "##knob", 30.0f, &m_busOutputs[bus], 0.0f, 1.0f, -1.0f, 0.0f );
+                {
+                    float busOutput = getBusValue( bus );
+                    ImGui::KnobFloat( "##knob", 30.0f, &busOutput, 0.0f, 1.0f, -1.0f, 0.0f );
+                }
 
                 ImGui::RadioButton( m_busNames[bus], &m_busEditIndex, bus );
                 ImGui::PopID();
@@ -18,6 +18,9 @@ struct DataBus
 {
     static constexpr size_t cBusCount = 9;
 
+    // default rate for the evaluation worker; fast enough that parameter changes driven off the bus don't step audibly
+    static constexpr uint32_t cDefaultEvaluationRateHz = 250;
+
     using DataProducer = std::function<void>( float v, float t );
 
     struct BusConfiguration
@@ -62,13 +65,30 @@ struct DataBus
     };
     using BusConfigurations = std::array< BusConfiguration, cBusCount >;
 
+    // bus outputs as of a single evaluation, stamped with the bus clock time it was computed for
+    struct Snapshot
+    {
+        std::array< float, cBusCount >  m_values;
+        double                          m_time = 0;         // seconds on the bus clock, see DataBus::now()
+        uint64_t                        m_tick = 0;         // incremented with each evaluation
+    };
+
     DataBus()
         : m_busEditIndex( 0 )
         , m_busEditorOpen( false )
+        , m_clockStart( std::chrono::steady_clock::now() )
     {
         m_busOutputs.fill( 0.0f );
         m_busProviders.fill( nullptr );
 
+        for ( auto& published : m_published )
+            published.store( 0.0f, std::memory_order_relaxed );
+        for ( auto i = 0; i < 2; i++ )
+        {
+            m_publishedTime[i].store( 0.0, std::memory_order_relaxed );
+            m_publishedTick[i].store( 0, std::memory_order_relaxed );
+        }
+
         for ( auto bI = 0U; bI < cBusCount; bI++ )
         {
             m_busNames[bI] = new char[10];
@@ -78,6 +98,8 @@ struct DataBus
 
     ~DataBus()
     {
+        stopWorker();
+
         for ( auto name : m_busNames )
             delete name;
     }
@@ -86,9 +108,29 @@ struct DataBus
     void load( const fs::path& appStashPath );
 
 
-    void updateBus( const size_t bI, const float currentTime );
+    // run bus evaluation on a dedicated thread at a fixed rate, decoupled from UI frame timing; outputs are
+    // published as snapshots that any thread can read without blocking the worker
+    void startWorker( const uint32_t evaluationRateHz = cDefaultEvaluationRateHz );
+    void stopWorker();
+    bool isWorkerRunning() const { return m_workerThread != nullptr; }
+
+    // evaluate all buses now on the calling thread, eg. to drive the bus from the audio block cadence or the UI frame;
+    // ignored while the worker thread is running
     void update();
 
+    // seconds elapsed on the bus clock; the same timebase used to stamp snapshots
+    double now() const;
+
+    // copy the two most recently published evaluations; safe from any thread
+    void readSnapshots( Snapshot& latest, Snapshot& previous ) const;
+
+    // latest published value for a single bus
+    float getBusValue( const size_t bI ) const;
+
+    // value for a bus at a point in time on the bus clock, interpolated between the two latest evaluations; requests
+    // beyond the latest evaluation hold its value rather than extrapolating
+    float sampleBusValue( const size_t bI, const double atTime ) const;
+
     void imgui();
 
 
@@ -108,14 +150,42 @@ struct DataBus
 
     BusConfigurations                   m_busConfigs;
     std::array< char*, cBusCount >      m_busNames;
-    std::array< float, cBusCount >      m_busOutputs;
-    std::array< bool,  cBusCount >      m_busOutputsUpdated;
 
     std::array< Provider*, cBusCount >  m_busProviders;
 
     int32_t                             m_busEditIndex;
 
     bool                                m_busEditorOpen;
+
+private:
+
+    void updateBus( const size_t bI, const float currentTime );
+    void evaluateAndPublish( const double currentTime );
+    void workerThread( const uint32_t evaluationRateHz );
+
+    // working state for an evaluation pass, only touched while holding m_evaluationMutex
+    std::array< float, cBusCount >      m_busOutputs;
+    std::array< bool,  cBusCount >      m_busOutputsUpdated;
+    uint64_t                            m_evaluationTick = 0;
+    double                              m_lastEvaluationTime = 0;
+    float                               m_evaluationDelta = 0;
+
+    // guards configuration & provider instances against the evaluation pass; held briefly by the UI when editing
+    mutable std::mutex                  m_evaluationMutex;
+
+    // published results, written under a sequence lock; the counter is odd while a write is in progress and readers
+    // retry if it changed underneath them. values are the latest evaluation followed by the one before it
+    static constexpr size_t cPublishedValues = cBusCount * 2;
+
+    std::atomic_uint64_t                                m_publishSequence = 0;
+    std::array< std::atomic<float>, cPublishedValues >  m_published;
+    std::atomic<double>                                 m_publishedTime[2];
+    std::atomic_uint64_t                                m_publishedTick[2];
+
+    std::chrono::steady_clock::time_point   m_clockStart;
+
+    std::unique_ptr< std::thread >      m_workerThread;
+    std::atomic_bool                    m_workerThreadAlive = false;
 };
 
 } // namespace data
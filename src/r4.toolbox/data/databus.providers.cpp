@@ -42,7 +42,14 @@ float Multiply2::generate( const Input& input )
 
 float Smooth::generate( const Input& input )
 {
-    m_lastValue += ( input.m_bus1 - m_lastValue ) * 0.1f * input.m_value;
+    // smoothing factor is defined per 60hz step; scale it to the actual time elapsed so the response is the same
+    // regardless of how often the bus is being evaluated
+    static constexpr float cReferenceRate = 60.0f;
+
+    const float perStepRetain = 1.0f - std::clamp( 0.1f * input.m_value, 0.0f, 1.0f );
+    const float blend         = 1.0f - std::pow( perStepRetain, input.m_delta * cReferenceRate );
+
+    m_lastValue += ( input.m_bus1 - m_lastValue ) * blend;
     return m_lastValue;
 }
 
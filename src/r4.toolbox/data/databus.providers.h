@@ -29,6 +29,7 @@ struct Provider
     {
         float       m_value = 0;
         float       m_time  = 0;
+        float       m_delta = 0;        // seconds since the previous evaluation
         float       m_bus1  = -1;
         float       m_bus2  = -1;
     };
@@ -5,13 +5,14 @@
 //  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
 //
 //  manager around connecting to Discord, marshalling voice comms and
-//  doing packet dispatch from the OPUS sample processor
+//  handing packets from the OPUS sample processor to the voice pacer
 //
 
 #include "pch.h"
 
 #include "discord/discord.bot.h"
 #include "discord/config.h"
+#include "discord/discord.voice.pacer.h"
 
 #include "spacetime/chronicle.h"
 
@@ -37,8 +38,47 @@ using VoiceChannelNameMap = std::unordered_map< dpp::snowflake, std::string >;
 // ---------------------------------------------------------------------------------------------------------------------
 struct Bot::State
 {
-    // lf queue exchanging completed blocks of packets from sample processor (audio thread) and our dispatch (main thread)
-    using OpusPacketQueue = mcc::ReaderWriterQueue<ssp::OpusPacketDataInstance>;
+    // routes paced packets from the VoicePacer thread into whichever dpp voice client is currently live
+    struct LiveVoiceSink final : public IVoiceSink
+    {
+        LiveVoiceSink( State& state ) : m_state( state ) {}
+
+        bool isReady() override
+        {
+            return m_state.m_voiceState == Bot::VoiceState::Joined;
+        }
+
+        void sendOpusPacket( const uint8_t* data, const std::size_t length ) override
+        {
+            std::lock_guard<std::mutex> voiceLock( m_state.m_liveVoiceGuard );
+            if ( m_state.m_voiceState != Bot::VoiceState::Joined || m_state.m_liveVoice == nullptr )
+                return;
+
+            // translate our UDP tuning value into the enum in dpp
+            switch ( m_state.m_voiceUdpTuning )
+            {
+                default:
+                case Bot::UdpTuning::Default:    m_state.m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Default;     break;
+                case Bot::UdpTuning::Delicate:   m_state.m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Delicate;    break;
+                case Bot::UdpTuning::Optimistic: m_state.m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Optimistic;  break;
+                case Bot::UdpTuning::Aggressive: m_state.m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Aggressive;  break;
+            }
+
+            // set working memory block with the data to send
+            m_workingMemory.opusData   = const_cast<uint8_t*>( data );
+            m_workingMemory.opusLength = length;
+
+            m_state.m_liveVoice->send_audio_opus_memopt( m_workingMemory );
+        }
+
+        uint32_t getDownstreamQueueLength() const override
+        {
+            return m_state.m_voiceBufferQueueState;
+        }
+
+        State&                                                  m_state;
+        dpp::discord_voice_client::OpusDispatchWorkingMemory    m_workingMemory;    // reusable memory block for encryption + send of opus packets
+    };
 
 
     State( app::ICoreServices& coreServices, const config::discord::Connection& configConnection )
@@ -57,13 +97,15 @@ struct Bot::State
 #endif
         ,            m_voiceState( Bot::VoiceState::NoConnection )
         ,    m_voiceChannelLiveID( 0 )
-        ,   m_opusDispatchRunning( false )
+        ,         m_liveVoiceSink( *this )
     {
         m_commandHandler.add_prefix( "." )
                         .add_prefix( "/" );
 
-        m_workingMemory.opusData = nullptr;
-        m_workingMemory.opusLength = 0;
+        m_liveVoiceSink.m_workingMemory.opusData   = nullptr;
+        m_liveVoiceSink.m_workingMemory.opusLength = 0;
+
+        m_voicePacer = std::make_unique< VoicePacer >( m_liveVoiceSink );
     }
 
     ~State()
@@ -79,7 +121,10 @@ struct Bot::State
             m_appCoreServices.getAudioModule()->blockUntil(
                 m_appCoreServices.getAudioModule()->detachSampleProcessor( m_opusStreamProcessorID ) );
         }
-        
+
+        // nothing will be feeding the pacer now, stop it before the voice sink goes away
+        m_voicePacer.reset();
+
         m_phase = Bot::ConnectionPhase::Uninitialised;
     }
 
@@ -209,7 +254,7 @@ struct Bot::State
         if ( m_voiceState != Bot::VoiceState::Joined )
             return;
 
-        m_opusQueue.enqueue( std::move( packets ) );
+        m_voicePacer->enqueue( std::move( packets ) );
     }
 
     // called once guild_get() returns something useful
@@ -291,7 +336,6 @@ struct Bot::State
 
         std::lock_guard<std::mutex> voiceLock( m_liveVoiceGuard );
         m_voiceState          = Bot::VoiceState::Flux;
-        m_opusDispatchRunning = false;
 
         dpp::discord_client* clientForGuild = m_cluster.get_shard( m_guildMetadata->m_shardID );
         clientForGuild->connect_voice( m_guildSID, vc.m_id, false, true );
@@ -310,7 +354,6 @@ struct Bot::State
 
         std::lock_guard<std::mutex> voiceLock( m_liveVoiceGuard );
         m_voiceState          = Bot::VoiceState::Flux;
-        m_opusDispatchRunning = false;
 
         dpp::discord_client* clientForGuild = m_cluster.get_shard( m_guildMetadata->m_shardID );
         clientForGuild->disconnect_voice( m_guildSID );
@@ -385,13 +428,10 @@ struct Bot::State
     ssp::OpusStream::SharedPtr              m_opusStreamProcessor;
     ssp::StreamProcessorInstanceID          m_opusStreamProcessorID;
 
-    dpp::discord_voice_client::OpusDispatchWorkingMemory
-                                            m_workingMemory;        // reusable memory block for encryption + send of opus packets
-
     const dpp::snowflake                    m_guildSID;
     GuildMetadataOptional                   m_guildMetadata;
 
-    std::mutex                              m_liveVoiceGuard;       // defense against the packet processing loop on main thread getting
+    std::mutex                              m_liveVoiceGuard;       // defense against the packet pacer thread getting
                                                                     // blindsided by voice channel disconnection 
     dpp::discord_voice_client*              m_liveVoice;
     std::atomic_uint32_t                    m_voiceBufferQueueState;
@@ -402,117 +442,34 @@ struct Bot::State
     VoiceChannelsAtomic                     m_voiceChannels;
     VoiceChannelNameMap                     m_voiceChannelNamesByID;
 
-    OpusPacketQueue                         m_opusQueue;
-    ssp::OpusPacketDataInstance             m_opusPacketInProgress;
-    ssp::OpusPacketDataInstance             m_opusPacketInReserve;
-    bool                                    m_opusDispatchRunning;
+    LiveVoiceSink                           m_liveVoiceSink;
+    std::unique_ptr< VoicePacer >           m_voicePacer;           // dispatches packets on their own clock, independent of update() rate
+
+    uint64_t                                m_lastPacketsSentCount = 0;
+    uint64_t                                m_lastPacketsSentBytes = 0;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
 void Bot::State::update( DispatchStats& stats )
 {
-    stats.m_packetsSentBytes    = 0;
-    stats.m_packetsSentCount    = 0;
-    stats.m_bufferingProgress   = -1;
-
-    stats.m_voiceBufferQueueState = m_voiceBufferQueueState;
-
-    const size_t maxPacketsDispatchedPerUpdate = 4;
-
-    // packet dispatch
-    {
-        std::lock_guard<std::mutex> voiceLock( m_liveVoiceGuard );
-        if ( m_voiceState == Bot::VoiceState::Joined && m_liveVoice != nullptr )
-        {
-            // translate our UDP tuning value into the enum in dpp
-            switch ( m_voiceUdpTuning )
-            {
-                default:
-                case Bot::UdpTuning::Default:    m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Default;     break;
-                case Bot::UdpTuning::Delicate:   m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Delicate;    break;
-                case Bot::UdpTuning::Optimistic: m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Optimistic;  break;
-                case Bot::UdpTuning::Aggressive: m_liveVoice->udpSendTiming = dpp::discord_voice_client::UdpSendTiming::Aggressive;  break;
-            }
-            
-            // no current packet block being drained? switch in the reserve
-            if ( m_opusPacketInProgress == nullptr )
-            {
-                if ( m_opusPacketInReserve != nullptr )
-                    std::swap( m_opusPacketInProgress, m_opusPacketInReserve );
-            }
-            // reserve empty? try dequeing one from the compressor thread's pile
-            if ( m_opusPacketInReserve == nullptr )
-            {
-                m_opusQueue.try_dequeue( m_opusPacketInReserve );
-            }
-
-            // pre-buffer stage - wait until we've got a bunch of packets to begin working with before 
-            // starting for real
-            if ( !m_opusDispatchRunning )
-            {
-                const auto queueLength = m_opusQueue.size_approx();
-                if ( queueLength >= 2 &&
-                     m_opusPacketInProgress &&
-                     m_opusPacketInReserve )
-                    m_opusDispatchRunning = true;
-                else
-                {
-                    stats.m_bufferingProgress = (float)queueLength;
-                    if ( m_opusPacketInProgress )
-                        stats.m_bufferingProgress++;
-                    if ( m_opusPacketInReserve )
-                        stats.m_bufferingProgress++;
-                    stats.m_bufferingProgress /= 4.0f;
-                }
-            }
-
-            // voice transmission is live, continuously stream packets to Discord
-            if ( m_opusDispatchRunning && 
-                 m_opusPacketInProgress )
-            {
-                const auto remainingPackets = std::min( m_opusPacketInProgress->m_opusPacketSizes.size() - m_opusPacketInProgress->m_dispatchedPackets, maxPacketsDispatchedPerUpdate );
-                for ( auto pkt = 0; pkt < remainingPackets; pkt++ )
-                {
-                    const size_t packetLength = m_opusPacketInProgress->m_opusPacketSizes[m_opusPacketInProgress->m_dispatchedPackets];
-
-                    // set working memory block with the data to send
-                    m_workingMemory.opusData = &m_opusPacketInProgress->m_opusData[m_opusPacketInProgress->m_dispatchedSize];
-                    m_workingMemory.opusLength = packetLength;
-
-                    m_liveVoice->send_audio_opus_memopt( m_workingMemory );
-
-                    m_opusPacketInProgress->m_dispatchedPackets++;
-                    m_opusPacketInProgress->m_dispatchedSize += packetLength;
-
-                    stats.m_packetsSentCount++;
-                    stats.m_packetsSentBytes += (uint32_t)packetLength;
-                    stats.m_averagePacketSize = m_opusPacketInProgress->m_averagePacketSize;
-                }
-
-                // depleted the current block of packets; this will be swapped out the next time through
-                if ( m_opusPacketInProgress->m_dispatchedPackets >= m_opusPacketInProgress->m_opusPacketSizes.size() )
-                {
-                    m_opusPacketInProgress.reset();
-                }
-            }
-        }
-        else if ( m_voiceState == Bot::VoiceState::Flux )
-        {
-            // flush all the dispatch state when in Flux
-            ssp::OpusPacketDataInstance flushQueue;
-            while ( m_opusQueue.try_dequeue( flushQueue ) )
-            {
-                blog::discord( FMTX( "draining packet queue..." ) );
-                flushQueue.reset();
-            }
-            m_opusPacketInProgress.reset();
-            m_opusPacketInReserve.reset();
-            m_opusDispatchRunning = false;
-        }
-    }
-
-    stats.m_packetBlobQueueLength   = (uint32_t)m_opusQueue.size_approx();
-    stats.m_dispatchRunning         = m_opusDispatchRunning;
+    const auto telemetry = m_voicePacer->getTelemetry();
+
+    // report what went out since the last update
+    stats.m_packetsSentCount        = (uint32_t)( telemetry.m_packetsSentCount - m_lastPacketsSentCount );
+    stats.m_packetsSentBytes        = (uint32_t)( telemetry.m_packetsSentBytes - m_lastPacketsSentBytes );
+    m_lastPacketsSentCount          = telemetry.m_packetsSentCount;
+    m_lastPacketsSentBytes          = telemetry.m_packetsSentBytes;
+
+    stats.m_packetBlobQueueLength   = telemetry.m_queuedBlocks;
+    stats.m_queuedPackets           = telemetry.m_queuedPackets;
+    stats.m_voiceBufferQueueState   = telemetry.m_downstreamQueueLength;
+    stats.m_averagePacketSize       = telemetry.m_averagePacketSize;
+    stats.m_jitterMeanMs            = telemetry.m_jitterMeanMs;
+    stats.m_jitterMaxMs             = telemetry.m_jitterMaxMs;
+    stats.m_underruns               = telemetry.m_underruns;
+    stats.m_resyncs                 = telemetry.m_resyncs;
+    stats.m_bufferingProgress       = telemetry.m_bufferingProgress;
+    stats.m_dispatchRunning         = telemetry.m_dispatchRunning;
 }
 
 
@@ -82,13 +82,19 @@ struct Bot
     struct DispatchStats
     {
         uint32_t    m_packetBlobQueueLength = 0;
+        uint32_t    m_queuedPackets         = 0;
 
-        uint32_t    m_packetsSentCount      = 0;
+        uint32_t    m_packetsSentCount      = 0;    // since the previous update() call
         uint32_t    m_packetsSentBytes      = 0;
 
         uint32_t    m_voiceBufferQueueState = 0;
         uint32_t    m_averagePacketSize     = 0;
 
+        float       m_jitterMeanMs          = 0;    // deviation of packet sends from their ideal cadence
+        float       m_jitterMaxMs           = 0;
+        uint32_t    m_underruns             = 0;
+        uint32_t    m_resyncs               = 0;
+
         float       m_bufferingProgress     = 0;
         bool        m_dispatchRunning       = false;
     };
@@ -100,7 +106,8 @@ struct Bot
     constexpr bool isInitialised() const { return m_initialised && m_state != nullptr; }
 
 
-    // call from main thread to let bot do regular main-thread processing tasks
+    // call from main thread to fetch the latest dispatch stats; packet dispatch itself runs on its own paced
+    // thread, so how often (or if) this is called has no effect on the voice stream
     void update( DispatchStats& stats );
 
 
@@ -52,12 +52,12 @@ void BotWithUI::imgui( app::CoreGUI& coreGUI )
 
     const bool bIsBotBusy = ( m_discordBot && m_discordBot->isBotBusy() );
 
-    // always tick the bot if its running, regardless of if we are showing the UI or not
-    // .. otherwise navigating to other tabs would halt the bot
+    // always poll the bot if its running, regardless of if we are showing the UI or not
+    // .. so traffic totals keep counting while on other tabs
     discord::Bot::DispatchStats stats;
     if ( m_discordBot )
     {
-        // main-thread update for the bot manager instance, read out current set of stats
+        // read out current set of stats; packets are dispatched on the bot's own pacing thread
         m_discordBot->update( stats );
 
         // update telemetry
@@ -216,6 +216,10 @@ void BotWithUI::imgui( app::CoreGUI& coreGUI )
 
                     ImGui::Text( "Voice Buffer Queue : %3u ( + ~%.1fs latency )", stats.m_voiceBufferQueueState, minimumLatency );
                     ImGui::Text( "Packet Size  (avg) : %4" PRIi64 " bytes", m_avgPacketSize.getInt64() );
+                    ImGui::Text( "Pacer Queue        : %3u packets", stats.m_queuedPackets );
+                    ImGui::Text( "Pacer Jitter       : %.1f ms avg, %.1f ms max", stats.m_jitterMeanMs, stats.m_jitterMaxMs );
+                    ImGui::CompactTooltip( "How far packet sends have drifted from their ideal cadence, over the last few seconds" );
+                    ImGui::Text( "Underruns / Resyncs: %u / %u", stats.m_underruns, stats.m_resyncs );
 
                     ImGui::PushItemWidth( discordViewWidth * 0.65f );
 
@@ -0,0 +1,293 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  paced dispatch of Opus voice packets on a dedicated thread, decoupled
+//  from whatever rate the UI happens to be ticking at
+//
+
+#include "pch.h"
+
+#include "discord/discord.voice.pacer.h"
+
+namespace discord {
+
+// ---------------------------------------------------------------------------------------------------------------------
+void LocalVoiceSink::sendOpusPacket( const uint8_t* data, const std::size_t length )
+{
+    {
+        std::lock_guard< std::mutex > arrivalLock( m_arrivalMutex );
+        m_arrivals.emplace_back( Clock::now() );
+    }
+    m_arrivalCVar.notify_one();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::optional< LocalVoiceSink::Clock::time_point > LocalVoiceSink::waitForPacket( const std::chrono::milliseconds timeout )
+{
+    std::unique_lock< std::mutex > arrivalLock( m_arrivalMutex );
+    if ( !m_arrivalCVar.wait_for( arrivalLock, timeout, [this] { return !m_arrivals.empty(); } ) )
+        return std::nullopt;
+
+    const auto arrival = m_arrivals.front();
+    m_arrivals.pop_front();
+    return arrival;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+VoicePacer::VoicePacer( IVoiceSink& sink, const double packetIntervalSec )
+    : m_sink( sink )
+    , m_packetInterval( std::chrono::duration_cast< Clock::duration >( std::chrono::duration< double >( packetIntervalSec ) ) )
+    , m_threadRun( true )
+{
+    m_jitterMs.fill( 0 );
+    m_thread = std::make_unique< std::thread >( &VoicePacer::threadWorker, this );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+VoicePacer::~VoicePacer()
+{
+    {
+        std::lock_guard< std::mutex > threadLock( m_threadMutex );
+        m_threadRun = false;
+    }
+    m_threadCVar.notify_one();
+
+    if ( m_thread && m_thread->joinable() )
+        m_thread->join();
+    m_thread.reset();
+
+    flush();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void VoicePacer::enqueue( ssp::OpusPacketDataInstance&& packets )
+{
+    m_opusQueue.enqueue( std::move( packets ) );
+
+    // nudge the pacer in case it was waiting on an empty queue (buffering, or after an underrun)
+    {
+        std::lock_guard< std::mutex > threadLock( m_threadMutex );
+        m_workPending = true;
+    }
+    m_threadCVar.notify_one();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+VoicePacer::Telemetry VoicePacer::getTelemetry() const
+{
+    std::lock_guard< std::mutex > telemetryLock( m_telemetryMutex );
+    return m_telemetry;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void VoicePacer::threadWorker()
+{
+    OuroveonThreadScope ots( OURO_THREAD_PREFIX "Discord::Pacer" );
+
+    const auto waitFor = [this]( const Clock::duration duration )
+        {
+            std::unique_lock< std::mutex > threadLock( m_threadMutex );
+            m_threadCVar.wait_for( threadLock, duration, [this] { return !m_threadRun || m_workPending; } );
+            m_workPending = false;
+        };
+
+    while ( m_threadRun )
+    {
+        // nowhere to send to; drop anything we're holding so we start fresh once the sink is back
+        if ( !m_sink.isReady() )
+        {
+            if ( m_dispatchRunning || m_opusPacketInProgress || m_opusPacketInReserve || m_opusQueue.size_approx() > 0 )
+            {
+                blog::discord( FMTX( "draining packet queue..." ) );
+                flush();
+            }
+            m_working.m_bufferingProgress = -1;
+            publishTelemetry();
+
+            waitFor( std::chrono::milliseconds( 20 ) );
+            continue;
+        }
+
+        refillFromQueue();
+
+        // pre-buffer stage - wait until we've got a bunch of packets to begin working with before starting for real
+        if ( !m_dispatchRunning )
+        {
+            const auto queueLength = m_opusQueue.size_approx();
+            if ( queueLength >= 2 &&
+                 m_opusPacketInProgress &&
+                 m_opusPacketInReserve )
+            {
+                m_dispatchRunning               = true;
+                m_packetDue                     = false;
+                m_nextSendTime                  = Clock::now();
+                m_working.m_bufferingProgress   = -1;
+            }
+            else
+            {
+                float bufferingProgress = (float)queueLength;
+                if ( m_opusPacketInProgress )
+                    bufferingProgress++;
+                if ( m_opusPacketInReserve )
+                    bufferingProgress++;
+
+                m_working.m_bufferingProgress = bufferingProgress / 4.0f;
+                publishTelemetry();
+
+                waitFor( m_packetInterval );
+                continue;
+            }
+        }
+
+        const auto timeNow = Clock::now();
+
+        // not time yet, sleep until the next slot comes round
+        if ( !m_packetDue && timeNow < m_nextSendTime )
+        {
+            std::unique_lock< std::mutex > threadLock( m_threadMutex );
+            m_threadCVar.wait_until( threadLock, m_nextSendTime, [this] { return !m_threadRun; } );
+            continue;
+        }
+
+        if ( sendNextPacket() )
+        {
+            if ( m_packetDue )
+            {
+                // we were starved; don't try and make up for lost time, just restart the cadence from here
+                m_packetDue    = false;
+                m_nextSendTime = timeNow + m_packetInterval;
+            }
+            else
+            {
+                recordJitter( timeNow - m_nextSendTime );
+                m_nextSendTime += m_packetInterval;
+
+                // if we're a long way behind (stalled machine, debugger, etc) then bursting out the backlog would
+                // just flood the voice connection; accept the loss and resync
+                if ( timeNow - m_nextSendTime > m_packetInterval * cMaximumCatchUpPackets )
+                {
+                    m_working.m_resyncs++;
+                    m_nextSendTime = timeNow + m_packetInterval;
+                }
+            }
+            publishTelemetry();
+        }
+        else
+        {
+            if ( !m_packetDue )
+            {
+                m_working.m_underruns++;
+                m_packetDue = true;
+                publishTelemetry();
+            }
+            waitFor( m_packetInterval );
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void VoicePacer::flush()
+{
+    ssp::OpusPacketDataInstance flushQueue;
+    while ( m_opusQueue.try_dequeue( flushQueue ) )
+    {
+        flushQueue.reset();
+    }
+    m_opusPacketInProgress.reset();
+    m_opusPacketInReserve.reset();
+
+    m_dispatchRunning = false;
+    m_packetDue       = false;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void VoicePacer::refillFromQueue()
+{
+    // no current packet block being drained? switch in the reserve
+    if ( m_opusPacketInProgress == nullptr )
+    {
+        if ( m_opusPacketInReserve != nullptr )
+            std::swap( m_opusPacketInProgress, m_opusPacketInReserve );
+    }
+    // reserve empty? try dequeing one from the compressor thread's pile
+    if ( m_opusPacketInReserve == nullptr )
+    {
+        m_opusQueue.try_dequeue( m_opusPacketInReserve );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool VoicePacer::sendNextPacket()
+{
+    refillFromQueue();
+
+    if ( m_opusPacketInProgress == nullptr )
+        return false;
+
+    const size_t packetLength = m_opusPacketInProgress->m_opusPacketSizes[m_opusPacketInProgress->m_dispatchedPackets];
+
+    m_sink.sendOpusPacket( &m_opusPacketInProgress->m_opusData[m_opusPacketInProgress->m_dispatchedSize], packetLength );
+
+    m_opusPacketInProgress->m_dispatchedPackets++;
+    m_opusPacketInProgress->m_dispatchedSize += packetLength;
+
+    m_working.m_packetsSentCount++;
+    m_working.m_packetsSentBytes += packetLength;
+    m_working.m_averagePacketSize = m_opusPacketInProgress->m_averagePacketSize;
+
+    // depleted the current block of packets, move on to the next
+    if ( m_opusPacketInProgress->m_dispatchedPackets >= m_opusPacketInProgress->m_opusPacketSizes.size() )
+    {
+        m_opusPacketInProgress.reset();
+        refillFromQueue();
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void VoicePacer::recordJitter( const Clock::duration lateness )
+{
+    const float latenessMs = std::chrono::duration< float, std::milli >( lateness ).count();
+
+    m_jitterMs[m_jitterWrite] = std::abs( latenessMs );
+    m_jitterWrite = ( m_jitterWrite + 1 ) % cJitterWindow;
+    m_jitterCount = std::min( m_jitterCount + 1, cJitterWindow );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void VoicePacer::publishTelemetry()
+{
+    uint32_t queuedPackets = 0;
+    if ( m_opusPacketInProgress )
+        queuedPackets += (uint32_t)( m_opusPacketInProgress->m_opusPacketSizes.size() - m_opusPacketInProgress->m_dispatchedPackets );
+    if ( m_opusPacketInReserve )
+        queuedPackets += (uint32_t)m_opusPacketInReserve->m_opusPacketSizes.size();
+
+    // blocks still in the queue are full ones straight from the encoder
+    const uint32_t queuedBlocks = (uint32_t)m_opusQueue.size_approx();
+    queuedPackets += queuedBlocks * ssp::OpusStream::cBufferedFrames;
+
+    float jitterSum = 0;
+    float jitterMax = 0;
+    for ( std::size_t jI = 0; jI < m_jitterCount; jI++ )
+    {
+        jitterSum += m_jitterMs[jI];
+        jitterMax  = std::max( jitterMax, m_jitterMs[jI] );
+    }
+
+    m_working.m_queuedBlocks            = queuedBlocks;
+    m_working.m_queuedPackets           = queuedPackets;
+    m_working.m_downstreamQueueLength   = m_sink.getDownstreamQueueLength();
+    m_working.m_jitterMeanMs            = ( m_jitterCount > 0 ) ? ( jitterSum / (float)m_jitterCount ) : 0.0f;
+    m_working.m_jitterMaxMs             = jitterMax;
+    m_working.m_dispatchRunning         = m_dispatchRunning;
+
+    std::lock_guard< std::mutex > telemetryLock( m_telemetryMutex );
+    m_telemetry = m_working;
+}
+
+} // namespace discord
@@ -0,0 +1,133 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  paced dispatch of Opus voice packets on a dedicated thread, decoupled
+//  from whatever rate the UI happens to be ticking at
+//
+
+#pragma once
+
+#include "base/construction.h"
+
+#include "ssp/ssp.stream.opus.h"
+
+namespace discord {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// destination for paced voice packets; called only from the pacer thread
+struct IVoiceSink
+{
+    virtual ~IVoiceSink() = default;
+
+    // is the sink able to take packets right now? while false, the pacer drops anything queued and waits
+    virtual bool isReady() = 0;
+
+    virtual void sendOpusPacket( const uint8_t* data, const std::size_t length ) = 0;
+
+    // number of packets buffered downstream of us, if the sink knows; purely for telemetry
+    virtual uint32_t getDownstreamQueueLength() const { return 0; }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// stand-in sink that goes nowhere, recording when each packet arrived; lets the pacing be exercised without a
+// live voice connection
+struct LocalVoiceSink final : public IVoiceSink
+{
+    using Clock = std::chrono::steady_clock;
+
+    bool isReady() override { return true; }
+    void sendOpusPacket( const uint8_t* data, const std::size_t length ) override;
+
+    // block until the next packet arrives (or timeout), returning its arrival time
+    std::optional< Clock::time_point > waitForPacket( const std::chrono::milliseconds timeout );
+
+private:
+
+    std::mutex                          m_arrivalMutex;
+    std::condition_variable             m_arrivalCVar;
+    std::deque< Clock::time_point >     m_arrivals;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct VoicePacer
+{
+    DECLARE_NO_COPY_NO_MOVE( VoicePacer );
+
+    using Clock = std::chrono::steady_clock;
+
+    // how far behind schedule we allow before giving up on catching up and restarting the cadence from now;
+    // catching up means sending back-to-back which Discord handles poorly, so keep this small
+    static constexpr uint32_t   cMaximumCatchUpPackets  = 3;
+    // number of recent packets that jitter stats are calculated over
+    static constexpr std::size_t cJitterWindow          = 64;
+
+    struct Telemetry
+    {
+        uint64_t    m_packetsSentCount      = 0;    // totals since the pacer started
+        uint64_t    m_packetsSentBytes      = 0;
+
+        uint32_t    m_queuedBlocks          = 0;    // packet blocks waiting from the encoder
+        uint32_t    m_queuedPackets         = 0;    // packets waiting in total, including the blocks in hand
+        uint32_t    m_downstreamQueueLength = 0;    // as reported by the sink
+        uint32_t    m_averagePacketSize     = 0;
+
+        float       m_jitterMeanMs          = 0;    // mean / max absolute deviation from the scheduled send time
+        float       m_jitterMaxMs           = 0;
+
+        uint32_t    m_underruns             = 0;    // send slots that came around with no packet ready
+        uint32_t    m_resyncs               = 0;    // times we fell too far behind and restarted the cadence
+
+        float       m_bufferingProgress     = -1;   // 0..1 while pre-buffering, -1 otherwise
+        bool        m_dispatchRunning       = false;
+    };
+
+    VoicePacer( IVoiceSink& sink, const double packetIntervalSec = ssp::OpusStream::cFrameTimeSec );
+    ~VoicePacer();
+
+    // called from the encoder thread
+    void enqueue( ssp::OpusPacketDataInstance&& packets );
+
+    // copy of the latest stats, safe to call from any thread
+    Telemetry getTelemetry() const;
+
+private:
+
+    using OpusPacketQueue = mcc::ReaderWriterQueue< ssp::OpusPacketDataInstance >;
+
+    void threadWorker();
+    void flush();
+    void refillFromQueue();
+    bool sendNextPacket();
+    void recordJitter( const Clock::duration lateness );
+    void publishTelemetry();
+
+    IVoiceSink&                         m_sink;
+    const Clock::duration               m_packetInterval;
+
+    OpusPacketQueue                     m_opusQueue;
+
+    std::unique_ptr< std::thread >      m_thread;
+    std::atomic_bool                    m_threadRun;
+    std::mutex                          m_threadMutex;
+    std::condition_variable             m_threadCVar;
+    bool                                m_workPending = false;      // set by enqueue() under m_threadMutex to cut short a wait for more packets
+
+    // owned by the pacer thread
+    ssp::OpusPacketDataInstance         m_opusPacketInProgress;
+    ssp::OpusPacketDataInstance         m_opusPacketInReserve;
+    bool                                m_dispatchRunning = false;
+    bool                                m_packetDue       = false;  // send slot reached but nothing to send; go as soon as a packet arrives
+    Clock::time_point                   m_nextSendTime;
+    std::array< float, cJitterWindow >  m_jitterMs;
+    std::size_t                         m_jitterWrite     = 0;
+    std::size_t                         m_jitterCount     = 0;
+    Telemetry                           m_working;
+
+    mutable std::mutex                  m_telemetryMutex;
+    Telemetry                           m_telemetry;
+};
+
+} // namespace discord
@@ -643,7 +643,7 @@ void EffectStack::ParameterSet::syncToDataBus( const data::DataBus& bus, nst::In
     {
         ABSL_ASSERT( pb.bus >= 0 && pb.bus < data::DataBus::cBusCount );
 
-        const float value = bus.m_busOutputs[pb.bus];
+        const float value = bus.getBusValue( pb.bus );
 
         for ( const auto& param : pb.parameters )
         {
@@ -25,6 +25,7 @@ RiffMixerBase::RiffMixerBase( const int32_t maxBufferSize, const int32_t sampleR
         m_mixChannelLeft[mI] = mem::alloc16To<float>( m_audioMaxBufferSize, 0.0f );
         m_mixChannelRight[mI] = mem::alloc16To<float>( m_audioMaxBufferSize, 0.0f );
     }
+    m_stemSampleIndices = mem::alloc16To<uint32_t>( m_audioMaxBufferSize, 0 );
 
     m_audioSampleRateRecp = 1.0 / (double)m_audioSampleRate;
 
@@ -43,6 +44,9 @@ RiffMixerBase::~RiffMixerBase()
     }
     m_mixChannelLeft.fill( nullptr );
     m_mixChannelRight.fill( nullptr );
+
+    mem::free16( m_stemSampleIndices );
+    m_stemSampleIndices = nullptr;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -120,6 +120,9 @@ protected:
     std::array< float*, 8 >         m_mixChannelLeft;
     std::array< float*, 8 >         m_mixChannelRight;
 
+    // scratch list of per-sample stem read positions, filled per layer and handed to Stem::gatherSamples
+    uint32_t*                       m_stemSampleIndices     = nullptr;
+
     // per-layer gain permutation controls
     Permutation                     m_permutationCurrent;
     Permutation                     m_permutationTarget;
@@ -0,0 +1,588 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+
+#include "pch.h"
+
+#include <numbers>
+
+#include "mix/engine.h"
+
+#include "endlesss/live.stem.h"
+
+namespace mix {
+
+// ---------------------------------------------------------------------------------------------------------------------
+void MixEngine::computeStemSampleIndices(
+    const endlesss::live::Stem& stemInst,
+    const float                 stemTimeStretch,
+          uint64_t              riffSample,
+    const uint64_t              riffLengthInSamples,
+    const uint32_t              sampleCount )
+{
+    const uint64_t stemSampleCount = stemInst.m_sampleCount;
+
+    if ( stemTimeStretch == 1.0f )
+    {
+        // unstretched reads just step along, wrapping on either the riff or the stem length; no per-sample modulo
+        uint64_t stemSample = riffSample % stemSampleCount;
+
+        for ( auto sI = 0U; sI < sampleCount; sI++ )
+        {
+            m_stemSampleIndices[sI] = static_cast<uint32_t>( stemSample );
+
+            riffSample++;
+            stemSample++;
+            if ( riffSample >= riffLengthInSamples )
+            {
+                riffSample = 0;
+                stemSample = 0;
+            }
+            if ( stemSample >= stemSampleCount )
+                stemSample = 0;
+        }
+    }
+    else
+    {
+        for ( auto sI = 0U; sI < sampleCount; sI++ )
+        {
+            const uint64_t scaledSample = static_cast<uint64_t>( (double)riffSample * stemTimeStretch );
+
+            m_stemSampleIndices[sI] = static_cast<uint32_t>( scaledSample % stemSampleCount );
+
+            riffSample++;
+            if ( riffSample >= riffLengthInSamples )
+                riffSample = 0;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void MixEngine::computeTransitionCurves(
+    const float                 valueStart,
+    const float                 valueEnd,
+    const uint32_t              sampleCount )
+{
+    // ramp across the buffer rather than stepping once per update(), ending exactly on `valueEnd`
+    const float valueStep = ( valueEnd - valueStart ) / static_cast<float>( sampleCount );
+
+    switch ( m_progression.m_blendCurve )
+    {
+        default:
+        case ProgressionConfiguration::BlendCurve::EqualPower:
+        {
+            constexpr float cHalfPi = std::numbers::pi_v<float> * 0.5f;
+
+            for ( auto sI = 0U; sI < sampleCount; sI++ )
+            {
+                const float blendAngle = std::clamp( valueStart + ( valueStep * static_cast<float>( sI + 1 ) ), 0.0f, 1.0f ) * cHalfPi;
+
+                m_transitionGainExisting[sI] = std::cos( blendAngle );
+                m_transitionGainIncoming[sI] = std::sin( blendAngle );
+            }
+        }
+        break;
+
+        case ProgressionConfiguration::BlendCurve::Linear:
+        {
+            for ( auto sI = 0U; sI < sampleCount; sI++ )
+            {
+                const float blendValue = std::clamp( valueStart + ( valueStep * static_cast<float>( sI + 1 ) ), 0.0f, 1.0f );
+
+                m_transitionGainExisting[sI] = 1.0f - blendValue;
+                m_transitionGainIncoming[sI] = blendValue;
+            }
+        }
+        break;
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void MixEngine::update(
+    const AudioBuffer&  outputBuffer,
+    const AudioSignal&  outputSignal,
+    const uint32_t      samplesToWrite,
+    const uint64_t      samplePosition )
+{
+    m_samplePosition = samplePosition;
+    m_timeInfo.samplePos = (double)samplePosition;
+
+    stemAmalgamUpdate();
+
+    const double linearTimeStep = (double)samplesToWrite / (double)m_audioSampleRate;
+
+    const auto notifyRepComOfActivity = [&]( uint32_t newStartSample )
+    {
+        assert( m_repcomState != RepComState::SampleFragmentAndResume );
+        if ( m_repcomState == RepComState::Paused )
+        {
+            blog::mix( "[ REPCOM ] UNPAUSE on new activity @ {} -> {}", newStartSample, samplesToWrite );
+
+            m_repcomSampleStart = newStartSample;
+            m_repcomSampleEnd   = cSampleCountMax;
+            m_repcomState       = RepComState::SampleFragmentAndResume;
+        }
+    };
+
+    // flag to indicate that the local data buffers need updating with m_riffCurrent data
+    // .. this is reset mid-cycle in the case we have to handle a transition event where the
+    // riff might change underneith us (via exchangeLiveRiff)
+    bool riffUnpackRequired = true;
+
+    // swap in the Next riff, mark transition/unpack flags as appropriate
+    const auto exchangeLiveRiff = [&]
+    {
+        m_riffCurrent           = m_riffNext;
+        m_riffNext              = {};
+        m_transitionValue       = 0.0f;
+        m_repcomRepeatBar       = 0;
+
+        m_abletonLinkControl.m_authorativeInterval = 1;
+
+        riffUnpackRequired      = true;
+    };
+
+    // process commands from the main thread
+    {
+        EngineCommandData engineCmd;
+        if ( m_commandQueue.try_dequeue( engineCmd ) )
+        {
+            switch ( engineCmd.getCommand() )
+            {
+                // start multitrack on the edge of a riff; the actual recording begins 
+                // when that is detected during the sample loop below
+                case EngineCommand::BeginRecording:
+                {
+                    m_multiTrackWaitingToRecordOnRiffEdge = true;
+                }
+                break;
+
+                // cleanly disengage recording from the mix thread
+                case EngineCommand::StopRecording:
+                {
+                    m_multiTrackWaitingToRecordOnRiffEdge = false;
+                    m_multiTrackRecording                 = false;
+                    m_multiTrackInFlux                    = false;
+
+                    // move recorders over to destroy on the main thread, avoid any stalls
+                    // from whatever may be required to tie off recording
+                    for ( auto i = 0; i < 8; i++ )
+                    {
+                        assert( m_multiTrackOutputsToDestroyOnMainThread[i] == nullptr );
+
+                        m_multiTrackOutputsToDestroyOnMainThread[i] = m_multiTrackOutputs[i];
+                        m_multiTrackOutputs[i].reset();
+                    }
+
+                    blog::mix( "[ Multitrack ] ... Stopped" );
+                }
+                break;
+
+                case EngineCommand::UpdateProgressionConfiguration:
+                {
+                    assert( engineCmd.getPtr() != nullptr );
+                    m_progression = *engineCmd.getPtrAs< ProgressionConfiguration >();
+                }
+                break;
+
+                case EngineCommand::UpdateRepComConfiguration:
+                {
+                    assert( !isRecording() );   // should not be allowed to update if recording is already underway
+                    assert( engineCmd.getPtr() != nullptr );
+                    m_repcom = *engineCmd.getPtrAs< RepComConfiguration >();
+                }
+                break;
+
+                case EngineCommand::ClearCurrentlyPlaying:
+                {
+                    m_riffNext = {};
+                    exchangeLiveRiff();
+                }
+                break;
+
+                case EngineCommand::ClearAllScheduledTransitions:
+                {
+                    // purge the queue
+                    endlesss::live::RiffAndPermutation dumpRiff;
+                    while ( m_riffQueue.try_dequeue( dumpRiff ) )
+                    { }
+                }
+                break;
+
+                default:
+                case EngineCommand::Invalid:
+                    blog::error::mix( "Unknown or invalid command received" );
+                    break;
+            }
+        }
+    }
+
+    const auto checkForAndDequeueNextRiff = [&]
+    {
+        if ( m_riffNext.isEmpty() )
+        {
+            if ( m_riffQueue.peek() != nullptr &&
+                 m_transitionValue == 0 )
+            {
+                if ( !m_riffQueue.try_dequeue( m_riffNext ) )
+                {
+                    assert( false );
+                    return false;
+                }
+
+                blog::mix( "[ BLEND ] DEQUEUED new riff" );
+
+                if ( m_riffNext.m_riffPtr->getSyncState() != endlesss::live::Riff::SyncState::Success )
+                {
+                    blog::error::mix( "[ BLEND ] .. new riff invalid, ignoring it" );
+                    m_riffNext = {};
+                }
+
+                // hard cut
+                if ( m_progression.m_blendTime == ProgressionConfiguration::BlendTime::Zero )
+                {
+                    blog::mix( "[ BLEND ] hard cut" );
+                    exchangeLiveRiff();
+                }
+                // pick blend rate based on how many bars to take
+                else
+                {
+                    ABSL_ASSERT( m_riffNext.isNotEmpty() );
+                    m_transitionRate = 1.0 / ( m_riffNext.m_riffPtr->m_timingDetails.m_lengthInSecPerBar * m_progression.getBlendTimeMultiplier() );
+                }
+            }
+        }
+
+        return ( m_riffNext.isNotEmpty() );
+    };
+
+    // in Arbitrary mode, check all the time to see if we could be switching
+    if ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::Arbitrary )
+    {
+        checkForAndDequeueNextRiff();
+    }
+
+    // note where the blend was at the start of this buffer, the crossfade ramps from here to the updated value
+    const float transitionValueAtStart = m_transitionValue;
+
+    // update the transition, if one is active; and swap in the next riff if one has completed
+    if ( m_riffNext.isNotEmpty() )
+    {
+        m_transitionValue += (float)(linearTimeStep * m_transitionRate);
+
+        if ( m_transitionValue >= 1.0f )
+        {
+            blog::mix( "[ BLEND ] completed" );
+            exchangeLiveRiff();
+        }
+    }
+
+    // early out if we have nothing to play or the active riff is 0-length
+    if ( m_riffCurrent.isEmpty() ||
+         m_riffCurrent.m_riffPtr->m_timingDetails.m_lengthInSamples == 0 )
+    {
+        outputBuffer.applySilence();
+
+        // reset computed riff playback variables
+        m_playbackProgression.reset();
+
+        // check if there's something on the horizon
+        if ( m_riffQueue.peek() != nullptr )
+        {
+            if ( checkForAndDequeueNextRiff() )
+            {
+                blog::mix( "[ BLEND ] hard cut to first riff" );
+                exchangeLiveRiff();
+                notifyRepComOfActivity( 0 );
+            }
+        }
+
+        // deal with LINK session update with nothing playing
+        {
+            m_abletonLinkControl.Transaction_StopPlaying();
+            m_abletonLinkControl.m_sampleTime += static_cast<double>(samplesToWrite);
+        }
+
+        return;
+    }
+
+
+
+    const endlesss::live::Riff* currentRiff = m_riffCurrent.m_riffPtr.get();
+    const endlesss::types::RiffPlaybackPermutation& currentPermutation = m_riffCurrent.m_permutation;
+
+    // compute where we are (roughly) for the UI
+    currentRiff->getTimingDetails().ComputeProgressionAtSample( m_samplePosition, m_playbackProgression );
+
+
+
+    // update vst time structure with latest state
+    m_timeInfo.tempo              = currentRiff->m_timingDetails.m_bpm;
+    m_timeInfo.timeSigNumerator   = currentRiff->m_timingDetails.m_quarterBeats;
+    m_timeInfo.timeSigDenominator = 4;
+
+
+    std::array< bool,  16 >         stemHasBeat;
+    std::array< float, 16 >         stemEnergy;
+    std::array< float, 16 >         stemTimeStretch;
+    std::array< float, 16 >         stemGains;
+    std::array< endlesss::live::Stem*, 16 >   stemPtr;
+
+    // keep note of where we are mixing in terms of the 0..N sample count of the current riff
+    std::array< uint32_t, 2 >       riffLengthInSamples;
+    std::array< uint32_t, 2 >       riffWrappedSampleStart;
+    
+    stemHasBeat.fill( false );
+    stemEnergy.fill( 0.0f );
+    stemTimeStretch.fill( 0.0f );
+    stemGains.fill( 0.0f );
+    stemPtr.fill( nullptr );
+
+    riffLengthInSamples.fill( 0 );
+    riffWrappedSampleStart.fill( 0 );
+
+    // unpack our primary foreground riff into the local data buffers used during sample filling
+    const auto decodeForegroundRiffData = [&]
+    {
+        riffLengthInSamples[0]      = currentRiff->m_timingDetails.m_lengthInSamples;
+        riffWrappedSampleStart[0]   = samplePosition % riffLengthInSamples[0];
+
+        for (auto stemI = 0U; stemI < 8; stemI++)
+        {
+            stemTimeStretch[stemI]  = currentRiff->m_stemTimeScales[stemI];
+            stemGains[stemI]        = currentRiff->m_stemGains[stemI] * currentPermutation.m_layerGainMultiplier[stemI];
+            stemPtr[stemI]          = currentRiff->m_stemPtrs[stemI];
+        }
+    };
+    decodeForegroundRiffData();
+
+    // unpack transitional riff? can be called mid-loop if we pull a new riff off the pile
+    const auto decodeTransitionalRiffData = [&]
+    {
+        if ( m_transitionValue > 0 )
+        {
+            const auto* nextRiff        = m_riffNext.m_riffPtr.get();
+            const auto& nextPermutation = m_riffNext.m_permutation;
+
+            riffLengthInSamples[1]      = nextRiff->m_timingDetails.m_lengthInSamples;
+            riffWrappedSampleStart[1]   = samplePosition % riffLengthInSamples[1];
+
+            for ( auto stemI = 0U; stemI < 8; stemI++ )
+            {
+                stemTimeStretch[ 8 + stemI ]  = nextRiff->m_stemTimeScales[stemI];
+                stemGains[ 8 + stemI ]        = nextRiff->m_stemGains[stemI] * nextPermutation.m_layerGainMultiplier[stemI];
+                stemPtr[ 8 + stemI ]          = nextRiff->m_stemPtrs[stemI];
+            }
+        }
+    };
+    decodeTransitionalRiffData();
+
+
+    const auto segmentLengthInSamples   = currentRiff->m_timingDetails.m_lengthInSamplesPerBar;
+          auto segmentSampleStart       = samplePosition % segmentLengthInSamples;
+
+    // walk the buffer in runs between bar / riff edges; any state changes (transition triggers, RepCom, recording) are
+    // handled at the start of a run, then the foreground stems are rendered across the whole run in one go
+    uint32_t runStart = 0;
+    while ( runStart < samplesToWrite )
+    {
+        // get sample position in context of the riff
+        const uint64_t riffSample = ( riffWrappedSampleStart[0] + runStart ) % riffLengthInSamples[0];
+
+        while ( segmentSampleStart >= segmentLengthInSamples )
+        {
+            segmentSampleStart -= segmentLengthInSamples;
+
+            m_playbackProgression.m_playbackBar++;
+            if ( m_playbackProgression.m_playbackBar >= currentRiff->m_timingDetails.m_barCount )
+                m_playbackProgression.m_playbackBar = 0;
+        }
+
+        if ( segmentSampleStart == 0 )
+        {
+//            blog::mix( "[ Edge ] Bar {}", m_riffPlaybackBar + 1 );
+
+            const bool isEvenBarNumber = (m_playbackProgression.m_playbackBar & 1 ) == 0;
+            const bool shouldTriggerTransition =
+                // any bar
+                ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::AnyBarStart ) ||
+                // 0, 2, 4, .. 
+                ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::AnyEvenBarStart && isEvenBarNumber ) ||
+                // next riff is bar 0
+                ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::NextRiffStart && m_playbackProgression.m_playbackBar == 0 );
+
+            if ( shouldTriggerTransition )
+            {
+                bool allowedToTrigger = true;
+
+                if ( isRepComPaused() && m_repcomPausedOnBar != m_playbackProgression.m_playbackBar )
+                    allowedToTrigger = false;
+
+                if ( allowedToTrigger && checkForAndDequeueNextRiff() )
+                {
+                    if ( riffUnpackRequired )
+                        decodeForegroundRiffData();
+                    decodeTransitionalRiffData();
+                    notifyRepComOfActivity( runStart );
+                }
+            }
+
+            if ( m_multiTrackRecording )
+            {
+                m_repcomRepeatBar++;
+
+                const bool repComTriggerPause = isRepComEnabled() &&
+                                                m_repcomRepeatBar >= currentRiff->m_timingDetails.m_longestStemInBars;
+
+                if (    repComTriggerPause
+                     && m_repcomState           == RepComState::Unpaused
+                     && m_riffNext.m_riffPtr    == nullptr
+                     && m_transitionValue       == 0 )
+                {
+                    blog::mix( "[ REPCOM ] Pausing @ bar {}, sample offset {}", m_playbackProgression.m_playbackBar, runStart );
+
+                    m_repcomPausedOnBar = m_playbackProgression.m_playbackBar;
+
+                    m_repcomSampleStart = 0;
+                    m_repcomSampleEnd   = runStart;
+                    m_repcomState       = RepComState::SampleFragmentAndPause;
+                }
+            }
+        }
+        if ( riffSample == 0 )
+        {
+            blog::mix( "[ Edge ] Riff" );
+
+            // multitrack recording waits till the start of a riff to begin
+            if ( m_multiTrackWaitingToRecordOnRiffEdge )
+            {
+                // begin writing out data
+                m_multiTrackRecording                 = true;
+                m_multiTrackWaitingToRecordOnRiffEdge = false;
+                m_multiTrackInFlux                    = false;
+
+                // reset repcom stats
+                m_repcomRepeatBar                     = 0;
+
+                blog::mix( "[ Multitrack ] Recording ..." );
+            }
+        }
+
+        // the run carries on until the next bar or riff edge, whichever comes first
+        const uint64_t samplesToBarEdge  = segmentLengthInSamples - segmentSampleStart;
+        const uint64_t samplesToRiffEdge = riffLengthInSamples[0] - riffSample;
+        const uint32_t runLength         = static_cast<uint32_t>( std::min< uint64_t >( { samplesToBarEdge, samplesToRiffEdge, samplesToWrite - runStart } ) );
+
+        segmentSampleStart += runLength;
+
+        for ( auto stemI = 0U; stemI < 8; stemI++ )
+        {
+            const endlesss::live::Stem* stemInst = stemPtr[stemI];
+
+            float* mixLeft  = m_mixChannelLeft[stemI]  + runStart;
+            float* mixRight = m_mixChannelRight[stemI] + runStart;
+
+            if ( stemInst == nullptr || stemInst->hasFailed() )
+            {
+                std::fill_n( mixLeft,  runLength, 0.0f );
+                std::fill_n( mixRight, runLength, 0.0f );
+
+                m_stemDataAmalgam.m_wave[stemI] = 0;
+                m_stemDataAmalgam.m_beat[stemI] = 0;
+                m_stemDataAmalgam.m_low[stemI]  = 0;
+                m_stemDataAmalgam.m_high[stemI] = 0;
+                continue;
+            }
+
+            computeStemSampleIndices( *stemInst, stemTimeStretch[stemI], riffSample, riffLengthInSamples[0], runLength );
+
+            if ( stemInst->getAnalysisState() == endlesss::live::Stem::AnalysisState::AnalysisValid )
+            {
+                const float permGain = currentPermutation.m_layerGainMultiplier[stemI];
+
+                const auto& stemAnalysis = stemInst->getAnalysisData();
+
+                for ( auto sI = 0U; sI < runLength; sI++ )
+                {
+                    const uint32_t finalSampleIdx = m_stemSampleIndices[sI];
+
+                    const float stemWave = stemAnalysis.getWaveF( finalSampleIdx ) * permGain;
+                    const float stemBeat = stemAnalysis.getBeatF( finalSampleIdx ) * permGain;
+                    const float stemLow  = stemAnalysis.getLowFreqF( finalSampleIdx ) * permGain;
+                    const float stemHigh = stemAnalysis.getHighFreqF( finalSampleIdx ) * permGain;
+
+                    m_stemDataAmalgam.m_wave[stemI] = std::max( m_stemDataAmalgam.m_wave[stemI], stemWave );
+                    m_stemDataAmalgam.m_beat[stemI] = std::max( m_stemDataAmalgam.m_beat[stemI], stemBeat );
+                    m_stemDataAmalgam.m_low[stemI]  = std::max( m_stemDataAmalgam.m_low[stemI],  stemLow  );
+                    m_stemDataAmalgam.m_high[stemI] = std::max( m_stemDataAmalgam.m_high[stemI], stemHigh );
+                }
+            }
+
+            stemInst->gatherSamples( m_stemSampleIndices, runLength, mixLeft, mixRight );
+
+            const float stemGain = stemGains[stemI];
+            for ( auto sI = 0U; sI < runLength; sI++ )
+            {
+                mixLeft[sI]  *= stemGain;
+                mixRight[sI] *= stemGain;
+            }
+        }
+
+        runStart += runLength;
+    }
+
+    // blend in the incoming riff; the transition can't start or stop partway through a buffer (new transitions only
+    // begin once m_transitionValue has been advanced at the top of update()) so this is done across the whole buffer
+    if ( m_transitionValue > 0 )
+    {
+        computeTransitionCurves( transitionValueAtStart, m_transitionValue, samplesToWrite );
+
+        for ( auto stemI = 0U; stemI < 8; stemI++ )
+        {
+            const endlesss::live::Stem* stemInst = stemPtr[ 8 + stemI ];
+
+            // when transitioning, a missing/muted stem means we need to transition down to silence, not just skip entirely
+            if ( stemInst == nullptr || stemInst->hasFailed() )
+            {
+                buffer::gain_curve_stereo(
+                    samplesToWrite,
+                    m_transitionGainExisting,
+                    m_mixChannelLeft[stemI],
+                    m_mixChannelRight[stemI] );
+                continue;
+            }
+
+            computeStemSampleIndices( *stemInst, stemTimeStretch[ 8 + stemI ], riffWrappedSampleStart[1], riffLengthInSamples[1], samplesToWrite );
+
+            stemInst->gatherSamples( m_stemSampleIndices, samplesToWrite, m_transitionLeft, m_transitionRight );
+
+            const float stemGain = stemGains[ 8 + stemI ];
+            for ( auto sI = 0U; sI < samplesToWrite; sI++ )
+            {
+                m_transitionLeft[sI]  *= stemGain;
+                m_transitionRight[sI] *= stemGain;
+            }
+
+            buffer::crossfade_stereo(
+                samplesToWrite,
+                m_transitionGainExisting,
+                m_transitionGainIncoming,
+                m_transitionLeft,
+                m_transitionRight,
+                m_mixChannelLeft[stemI],
+                m_mixChannelRight[stemI] );
+        }
+    }
+
+    m_stemDataAmalgamSamplesUsed += samplesToWrite;
+
+    // keep any Link session up to date; this is a no-op for most buffers
+    m_abletonLinkControl.Transaction_UpdatePlaying( currentRiff, m_samplePosition, samplesToWrite, m_audioSampleRate );
+
+    commit( outputBuffer, outputSignal, samplesToWrite );
+}
+
+} // namespace mix
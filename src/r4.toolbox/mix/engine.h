@@ -0,0 +1,655 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  the BEAM mixer; blends between a queue of riffs on musically sensible boundaries, drives an Ableton Link session
+//  as the tempo authority and can record the 8 pre-mix channels to disk with optional repetition compression
+//
+
+#pragma once
+
+#include "base/utils.h"
+#include "math/rng.h"
+#include "buffer/mix.h"
+
+#include "mix/common.h"
+
+#include "app/module.audio.h"
+
+#include "ssp/ssp.file.flac.h"
+
+#include "endlesss/live.riff.h"
+#include "endlesss/toolkit.exchange.h"
+
+#include <ableton/Link.hpp>
+#include <ableton/link/HostTimeFilter.hpp>
+
+namespace mix {
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct BeamAbletonLinkControl
+{
+    BeamAbletonLinkControl()
+        : m_link( 120.0 )
+    {
+    }
+    ~BeamAbletonLinkControl()
+    {
+        m_link.enable( false );
+    }
+
+    using LinkHostTime = ableton::link::HostTimeFilter<ableton::link::platform::Clock>;
+
+    // counters written by the audio thread; read and reported from the main thread so nothing on the audio
+    // path has to log or format strings
+    struct Diagnostics
+    {
+        std::atomic_uint32_t    m_sessionCommits    = 0;
+        std::atomic_uint32_t    m_beatsForced       = 0;
+        std::atomic_uint32_t    m_beatsRequested    = 0;
+        std::atomic<double>     m_committedTempo    = 0;
+    };
+
+    // riff sample position -> Link beat mapping, rebuilt only when the playing riff changes
+    struct BeatMapping
+    {
+        const endlesss::live::Riff* m_riff              = nullptr;
+        endlesss::live::Riff::RiffCIDHash
+                                    m_riffHash          = endlesss::live::Riff::RiffCIDHash::Invalid();
+        double                      m_tempo             = 0;
+        double                      m_quantum           = 4.0;      // beats per bar
+        double                      m_samplesPerBeat    = 0;
+        uint64_t                    m_samplesPerBar     = 0;
+    };
+
+    void Transaction_StopPlaying()
+    {
+        // if the current link state is "playing", snag and change the session to stop it
+        if ( m_linkIsPlaying )
+        {
+            auto linkSessionState = m_link.captureAudioSessionState();
+            {
+                linkSessionState.setIsPlaying(
+                    false,
+                    m_hostTimeFilter.sampleTimeToHostTime( m_sampleTime ) );
+
+                m_linkIsPlaying = false;
+            }
+            m_link.commitAudioSessionState( linkSessionState );
+
+            // re-assert our tempo when playback resumes
+            m_committedTempo = -1.0;
+
+            m_diagnostics.m_sessionCommits.fetch_add( 1, std::memory_order_relaxed );
+        }
+    }
+
+    // called once per audio buffer while a riff is playing; only touches the Link session when there is something
+    // to tell it - starting playback, a tempo change or a beat boundary landing inside this buffer
+    void Transaction_UpdatePlaying(
+        const endlesss::live::Riff* currentRiff,
+        const uint64_t              samplePosition,
+        const uint32_t              samplesToWrite,
+        const int32_t               sampleRate )
+    {
+        if ( m_mapping.m_riff != currentRiff || m_mapping.m_riffHash != currentRiff->getCIDHash() )
+        {
+            const auto& timingData = currentRiff->getTimingDetails();
+
+            m_mapping.m_riff            = currentRiff;
+            m_mapping.m_riffHash        = currentRiff->getCIDHash();
+            m_mapping.m_tempo           = static_cast<double>( timingData.m_bpm );
+            m_mapping.m_quantum         = static_cast<double>( std::max( timingData.m_quarterBeats, 1 ) );
+            m_mapping.m_samplesPerBar   = timingData.m_lengthInSamplesPerBar;
+            m_mapping.m_samplesPerBeat  = static_cast<double>( timingData.m_lengthInSamplesPerBar ) / m_mapping.m_quantum;
+        }
+
+        // keep the host time filter fed every buffer, it needs a steady stream of samples to stay accurate
+        const auto hostTime = m_hostTimeFilter.sampleTimeToHostTime( m_sampleTime );
+        m_sampleTime += static_cast<double>(samplesToWrite);
+
+        if ( m_mapping.m_samplesPerBar == 0 )
+            return;
+
+        // find the first beat boundary at or after the start of this buffer
+        const double beatAtBufferStart  = static_cast<double>( samplePosition % m_mapping.m_samplesPerBar ) / m_mapping.m_samplesPerBeat;
+        const double nextBeat           = std::ceil( beatAtBufferStart );
+        const double samplesToNextBeat  = ( nextBeat - beatAtBufferStart ) * m_mapping.m_samplesPerBeat;
+
+        const bool bBeatInBuffer        = samplesToNextBeat < static_cast<double>( samplesToWrite );
+        const bool bTempoChanged        = m_mapping.m_tempo != m_committedTempo;
+
+        if ( m_linkIsPlaying && !bBeatInBuffer && !bTempoChanged )
+            return;
+
+        const auto bufferBeginAtOutput = hostTime + m_outputLatency;
+
+        auto linkSessionState = m_link.captureAudioSessionState();
+
+        // we are the tempo, but only say so when it changes
+        if ( bTempoChanged )
+        {
+            linkSessionState.setTempo( m_mapping.m_tempo, bufferBeginAtOutput );
+            m_committedTempo = m_mapping.m_tempo;
+
+            m_diagnostics.m_committedTempo.store( m_committedTempo, std::memory_order_relaxed );
+        }
+
+        // on the arrival of a new riff when nothing was playing, tag IsPlaying in the session state and pin
+        // the beat phase to where we are in the bar
+        if ( !m_linkIsPlaying )
+        {
+            linkSessionState.setIsPlaying( true, bufferBeginAtOutput );
+            linkSessionState.forceBeatAtTime( beatAtBufferStart, bufferBeginAtOutput, m_mapping.m_quantum );
+            m_linkIsPlaying = true;
+        }
+
+        if ( bBeatInBuffer )
+        {
+            const double beatInBar  = std::fmod( nextBeat, m_mapping.m_quantum );
+            const auto   beatTime   = bufferBeginAtOutput + std::chrono::microseconds( std::llround( samplesToNextBeat * 1.0e6 / static_cast<double>( sampleRate ) ) );
+
+            // force the downbeat and the first few beats after a riff change, otherwise just ask nicely
+            if ( beatInBar == 0 || m_authorativeInterval >= 0 )
+            {
+                linkSessionState.forceBeatAtTime( beatInBar, beatTime, m_mapping.m_quantum );
+                m_diagnostics.m_beatsForced.fetch_add( 1, std::memory_order_relaxed );
+            }
+            else
+            {
+                linkSessionState.requestBeatAtTime( beatInBar, beatTime, m_mapping.m_quantum );
+                m_diagnostics.m_beatsRequested.fetch_add( 1, std::memory_order_relaxed );
+            }
+
+            if ( m_authorativeInterval >= 0 )
+                m_authorativeInterval--;
+        }
+
+        m_link.commitAudioSessionState( linkSessionState );
+
+        m_diagnostics.m_sessionCommits.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+
+    ableton::Link               m_link;
+    LinkHostTime                m_hostTimeFilter;
+    std::chrono::microseconds   m_outputLatency;
+    double                      m_sampleTime = 0;
+    double                      m_committedTempo = -1.0;
+    int32_t                     m_authorativeInterval = -1;
+    bool                        m_linkIsPlaying = false;
+
+    BeatMapping                 m_mapping;
+    Diagnostics                 m_diagnostics;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct MixEngine final : public app::module::MixerInterface,
+                         public rec::IRecordable,
+                         public mix::RiffMixerBase
+{
+    using AudioBuffer = app::module::Audio::OutputBuffer;
+    using AudioSignal = app::module::Audio::OutputSignal;
+
+    static constexpr uint32_t cSampleCountMax = std::numeric_limits<uint32_t>::max();
+
+    // 
+    struct ProgressionConfiguration
+    {
+        ProgressionConfiguration()
+            : m_triggerPoint( TriggerPoint::AnyBarStart )
+            , m_blendTime( BlendTime::TwoBars )
+            , m_blendCurve( BlendCurve::EqualPower )
+            , m_greedyMode( false )
+        {}
+
+        bool operator==( ProgressionConfiguration const& ) const = default;
+
+        // choose when to begin blending to the next riff
+        enum class TriggerPoint
+        {
+            Arbitrary,                      // start blending whenever a new riff arrives, yolo
+            NextRiffStart,                  //             .. when a riff loops around to the beginning (ie. once per riff loop)
+            AnyBarStart,                    //             .. when a bar segment is crossed (or near enough) (ie. usually 8 opportunities per riff loop)
+            AnyEvenBarStart,                //             .. when an even-numbered bar is crossed
+        }               m_triggerPoint;
+
+        static constexpr size_t cTriggerPointCount = 4;
+        static constexpr std::array< const char*, cTriggerPointCount > cTriggerPointNames {{
+            "At Any Point",
+            "At Riff Start",
+            "At Any Bar Start",
+            "At Even Bar Start"
+        }};
+        inline static const char* getTriggerPointName( const TriggerPoint tp )
+        {
+            return cTriggerPointNames[(size_t)tp];
+        }
+        inline static bool triggerPointGetter( void* data, int idx, const char** out_text )
+        {
+            *out_text = getTriggerPointName( (TriggerPoint)idx );
+            return true;
+        }
+
+        // how long the blend should take
+        enum class BlendTime
+        {
+            Zero,
+            OneBar,
+            TwoBars,
+            FourBars,
+            EightBars
+        }               m_blendTime;
+
+        static constexpr size_t cBlendTimeCount = 5;
+        static constexpr std::array< const char*, cBlendTimeCount > cBlendTimeNames {{
+            "Instant",
+            "One Bar",
+            "Two Bars",
+            "Four Bars",
+            "Eight Bars"
+        }};
+        inline static const char* getBlendTimeName( const BlendTime bt )
+        {
+            return cBlendTimeNames[(size_t)bt];
+        }
+        inline static bool blendTimeGetter( void* data, int idx, const char** out_text )
+        {
+            *out_text = getBlendTimeName( (BlendTime)idx );
+            return true;
+        }
+        inline float getBlendTimeMultiplier() const
+        {
+            switch ( m_blendTime )
+            {
+            default:
+            case ProgressionConfiguration::BlendTime::OneBar:    return 1.0f;
+            case ProgressionConfiguration::BlendTime::TwoBars:   return 2.0f;
+            case ProgressionConfiguration::BlendTime::FourBars:  return 4.0f;
+            case ProgressionConfiguration::BlendTime::EightBars: return 8.0f;
+            }
+        }
+
+        // shape of the gain curves used to blend between riffs
+        enum class BlendCurve
+        {
+            EqualPower,                     // sin/cos curves, holds perceived loudness constant through the blend
+            Linear,                         // straight lerp; dips in volume around the midpoint
+        }               m_blendCurve;
+
+        static constexpr size_t cBlendCurveCount = 2;
+        static constexpr std::array< const char*, cBlendCurveCount > cBlendCurveNames {{
+            "Equal Power",
+            "Linear"
+        }};
+        inline static const char* getBlendCurveName( const BlendCurve bc )
+        {
+            return cBlendCurveNames[(size_t)bc];
+        }
+        inline static bool blendCurveGetter( void* data, int idx, const char** out_text )
+        {
+            *out_text = getBlendCurveName( (BlendCurve)idx );
+            return true;
+        }
+
+        bool            m_greedyMode;       // if on and there are multiple 'next riffs' in the queue when it comes time to begin
+                                            // blending, empty the list and only blend to the most recent one. if off, we will
+                                            // work our way through each enqueued change in turn
+    };
+
+    struct RepComConfiguration
+    {
+        bool            m_enable = false;   // if multi-track is started, use repcom logic
+    };
+
+    enum class EngineCommand
+    {
+        Invalid,
+        BeginRecording,
+        StopRecording,
+        UpdateProgressionConfiguration,     // pass ProgressionConfiguration*
+        UpdateRepComConfiguration,          // pass RepComConfiguration*
+        ClearCurrentlyPlaying,
+        ClearAllScheduledTransitions
+    };
+    struct EngineCommandData : public base::BasicCommandType<EngineCommand> { using BasicCommandType::BasicCommandType; };
+
+
+
+    using CommandQueue  = mcc::ReaderWriterQueue<EngineCommandData>;
+    using RiffQueue     = mcc::ReaderWriterQueue<endlesss::live::RiffAndPermutation>;
+
+
+    uint64_t                    m_samplePosition;
+
+
+    endlesss::live::RiffAndPermutation
+                                m_riffCurrent;
+    uint32_t                    m_riffLengthInSamples;
+
+    endlesss::live::RiffProgression
+                                m_playbackProgression;
+
+    RiffQueue                   m_riffQueue;
+    CommandQueue                m_commandQueue;
+
+    endlesss::live::RiffAndPermutation
+                                m_riffNext;
+    float                       m_transitionValue;
+
+    float                       m_stemBeatRate;
+    double                      m_transitionRate;
+
+    ProgressionConfiguration    m_progression;
+
+    BeamAbletonLinkControl      m_abletonLinkControl;
+
+
+    MixEngine( const int32_t maxBufferSize, const int32_t sampleRate, const std::chrono::microseconds outputLatency, base::EventBusClient& eventBusClient )
+        : RiffMixerBase( maxBufferSize, sampleRate, eventBusClient )
+        , m_samplePosition( 0 )
+        , m_transitionValue( 0 )
+        , m_stemBeatRate( 4.0f )
+        , m_transitionRate( 0.25 )
+        , m_multiTrackInFlux( false )
+        , m_multiTrackWaitingToRecordOnRiffEdge( false )
+        , m_multiTrackRecording( false )
+        , m_repcomRepeatBar( 0 )
+        , m_repcomPausedOnBar( -1 )
+        , m_repcomRepeatLimit( 0 )
+        , m_repcomSampleStart( 0 )
+        , m_repcomSampleEnd( cSampleCountMax )
+        , m_repcomState( RepComState::Unpaused )
+    {
+        m_abletonLinkControl.m_outputLatency = outputLatency;
+
+        m_transitionLeft            = mem::alloc16To<float>( maxBufferSize, 0.0f );
+        m_transitionRight           = mem::alloc16To<float>( maxBufferSize, 0.0f );
+        m_transitionGainExisting    = mem::alloc16To<float>( maxBufferSize, 0.0f );
+        m_transitionGainIncoming    = mem::alloc16To<float>( maxBufferSize, 0.0f );
+    }
+
+    virtual ~MixEngine()
+    {
+        mem::free16( m_transitionLeft );
+        mem::free16( m_transitionRight );
+        mem::free16( m_transitionGainExisting );
+        mem::free16( m_transitionGainIncoming );
+    }
+
+    const app::AudioPlaybackTimeInfo* getPlaybackTimeInfo() const override { return getTimeInfoPtr(); }
+
+
+    inline void addNextRiff( const endlesss::live::RiffPtr& nextRiff )
+    {
+        m_riffQueue.emplace( nextRiff );
+    }
+
+    // add new riff with an optional permutation packet
+    inline void addNextRiff( const endlesss::live::RiffPtr& nextRiff, const endlesss::types::RiffPlaybackPermutationOpt& permOpt )
+    {
+        m_riffQueue.emplace( nextRiff, permOpt );
+    }
+
+
+    inline void updateProgressionConfiguration( const ProgressionConfiguration* pConfig )
+    {
+        m_commandQueue.emplace( EngineCommand::UpdateProgressionConfiguration, (void*) pConfig );
+    }
+
+    void clearAllScheduledTransitions()
+    {
+        m_commandQueue.emplace( EngineCommand::ClearAllScheduledTransitions );
+    }
+
+    inline void updateRepComConfiguration( const RepComConfiguration* pConfig )
+    {
+        m_commandQueue.emplace( EngineCommand::UpdateRepComConfiguration, (void*)pConfig );
+    }
+
+    inline void clearCurrentPlayback()
+    {
+        m_commandQueue.emplace( EngineCommand::ClearCurrentlyPlaying );
+    }
+
+    void enableAbletonLink( bool bEnabled )
+    {
+        m_abletonLinkControl.m_link.enable( bEnabled );
+    }
+
+
+    inline uint32_t getBarRepetitions() const { return m_repcomRepeatBar; }
+
+    inline bool isRepComEnabled() const { return m_repcom.m_enable; }
+    inline bool isRepComPaused() const { return isRepComEnabled() && ( m_repcomState != RepComState::Unpaused ); }
+    inline int32_t getBarPausedOn() const { return m_repcomPausedOnBar; }
+
+
+    void update(
+        const AudioBuffer&  outputBuffer,
+        const AudioSignal&  outputSignal,
+        const uint32_t      samplesToWrite,
+        const uint64_t      samplePosition ) override;
+
+    void commit(
+        const AudioBuffer&  outputBuffer,
+        const AudioSignal&  outputSignal,
+        const uint32_t      samplesToWrite )
+    {
+        buffer::downmix_8channel_stereo(
+            outputSignal.m_linearGain,
+            samplesToWrite,
+            m_mixChannelLeft[0],
+            m_mixChannelLeft[1],
+            m_mixChannelLeft[2],
+            m_mixChannelLeft[3],
+            m_mixChannelLeft[4],
+            m_mixChannelLeft[5],
+            m_mixChannelLeft[6],
+            m_mixChannelLeft[7],
+            m_mixChannelRight[0],
+            m_mixChannelRight[1],
+            m_mixChannelRight[2],
+            m_mixChannelRight[3],
+            m_mixChannelRight[4],
+            m_mixChannelRight[5],
+            m_mixChannelRight[6],
+            m_mixChannelRight[7],
+            outputBuffer.m_workingLR[0],
+            outputBuffer.m_workingLR[1]);
+
+        if ( m_multiTrackRecording )
+        {
+            const bool repComEnabled = isRepComEnabled();
+
+            // repetition compression is being activated or suspended, meaning we need to take just a chunk of the 
+            // presented samples rather than all of it
+            if ( repComEnabled && ( m_repcomState == RepComState::SampleFragmentAndPause ||
+                                    m_repcomState == RepComState::SampleFragmentAndResume ) )
+            {
+                const auto fragmentSampleCount = std::min( (uint32_t)m_repcomSampleEnd, samplesToWrite ) - m_repcomSampleStart;
+
+                blog::mix( "[ REPCOM ] Fragmenting ({})  [ {} ] -> [ {} ]  ({} samples)",
+                    ( m_repcomState == RepComState::SampleFragmentAndPause ) ? "Pausing" : "Resuming",
+                    m_repcomSampleStart,
+                    m_repcomSampleStart + fragmentSampleCount,
+                    fragmentSampleCount );
+
+                for ( auto i = 0; i < 8; i++ )
+                {
+                    m_multiTrackOutputs[i]->appendSamples(
+                        m_mixChannelLeft[i] + m_repcomSampleStart,
+                        m_mixChannelRight[i] + m_repcomSampleStart,
+                        fragmentSampleCount );
+                }
+            }
+            else if ( !repComEnabled || m_repcomState == RepComState::Unpaused )
+            {
+                for ( auto i = 0; i < 8; i++ )
+                {
+                    m_multiTrackOutputs[i]->appendSamples( m_mixChannelLeft[i], m_mixChannelRight[i], samplesToWrite );
+                }
+            }
+        }
+        {
+            if ( m_repcomState == RepComState::SampleFragmentAndPause )
+                 m_repcomState  = RepComState::Paused;
+            if ( m_repcomState == RepComState::SampleFragmentAndResume )
+            {
+                m_repcomState       = RepComState::Unpaused;
+                m_repcomPausedOnBar = -1;
+            }
+
+            m_repcomSampleStart = 0;
+            m_repcomSampleEnd   = cSampleCountMax;
+        }
+    }
+
+    void mainThreadUpdate( const float dT, endlesss::toolkit::Exchange& beatEx )
+    {
+        for ( auto layer = 0U; layer < 8; layer++ )
+            m_multiTrackOutputsToDestroyOnMainThread[layer].reset();
+
+        // report Link tempo changes from here rather than the audio thread
+        const double linkTempo = m_abletonLinkControl.m_diagnostics.m_committedTempo.load( std::memory_order_relaxed );
+        if ( linkTempo != m_linkTempoReported )
+        {
+            blog::mix( FMTX( "[ LINK ] tempo committed : {:.2f} bpm" ), linkTempo );
+            m_linkTempoReported = linkTempo;
+        }
+    }
+
+    inline const BeamAbletonLinkControl::Diagnostics& getLinkDiagnostics() const { return m_abletonLinkControl.m_diagnostics; }
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// rec::IRecordable
+
+public:
+
+    inline bool beginRecording( const fs::path& outputPath, const std::string& filePrefix ) override
+    {
+        // should not be calling this if we're already in the process of streaming out
+        assert( !isRecording() );
+        if ( isRecording() )
+            return false;
+
+        math::RNG32 writeBufferShuffleRNG;
+
+        // set up 8 WAV output streams, one for each Endlesss layer
+        for ( auto i = 0; i < 8; i++ )
+        {
+            auto recordFile = outputPath / fmt::format( "{}beam_channel{}.flac", filePrefix, i );
+            m_multiTrackOutputs[i] = ssp::FLACWriter::Create(
+                recordFile.string(),
+                m_audioSampleRate,
+                writeBufferShuffleRNG.genFloat( 0.75f, 1.75f ) );   // randomise the write buffer sizes to avoid all
+                                                                    // outputs flushing outputs simultaneously
+        }
+
+        // tell the worker thread to begin writing to our streams
+        m_commandQueue.enqueue( EngineCommand::BeginRecording );
+        m_multiTrackInFlux = true;
+
+        return true;
+    }
+
+    inline void stopRecording() override
+    {
+        // can't stop what hasn't started
+        assert( isRecording() );
+        if ( !isRecording() )
+            return;
+
+        m_commandQueue.enqueue( EngineCommand::StopRecording );
+        m_multiTrackInFlux = true;
+    }
+
+    // either we're fully engaged with writing out the stream or the request to do (or to stop) is still in-flight
+    inline bool isRecording() const override
+    {
+        return m_multiTrackRecording || 
+               m_multiTrackInFlux;
+    }
+
+    inline uint64_t getRecordingDataUsage() const override
+    {
+        if ( !isRecording() )
+            return 0;
+
+        uint64_t usage = 0;
+        for ( auto i = 0; i < 8; i++ )
+            usage += m_multiTrackOutputs[i]->getStorageUsageInBytes();
+
+        return usage;
+    }
+
+    inline std::string_view getRecorderName() const override { return " Multitrack "; }
+    inline const char* getFluxState() const override
+    {
+        if ( m_repcomState != RepComState::Unpaused )
+            return "[PAUSED] ";
+        if ( m_multiTrackInFlux )
+            return " Awaiting Loop Start";
+
+        return nullptr;
+    }
+
+
+private:
+
+    // fill m_stemSampleIndices with the stem read positions for `sampleCount` output samples, beginning at
+    // `riffSample` in a riff that loops every `riffLengthInSamples`
+    void computeStemSampleIndices(
+        const endlesss::live::Stem& stemInst,
+        const float                 stemTimeStretch,
+              uint64_t              riffSample,
+        const uint64_t              riffLengthInSamples,
+        const uint32_t              sampleCount );
+
+    // fill the transition gain curves for a blend moving from `valueStart` to `valueEnd` across `sampleCount` samples
+    void computeTransitionCurves(
+        const float                 valueStart,
+        const float                 valueEnd,
+        const uint32_t              sampleCount );
+
+    double              m_linkTempoReported = 0;                    // main-thread copy of the last tempo we logged
+
+    // scratch space for rendering the incoming riff during a transition, plus the per-sample blend curves
+    float*              m_transitionLeft            = nullptr;
+    float*              m_transitionRight           = nullptr;
+    float*              m_transitionGainExisting    = nullptr;
+    float*              m_transitionGainIncoming    = nullptr;
+
+    using MultiTrackStreams = std::array < std::shared_ptr<ssp::FLACWriter>, 8 >;
+
+    bool                m_multiTrackInFlux;
+    bool                m_multiTrackWaitingToRecordOnRiffEdge;
+    bool                m_multiTrackRecording;
+    MultiTrackStreams   m_multiTrackOutputs;                        // currently live recorders
+    MultiTrackStreams   m_multiTrackOutputsToDestroyOnMainThread;   // recorders ready to decommission on main thread
+
+
+    // multitrack "repetition compression" (RepCom) 
+
+    // repcom config written to via engine command
+    RepComConfiguration m_repcom;
+
+    // repcom internal state
+    int32_t             m_repcomRepeatBar;
+    int32_t             m_repcomPausedOnBar;
+    int32_t             m_repcomRepeatLimit;
+    uint32_t            m_repcomSampleStart;
+    uint32_t            m_repcomSampleEnd;
+    enum class RepComState
+    {
+        Unpaused,
+        SampleFragmentAndPause,
+        Paused,
+        SampleFragmentAndResume
+    }                   m_repcomState;
+};
+
+} // namespace mix
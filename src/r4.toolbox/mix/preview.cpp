@@ -173,11 +173,11 @@ void Preview::renderCurrentRiff(
         // get sample position in context of the riff
         uint64_t riffSample = riffWrappedSampleStart;
 
-        float lastSampleLeft  = 0;
-        float lastSampleRight = 0;
-
         auto& stemAnalysis = stemInst->getAnalysisData();
 
+        const float permGainStart = permGain;
+
+        // first pass works out where we are reading from in the stem for each output sample
         for ( auto sI = 0U; sI < samplesToWrite; sI++ )
         {
             const auto sampleCount = stemInst->m_sampleCount;
@@ -207,10 +207,7 @@ void Preview::renderCurrentRiff(
                 m_stemDataAmalgam.m_high[stemI] = std::max( m_stemDataAmalgam.m_high[stemI], stemHigh );
             }
 
-            lastSampleLeft  = stemInst->m_channel[0][finalSampleIdx] * stemGain * permGain;
-            lastSampleRight = stemInst->m_channel[1][finalSampleIdx] * stemGain * permGain;
-            m_mixChannelLeft[stemI][outputOffset + sI]  = lastSampleLeft;
-            m_mixChannelRight[stemI][outputOffset + sI] = lastSampleRight;
+            m_stemSampleIndices[sI] = static_cast<uint32_t>( finalSampleIdx );
 
             riffSample++;
             if ( riffSample >= riffLengthInSamples )
@@ -219,8 +216,25 @@ void Preview::renderCurrentRiff(
             permGain += m_permutationSampleGainDelta[stemI];
         }
 
-        m_txBlendCacheLeft[stemI]  = lastSampleLeft;
-        m_txBlendCacheRight[stemI] = lastSampleRight;
+        float* mixLeft  = m_mixChannelLeft[stemI]  + outputOffset;
+        float* mixRight = m_mixChannelRight[stemI] + outputOffset;
+
+        // pull the samples across as a block, unpacking compact stem storage as we go, then apply gain ramp
+        stemInst->gatherSamples( m_stemSampleIndices, samplesToWrite, mixLeft, mixRight );
+        {
+            const float permGainDelta = m_permutationSampleGainDelta[stemI];
+
+            for ( auto sI = 0U; sI < samplesToWrite; sI++ )
+            {
+                const float sampleGain = stemGain * ( permGainStart + ( permGainDelta * static_cast<float>( sI ) ) );
+
+                mixLeft[sI]  *= sampleGain;
+                mixRight[sI] *= sampleGain;
+            }
+        }
+
+        m_txBlendCacheLeft[stemI]  = mixLeft[samplesToWrite - 1];
+        m_txBlendCacheRight[stemI] = mixRight[samplesToWrite - 1];
 
         m_permutationCurrent.m_layerGainMultiplier[stemI] = permGain - m_permutationSampleGainDelta[stemI];
     }
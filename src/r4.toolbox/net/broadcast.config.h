@@ -0,0 +1,36 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#pragma once
+
+#include "config/base.h"
+
+namespace config {
+namespace broadcast {
+
+OURO_CONFIG( Server )
+{
+    // data routing
+    static constexpr auto StoragePath       = IPathProvider::PathFor::SharedConfig;
+    static constexpr auto StorageFilename   = "broadcast.json";
+
+    uint32_t        port        = 8090;     // HTTP port to listen on, all interfaces
+    int32_t         bitrate     = 96000;    // opus encoder target bitrate
+
+    template<class Archive>
+    void serialize( Archive& archive )
+    {
+        archive( CEREAL_NVP( port ),
+                 CEREAL_NVP( bitrate )
+        );
+    }
+};
+
+} // namespace broadcast
+} // namespace config
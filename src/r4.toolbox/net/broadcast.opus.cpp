@@ -0,0 +1,553 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "base/instrumentation.h"
+
+#include "app/core.h"
+#include "app/module.audio.h"
+
+#include "net/broadcast.opus.h"
+
+using namespace std::chrono_literals;
+
+namespace net {
+namespace broadcast {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// just enough Ogg (RFC 3533) to wrap up a single continuous Opus stream (RFC 7845)
+namespace ogg {
+
+enum HeaderType : uint8_t
+{
+    Fresh           = 0x00,
+    Continued       = 0x01,
+    BeginOfStream   = 0x02,
+    EndOfStream     = 0x04
+};
+
+static constexpr std::size_t cMaxLacingValues   = 255;
+static constexpr std::size_t cCRCOffset         = 22;       // byte offset of the checksum field in a page header
+
+// CRC32 with the 0x04c11db7 polynomial, unreflected, zero initial value and no final xor
+struct CRCTable
+{
+    constexpr CRCTable()
+    {
+        for ( uint32_t index = 0; index < 256; index++ )
+        {
+            uint32_t remainder = index << 24;
+            for ( int32_t bit = 0; bit < 8; bit++ )
+                remainder = ( remainder & 0x80000000u ) ? ( ( remainder << 1 ) ^ 0x04c11db7u ) : ( remainder << 1 );
+
+            m_table[index] = remainder;
+        }
+    }
+
+    std::array< uint32_t, 256 >  m_table{};
+};
+static constexpr CRCTable cCRCTable;
+
+inline uint32_t checksum( const uint8_t* data, const std::size_t length )
+{
+    uint32_t crc = 0;
+    for ( std::size_t index = 0; index < length; index++ )
+        crc = ( crc << 8 ) ^ cCRCTable.m_table[ ( ( crc >> 24 ) ^ data[index] ) & 0xff ];
+    return crc;
+}
+
+template< typename _IntType >
+inline void appendLE( std::string& output, const _IntType value )
+{
+    using UnsignedType = std::make_unsigned_t<_IntType>;
+    const UnsignedType bits = static_cast<UnsignedType>( value );
+
+    for ( std::size_t byte = 0; byte < sizeof( _IntType ); byte++ )
+        output.push_back( static_cast<char>( ( bits >> ( byte * 8 ) ) & 0xff ) );
+}
+
+// number of lacing values a packet of the given size will occupy
+constexpr std::size_t lacingCount( const std::size_t packetBytes )
+{
+    return ( packetBytes / 255 ) + 1;
+}
+
+inline void appendLacing( std::vector< uint8_t >& lacing, std::size_t packetBytes )
+{
+    while ( packetBytes >= 255 )
+    {
+        lacing.push_back( 255 );
+        packetBytes -= 255;
+    }
+    lacing.push_back( static_cast<uint8_t>( packetBytes ) );
+}
+
+// write a complete page - header, lacing table and payload - onto the end of output
+inline void appendPage(
+    std::string&                    output,
+    const uint8_t                   headerType,
+    const int64_t                   granulePosition,
+    const uint32_t                  serialNumber,
+    const uint32_t                  sequenceNumber,
+    const std::vector< uint8_t >&   lacing,
+    const uint8_t*                  payload,
+    const std::size_t               payloadBytes )
+{
+    ABSL_ASSERT( lacing.size() <= cMaxLacingValues );
+
+    const std::size_t pageStart = output.size();
+
+    output.append( "OggS", 4 );
+    output.push_back( 0 );                                      // stream structure version
+    output.push_back( static_cast<char>( headerType ) );
+    appendLE( output, granulePosition );
+    appendLE( output, serialNumber );
+    appendLE( output, sequenceNumber );
+    appendLE( output, uint32_t( 0 ) );                          // checksum, patched below
+    output.push_back( static_cast<char>( lacing.size() ) );
+    output.append( reinterpret_cast<const char*>( lacing.data() ), lacing.size() );
+    output.append( reinterpret_cast<const char*>( payload ), payloadBytes );
+
+    const uint32_t crc = checksum( reinterpret_cast<const uint8_t*>( output.data() ) + pageStart, output.size() - pageStart );
+    for ( std::size_t byte = 0; byte < 4; byte++ )
+        output[pageStart + cCRCOffset + byte] = static_cast<char>( ( crc >> ( byte * 8 ) ) & 0xff );
+}
+
+// single-packet page, used for the stream headers
+inline void appendPacketAsPage(
+    std::string&        output,
+    const uint8_t       headerType,
+    const uint32_t      serialNumber,
+    const uint32_t      sequenceNumber,
+    const std::string&  packet )
+{
+    std::vector< uint8_t > lacing;
+    appendLacing( lacing, packet.size() );
+
+    appendPage( output, headerType, 0, serialNumber, sequenceNumber, lacing, reinterpret_cast<const uint8_t*>( packet.data() ), packet.size() );
+}
+
+} // namespace ogg
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct OpusServer::State
+{
+    DECLARE_NO_COPY_NO_MOVE( State );
+
+    using PagePtr  = std::shared_ptr< const std::string >;
+    using PageRing = std::array< PagePtr, OpusServer::cPageRingSize >;
+
+    // how long a client thread sleeps waiting for new pages before checking back in with httplib
+    static constexpr auto cClientWaitTimeout = 250ms;
+
+    // per-listener state, owned by the content provider for that connection
+    struct Client
+    {
+        uint64_t    m_cursor        = 0;        // index of the next entry to read from the page ring
+        bool        m_sentHeaders   = false;
+    };
+
+
+    State( app::ICoreServices& coreServices )
+        : m_appCoreServices( coreServices )
+        , m_opusStreamProcessorID( ssp::StreamProcessorInstanceID::invalid() )
+    {
+    }
+
+    ~State()
+    {
+        std::ignore = stop();
+    }
+
+    ouro_nodiscard absl::Status start( const uint32_t port, const int32_t bitrate )
+    {
+        if ( m_serverThread != nullptr )
+        {
+            return absl::AlreadyExistsError( "server already running" );
+        }
+
+        // Opus only deals in a handful of sample rates, we need 48 kHz for the 1:1 granule mapping
+        const auto sampleRate = m_appCoreServices.getAudioModule()->getSampleRate();
+        if ( sampleRate != 48000 )
+        {
+            return absl::FailedPreconditionError( fmt::format( FMTX( "Opus broadcast requires a 48000 Hz audio sample rate (currently {})" ), sampleRate ) );
+        }
+
+        const auto statusOrPtr = ssp::OpusStream::Create( std::bind( &State::onOpusPacketBlock, this, std::placeholders::_1 ), sampleRate );
+        if ( !statusOrPtr.ok() )
+        {
+            return statusOrPtr.status();
+        }
+        m_opusStreamProcessor = *statusOrPtr;
+        {
+            ssp::OpusStream::CompressionSetup setup = m_opusStreamProcessor->getCurrentCompressionSetup();
+            setup.m_bitrate = bitrate;
+            m_opusStreamProcessor->setCompressionSetup( setup );
+        }
+
+        // reset the muxer and page ring; nothing else is touching these until the encoder is attached below
+        buildStreamHeaders( sampleRate, m_opusStreamProcessor->getEncoderLookahead() );
+        m_granulePosition   = 0;
+        m_pageSequence      = 2;    // 0 and 1 are the header pages
+        {
+            std::lock_guard< std::mutex > ringLock( m_ringMutex );
+            for ( auto& page : m_pageRing )
+                page.reset();
+            m_ringHead = 0;
+            m_running  = true;
+        }
+
+        m_server = std::make_unique< httplib::Server >();
+        configureServer();
+
+        if ( !m_server->bind_to_port( "0.0.0.0", static_cast<int>( port ) ) )
+        {
+            m_running = false;
+            m_server.reset();
+            m_opusStreamProcessor.reset();
+
+            return absl::UnavailableError( fmt::format( FMTX( "unable to bind to port {}" ), port ) );
+        }
+
+        m_port          = port;
+        m_serverState   = ServerState::Starting;
+        m_serverThread  = std::make_unique<std::thread>( &State::serverThread, this );
+
+        // begin encoding
+        m_opusStreamProcessorID = m_opusStreamProcessor->getInstanceID();
+        m_appCoreServices.getAudioModule()->attachSampleProcessor( m_opusStreamProcessor );
+
+        return absl::OkStatus();
+    }
+
+    ouro_nodiscard absl::Status stop()
+    {
+        if ( m_serverThread == nullptr )
+        {
+            return absl::UnavailableError( "server is already stopped" );
+        }
+
+        // pull the encoder out of the audio path first so nothing new lands in the ring
+        if ( m_opusStreamProcessorID != ssp::StreamProcessorInstanceID::invalid() )
+        {
+            m_appCoreServices.getAudioModule()->blockUntil(
+                m_appCoreServices.getAudioModule()->detachSampleProcessor( m_opusStreamProcessorID ) );
+            m_opusStreamProcessorID = ssp::StreamProcessorInstanceID::invalid();
+        }
+
+        // wake up any client threads waiting on pages, they will then close out their connections
+        {
+            std::lock_guard< std::mutex > ringLock( m_ringMutex );
+            m_running = false;
+        }
+        m_ringCVar.notify_all();
+
+        m_server->stop();
+        m_serverThread->join();
+        m_serverThread.reset();
+        m_server.reset();
+
+        m_opusStreamProcessor.reset();
+        m_serverState = ServerState::Stopped;
+
+        return absl::OkStatus();
+    }
+
+    void buildStreamHeaders( const uint32_t sampleRate, const uint16_t preSkip )
+    {
+        // pick a fresh serial number for each run so players don't confuse restarted streams
+        m_streamSerial = static_cast<uint32_t>( std::chrono::steady_clock::now().time_since_epoch().count() );
+
+        std::string opusHead;
+        opusHead.append( "OpusHead", 8 );
+        opusHead.push_back( 1 );                            // version
+        opusHead.push_back( 2 );                            // channel count
+        ogg::appendLE( opusHead, preSkip );
+        ogg::appendLE( opusHead, sampleRate );              // original input sample rate
+        ogg::appendLE( opusHead, int16_t( 0 ) );            // output gain
+        opusHead.push_back( 0 );                            // channel mapping family; mono/stereo
+
+        const std::string vendor = OURO_FRAMEWORK_CREDIT;
+        const std::string encoderComment = "ENCODER=OUROVEON " OURO_FRAMEWORK_VERSION;
+
+        std::string opusTags;
+        opusTags.append( "OpusTags", 8 );
+        ogg::appendLE( opusTags, static_cast<uint32_t>( vendor.size() ) );
+        opusTags.append( vendor );
+        ogg::appendLE( opusTags, uint32_t( 1 ) );           // user comment count
+        ogg::appendLE( opusTags, static_cast<uint32_t>( encoderComment.size() ) );
+        opusTags.append( encoderComment );
+
+        m_streamHeaders.clear();
+        ogg::appendPacketAsPage( m_streamHeaders, ogg::BeginOfStream, m_streamSerial, 0, opusHead );
+        ogg::appendPacketAsPage( m_streamHeaders, ogg::Fresh,         m_streamSerial, 1, opusTags );
+    }
+
+    void configureServer()
+    {
+        // each connected listener holds a worker for the lifetime of its connection; leave a couple spare
+        // so that rejections can still be serviced when we're full
+        m_server->new_task_queue = []
+        {
+            return new httplib::ThreadPool( OpusServer::cMaxClients + 2 );
+        };
+
+        // a client that can't take a page within this time is considered gone
+        m_server->set_write_timeout( 5, 0 );
+
+        m_server->Get( "/", []( const httplib::Request&, httplib::Response& res )
+        {
+            res.set_content( fmt::format( FMTX(
+                "<!DOCTYPE html><html><head><title>OUROVEON</title></head>"
+                "<body><audio controls autoplay src=\"{}\"></audio></body></html>" ), OpusServer::cStreamEndpoint ),
+                "text/html" );
+        });
+
+        m_server->Get( OpusServer::cStreamEndpoint, [this]( const httplib::Request& req, httplib::Response& res )
+        {
+            // claim a listener slot in one step; checking the count and then incrementing it separately would let
+            // simultaneous connections all pass the check and go over the limit
+            uint32_t clientsConnected = m_clientsConnected.load();
+            do
+            {
+                if ( clientsConnected >= OpusServer::cMaxClients )
+                {
+                    res.status = 503;
+                    res.set_content( "listener limit reached", "text/plain" );
+                    return;
+                }
+            } while ( !m_clientsConnected.compare_exchange_weak( clientsConnected, clientsConnected + 1 ) );
+
+            auto client = std::make_shared< Client >();
+            {
+                // start new listeners on the most recent page so playback begins straight away
+                std::lock_guard< std::mutex > ringLock( m_ringMutex );
+                client->m_cursor = ( m_ringHead > 0 ) ? ( m_ringHead - 1 ) : 0;
+            }
+
+            blog::app( FMTX( "[broadcast] listener connected ({}:{})" ), req.remote_addr, req.remote_port );
+
+            res.set_header( "Cache-Control", "no-cache, no-store" );
+            res.set_content_provider(
+                "audio/ogg",
+                [this, client]( size_t offset, httplib::DataSink& sink ) -> bool
+                {
+                    return provideClientData( *client, sink );
+                },
+                [this, remote = fmt::format( FMTX( "{}:{}" ), req.remote_addr, req.remote_port )]( bool success )
+                {
+                    m_clientsConnected--;
+                    blog::app( FMTX( "[broadcast] listener disconnected ({})" ), remote );
+                });
+        });
+    }
+
+    // called repeatedly from a server worker thread for as long as the listener is connected
+    bool provideClientData( Client& client, httplib::DataSink& sink )
+    {
+        if ( !client.m_sentHeaders )
+        {
+            client.m_sentHeaders = true;
+            m_bytesSent += m_streamHeaders.size();
+
+            return sink.write( m_streamHeaders.data(), m_streamHeaders.size() );
+        }
+
+        PagePtr page;
+        {
+            std::unique_lock< std::mutex > ringLock( m_ringMutex );
+            m_ringCVar.wait_for( ringLock, cClientWaitTimeout, [&]
+            {
+                return !m_running || client.m_cursor < m_ringHead;
+            });
+
+            if ( !m_running )
+            {
+                sink.done();
+                return true;
+            }
+
+            // nothing new yet; hand back to httplib so it can check the connection is still alive
+            if ( client.m_cursor >= m_ringHead )
+                return true;
+
+            // ring has lapped this client, it cannot keep up - cut it loose
+            if ( m_ringHead - client.m_cursor > OpusServer::cPageRingSize )
+            {
+                m_clientsDropped++;
+                blog::app( FMTX( "[broadcast] dropping listener, {} pages behind" ), m_ringHead - client.m_cursor );
+                return false;
+            }
+
+            page = m_pageRing[ client.m_cursor % OpusServer::cPageRingSize ];
+            client.m_cursor++;
+        }
+
+        // write outside of the lock; a slow socket only ever holds up its own client
+        m_bytesSent += page->size();
+        return sink.write( page->data(), page->size() );
+    }
+
+    // called from the OpusStream processor thread with each block of encoded packets; mux them into
+    // pages and publish them to the ring. nothing in here blocks for longer than a ring insertion
+    void onOpusPacketBlock( ssp::OpusPacketDataInstance&& packets )
+    {
+        auto pageData = std::make_shared< std::string >();
+        pageData->reserve( packets->m_opusDataBufferSize );
+
+        m_workingLacing.clear();
+
+        const uint8_t*  pagePayload         = packets->m_opusData;
+        std::size_t     pagePayloadBytes    = 0;
+
+        for ( const auto packetSize : packets->m_opusPacketSizes )
+        {
+            // flush what we have if this packet won't fit in the current page's lacing table
+            if ( m_workingLacing.size() + ogg::lacingCount( packetSize ) > ogg::cMaxLacingValues )
+            {
+                ogg::appendPage( *pageData, ogg::Fresh, m_granulePosition, m_streamSerial, m_pageSequence++, m_workingLacing, pagePayload, pagePayloadBytes );
+
+                m_workingLacing.clear();
+                pagePayload        += pagePayloadBytes;
+                pagePayloadBytes    = 0;
+            }
+
+            ogg::appendLacing( m_workingLacing, packetSize );
+            pagePayloadBytes  += packetSize;
+            m_granulePosition += ssp::OpusStream::cFrameSize;
+        }
+        if ( !m_workingLacing.empty() )
+        {
+            ogg::appendPage( *pageData, ogg::Fresh, m_granulePosition, m_streamSerial, m_pageSequence++, m_workingLacing, pagePayload, pagePayloadBytes );
+        }
+
+        m_pagesEncoded++;
+        m_bytesEncoded += pageData->size();
+
+        PagePtr retiredPage = std::move( pageData );
+        {
+            std::lock_guard< std::mutex > ringLock( m_ringMutex );
+            std::swap( m_pageRing[ m_ringHead % OpusServer::cPageRingSize ], retiredPage );
+            m_ringHead++;
+        }
+        m_ringCVar.notify_all();
+    }
+
+    void serverThread()
+    {
+        OuroveonThreadScope ots( OURO_THREAD_PREFIX "OpusBroadcast" );
+
+        blog::app( FMTX( "[broadcast] serving on port {}" ), m_port );
+        m_serverState = ServerState::Running;
+
+        if ( !m_server->listen_after_bind() && m_running )
+        {
+            blog::error::app( FMTX( "[broadcast] server stopped unexpectedly" ) );
+            m_serverState = ServerState::Failed;
+        }
+
+        blog::app( FMTX( "[broadcast] ... server thread exit" ) );
+    }
+
+
+    app::ICoreServices&                 m_appCoreServices;
+
+    ssp::OpusStream::SharedPtr          m_opusStreamProcessor;
+    ssp::StreamProcessorInstanceID      m_opusStreamProcessorID;
+
+    std::unique_ptr< httplib::Server >  m_server;
+    std::unique_ptr< std::thread >      m_serverThread;
+    std::atomic< ServerState >          m_serverState       = ServerState::Stopped;
+    uint32_t                            m_port              = 0;
+
+    // muxer state, only touched from the encoder thread once running
+    std::string                         m_streamHeaders;
+    uint32_t                            m_streamSerial      = 0;
+    uint32_t                            m_pageSequence      = 0;
+    int64_t                             m_granulePosition   = 0;
+    std::vector< uint8_t >              m_workingLacing;
+
+    // shared page ring; m_ringHead is the total number of entries ever written
+    std::mutex                          m_ringMutex;
+    std::condition_variable             m_ringCVar;
+    PageRing                            m_pageRing;
+    uint64_t                            m_ringHead          = 0;
+    std::atomic_bool                    m_running           = false;
+
+    std::atomic_uint32_t                m_clientsConnected  = 0;
+    std::atomic_uint32_t                m_clientsDropped    = 0;
+    std::atomic_uint64_t                m_pagesEncoded      = 0;
+    std::atomic_uint64_t                m_bytesEncoded      = 0;
+    std::atomic_uint64_t                m_bytesSent         = 0;
+};
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+OpusServer::OpusServer( app::ICoreServices& coreServices )
+    : m_state( std::make_unique<State>( coreServices ) )
+{
+}
+
+OpusServer::~OpusServer()
+{
+}
+
+absl::Status OpusServer::start( const uint32_t port, const int32_t bitrate )
+{
+    return m_state->start( port, bitrate );
+}
+
+absl::Status OpusServer::stop()
+{
+    return m_state->stop();
+}
+
+ServerState OpusServer::getState() const
+{
+    return m_state->m_serverState;
+}
+
+uint32_t OpusServer::getPort() const
+{
+    return m_state->m_port;
+}
+
+void OpusServer::getStats( Stats& stats ) const
+{
+    stats.m_clientsConnected    = m_state->m_clientsConnected;
+    stats.m_clientsDropped      = m_state->m_clientsDropped;
+    stats.m_pagesEncoded        = m_state->m_pagesEncoded;
+    stats.m_bytesEncoded        = m_state->m_bytesEncoded;
+    stats.m_bytesSent           = m_state->m_bytesSent;
+}
+
+bool OpusServer::getCurrentCompressionSetup( ssp::OpusStream::CompressionSetup& setup ) const
+{
+    if ( m_state->m_opusStreamProcessor )
+    {
+        setup = m_state->m_opusStreamProcessor->getCurrentCompressionSetup();
+        return true;
+    }
+    return false;
+}
+
+bool OpusServer::setCompressionSetup( const ssp::OpusStream::CompressionSetup& setup )
+{
+    if ( m_state->m_opusStreamProcessor )
+    {
+        m_state->m_opusStreamProcessor->setCompressionSetup( setup );
+        return true;
+    }
+    return false;
+}
+
+} // namespace broadcast
+} // namespace net
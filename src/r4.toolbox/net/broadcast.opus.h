@@ -0,0 +1,77 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  embedded HTTP server that streams the final audio mix as a continuous Ogg/Opus stream to any number of
+//  listeners on the local network; audio is encoded once by an OpusStream processor, muxed into Ogg pages and
+//  pushed into a shared ring that each connected client reads from at its own pace. clients that fall further
+//  behind than the ring can hold are disconnected rather than holding anything else up
+//
+//  eg.  curl http://localhost:8090/stream.opus | ffplay -
+//
+
+#pragma once
+
+#include "base/construction.h"
+
+#include "ssp/ssp.stream.opus.h"
+
+namespace app { struct ICoreServices; }
+
+namespace net {
+namespace broadcast {
+
+enum class ServerState
+{
+    Stopped,
+    Starting,
+    Running,
+    Failed
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct OpusServer
+{
+    DECLARE_NO_COPY_NO_MOVE( OpusServer );
+
+    // number of muxed Ogg pages held in the shared ring; each page holds one block of encoded packets
+    // from the OpusStream (OpusStream::cBufferedFrames worth of audio), this dictates how far behind a client can fall
+    static constexpr uint32_t   cPageRingSize       = 16;
+    // hard limit on concurrent listeners, each one occupies a server thread for as long as it is connected
+    static constexpr uint32_t   cMaxClients         = 16;
+
+    static constexpr auto       cStreamEndpoint     = "/stream.opus";
+
+    struct Stats
+    {
+        uint32_t    m_clientsConnected  = 0;
+        uint32_t    m_clientsDropped    = 0;    // total clients disconnected for being too slow
+        uint64_t    m_pagesEncoded      = 0;
+        uint64_t    m_bytesEncoded      = 0;
+        uint64_t    m_bytesSent         = 0;    // total across all clients
+    };
+
+    OpusServer( app::ICoreServices& coreServices );
+    ~OpusServer();
+
+    // create the encoder, attach it to the audio module and begin listening on the given port
+    ouro_nodiscard absl::Status start( const uint32_t port, const int32_t bitrate );
+    ouro_nodiscard absl::Status stop();
+
+    ouro_nodiscard ServerState getState() const;
+    ouro_nodiscard uint32_t getPort() const;
+
+    void getStats( Stats& stats ) const;
+
+    bool getCurrentCompressionSetup( ssp::OpusStream::CompressionSetup& setup ) const;
+    bool setCompressionSetup( const ssp::OpusStream::CompressionSetup& setup );
+
+private:
+    struct State;
+    std::unique_ptr< State >    m_state;
+};
+
+} // namespace broadcast
+} // namespace net
@@ -0,0 +1,182 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "base/text.h"
+
+#include "net/broadcast.opus.ui.h"
+#include "net/broadcast.opus.h"
+#include "net/broadcast.config.h"
+
+#include "app/module.audio.h"
+
+
+namespace net {
+namespace broadcast {
+
+// ---------------------------------------------------------------------------------------------------------------------
+OpusServerWithUI::OpusServerWithUI( app::ICoreServices& coreServices )
+    : m_services( coreServices )
+    , m_trafficOutBytes( 0 )
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+OpusServerWithUI::~OpusServerWithUI()
+{
+    // the status bar block captures `this`, it can't be left behind if we go away while broadcasting
+    if ( m_trafficOutBytesStatusHandle.has_value() )
+    {
+        ABSL_ASSERT( m_trafficOutBytesStatusOwner != nullptr );
+        m_trafficOutBytesStatusOwner->unregisterStatusBarBlock( m_trafficOutBytesStatusHandle.value() );
+        m_trafficOutBytesStatusHandle.reset();
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void OpusServerWithUI::imgui( app::CoreGUI& coreGUI )
+{
+    // delay-load any stored server settings
+    if ( !m_config.has_value() )
+    {
+        config::broadcast::Server serverConfig;
+
+        // try and load existing config, failure is fine
+        std::ignore = config::load( coreGUI, serverConfig );
+        m_config = serverConfig;
+    }
+
+    OpusServer::Stats stats;
+    if ( m_server )
+    {
+        m_server->getStats( stats );
+        m_trafficOutBytes = stats.m_bytesSent;
+    }
+
+    if ( ImGui::Begin( ICON_FA_TOWER_BROADCAST " LAN Broadcast###broadcast_view" ) )
+    {
+        const float panelWidth = ImGui::GetContentRegionAvail().x;
+
+        if ( m_services.getAudioModule()->getSampleRate() != 48000 )
+        {
+            ImGui::TextDisabled( "[ Incompatible Audio Sample Rate ]" );
+        }
+        else if ( m_server == nullptr )
+        {
+            ABSL_ASSERT( m_config.has_value() );
+            auto& serverConfig = m_config.value();
+
+            ImGui::PushItemWidth( panelWidth * 0.5f );
+            {
+                int32_t port = static_cast<int32_t>( serverConfig.port );
+                if ( ImGui::InputInt( " Port", &port, 1, 10 ) )
+                    serverConfig.port = static_cast<uint32_t>( std::clamp( port, 1024, 65535 ) );
+
+                ImGui::SliderInt( " Target Bitrate", &serverConfig.bitrate, 32000, 256000 );
+                ImGui::CompactTooltip( "OPUS compressor target bitrate" );
+            }
+            ImGui::PopItemWidth();
+
+            ImGui::Spacing();
+            ImGui::Spacing();
+
+            if ( ImGui::Button( ICON_FA_CIRCLE_PLAY " Start Broadcast ", ImVec2( -1.0f, 34.0f ) ) )
+            {
+                if ( config::save( coreGUI, serverConfig ) != config::SaveResult::Success )
+                {
+                    blog::error::cfg( "Unable to save broadcast configuration" );
+                }
+
+                m_server = std::make_unique< OpusServer >( m_services );
+                m_serverStatus = m_server->start( serverConfig.port, serverConfig.bitrate );
+                if ( !m_serverStatus.ok() )
+                {
+                    blog::error::app( FMTX( "broadcast server failed to start; {}" ), m_serverStatus.ToString() );
+                    m_server.reset();
+                }
+            }
+
+            // report a basic start failure, set above
+            if ( !m_serverStatus.ok() )
+            {
+                ImGui::Spacing();
+                ImGui::TextColored( ImGui::GetErrorTextColour(), ICON_FA_TRIANGLE_EXCLAMATION " %s", m_serverStatus.ToString().c_str() );
+            }
+        }
+        else
+        {
+            if ( !m_trafficOutBytesStatusHandle.has_value() )
+            {
+                m_trafficOutBytesStatusHandle = coreGUI.registerStatusBarBlock( app::CoreGUI::StatusBarAlignment::Right, 120.0f, [this]()
+                {
+                    ImGui::Text( ICON_FA_TOWER_BROADCAST " %s", base::humaniseByteSize( "", m_trafficOutBytes ).c_str() );
+                });
+                m_trafficOutBytesStatusOwner = &coreGUI;
+            }
+
+            switch ( m_server->getState() )
+            {
+                case ServerState::Stopped:
+                case ServerState::Starting:
+                    ImGui::TextColored( ImGui::GetPulseColourVec4(), ICON_FA_CIRCLE_DOT " Starting ..." );
+                    break;
+                case ServerState::Running:
+                    ImGui::TextColored( ImGui::GetStyleColorVec4( ImGuiCol_NavHighlight ), ICON_FA_CIRCLE " Live on port %u", m_server->getPort() );
+                    break;
+                case ServerState::Failed:
+                    ImGui::TextColored( ImGui::GetErrorTextColour(), ICON_FA_TRIANGLE_EXCLAMATION " Server failure, check log" );
+                    break;
+            }
+            ImGui::Spacing();
+            ImGui::TextDisabled( "http://<this-machine>:%u%s", m_server->getPort(), OpusServer::cStreamEndpoint );
+            ImGui::Spacing();
+            ImGui::Spacing();
+
+            ImGui::Text( "Listeners      : %u / %u", stats.m_clientsConnected, OpusServer::cMaxClients );
+            ImGui::Text( "Dropped (slow) : %u", stats.m_clientsDropped );
+            ImGui::Text( "Encoded        : %s", base::humaniseByteSize( "", stats.m_bytesEncoded ).c_str() );
+            ImGui::Spacing();
+
+            ssp::OpusStream::CompressionSetup setup;
+            if ( m_server->getCurrentCompressionSetup( setup ) )
+            {
+                ImGui::PushItemWidth( panelWidth * 0.5f );
+                if ( ImGui::SliderInt( " Target Bitrate", &setup.m_bitrate, 32000, 256000 ) )
+                {
+                    m_server->setCompressionSetup( setup );
+                    m_config->bitrate = setup.m_bitrate;
+                }
+                ImGui::PopItemWidth();
+            }
+
+            ImGui::Spacing();
+            ImGui::Spacing();
+
+            if ( ImGui::Button( ICON_FA_CIRCLE_STOP " Stop Broadcast ", ImVec2( -1.0f, 34.0f ) ) )
+            {
+                std::ignore = m_server->stop();
+                m_server.reset();
+                m_serverStatus = absl::OkStatus();
+            }
+        }
+    }
+    ImGui::End();
+
+    // remove status bar chunk when not live
+    if ( m_server == nullptr && m_trafficOutBytesStatusHandle.has_value() )
+    {
+        coreGUI.unregisterStatusBarBlock( m_trafficOutBytesStatusHandle.value() );
+        m_trafficOutBytesStatusHandle.reset();
+        m_trafficOutBytesStatusOwner = nullptr;
+    }
+}
+
+} // namespace broadcast
+} // namespace net
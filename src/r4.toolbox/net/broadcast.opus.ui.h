@@ -0,0 +1,44 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#pragma once
+
+#include "app/core.h"
+#include "net/broadcast.config.h"
+
+namespace net {
+namespace broadcast {
+
+struct OpusServer;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// little wrapper around running the LAN broadcast server via an imgui panel
+struct OpusServerWithUI
+{
+    OpusServerWithUI( app::ICoreServices& coreServices );
+    ~OpusServerWithUI();
+
+    void imgui( app::CoreGUI& coreGUI );
+
+
+private:
+
+    std::unique_ptr< OpusServer >               m_server;
+    absl::Status                                m_serverStatus;
+
+    app::ICoreServices&                         m_services;
+    std::optional< config::broadcast::Server >  m_config;
+
+    app::CoreGUI::UIInjectionHandleOptional     m_trafficOutBytesStatusHandle;
+    app::CoreGUI*                               m_trafficOutBytesStatusOwner = nullptr;    // who we registered the block with
+    uint64_t                                    m_trafficOutBytes;
+};
+
+} // namespace broadcast
+} // namespace net
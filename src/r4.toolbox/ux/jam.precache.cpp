@@ -14,16 +14,13 @@
 
 #include "app/imgui.ext.h"
 
-#include "endlesss/cache.stems.h"
-#include "endlesss/live.stem.h"
+#include "endlesss/toolkit.stem.precache.h"
 #include "endlesss/toolkit.warehouse.h"
 
 namespace ux {
 
 struct JamPrecacheState
 {
-    static constexpr std::size_t cSyncSamples = 16;
-
     using Instance = std::shared_ptr<JamPrecacheState>;
 
     enum class State
@@ -41,20 +38,22 @@ struct JamPrecacheState
     {
     }
 
-#if OURO_DEBUG
     ~JamPrecacheState()
     {
+        // make sure workers are done before anything they might touch goes away
+        m_precache.reset();
+
+#if OURO_DEBUG
         if ( m_failureDiagnosticLog != nullptr )
         {
             fclose( m_failureDiagnosticLog );
         }
-    }
 #endif // OURO_DEBUG
+    }
 
     void imgui(
         const endlesss::toolkit::Warehouse& warehouse,
-        endlesss::services::RiffFetchProvider& fetchProvider,
-        tf::Executor& taskExecutor );
+        endlesss::services::RiffFetchProvider& fetchProvider );
 
     endlesss::types::JamCouchID     m_jamCouchID;
     endlesss::types::StemCouchIDs   m_stemIDs;
@@ -74,23 +73,13 @@ struct JamPrecacheState
     int32_t                         m_maximumDownloadsInFlight = OURO_THREAD_LIMIT;
 
     State                           m_state = State::Intro;
-    std::size_t                     m_currentStemIndex = 0;
 
     std::size_t                     m_stemPayloadFileSizeEstimation = 0;
     std::string                     m_stemPayloadFileSizeEstimationString;
 
-    std::atomic_uint32_t            m_statsStemsAlreadyInCache = 0;
-    std::atomic_uint32_t            m_statsStemsDownloaded = 0;
-    std::atomic_uint32_t            m_statsStemsMissingFromDb = 0;
-    std::atomic_uint32_t            m_statsStemsFailedToDownload = 0;           // some kind of stem download error, may be resolveable with re-download
-    std::atomic_uint32_t            m_statsStemsFailedToDownloadTerminal = 0;   // 403 errors - the stem is gone forever
-
-    std::atomic_uint32_t            m_downloadsDispatched = 0;
-
-    spacetime::Moment               m_syncTimer;
-    base::RollingAverage< cSyncSamples >
-                                    m_averageSyncTimeMillis;
-    std::size_t                     m_averageSyncMeasurements = 0;
+    // the actual work is all done by the precache service on its own threads, we just poll it for progress
+    std::unique_ptr< endlesss::toolkit::StemPrecache >
+                                    m_precache;
 };
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -104,8 +93,7 @@ void modalJamPrecache(
     const char* title,
     JamPrecacheState& jamPrecacheState,
     const struct endlesss::toolkit::Warehouse& warehouse,
-    endlesss::services::RiffFetchProvider& fetchProvider,
-    tf::Executor& taskExecutor )
+    endlesss::services::RiffFetchProvider& fetchProvider )
 {
     const ImVec2 configWindowSize = ImVec2( 830.0f, 260.0f );
     ImGui::SetNextWindowContentSize( configWindowSize );
@@ -114,7 +102,7 @@ void modalJamPrecache(
 
     if ( ImGui::BeginPopupModal( title, nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoResize ) )
     {
-        jamPrecacheState.imgui( warehouse, fetchProvider, taskExecutor );
+        jamPrecacheState.imgui( warehouse, fetchProvider );
 
         ImGui::EndPopup();
     }
@@ -124,8 +112,7 @@ void modalJamPrecache(
 // ---------------------------------------------------------------------------------------------------------------------
 void JamPrecacheState::imgui(
     const endlesss::toolkit::Warehouse& warehouse,
-    endlesss::services::RiffFetchProvider& fetchProvider,
-    tf::Executor& taskExecutor )
+    endlesss::services::RiffFetchProvider& fetchProvider )
 {
     const ImVec2 buttonSize( 240.0f, 32.0f );
 
@@ -220,159 +207,68 @@ void JamPrecacheState::imgui(
             ImGui::Spacing();
             if ( ImGui::Button( "Begin Download", buttonSize ) )
             {
-                ABSL_ASSERT( m_currentStemIndex == 0 );
+                endlesss::toolkit::StemPrecache::FailureCallback failureCallback = nullptr;
 
 #if OURO_DEBUG
                 if ( m_enableFailureLog )
                 {
                     m_failureDiagnosticLog = fopen( "precache_failures.txt", "wt" );
+
+                    failureCallback = [this]( const endlesss::types::Stem& stemData, const uint32_t httpStatus )
+                        {
+                            std::scoped_lock<std::mutex> logLock( m_failureDiagnosticMutex );
+
+                            const auto failedEndpoint = stemData.fullEndpoint();
+                            fprintf( m_failureDiagnosticLog, "%s/%s\n", failedEndpoint.c_str(), stemData.fileKey.c_str() );
+                            fflush( m_failureDiagnosticLog );
+                        };
                 }
 #endif // OURO_DEBUG
 
-                m_syncTimer.setToNow();
+                m_precache = std::make_unique< endlesss::toolkit::StemPrecache >( warehouse, fetchProvider );
+                m_precache->start( m_stemIDs, m_maximumDownloadsInFlight, m_enableDryRun, failureCallback );
+
                 m_state = State::Download;
             }
         }
         break;
 
-        // do the actual work; this runs through and triggers more download tasks if we don't have enough in-flight
+        // the precache service is doing the work, show how it's getting on
         case State::Download:
         {
-            const auto stemCount = m_stemIDs.size();
-
-            if ( m_currentStemIndex >= stemCount )
+            if ( !m_precache->isRunning() )
             {
-                taskExecutor.wait_for_all();
                 m_state = State::Complete;
                 break;
             }
 
-            // show progress
-            {
-                const float progressFraction = (1.0f / static_cast<float>(stemCount)) * static_cast<float>(m_currentStemIndex);
-                ImGui::ProgressBar( progressFraction, ImVec2( -1, 26.0f ), fmt::format( FMTX( "{} of {}" ), m_currentStemIndex + 1, m_stemIDs.size() ).c_str() );
-            }
+            const auto& stats = m_precache->getStatistics();
+            const auto  stemCount = m_precache->getTotalStems();
 
-            // how many fs::exists() checks we can do in a sequence, otherwise we would do one per frame and 
-            // that means iterating through larger jams that are already on-disk would be a chore
-            int32_t fileOpsBurstCount = 100;
-
-            // if there are not enough live tasks running, kick some off
-            while ( m_downloadsDispatched < static_cast<uint32_t>(m_maximumDownloadsInFlight) && fileOpsBurstCount > 0 )
+            // show progress
             {
-                const endlesss::types::StemCouchID stemID = m_stemIDs[ ( stemCount - 1 ) - m_currentStemIndex ];
-
-                // pull the full stem data we have on file
-                endlesss::types::Stem stemData;
-                bool bFoundStemData = warehouse.fetchSingleStemByID( stemID, stemData );
-                if ( bFoundStemData )
-                {
-                    const fs::path stemCachePath = fetchProvider->getStemCache().getCachePathForStem( stemData );
-
-                    // early out if the stem already exists in the cache -- although this is checked in the stem-live code,
-                    // saves on allocation and work if we check it here too
-                    if ( fs::exists( stemCachePath / stemData.couchID.value() ) )
-                    {
-                        m_statsStemsAlreadyInCache++;
-                        fileOpsBurstCount--;
-                    }
-                    else
-                    {
-                        if ( !m_enableDryRun )
-                        {
-                            ++m_downloadsDispatched;
-                            fileOpsBurstCount = -1;
-
-                            // keep timer on how long it takes to cycle through to dispatching new tasks; this gives
-                            // a rough idea of how long the whole process will take
-                            {
-                                const auto downloadTimeMillis = m_syncTimer.delta< std::chrono::milliseconds >();
-                                m_averageSyncTimeMillis.update( static_cast<double>(downloadTimeMillis.count()) );
-                                m_syncTimer.setToNow();
-                                ++m_averageSyncMeasurements;
-                            }
-
-                            // kick out an untethered async task to initialise a live Stem object
-                            // doing so will go through the default machinery of downloading / validating it, same as
-                            // when we do this for playing riffs back in the rest of the app - difference being that 
-                            // we don't keep the live Stem around, it's just immediately tossed
-                            taskExecutor.silent_async( [=, this]()
-                                {
-                                    auto stemLivePtr = std::make_shared<endlesss::live::Stem>( stemData, 8000 );   // any sample rate is fine, we aren't keeping the data
-                                    stemLivePtr->fetch(
-                                        fetchProvider->getNetConfiguration(),
-                                        stemCachePath );
-
-                                    if ( stemLivePtr->hasFailed() )
-                                    {
-#if OURO_DEBUG
-                                        if ( m_enableFailureLog )
-                                        {
-                                            const auto failedEndpoint = stemData.fullEndpoint();
-                                            fprintf( m_failureDiagnosticLog, "%s/%s\n", failedEndpoint.c_str(), stemData.fileKey.c_str() );
-                                            fflush( m_failureDiagnosticLog );
-                                        }
-#endif // OURO_DEBUG
-                                        blog::error::app( FMTX( "failed to download stem to cache : [{}]" ), stemID );
-                                        ++m_statsStemsFailedToDownload;
-
-                                        // check if we have a recorded HTTP status - and if it's a permission failure, 
-                                        // it shows the bug we have had where some stems on the CDN have become permanently unreachable
-                                        const uint32_t httpFailureStatus = stemLivePtr->httpFailureStatus();
-                                        if ( httpFailureStatus != 0 )
-                                        {
-                                            if ( httpFailureStatus == 403 )
-                                            {
-                                                m_statsStemsFailedToDownloadTerminal++;
-                                            }
-                                        }
-                                    }
-                                    else
-                                    {
-                                        ++m_statsStemsDownloaded;
-                                    }
-
-                                    // tag that we are done with this task so that the cycle can kick more off
-                                    --m_downloadsDispatched;
-                                });
-                        }
-                    }
-                }
-                else
-                {
-                    blog::error::app( FMTX( "was unable to fetch stem data from warehouse during precache : [{}]" ), stemID );
-                    ++m_statsStemsMissingFromDb;
-                }
-
-                // we've done something with this one, next stem in the list...
-                ++m_currentStemIndex;
-                // break out of the burst loop if we're out of stems, it will flush the workers on the next loop round
-                if ( m_currentStemIndex >= m_stemIDs.size() )
-                    break;
+                const uint32_t stemsProcessed = stats.m_stemsProcessed;
+                const float progressFraction = (1.0f / static_cast<float>(stemCount)) * static_cast<float>(stemsProcessed);
+                ImGui::ProgressBar( progressFraction, ImVec2( -1, 26.0f ), fmt::format( FMTX( "{} of {}" ), stemsProcessed, stemCount ).c_str() );
             }
 
             ImGui::Spacing();
             ImGui::Spacing();
 
-            // do some estimation of how long the full download will take based on how long the average download is taking
-            // based on how long each stem has taken so far
-            if ( m_averageSyncMeasurements < cSyncSamples * 2 )
+            // extrapolate how long the whole process will take based on progress so far
+            std::chrono::seconds timeRemaining;
+            if ( !m_precache->estimateTimeRemaining( timeRemaining ) )
             {
                 ImGui::TextColored( colour::shades::toast.dark(), "Estimated time remaining : Calculating ..." );
             }
             else
             {
-                const uint32_t averageSyncTimeMs = static_cast<uint32_t>(m_averageSyncTimeMillis.getInt64());
-                std::chrono::milliseconds perSyncMs( averageSyncTimeMs );
-                float perSyncSecF = static_cast<float>( perSyncMs.count() ) / 1000.0f;
-                
-                // multiply per-sync time by the remaining stem count
-                perSyncMs *= m_stemIDs.size() - m_currentStemIndex;
-                std::chrono::minutes fullSyncMinutes = std::chrono::duration_cast<std::chrono::minutes>( perSyncMs );
-
-                ImGui::TextColored( colour::shades::toast.light(), "Estimated time remaining : ~%u minute(s) (~%.1f seconds per stem)",
+                const auto fullSyncMinutes = std::chrono::duration_cast<std::chrono::minutes>( timeRemaining );
+                const auto bytesDownloaded = base::humaniseByteSize( "", stats.m_bytesDownloaded.load() );
+
+                ImGui::TextColored( colour::shades::toast.light(), "Estimated time remaining : ~%u minute(s) (%s downloaded so far)",
                     static_cast<uint32_t>( fullSyncMinutes.count() ),
-                    perSyncSecF
+                    bytesDownloaded.c_str()
                     );
             }
         }
@@ -385,9 +281,11 @@ void JamPrecacheState::imgui(
                 ImGui::TextColored( colour::shades::green.light(), "Process complete" );
             }
 
+            const auto& stats = m_precache->getStatistics();
+
             // work out percentages for how many stems are found on disk and how many have come down over the wire
-            const auto stemsInCache         = m_statsStemsAlreadyInCache.load();
-            const auto stemsDownloaded      = m_statsStemsDownloaded.load();
+            const auto stemsInCache         = stats.m_stemsAlreadyInCache.load();
+            const auto stemsDownloaded      = stats.m_stemsDownloaded.load();
             const double totalStemsRecpPct  = 100.0 / static_cast<double>( m_stemIDs.size() );
             const double stemsInCachePct    = totalStemsRecpPct * static_cast<double>(stemsInCache);
             const double downloadedPct      = totalStemsRecpPct * static_cast<double>(stemsDownloaded);
@@ -399,15 +297,15 @@ void JamPrecacheState::imgui(
             ImGui::SeparatorBreak();
             ImGui::TextColored( colour::shades::toast.light(), "[ %6i ] Stems already in cache (%.1f%%)", stemsInCache, stemsInCachePct );
             ImGui::TextColored( colour::shades::callout.light(), "[ %6i ] Stems downloaded (%.1f%%)", stemsDownloaded, downloadedPct );
-            if ( m_statsStemsFailedToDownload > 0 )
-                ImGui::TextColored( colour::shades::errors.neutral(), "[ %6i ] Stems failed to download", m_statsStemsFailedToDownload.load() );
-            if ( m_statsStemsFailedToDownloadTerminal > 0 )
+            if ( stats.m_stemsFailedToDownload > 0 )
+                ImGui::TextColored( colour::shades::errors.neutral(), "[ %6i ] Stems failed to download", stats.m_stemsFailedToDownload.load() );
+            if ( stats.m_stemsFailedToDownloadTerminal > 0 )
             {
-                ImGui::TextColored( colour::shades::errors.light(), "[ %6i ] Stems failed to download permanently [?]", m_statsStemsFailedToDownloadTerminal.load() );
+                ImGui::TextColored( colour::shades::errors.light(), "[ %6i ] Stems failed to download permanently [?]", stats.m_stemsFailedToDownloadTerminal.load() );
                 ImGui::CompactTooltip( "These stems returned a 403 error code from the CDN\nThere is no way to recover them" );
             }
-            if ( m_statsStemsMissingFromDb > 0 )
-                ImGui::TextColored( colour::shades::errors.light(), "[ %6i ] Stems missing from Warehouse", m_statsStemsMissingFromDb.load() );
+            if ( stats.m_stemsMissingFromDb > 0 )
+                ImGui::TextColored( colour::shades::errors.light(), "[ %6i ] Stems missing from Warehouse", stats.m_stemsMissingFromDb.load() );
         }
         break;
     }
@@ -416,7 +314,10 @@ void JamPrecacheState::imgui(
 
     if ( ImGui::BottomRightAlignedButton( "Close", buttonSize ) )
     {
-        taskExecutor.wait_for_all();
+        // lets any active downloads finish, then waits for the workers to exit
+        if ( m_precache != nullptr )
+            m_precache->stop();
+
         ImGui::CloseCurrentPopup();
     }
 }
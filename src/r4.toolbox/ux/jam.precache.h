@@ -26,7 +26,6 @@ namespace ux {
         const char* title,                                      // a imgui label to use with ImGui::OpenPopup
         JamPrecacheState& jamPrecacheState,                     // UI state 
         const endlesss::toolkit::Warehouse& warehouse,          // warehouse access to pull stem data
-        endlesss::services::RiffFetchProvider& fetchProvider,   // network fetch services
-        tf::Executor& taskExecutor );                           // async support via tf
+        endlesss::services::RiffFetchProvider& fetchProvider ); // network fetch services
 
 } // namespace ux
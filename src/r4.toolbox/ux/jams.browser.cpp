@@ -12,7 +12,6 @@
 #include "ux/jams.browser.h"
 
 #include "base/text.h"
-#include "base/text.transform.h"
 
 #include "app/core.h"
 #include "app/imgui.ext.h"
@@ -20,6 +19,7 @@
 
 #include "endlesss/cache.jams.h"
 #include "endlesss/config.h"
+#include "endlesss/toolkit.population.h"
 
 #include "ux/user.selector.h"
 
@@ -29,8 +29,6 @@ namespace ux {
 // ---------------------------------------------------------------------------------------------------------------------
 struct UniversalJamBrowserState
 {
-    using DiveUserContributions = absl::flat_hash_map< endlesss::types::JamCouchID, uint32_t >;
-
     struct ValidationState
     {
         enum class Mode
@@ -57,20 +55,26 @@ struct UniversalJamBrowserState
     {
         m_diveProcessing = true;
 
-        m_populationDataLoadResult = config::load( pathProvider, m_populationData );
+        // compiled population index is loaded once and then re-queried for each new user
+        if ( !m_populationIndex.isValid() )
+        {
+            const auto loadStatus = m_populationIndex.load( pathProvider );
+            if ( !loadStatus.ok() )
+                blog::error::core( FMTX( "deep dive data unavailable; {}" ), loadStatus.ToString() );
+        }
 
         if ( hasPopulationData() )
         {
+            const auto userContributions = m_populationIndex.findUserContributions( m_diveUser.getUsername() );
+
             // clear out and reserve some space
-            m_diveUserContributions.clear();
             m_diveJamIDs.clear();
             m_diveJamNames.clear();
             m_diveUserRiffCounts.clear();
             m_diveUserPercentage.clear();
             m_diveTotalRiffCounts.clear();
             {
-                const auto reserveSize = m_populationData.jampop.size();
-                m_diveUserContributions.reserve( reserveSize );
+                const auto reserveSize = userContributions.size();
                 m_diveJamIDs.reserve( reserveSize );
                 m_diveJamNames.reserve( reserveSize );
                 m_diveUserRiffCounts.reserve( reserveSize );
@@ -78,27 +82,20 @@ struct UniversalJamBrowserState
                 m_diveTotalRiffCounts.reserve( reserveSize );
             }
 
-            const std::string& userSearch = m_diveUser.getUsername();
-
-            for ( const auto& jamPair : m_populationData.jampop )
+            for ( const auto& userJam : userContributions )
             {
-                for ( const auto& userRiffPair : jamPair.second.user_and_riff_count )
-                {
-                    if ( userRiffPair.first == userSearch )
-                    {
-                        const float riffCountF = static_cast<float>( jamPair.second.riff_scanned );
-                        const float userCountF = static_cast<float>( userRiffPair.second );
+                const uint32_t riffsScanned = m_populationIndex.getJamRiffsScanned( userJam.m_jamIndex );
 
-                        const float userPercentage = ( 100.0f / riffCountF ) * userCountF;
+                const float riffCountF = static_cast<float>( riffsScanned );
+                const float userCountF = static_cast<float>( userJam.m_riffCount );
 
-                        m_diveUserContributions.emplace( jamPair.first, userRiffPair.second );
-                        m_diveJamIDs.emplace_back( jamPair.first );
-                        m_diveJamNames.emplace_back( jamPair.second.jam_name );
-                        m_diveUserRiffCounts.emplace_back( userRiffPair.second );
-                        m_diveUserPercentage.emplace_back( userPercentage );
-                        m_diveTotalRiffCounts.emplace_back( jamPair.second.riff_scanned );
-                    }
-                }
+                const float userPercentage = ( 100.0f / riffCountF ) * userCountF;
+
+                m_diveJamIDs.emplace_back( m_populationIndex.getJamCouchID( userJam.m_jamIndex ) );
+                m_diveJamNames.emplace_back( m_populationIndex.getJamName( userJam.m_jamIndex ) );
+                m_diveUserRiffCounts.emplace_back( userJam.m_riffCount );
+                m_diveUserPercentage.emplace_back( userPercentage );
+                m_diveTotalRiffCounts.emplace_back( riffsScanned );
             }
 
             // build index arrays to then presort on the various data we have to offer
@@ -122,12 +119,7 @@ struct UniversalJamBrowserState
                 m_diveIndexSortedByTotals.push_back( idx );
             }
 
-            // sort the indices by the data in question
-            std::sort( m_diveIndexSortedByName.begin(), m_diveIndexSortedByName.end(),
-                [&]( const size_t lhs, const size_t rhs ) -> bool
-                {
-                    return base::StrToLwrExt( m_diveJamNames[lhs] ) < base::StrToLwrExt( m_diveJamNames[rhs] );
-                });
+            // contributions arrive in name order already, the rest are cheap numeric sorts over this user's jams
             std::sort( m_diveIndexSortedByRiff.begin(), m_diveIndexSortedByRiff.end(),
                 [&]( const size_t lhs, const size_t rhs ) -> bool
                 {
@@ -149,7 +141,7 @@ struct UniversalJamBrowserState
         m_diveProcessing = false;
     }
 
-    bool hasPopulationData() const { return m_populationDataLoadResult == config::LoadResult::Success; }
+    bool hasPopulationData() const { return m_populationIndex.isValid(); }
 
 
     void commonValidationImgui( ValidationState& validationState, const std::string& currentData )
@@ -202,11 +194,9 @@ struct UniversalJamBrowserState
     ImGui::ux::UserSelector                     m_diveUser;
     std::atomic_bool                            m_diveProcessing = false;
 
-    config::endlesss::PopulationPublics         m_populationData;
-    config::LoadResult                          m_populationDataLoadResult;
+    endlesss::toolkit::PopulationPublicsIndex   m_populationIndex;
 
     // data pages for the examined deep dive user
-    DiveUserContributions                       m_diveUserContributions;
     std::vector< endlesss::types::JamCouchID >  m_diveJamIDs;
     std::vector< std::string >                  m_diveJamNames;
     std::vector< uint32_t >                     m_diveUserRiffCounts;
@@ -294,12 +284,21 @@ void modalUniversalJamBrowser(
 
         bool shouldClosePopup = false;
 
-        // wrap up the search function for filtering between public/private jams
+        // rows that pass the name filter, gathered in display order each frame so that only the visible
+        // slice of them needs to be submitted to imgui (public archive can run to many thousands of jams)
+        static std::vector< const Jams::Data* > filteredJams;
+        filteredJams.clear();
+
         const auto iterationFn = [&]( const Jams::Data& jamData )
         {
             if ( !jamNameFilter.PassFilter( jamData.m_displayName.c_str() ) )
                 return;
 
+            filteredJams.emplace_back( &jamData );
+        };
+
+        const auto drawJamRow = [&]( const Jams::Data& jamData )
+        {
             const bool showAsDisabled = ( behaviour.fnIsDisabled && behaviour.fnIsDisabled(jamData.m_jamCID) );
 
             ImGui::TableNextColumn();
@@ -417,6 +416,14 @@ void modalUniversalJamBrowser(
 
                 jamCache.iterateJams( iterationFn, activeType, jamSortOption );
 
+                ImGuiListClipper jamClipper;
+                jamClipper.Begin( (int32_t)filteredJams.size() );
+                while ( jamClipper.Step() )
+                {
+                    for ( int32_t row = jamClipper.DisplayStart; row < jamClipper.DisplayEnd; row++ )
+                        drawJamRow( *filteredJams[row] );
+                }
+
                 ImGui::EndTable();
             }
         }
@@ -438,7 +445,7 @@ void modalUniversalJamBrowser(
                     ImGui::SameLine();
                     if ( ImGui::Button( " Examine Username " ) )
                     {
-                        coreServices.getTaskExecutor().silent_async( [&]()
+                        coreServices.getTaskExecutorIO().silent_async( [&]()
                             {
                                 browserState.populationLoad( coreServices );
                             });
@@ -483,69 +490,75 @@ void modalUniversalJamBrowser(
                                 const ImGuiTableSortSpecs* sortingSpec = ImGui::TableGetSortSpecs();
 
                                 const std::size_t totalDiveJams = browserState.m_diveJamIDs.size();
-                                for ( std::size_t index = 0; index < totalDiveJams; index++ )
+
+                                ImGuiListClipper diveClipper;
+                                diveClipper.Begin( (int32_t)totalDiveJams );
+                                while ( diveClipper.Step() )
                                 {
-                                    // default to plain index but usually we have a sort index from the table columns
-                                    std::size_t sortedIndex = index;
-                                    if ( sortingSpec != nullptr && sortingSpec->SpecsCount == 1 )
+                                    for ( std::size_t index = (std::size_t)diveClipper.DisplayStart; index < (std::size_t)diveClipper.DisplayEnd; index++ )
                                     {
-                                        // handle sort direction by inverting lookup index
-                                        std::size_t sortIndexDirection = index;
-                                        if ( sortingSpec->Specs[0].SortDirection == 2 )
+                                        // default to plain index but usually we have a sort index from the table columns
+                                        std::size_t sortedIndex = index;
+                                        if ( sortingSpec != nullptr && sortingSpec->SpecsCount == 1 )
                                         {
-                                            sortIndexDirection = ( totalDiveJams - 1 ) - index;
+                                            // handle sort direction by inverting lookup index
+                                            std::size_t sortIndexDirection = index;
+                                            if ( sortingSpec->Specs[0].SortDirection == 2 )
+                                            {
+                                                sortIndexDirection = ( totalDiveJams - 1 ) - index;
+                                            }
+
+                                            switch ( sortingSpec->Specs[0].ColumnIndex )
+                                            {
+                                                default:
+                                                    ABSL_ASSERT( 0 );
+                                                case 0: sortedIndex = browserState.m_diveIndexSortedByName[sortIndexDirection]; break;
+                                                case 1: sortedIndex = browserState.m_diveIndexSortedByRiff[sortIndexDirection]; break;
+                                                case 2: sortedIndex = browserState.m_diveIndexSortedByContrib[sortIndexDirection]; break;
+                                                case 3: sortedIndex = browserState.m_diveIndexSortedByTotals[sortIndexDirection]; break;
+                                            }
                                         }
 
-                                        switch ( sortingSpec->Specs[0].ColumnIndex )
-                                        {
-                                            default:
-                                                ABSL_ASSERT( 0 );
-                                            case 0: sortedIndex = browserState.m_diveIndexSortedByName[sortIndexDirection]; break;
-                                            case 1: sortedIndex = browserState.m_diveIndexSortedByRiff[sortIndexDirection]; break;
-                                            case 2: sortedIndex = browserState.m_diveIndexSortedByContrib[sortIndexDirection]; break;
-                                            case 3: sortedIndex = browserState.m_diveIndexSortedByTotals[sortIndexDirection]; break;
-                                        }
-                                    }
+                                        const auto& jamID           = browserState.m_diveJamIDs[sortedIndex];
+                                        const auto& jamName         = browserState.m_diveJamNames[sortedIndex];
+                                        const uint32_t userRiffs    = browserState.m_diveUserRiffCounts[sortedIndex];
+                                        const float userPct         = browserState.m_diveUserPercentage[sortedIndex];
+                                        const uint32_t totalRiffs   = browserState.m_diveTotalRiffCounts[sortedIndex];
 
-                                    const auto& jamID           = browserState.m_diveJamIDs[sortedIndex];
-                                    const auto& jamName         = browserState.m_diveJamNames[sortedIndex];
-                                    const uint32_t userRiffs    = browserState.m_diveUserRiffCounts[sortedIndex];
-                                    const float userPct         = browserState.m_diveUserPercentage[sortedIndex];
-                                    const uint32_t totalRiffs   = browserState.m_diveTotalRiffCounts[sortedIndex];
+                                        const bool showAsDisabled   = (behaviour.fnIsDisabled && behaviour.fnIsDisabled( jamID ));
 
-                                    const bool showAsDisabled   = (behaviour.fnIsDisabled && behaviour.fnIsDisabled( jamID ));
+                                        ImGui::TableNextColumn();
+                                        ImGui::PushID( (int32_t)index );
 
-                                    ImGui::TableNextColumn();
-                                    ImGui::PushID( (int32_t)index );
-
-                                    if ( showAsDisabled )
-                                    {
-                                        ImGui::PushStyleColor( ImGuiCol_Text, colourJamDisabled );
-                                        ImGui::TextUnformatted( jamName );
-                                        ImGui::PopStyleColor();
-                                    }
-                                    else
-                                    {
-                                        if ( ImGui::Selectable( jamName.c_str() ) )
+                                        if ( showAsDisabled )
                                         {
-                                            if ( behaviour.fnOnSelected )
-                                                behaviour.fnOnSelected( jamID );
-
-                                            // #HDD TODO make closing-on-selection optional?
-                                            shouldClosePopup = true;
+                                            ImGui::PushStyleColor( ImGuiCol_Text, colourJamDisabled );
+                                            ImGui::TextUnformatted( jamName );
+                                            ImGui::PopStyleColor();
+                                        }
+                                        else
+                                        {
+                                            if ( ImGui::Selectable( jamName.c_str() ) )
+                                            {
+                                                if ( behaviour.fnOnSelected )
+                                                    behaviour.fnOnSelected( jamID );
+
+                                                // #HDD TODO make closing-on-selection optional?
+                                                shouldClosePopup = true;
+                                            }
                                         }
-                                    }
 
-                                    ImGui::TableNextColumn();
-                                    ImGui::Text( "%u", userRiffs );
+                                        ImGui::TableNextColumn();
+                                        ImGui::Text( "%u", userRiffs );
 
-                                    ImGui::TableNextColumn();
-                                    ImGui::Text( "%.3f %%", userPct );
+                                        ImGui::TableNextColumn();
+                                        ImGui::Text( "%.3f %%", userPct );
 
-                                    ImGui::TableNextColumn();
-                                    ImGui::Text( "%u", totalRiffs );
+                                        ImGui::TableNextColumn();
+                                        ImGui::Text( "%u", totalRiffs );
 
-                                    ImGui::PopID();
+                                        ImGui::PopID();
+                                    }
                                 }
                                 ImGui::EndTable();
                             }
@@ -294,7 +294,7 @@ void JamImporterState::launchImportTasks( app::OuroApp& ouroApplication )
     }
 
     // launch task schedule, let it ride in the background
-    ouroApplication.getTaskExecutor().run( std::move( taskflow ) );
+    ouroApplication.getTaskExecutorIO().run( std::move( taskflow ) );
 }
 
 
@@ -317,7 +317,7 @@ void JamImporterState::imgui( app::OuroApp& ouroApplication )
             m_importablesRefreshing = true;
             m_importablesList.clear();
 
-            ouroApplication.getTaskExecutor().silent_async( [this, theWarehouse = ouroApplication.getWarehouseInstance() ]() { this->refreshAvailableJams( theWarehouse ); } );
+            ouroApplication.getTaskExecutorIO().silent_async( [this, theWarehouse = ouroApplication.getWarehouseInstance() ]() { this->refreshAvailableJams( theWarehouse ); } );
         }
     }
     // show progress on the background inspection process if running
@@ -354,81 +354,92 @@ void JamImporterState::imgui( app::OuroApp& ouroApplication )
             ImGui::TableSetupColumn( "Internal ID", ImGuiTableColumnFlags_WidthFixed,   140.0f );
             ImGui::TableHeadersRow();
 
-            for ( size_t jamIdx = 0; jamIdx < m_importablesList.size(); jamIdx++ )
+            // tally up selection / work-in-flight across the whole list first; the clipper only draws visible rows
+            for ( const auto& item : m_importablesList )
             {
-                const bool bHasValidYaml    = m_importablesList[jamIdx]->m_bYamlParseOk;
-                const bool bHasFileTAR      = m_importablesList[jamIdx]->m_fileTAR.empty() == false;
-                const bool bHasFileYAML     = m_importablesList[jamIdx]->m_fileYAML.empty() == false;
-                const bool bHasBothFiles    = bHasFileTAR && bHasFileYAML;
+                if ( item->m_bYamlParseOk && !item->m_fileTAR.empty() && !item->m_fileYAML.empty() && item->m_import )
+                    potentialExportsCount++;
 
-                ImGui::PushID( (int32_t)jamIdx );
-                ImGui::TableNextColumn();
+                if ( item->m_importOperationYAML.isValid() ||
+                     item->m_importOperationTAR.isValid() )
+                    anyProcessingHappening = true;
+            }
 
+            ImGuiListClipper importClipper;
+            importClipper.Begin( (int32_t)m_importablesList.size() );
+            while ( importClipper.Step() )
+            {
+                for ( size_t jamIdx = (size_t)importClipper.DisplayStart; jamIdx < (size_t)importClipper.DisplayEnd; jamIdx++ )
                 {
-                    ImGui::AlignTextToFramePadding();
-                    ImGui::TextUnformatted( "  " );
-                    ImGui::SameLine();
+                    const bool bHasValidYaml    = m_importablesList[jamIdx]->m_bYamlParseOk;
+                    const bool bHasFileTAR      = m_importablesList[jamIdx]->m_fileTAR.empty() == false;
+                    const bool bHasFileYAML     = m_importablesList[jamIdx]->m_fileYAML.empty() == false;
+                    const bool bHasBothFiles    = bHasFileTAR && bHasFileYAML;
 
-                    if ( bHasValidYaml && bHasBothFiles )
-                    {
-                        ImGui::Checkbox( "##import", &m_importablesList[jamIdx]->m_import );
-                    }
-                    else
-                    {
-                        ImGui::TextColored( colour::shades::callout.neutral(), ICON_FA_CIRCLE_EXCLAMATION );
-                    }
+                    ImGui::PushID( (int32_t)jamIdx );
                     ImGui::TableNextColumn();
-                }
-                {
-                    ImGui::AlignTextToFramePadding();
-                    if ( !bHasFileYAML )
-                    {
-                        ImGui::TextColored( colour::shades::errors.neutral(), "No matching .YAML file found" );
-                        ImGui::CompactTooltip( m_importablesList[jamIdx]->m_fileTAR.string().c_str() );
-                    }
-                    else if ( !bHasValidYaml )
+
                     {
-                        ImGui::TextColored( colour::shades::errors.neutral(), "YAML file failed to parse" );
-                        ImGui::CompactTooltip( m_importablesList[jamIdx]->m_fileYAML.string().c_str() );
+                        ImGui::AlignTextToFramePadding();
+                        ImGui::TextUnformatted( "  " );
+                        ImGui::SameLine();
+
+                        if ( bHasValidYaml && bHasBothFiles )
+                        {
+                            ImGui::Checkbox( "##import", &m_importablesList[jamIdx]->m_import );
+                        }
+                        else
+                        {
+                            ImGui::TextColored( colour::shades::callout.neutral(), ICON_FA_CIRCLE_EXCLAMATION );
+                        }
+                        ImGui::TableNextColumn();
                     }
-                    else if ( !bHasFileTAR )
                     {
-                        ImGui::TextColored( colour::shades::errors.neutral(), "No matching .TAR file found" );
-                        ImGui::CompactTooltip( m_importablesList[jamIdx]->m_fileYAML.string().c_str() );
+                        ImGui::AlignTextToFramePadding();
+                        if ( !bHasFileYAML )
+                        {
+                            ImGui::TextColored( colour::shades::errors.neutral(), "No matching .YAML file found" );
+                            ImGui::CompactTooltip( m_importablesList[jamIdx]->m_fileTAR.string().c_str() );
+                        }
+                        else if ( !bHasValidYaml )
+                        {
+                            ImGui::TextColored( colour::shades::errors.neutral(), "YAML file failed to parse" );
+                            ImGui::CompactTooltip( m_importablesList[jamIdx]->m_fileYAML.string().c_str() );
+                        }
+                        else if ( !bHasFileTAR )
+                        {
+                            ImGui::TextColored( colour::shades::errors.neutral(), "No matching .TAR file found" );
+                            ImGui::CompactTooltip( m_importablesList[jamIdx]->m_fileYAML.string().c_str() );
+                        }
+                        else
+                        {
+                            ImGui::TextColored( colour::shades::sea_green.neutral(), "%s",
+                                m_importablesList[jamIdx]->m_jamNameFromYAML.c_str() );
+                        }
+                        ImGui::TableNextColumn();
                     }
-                    else
                     {
-                        ImGui::TextColored( colour::shades::sea_green.neutral(), "%s",
-                            m_importablesList[jamIdx]->m_jamNameFromYAML.c_str() );
+                        if ( m_importablesList[jamIdx]->m_importOperationYAML.isValid() )
+                        {
+                            ImGui::Spinner( "##yaml_working", true, ImGui::GetTextLineHeight() * 0.4f, 3.0f, 1.5f, ImGui::GetColorU32( ImGuiCol_Text ) );
+                        }
 
-                        if ( m_importablesList[jamIdx]->m_import )
-                            potentialExportsCount++;
-                    }
-                    ImGui::TableNextColumn();
-                }
-                {
-                    if ( m_importablesList[jamIdx]->m_importOperationYAML.isValid() )
-                    {
-                        ImGui::Spinner( "##yaml_working", true, ImGui::GetTextLineHeight() * 0.4f, 3.0f, 1.5f, ImGui::GetColorU32( ImGuiCol_Text ) );
-                        anyProcessingHappening = true;
-                    }
+                        ImGui::TableNextColumn();
 
-                    ImGui::TableNextColumn();
+                        if ( m_importablesList[jamIdx]->m_importOperationTAR.isValid() )
+                        {
+                            ImGui::Spinner( "##tar_working", true, ImGui::GetTextLineHeight() * 0.4f, 3.0f, 1.5f, ImGui::GetColorU32( ImGuiCol_Text ) );
+                        }
 
-                    if ( m_importablesList[jamIdx]->m_importOperationTAR.isValid() )
+                        ImGui::TableNextColumn();
+                    }
                     {
-                        ImGui::Spinner( "##tar_working", true, ImGui::GetTextLineHeight() * 0.4f, 3.0f, 1.5f, ImGui::GetColorU32( ImGuiCol_Text ) );
-                        anyProcessingHappening = true;
+                        ImGui::AlignTextToFramePadding();
+                        ImGui::TextUnformatted( m_importablesList[jamIdx]->m_jamCouchID.c_str() );
                     }
 
-                    ImGui::TableNextColumn();
+                    ImGui::PopID();
                 }
-                {
-                    ImGui::AlignTextToFramePadding();
-                    ImGui::TextUnformatted( m_importablesList[jamIdx]->m_jamCouchID.c_str() );
-                }
-
-                ImGui::PopID();
             }
 
             ImGui::EndTable();
@@ -464,7 +475,7 @@ void JamImporterState::imgui( app::OuroApp& ouroApplication )
 
         if ( ImGui::BottomRightAlignedButton( "Close", buttonSize ) )
         {
-            ouroApplication.getTaskExecutor().wait_for_all();
+            ouroApplication.getTaskExecutorIO().wait_for_all();
             ImGui::CloseCurrentPopup();
         }
     }
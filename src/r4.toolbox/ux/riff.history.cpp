@@ -185,45 +185,54 @@ void RiffHistory::State::imgui( app::CoreGUI& coreGUI )
                 m_enqueuedRiffIDSet.emplace( enqueuedID );
         }
 
-        std::size_t entryToDelete = 0;
-        for ( std::size_t rI = 0; rI < recordsToIterate; rI++ )
+        // replay covers every record, not just the rows that survive clipping below
+        if ( bReRunSequenceOnIteration )
         {
-            const auto& currentJamID    = m_historyRecords.m_jamCouchIDs[readIndex];
-            const auto& currentRiffID   = m_historyRecords.m_riffCouchIDs[readIndex];
+            for ( std::size_t rI = 0; rI < recordsToIterate; rI++ )
+                m_replayIndices.emplace_back( rI );
+        }
 
-            const bool bIsPlaying       = m_currentlyPlayingRiffID == currentRiffID;
-            const bool bRiffWasEnqueued = m_enqueuedRiffIDSet.contains( currentRiffID );
+        std::size_t entryToDelete = 0;
 
-            if ( bReRunSequenceOnIteration )
+        ImGuiListClipper historyClipper;
+        historyClipper.Begin( (int32_t)recordsToIterate );
+        while ( historyClipper.Step() )
+        {
+            for ( std::size_t rI = (std::size_t)historyClipper.DisplayStart; rI < (std::size_t)historyClipper.DisplayEnd; rI++ )
             {
-                m_replayIndices.emplace_back( rI );
-            }
+                // walk backwards through the ring buffer from the most recent record
+                readIndex = ( originalReadIndex + HistoryRecords::cMaximumHistorySize - rI ) % HistoryRecords::cMaximumHistorySize;
 
-            ImGui::PushID( (int32_t)rI );
-            if ( ImGui::Button( ICON_FA_CIRCLE_XMARK ) )
-            {
-                entryToDelete = readIndex + 1;
-            }
-            ImGui::SameLine( 0, 2.0f );
-            {
-                ImGui::Scoped::Disabled disabledButton( bRiffWasEnqueued );
-                ImGui::Scoped::ToggleButton highlightButton( bIsPlaying, true );
-                if ( ImGui::Button( currentRiffID.value().c_str() ) )
+                const auto& currentJamID    = m_historyRecords.m_jamCouchIDs[readIndex];
+                const auto& currentRiffID   = m_historyRecords.m_riffCouchIDs[readIndex];
+
+                const bool bIsPlaying       = m_currentlyPlayingRiffID == currentRiffID;
+                const bool bRiffWasEnqueued = m_enqueuedRiffIDSet.contains( currentRiffID );
+
+                ImGui::PushID( (int32_t)rI );
+                if ( ImGui::Button( ICON_FA_CIRCLE_XMARK ) )
+                {
+                    entryToDelete = readIndex + 1;
+                }
+                ImGui::SameLine( 0, 2.0f );
                 {
-                    // don't re-enqueue if this riff is already in the enqueued-list, nor if it's already playing
-                    if ( bRiffWasEnqueued == false && bIsPlaying == false )
+                    ImGui::Scoped::Disabled disabledButton( bRiffWasEnqueued );
+                    ImGui::Scoped::ToggleButton highlightButton( bIsPlaying, true );
+                    if ( ImGui::Button( currentRiffID.value().c_str() ) )
                     {
-                        // ask for this riff to play but stash the ID so we can ignore it when it immediately arrives in event_MixerRiffChange
-                        m_enqueuedRiffIDs.emplace_back( currentRiffID );
-                        m_eventBusClient.Send< ::events::EnqueueRiffPlayback >( currentJamID, currentRiffID );
+                        // don't re-enqueue if this riff is already in the enqueued-list, nor if it's already playing
+                        if ( bRiffWasEnqueued == false && bIsPlaying == false )
+                        {
+                            // ask for this riff to play but stash the ID so we can ignore it when it immediately arrives in event_MixerRiffChange
+                            m_enqueuedRiffIDs.emplace_back( currentRiffID );
+                            m_eventBusClient.Send< ::events::EnqueueRiffPlayback >( currentJamID, currentRiffID );
+                        }
                     }
                 }
+                ImGui::SameLine();
+                ImGui::TextUnformatted( fmt::format( FMTX( "{}" ), m_historyRecords.m_timestamps[readIndex] ).c_str() );
+                ImGui::PopID();
             }
-            ImGui::SameLine();
-            ImGui::TextUnformatted( fmt::format( FMTX( "{}" ), m_historyRecords.m_timestamps[readIndex] ).c_str() );
-            ImGui::PopID();
-
-            decrementReadIndex();
         }
 
         // handle the replay sequence request - enqueue riffs in reverse order
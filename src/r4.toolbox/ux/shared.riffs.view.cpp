@@ -309,6 +309,10 @@ void SharedRiffView::State::manualDataImport( app::CoreGUI& coreGUI )
                 cereal::JSONInputArchive archive( is );
 
                 newData->serialize( archive );
+
+                // validate and bring older (newest-first) snapshots into chronological order
+                if ( !newData->postLoad() )
+                    throw cereal::Exception( "shared riff arrays are inconsistent" );
             }
             catch ( cereal::Exception& cEx )
             {
@@ -336,25 +340,22 @@ void SharedRiffView::State::imgui(
     // try to restore from the cache if requested; usually on the first time through, done here as we need CoreGUI / path provider
     if ( m_tryLoadFromCache )
     {
-        auto newData = std::make_shared<config::endlesss::SharedRiffsCache>();
-
-        const auto cacheLoadResult = config::load( coreGUI, *newData );
+        auto cacheLoadResult = m_sharesCache.loadCache( coreGUI );
 
-        // only complain if the file was malformed, it being missing is not an error
-        if ( cacheLoadResult != config::LoadResult::Success &&
-             cacheLoadResult != config::LoadResult::CannotFindConfigFile )
-        {
-            // not the end of the world but note it regardless
-            blog::error::cfg( FMTX( "Unable to load shared riff cache [{}]" ), LoadResultToString( cacheLoadResult ) );
-        }
-        else
+        if ( cacheLoadResult.ok() )
         {
             // stash if loaded ok
-            m_sharesData = newData;
-            m_user.setUsername( newData->m_username );
+            m_sharesData = cacheLoadResult;
+            m_user.setUsername( (*cacheLoadResult)->m_username );
 
             onNewDataAssigned();
         }
+        // only complain if the file was malformed, it being missing is not an error
+        else if ( !absl::IsNotFound( cacheLoadResult.status() ) )
+        {
+            // not the end of the world but note it regardless
+            blog::error::cfg( FMTX( "Unable to load shared riff cache [{}]" ), cacheLoadResult.status().ToString() );
+        }
 
         m_tryLoadFromCache = false;
     }
@@ -365,24 +366,27 @@ void SharedRiffView::State::imgui(
     {
         const auto dataPtr = *m_sharesData;
 
+        // work back from the newest shares, as those are the ones at the top of the table
+        const std::size_t resolveEntry = dataPtr->m_count - 1 - m_jamNameCacheSyncIndex;
+
         // don't try and resolve non band##### IDs
-        if ( dataPtr->m_personal[m_jamNameCacheSyncIndex] )
+        if ( dataPtr->m_personal[resolveEntry] )
         {
-            m_jamNameResolvedArray[m_jamNameCacheSyncIndex] = "[ personal ]";
+            m_jamNameResolvedArray[resolveEntry] = "[ personal ]";
         }
         else
         {
             // ask jame name services for data
             const auto bJamNameFound = jamNameResolver->lookupJamName(
-                dataPtr->m_jamIDs[m_jamNameCacheSyncIndex],
-                m_jamNameResolvedArray[m_jamNameCacheSyncIndex]
+                dataPtr->m_jamIDs[resolveEntry],
+                m_jamNameResolvedArray[resolveEntry]
             );
 
             // if we get a cache miss, issue a fetch request to go plumb the servers for answers
             if ( bJamNameFound == endlesss::services::IJamNameResolveService::LookupResult::NotFound )
             {
                 m_eventBusClient.Send< ::events::BNSCacheMiss >(
-                    dataPtr->m_jamIDs[m_jamNameCacheSyncIndex] );
+                    dataPtr->m_jamIDs[resolveEntry] );
             }
         }
 
@@ -434,10 +438,11 @@ void SharedRiffView::State::imgui(
                 {
                     m_fetchInProgress = true;
 
-                    coreGUI.getTaskExecutor().run( 
+                    coreGUI.getTaskExecutorIO().run( 
                         m_sharesCache.taskFetchLatest(
                             *m_networkConfiguration,
                             m_user.getUsername(),
+                            bCurrentDataSetIsForTheUsernameInThePicker ? *m_sharesData : nullptr,   // only fetch what's new if we can
                             [this]( toolkit::Shares::StatusOrData newData )
                             {
                                 onNewDataFetched( newData );
@@ -550,137 +555,164 @@ void SharedRiffView::State::imgui(
                                                              ImGuiTableColumnFlags_WidthStretch, 0.5f);
                             ImGui::TableHeadersRow();
 
+                            // find the playing riff up-front rather than as a side-effect of drawing rows, as the clipper below
+                            // only visits the handful of rows currently on screen
+                            std::size_t playingEntry = dataPtr->m_count;
                             for ( std::size_t entry = 0; entry < dataPtr->m_count; entry++ )
                             {
-                                const bool bIsPrivate       = dataPtr->m_private[entry];
-                                const bool bIsPersonal      = dataPtr->m_personal[entry];
-                                const bool bIsPlaying       = dataPtr->m_riffIDs[entry] == m_currentlyPlayingRiffID;
-                                const bool bRiffWasEnqueued = m_enqueuedRiffIDs.contains( dataPtr->m_riffIDs[entry] );
+                                if ( dataPtr->m_riffIDs[entry] == m_currentlyPlayingRiffID )
+                                {
+                                    playingEntry = entry;
+                                    break;
+                                }
+                            }
+                            // keep track of if any of the shared riffs are considered active, used to enable scroll-to-playing button above
+                            // (done backwards due to nature of imguis)
+                            bFoundAPlayingRiffInTable = ( playingEntry < dataPtr->m_count );
 
+                            ImGuiListClipper riffClipper;
+                            riffClipper.Begin( (int32_t)dataPtr->m_count );
 
+                            // shares are stored oldest-first, display them newest-first
+                            const auto rowToEntry = [count = dataPtr->m_count]( const std::size_t index ) { return count - 1 - index; };
 
-                                // keep track of if any of the shared riffs are considered active, used to enable scroll-to-playing button above
-                                // (done backwards due to nature of imguis)
-                                bFoundAPlayingRiffInTable |= bIsPlaying;
+                            // make sure the playing row gets submitted even if it's off-screen so ScrollToItem has something to aim at
+                            if ( bFoundAPlayingRiffInTable && bScrollToPlaying )
+                            {
+                                const int32_t playingRow = (int32_t)rowToEntry( playingEntry );
+                                riffClipper.IncludeRangeByIndices( playingRow, playingRow + 1 );
+                            }
+
+                            while ( riffClipper.Step() )
+                            {
+                                for ( std::size_t row = (std::size_t)riffClipper.DisplayStart; row < (std::size_t)riffClipper.DisplayEnd; row++ )
+                                {
+                                    const std::size_t entry = rowToEntry( row );
+
+                                    const bool bIsPrivate       = dataPtr->m_private[entry];
+                                    const bool bIsPersonal      = dataPtr->m_personal[entry];
+                                    const bool bIsPlaying       = dataPtr->m_riffIDs[entry] == m_currentlyPlayingRiffID;
+                                    const bool bRiffWasEnqueued = m_enqueuedRiffIDs.contains( dataPtr->m_riffIDs[entry] );
 
-                                ImGui::PushID( (int32_t)entry );
+                                    ImGui::PushID( (int32_t)entry );
 
 #if OURO_HAS_NDLS_ONLINE
-                                ImGui::TableNextColumn();
-                                {
-                                    // show some indication that work is in progress for this entry if it's been asked to play
-                                    if ( bRiffWasEnqueued )
-                                    {
-                                        ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg1, ImGui::GetPulseColour( 0.25f ) );
-                                    }
-                                    ImGui::Dummy( { 0, 0 } );
+                                    ImGui::TableNextColumn();
                                     {
-                                        // riff enqueue-to-play button, disabled when in-flight
-                                        ImGui::Scoped::Disabled disabledButton( bRiffWasEnqueued );
-                                        ImGui::Scoped::ToggleButton highlightButton( bIsPlaying, true );
-                                        if ( ImGui::PrecisionButton( bRiffWasEnqueued ? ICON_FA_CIRCLE_CHEVRON_DOWN : ICON_FA_PLAY, buttonSizeMidTable, 1.0f ) )
+                                        // show some indication that work is in progress for this entry if it's been asked to play
+                                        if ( bRiffWasEnqueued )
                                         {
-                                            m_eventBusClient.Send< ::events::EnqueueRiffPlayback >( getEntryRiffIdentity( entry, true, EAttachImage::IgnoreImage ) );
-
-                                            // enqueue the riff ID, not the *shared* riff ID as the default riff ID is what will
-                                            // be flowing back through "riff now being played" messages
-                                            m_enqueuedRiffIDs.emplace( dataPtr->m_riffIDs[entry] );
+                                            ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg1, ImGui::GetPulseColour( 0.25f ) );
+                                        }
+                                        ImGui::Dummy( { 0, 0 } );
+                                        {
+                                            // riff enqueue-to-play button, disabled when in-flight
+                                            ImGui::Scoped::Disabled disabledButton( bRiffWasEnqueued );
+                                            ImGui::Scoped::ToggleButton highlightButton( bIsPlaying, true );
+                                            if ( ImGui::PrecisionButton( bRiffWasEnqueued ? ICON_FA_CIRCLE_CHEVRON_DOWN : ICON_FA_PLAY, buttonSizeMidTable, 1.0f ) )
+                                            {
+                                                m_eventBusClient.Send< ::events::EnqueueRiffPlayback >( getEntryRiffIdentity( entry, true, EAttachImage::IgnoreImage ) );
+
+                                                // enqueue the riff ID, not the *shared* riff ID as the default riff ID is what will
+                                                // be flowing back through "riff now being played" messages
+                                                m_enqueuedRiffIDs.emplace( dataPtr->m_riffIDs[entry] );
+                                            }
+
+                                            if ( bIsPlaying && bScrollToPlaying )
+                                                ImGui::ScrollToItem( ImGuiScrollFlags_KeepVisibleCenterY );
                                         }
-
-                                        if ( bIsPlaying && bScrollToPlaying )
-                                            ImGui::ScrollToItem( ImGuiScrollFlags_KeepVisibleCenterY );
                                     }
-                                }
 #endif // OURO_HAS_NDLS_ONLINE
-                                ImGui::TableNextColumn();
-                                ImGui::AlignTextToFramePadding();
-                                {
-                                    // draw the riff name
-                                    if ( bIsPrivate )
-                                    {
-                                        ImGui::TextUnformatted( ICON_FA_LOCK );
-                                        ImGui::SameLine();
-                                    }
-                                    if ( bIsPlaying )
-                                    {
-                                        ImGui::TextColoredUnformatted( colour::shades::lime.neutral(), dataPtr->m_names[entry] );
-                                        if ( bScrollToPlaying )
-                                            ImGui::ScrollToItem( ImGuiScrollFlags_KeepVisibleCenterY );
-                                    }
-                                    else
+                                    ImGui::TableNextColumn();
+                                    ImGui::AlignTextToFramePadding();
                                     {
-                                        ImGui::TextUnformatted( dataPtr->m_names[entry] );
+                                        // draw the riff name
+                                        if ( bIsPrivate )
+                                        {
+                                            ImGui::TextUnformatted( ICON_FA_LOCK );
+                                            ImGui::SameLine();
+                                        }
+                                        if ( bIsPlaying )
+                                        {
+                                            ImGui::TextColoredUnformatted( colour::shades::lime.neutral(), dataPtr->m_names[entry] );
+                                            if ( bScrollToPlaying )
+                                                ImGui::ScrollToItem( ImGuiScrollFlags_KeepVisibleCenterY );
+                                        }
+                                        else
+                                        {
+                                            ImGui::TextUnformatted( dataPtr->m_names[entry] );
+                                        }
                                     }
-                                }
 #if OURO_HAS_NDLS_ONLINE
-                                ImGui::TableNextColumn();
-                                {
-                                    ImGui::Dummy( { 0, 0 } );
+                                    ImGui::TableNextColumn();
+                                    {
+                                        ImGui::Dummy( { 0, 0 } );
                                     
-                                    const auto& sharedRiffKey = dataPtr->m_sharedRiffIDs[entry];
+                                        const auto& sharedRiffKey = dataPtr->m_sharedRiffIDs[entry];
 
-                                    ImGui::Scoped::Disabled sd( m_sharedRiffExportOperationsMap.hasValue( sharedRiffKey ) );
-                                    if ( ImGui::PrecisionButton( ICON_FA_FLOPPY_DISK, buttonSizeMidTable, 1.0f ) )
-                                    {
-                                        const auto operationID = riffExportDispatcher.dispatchRiffExportAsync( getEntryRiffIdentity( entry, true, EAttachImage::AttachImage ) );
-                                        m_sharedRiffExportOperationsMap.add( operationID, sharedRiffKey );
+                                        ImGui::Scoped::Disabled sd( m_sharedRiffExportOperationsMap.hasValue( sharedRiffKey ) );
+                                        if ( ImGui::PrecisionButton( ICON_FA_FLOPPY_DISK, buttonSizeMidTable, 1.0f ) )
+                                        {
+                                            const auto operationID = riffExportDispatcher.dispatchRiffExportAsync( getEntryRiffIdentity( entry, true, EAttachImage::AttachImage ) );
+                                            m_sharedRiffExportOperationsMap.add( operationID, sharedRiffKey );
+                                        }
                                     }
-                                }
-                                ImGui::TableNextColumn();
-                                {
-                                    ImGui::Dummy( { 0, 0 } );
-                                    if ( ImGui::PrecisionButton( ICON_FA_LINK, buttonSizeMidTable, 1.0f ) )
+                                    ImGui::TableNextColumn();
                                     {
-                                        // cross-platform launch a browser to navigate to the Endlesss riff web player
-                                        const auto webPlayerURL = fmt::format( FMTX( "https://endlesss.fm/{}/?rifffId={}" ), m_user.getUsername(), dataPtr->m_sharedRiffIDs[entry] );
-                                        xpOpenURL( webPlayerURL.c_str() );
+                                        ImGui::Dummy( { 0, 0 } );
+                                        if ( ImGui::PrecisionButton( ICON_FA_LINK, buttonSizeMidTable, 1.0f ) )
+                                        {
+                                            // cross-platform launch a browser to navigate to the Endlesss riff web player
+                                            const auto webPlayerURL = fmt::format( FMTX( "https://endlesss.fm/{}/?rifffId={}" ), m_user.getUsername(), dataPtr->m_sharedRiffIDs[entry] );
+                                            xpOpenURL( webPlayerURL.c_str() );
+                                        }
                                     }
-                                }
 #endif // OURO_HAS_NDLS_ONLINE
-                                ImGui::TableNextColumn();
-                                {
-                                    ImGui::Dummy( { 0, 0 } );
-                                    if ( ImGui::PrecisionButton( ICON_FA_GRIP, buttonSizeMidTable, 1.0f ) )
-                                    {
-                                        // dispatch a request to navigate this this riff, if we can find it
-                                        m_eventBusClient.Send< ::events::RequestNavigationToRiff >( getEntryRiffIdentity( entry, false, EAttachImage::IgnoreImage ) );
-                                    }
-                                }
-                                ImGui::TableNextColumn();
-                                ImGui::AlignTextToFramePadding();
-                                {
-                                    // render the jam name, if we have one
+                                    ImGui::TableNextColumn();
                                     {
-                                        const auto jamID = dataPtr->m_jamIDs[entry];
-
-                                        // double-wrap tooltip so we only do the time conversion / string build on hover
-                                        // shows the share-time using past-tense formatting (personally I find this more useful than the stuff endlesss puts on the website)
-                                        ImGui::TextDisabled( ICON_FA_CLOCK );
-                                        if ( ImGui::IsItemHovered( ImGuiHoveredFlags_DelayNormal ) )
+                                        ImGui::Dummy( { 0, 0 } );
+                                        if ( ImGui::PrecisionButton( ICON_FA_GRIP, buttonSizeMidTable, 1.0f ) )
                                         {
-                                            const auto shareTimeUnix = spacetime::InSeconds( std::chrono::seconds{ dataPtr->m_timestamps[entry] } );
-                                            const auto cacheTimeDelta = spacetime::calculateDeltaFromNow( shareTimeUnix ).asPastTenseString( 2 );
-                                            ImGui::CompactTooltip( cacheTimeDelta );
+                                            // dispatch a request to navigate this this riff, if we can find it
+                                            m_eventBusClient.Send< ::events::RequestNavigationToRiff >( getEntryRiffIdentity( entry, false, EAttachImage::IgnoreImage ) );
                                         }
-                                        ImGui::SameLine();
-
-                                        // click on ID to copy it into the clipboard for debug purposes
-                                        ImGui::TextDisabled( "ID" );
-                                        if ( ImGui::IsItemClicked() )
+                                    }
+                                    ImGui::TableNextColumn();
+                                    ImGui::AlignTextToFramePadding();
+                                    {
+                                        // render the jam name, if we have one
                                         {
-                                            ImGui::SetClipboardText( jamID.c_str() );
+                                            const auto jamID = dataPtr->m_jamIDs[entry];
+
+                                            // double-wrap tooltip so we only do the time conversion / string build on hover
+                                            // shows the share-time using past-tense formatting (personally I find this more useful than the stuff endlesss puts on the website)
+                                            ImGui::TextDisabled( ICON_FA_CLOCK );
+                                            if ( ImGui::IsItemHovered( ImGuiHoveredFlags_DelayNormal ) )
+                                            {
+                                                const auto shareTimeUnix = spacetime::InSeconds( std::chrono::seconds{ dataPtr->m_timestamps[entry] } );
+                                                const auto cacheTimeDelta = spacetime::calculateDeltaFromNow( shareTimeUnix ).asPastTenseString( 2 );
+                                                ImGui::CompactTooltip( cacheTimeDelta );
+                                            }
+                                            ImGui::SameLine();
+
+                                            // click on ID to copy it into the clipboard for debug purposes
+                                            ImGui::TextDisabled( "ID" );
+                                            if ( ImGui::IsItemClicked() )
+                                            {
+                                                ImGui::SetClipboardText( jamID.c_str() );
+                                            }
+                                            ImGui::CompactTooltip( jamID.c_str() );
+                                            ImGui::SameLine( 0, 12.0f );
+
+                                            // origin jam, potentially [username] personal / solo jam
+                                            if ( bIsPrivate || bIsPersonal )
+                                                ImGui::TextColored( colour::shades::callout.neutral(), "%s", m_jamNameResolvedArray[entry].c_str());
+                                            else
+                                                ImGui::TextUnformatted( m_jamNameResolvedArray[entry]);
                                         }
-                                        ImGui::CompactTooltip( jamID.c_str() );
-                                        ImGui::SameLine( 0, 12.0f );
-
-                                        // origin jam, potentially [username] personal / solo jam
-                                        if ( bIsPrivate || bIsPersonal )
-                                            ImGui::TextColored( colour::shades::callout.neutral(), "%s", m_jamNameResolvedArray[entry].c_str());
-                                        else
-                                            ImGui::TextUnformatted( m_jamNameResolvedArray[entry]);
                                     }
+                                    ImGui::PopID();
                                 }
-                                ImGui::PopID();
                             }
 
                             ImGui::EndTable();
@@ -694,10 +726,10 @@ void SharedRiffView::State::imgui(
                 // if set in onNewDataFetched(), page any new data out to disk to cache the results across sessions
                 if ( m_trySaveToCache )
                 {
-                    const auto cacheSaveResult = config::save( coreGUI, *dataPtr );
-                    if ( cacheSaveResult != config::SaveResult::Success )
+                    const auto cacheSaveResult = m_sharesCache.saveCache( coreGUI, *dataPtr );
+                    if ( !cacheSaveResult.ok() )
                     {
-                        blog::error::cfg( FMTX( "Unable to save shared riff cache" ) );
+                        blog::error::cfg( FMTX( "Unable to save shared riff cache [{}]" ), cacheSaveResult.ToString() );
                     }
                     m_trySaveToCache = false;
                 }
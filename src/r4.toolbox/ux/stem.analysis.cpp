@@ -97,7 +97,23 @@ void StemAnalysis( endlesss::live::RiffPtr& liveRiff, const int32_t audioSampleR
             ImPlot::SetupAxis( ImAxis_Y1, nullptr, ImPlotAxisFlags_NoDecorations | ImPlotAxisFlags_LockMin );
 
             ImPlot::SetNextFillStyle( colour::shades::blue_gray.dark(), 0.8f );
-            ImPlot::PlotBars( "##waveform", liveStem->m_channel[0], steppedSampleCount, 0.67, 0, 0, 0, sizeof(float) * sampleStep );
+            if ( liveStem->getSampleStorage() == endlesss::live::Stem::SampleStorage::Int16 )
+            {
+                // compact stems are unpacked back to -1..1 on the fly
+                ImPlot::PlotBarsG( "##waveform", []( int idx, void* userData ) -> ImPlotPoint
+                    {
+                        const auto* stem = static_cast<const endlesss::live::Stem*>( userData );
+
+                        float left, right;
+                        stem->getSamplePair( static_cast<std::size_t>( idx ) * sampleStep, left, right );
+                        return ImPlotPoint( idx, left );
+                    },
+                    (void*)liveStem, steppedSampleCount, 0.67 );
+            }
+            else
+            {
+                ImPlot::PlotBars( "##waveform", liveStem->m_channel[0], steppedSampleCount, 0.67, 0, 0, 0, sizeof(float) * sampleStep );
+            }
 
             ImPlot::EndPlot();
         }
@@ -1,9 +1,8 @@
 #include "pch.h"
 
 #include "base/utils.h"
-#include "math/rng.h"
-#include "buffer/mix.h"
 #include "mix/common.h"
+#include "mix/engine.h"
 
 #include "spacetime/moment.h"
 
@@ -18,991 +17,69 @@
 #include "ux/stem.beats.h"
 #include "ux/riff.tagline.h"
 
-#include "ssp/ssp.file.flac.h"
-
-#include "discord/discord.bot.ui.h"
-
-#include "endlesss/all.h"
-
-#include "data/databus.h"
-#include "effect/effect.stack.h"
-#include "net/bond.riffpush.h"
-
-#include <ableton/Link.hpp>
-#include <ableton/link/HostTimeFilter.hpp>
-
-
-#define OUROVEON_BEAM           "BEAM"
-#define OUROVEON_BEAM_VERSION   OURO_FRAMEWORK_VERSION "-beta"
-
-using namespace std::chrono_literals;
-
-// ---------------------------------------------------------------------------------------------------------------------
-struct BeamAbletonLinkControl
-{
-    BeamAbletonLinkControl()
-        : m_link( 120.0 )
-    {
-    }
-    ~BeamAbletonLinkControl()
-    {
-        m_link.enable( false );
-    }
-
-    using LinkHostTime = ableton::link::HostTimeFilter<ableton::link::platform::Clock>;
-
-    void Transaction_StopPlaying()
-    {
-        // if the current link state is "playing", snag and change the session to stop it
-        if ( m_linkIsPlaying )
-        {
-            auto linkSessionState = m_link.captureAudioSessionState();
-            {
-                linkSessionState.setIsPlaying(
-                    false,
-                    m_hostTimeFilter.sampleTimeToHostTime( m_sampleTime ) );
-
-                m_linkIsPlaying = false;
-            }
-            m_link.commitAudioSessionState( linkSessionState );
-        }
-    }
-
-
-    ableton::Link               m_link;
-    LinkHostTime                m_hostTimeFilter;
-    std::chrono::microseconds   m_outputLatency;
-    double                      m_sampleTime = 0;
-    int32_t                     m_authorativeInterval = -1;
-    bool                        m_linkIsPlaying = false;
-};
-
-// ---------------------------------------------------------------------------------------------------------------------
-struct MixEngine final : public app::module::MixerInterface,
-                         public rec::IRecordable,
-                         public mix::RiffMixerBase
-{
-    using AudioBuffer = app::module::Audio::OutputBuffer;
-    using AudioSignal = app::module::Audio::OutputSignal;
-
-    static constexpr uint32_t cSampleCountMax = std::numeric_limits<uint32_t>::max();
-
-    // 
-    struct ProgressionConfiguration
-    {
-        ProgressionConfiguration()
-            : m_triggerPoint( TriggerPoint::AnyBarStart )
-            , m_blendTime( BlendTime::TwoBars )
-            , m_greedyMode( false )
-        {}
-
-        bool operator==( ProgressionConfiguration const& ) const = default;
-
-        // choose when to begin blending to the next riff
-        enum class TriggerPoint
-        {
-            Arbitrary,                      // start blending whenever a new riff arrives, yolo
-            NextRiffStart,                  //             .. when a riff loops around to the beginning (ie. once per riff loop)
-            AnyBarStart,                    //             .. when a bar segment is crossed (or near enough) (ie. usually 8 opportunities per riff loop)
-            AnyEvenBarStart,                //             .. when an even-numbered bar is crossed
-        }               m_triggerPoint;
-
-        static constexpr size_t cTriggerPointCount = 4;
-        static constexpr std::array< const char*, cTriggerPointCount > cTriggerPointNames {{
-            "At Any Point",
-            "At Riff Start",
-            "At Any Bar Start",
-            "At Even Bar Start"
-        }};
-        inline static const char* getTriggerPointName( const TriggerPoint tp )
-        {
-            return cTriggerPointNames[(size_t)tp];
-        }
-        inline static bool triggerPointGetter( void* data, int idx, const char** out_text )
-        {
-            *out_text = getTriggerPointName( (TriggerPoint)idx );
-            return true;
-        }
-
-        // how long the blend should take
-        enum class BlendTime
-        {
-            Zero,
-            OneBar,
-            TwoBars,
-            FourBars,
-            EightBars
-        }               m_blendTime;
-
-        static constexpr size_t cBlendTimeCount = 5;
-        static constexpr std::array< const char*, cBlendTimeCount > cBlendTimeNames {{
-            "Instant",
-            "One Bar",
-            "Two Bars",
-            "Four Bars",
-            "Eight Bars"
-        }};
-        inline static const char* getBlendTimeName( const BlendTime bt )
-        {
-            return cBlendTimeNames[(size_t)bt];
-        }
-        inline static bool blendTimeGetter( void* data, int idx, const char** out_text )
-        {
-            *out_text = getBlendTimeName( (BlendTime)idx );
-            return true;
-        }
-        inline float getBlendTimeMultiplier() const
-        {
-            switch ( m_blendTime )
-            {
-            default:
-            case ProgressionConfiguration::BlendTime::OneBar:    return 1.0f;
-            case ProgressionConfiguration::BlendTime::TwoBars:   return 2.0f;
-            case ProgressionConfiguration::BlendTime::FourBars:  return 4.0f;
-            case ProgressionConfiguration::BlendTime::EightBars: return 8.0f;
-            }
-        }
-
-        bool            m_greedyMode;       // if on and there are multiple 'next riffs' in the queue when it comes time to begin
-                                            // blending, empty the list and only blend to the most recent one. if off, we will
-                                            // work our way through each enqueued change in turn
-    };
-
-    struct RepComConfiguration
-    {
-        bool            m_enable = false;   // if multi-track is started, use repcom logic
-    };
-
-    enum class EngineCommand
-    {
-        Invalid,
-        BeginRecording,
-        StopRecording,
-        UpdateProgressionConfiguration,     // pass ProgressionConfiguration*
-        UpdateRepComConfiguration,          // pass RepComConfiguration*
-        ClearCurrentlyPlaying,
-        ClearAllScheduledTransitions
-    };
-    struct EngineCommandData : public base::BasicCommandType<EngineCommand> { using BasicCommandType::BasicCommandType; };
-
-
-
-    using CommandQueue  = mcc::ReaderWriterQueue<EngineCommandData>;
-    using RiffQueue     = mcc::ReaderWriterQueue<endlesss::live::RiffAndPermutation>;
-
-
-    uint64_t                    m_samplePosition;
-
-
-    endlesss::live::RiffAndPermutation
-                                m_riffCurrent;
-    uint32_t                    m_riffLengthInSamples;
-
-    endlesss::live::RiffProgression
-                                m_playbackProgression;
-
-    RiffQueue                   m_riffQueue;
-    CommandQueue                m_commandQueue;
-
-    endlesss::live::RiffAndPermutation
-                                m_riffNext;
-    float                       m_transitionValue;
-
-    float                       m_stemBeatRate;
-    double                      m_transitionRate;
-
-    ProgressionConfiguration    m_progression;
-
-    BeamAbletonLinkControl      m_abletonLinkControl;
-
-
-    MixEngine( const int32_t maxBufferSize, const int32_t sampleRate, const std::chrono::microseconds outputLatency, base::EventBusClient& eventBusClient )
-        : RiffMixerBase( maxBufferSize, sampleRate, eventBusClient )
-        , m_samplePosition( 0 )
-        , m_transitionValue( 0 )
-        , m_stemBeatRate( 4.0f )
-        , m_transitionRate( 0.25 )
-        , m_multiTrackInFlux( false )
-        , m_multiTrackWaitingToRecordOnRiffEdge( false )
-        , m_multiTrackRecording( false )
-        , m_repcomRepeatBar( 0 )
-        , m_repcomPausedOnBar( -1 )
-        , m_repcomRepeatLimit( 0 )
-        , m_repcomSampleStart( 0 )
-        , m_repcomSampleEnd( cSampleCountMax )
-        , m_repcomState( RepComState::Unpaused )
-    {
-        m_abletonLinkControl.m_outputLatency = outputLatency;
-    }
-
-    virtual ~MixEngine()
-    {
-    }
-
-    const app::AudioPlaybackTimeInfo* getPlaybackTimeInfo() const override { return getTimeInfoPtr(); }
-
-
-    inline void addNextRiff( const endlesss::live::RiffPtr& nextRiff )
-    {
-        m_riffQueue.emplace( nextRiff );
-    }
-
-    // add new riff with an optional permutation packet
-    inline void addNextRiff( const endlesss::live::RiffPtr& nextRiff, const endlesss::types::RiffPlaybackPermutationOpt& permOpt )
-    {
-        m_riffQueue.emplace( nextRiff, permOpt );
-    }
-
-
-    inline void updateProgressionConfiguration( const ProgressionConfiguration* pConfig )
-    {
-        m_commandQueue.emplace( EngineCommand::UpdateProgressionConfiguration, (void*) pConfig );
-    }
-
-    void clearAllScheduledTransitions()
-    {
-        m_commandQueue.emplace( EngineCommand::ClearAllScheduledTransitions );
-    }
-
-    inline void updateRepComConfiguration( const RepComConfiguration* pConfig )
-    {
-        m_commandQueue.emplace( EngineCommand::UpdateRepComConfiguration, (void*)pConfig );
-    }
-
-    inline void clearCurrentPlayback()
-    {
-        m_commandQueue.emplace( EngineCommand::ClearCurrentlyPlaying );
-    }
-
-    void enableAbletonLink( bool bEnabled )
-    {
-        m_abletonLinkControl.m_link.enable( bEnabled );
-    }
-
-
-    inline uint32_t getBarRepetitions() const { return m_repcomRepeatBar; }
-
-    inline bool isRepComEnabled() const { return m_repcom.m_enable; }
-    inline bool isRepComPaused() const { return isRepComEnabled() && ( m_repcomState != RepComState::Unpaused ); }
-    inline int32_t getBarPausedOn() const { return m_repcomPausedOnBar; }
-
-
-    void update(
-        const AudioBuffer&  outputBuffer,
-        const AudioSignal&  outputSignal,
-        const uint32_t      samplesToWrite,
-        const uint64_t      samplePosition ) override;
-
-    void commit(
-        const AudioBuffer&  outputBuffer,
-        const AudioSignal&  outputSignal,
-        const uint32_t      samplesToWrite )
-    {
-        buffer::downmix_8channel_stereo(
-            outputSignal.m_linearGain,
-            samplesToWrite,
-            m_mixChannelLeft[0],
-            m_mixChannelLeft[1],
-            m_mixChannelLeft[2],
-            m_mixChannelLeft[3],
-            m_mixChannelLeft[4],
-            m_mixChannelLeft[5],
-            m_mixChannelLeft[6],
-            m_mixChannelLeft[7],
-            m_mixChannelRight[0],
-            m_mixChannelRight[1],
-            m_mixChannelRight[2],
-            m_mixChannelRight[3],
-            m_mixChannelRight[4],
-            m_mixChannelRight[5],
-            m_mixChannelRight[6],
-            m_mixChannelRight[7],
-            outputBuffer.m_workingLR[0],
-            outputBuffer.m_workingLR[1]);
-
-        if ( m_multiTrackRecording )
-        {
-            const bool repComEnabled = isRepComEnabled();
-
-            // repetition compression is being activated or suspended, meaning we need to take just a chunk of the 
-            // presented samples rather than all of it
-            if ( repComEnabled && ( m_repcomState == RepComState::SampleFragmentAndPause ||
-                                    m_repcomState == RepComState::SampleFragmentAndResume ) )
-            {
-                const auto fragmentSampleCount = std::min( (uint32_t)m_repcomSampleEnd, samplesToWrite ) - m_repcomSampleStart;
-
-                blog::mix( "[ REPCOM ] Fragmenting ({})  [ {} ] -> [ {} ]  ({} samples)",
-                    ( m_repcomState == RepComState::SampleFragmentAndPause ) ? "Pausing" : "Resuming",
-                    m_repcomSampleStart,
-                    m_repcomSampleStart + fragmentSampleCount,
-                    fragmentSampleCount );
-
-                for ( auto i = 0; i < 8; i++ )
-                {
-                    m_multiTrackOutputs[i]->appendSamples(
-                        m_mixChannelLeft[i] + m_repcomSampleStart,
-                        m_mixChannelRight[i] + m_repcomSampleStart,
-                        fragmentSampleCount );
-                }
-            }
-            else if ( !repComEnabled || m_repcomState == RepComState::Unpaused )
-            {
-                for ( auto i = 0; i < 8; i++ )
-                {
-                    m_multiTrackOutputs[i]->appendSamples( m_mixChannelLeft[i], m_mixChannelRight[i], samplesToWrite );
-                }
-            }
-        }
-        {
-            if ( m_repcomState == RepComState::SampleFragmentAndPause )
-                 m_repcomState  = RepComState::Paused;
-            if ( m_repcomState == RepComState::SampleFragmentAndResume )
-            {
-                m_repcomState       = RepComState::Unpaused;
-                m_repcomPausedOnBar = -1;
-            }
-
-            m_repcomSampleStart = 0;
-            m_repcomSampleEnd   = cSampleCountMax;
-        }
-    }
-
-    void mainThreadUpdate( const float dT, endlesss::toolkit::Exchange& beatEx )
-    {
-        for ( auto layer = 0U; layer < 8; layer++ )
-            m_multiTrackOutputsToDestroyOnMainThread[layer].reset();
-    }
-
-
-// ---------------------------------------------------------------------------------------------------------------------
-// rec::IRecordable
-
-public:
-
-    inline bool beginRecording( const fs::path& outputPath, const std::string& filePrefix ) override
-    {
-        // should not be calling this if we're already in the process of streaming out
-        assert( !isRecording() );
-        if ( isRecording() )
-            return false;
-
-        math::RNG32 writeBufferShuffleRNG;
-
-        // set up 8 WAV output streams, one for each Endlesss layer
-        for ( auto i = 0; i < 8; i++ )
-        {
-            auto recordFile = outputPath / fmt::format( "{}beam_channel{}.flac", filePrefix, i );
-            m_multiTrackOutputs[i] = ssp::FLACWriter::Create(
-                recordFile.string(),
-                m_audioSampleRate,
-                writeBufferShuffleRNG.genFloat( 0.75f, 1.75f ) );   // randomise the write buffer sizes to avoid all
-                                                                    // outputs flushing outputs simultaneously
-        }
-
-        // tell the worker thread to begin writing to our streams
-        m_commandQueue.enqueue( EngineCommand::BeginRecording );
-        m_multiTrackInFlux = true;
-
-        return true;
-    }
-
-    inline void stopRecording() override
-    {
-        // can't stop what hasn't started
-        assert( isRecording() );
-        if ( !isRecording() )
-            return;
-
-        m_commandQueue.enqueue( EngineCommand::StopRecording );
-        m_multiTrackInFlux = true;
-    }
-
-    // either we're fully engaged with writing out the stream or the request to do (or to stop) is still in-flight
-    inline bool isRecording() const override
-    {
-        return m_multiTrackRecording || 
-               m_multiTrackInFlux;
-    }
-
-    inline uint64_t getRecordingDataUsage() const override
-    {
-        if ( !isRecording() )
-            return 0;
-
-        uint64_t usage = 0;
-        for ( auto i = 0; i < 8; i++ )
-            usage += m_multiTrackOutputs[i]->getStorageUsageInBytes();
-
-        return usage;
-    }
-
-    inline std::string_view getRecorderName() const override { return " Multitrack "; }
-    inline const char* getFluxState() const override
-    {
-        if ( m_repcomState != RepComState::Unpaused )
-            return "[PAUSED] ";
-        if ( m_multiTrackInFlux )
-            return " Awaiting Loop Start";
-
-        return nullptr;
-    }
-
-
-private:
-
-    using MultiTrackStreams = std::array < std::shared_ptr<ssp::FLACWriter>, 8 >;
-
-    bool                m_multiTrackInFlux;
-    bool                m_multiTrackWaitingToRecordOnRiffEdge;
-    bool                m_multiTrackRecording;
-    MultiTrackStreams   m_multiTrackOutputs;                        // currently live recorders
-    MultiTrackStreams   m_multiTrackOutputsToDestroyOnMainThread;   // recorders ready to decommission on main thread
-
-
-    // multitrack "repetition compression" (RepCom) 
-
-    // repcom config written to via engine command
-    RepComConfiguration m_repcom;
-
-    // repcom internal state
-    int32_t             m_repcomRepeatBar;
-    int32_t             m_repcomPausedOnBar;
-    int32_t             m_repcomRepeatLimit;
-    uint32_t            m_repcomSampleStart;
-    uint32_t            m_repcomSampleEnd;
-    enum class RepComState
-    {
-        Unpaused,
-        SampleFragmentAndPause,
-        Paused,
-        SampleFragmentAndResume
-    }                   m_repcomState;
-};
-
-// ---------------------------------------------------------------------------------------------------------------------
-void MixEngine::update(
-    const AudioBuffer&  outputBuffer,
-    const AudioSignal&  outputSignal,
-    const uint32_t      samplesToWrite,
-    const uint64_t      samplePosition )
-{
-    m_samplePosition = samplePosition;
-    m_timeInfo.samplePos = (double)samplePosition;
-
-    stemAmalgamUpdate();
-
-    const double linearTimeStep = (double)samplesToWrite / (double)m_audioSampleRate;
-
-    const auto notifyRepComOfActivity = [&]( uint32_t newStartSample )
-    {
-        assert( m_repcomState != RepComState::SampleFragmentAndResume );
-        if ( m_repcomState == RepComState::Paused )
-        {
-            blog::mix( "[ REPCOM ] UNPAUSE on new activity @ {} -> {}", newStartSample, samplesToWrite );
-
-            m_repcomSampleStart = newStartSample;
-            m_repcomSampleEnd   = cSampleCountMax;
-            m_repcomState       = RepComState::SampleFragmentAndResume;
-        }
-    };
-
-    // flag to indicate that the local data buffers need updating with m_riffCurrent data
-    // .. this is reset mid-cycle in the case we have to handle a transition event where the
-    // riff might change underneith us (via exchangeLiveRiff)
-    bool riffUnpackRequired = true;
-
-    // swap in the Next riff, mark transition/unpack flags as appropriate
-    const auto exchangeLiveRiff = [&]
-    {
-        m_riffCurrent           = m_riffNext;
-        m_riffNext              = {};
-        m_transitionValue       = 0.0f;
-        m_repcomRepeatBar       = 0;
-
-        m_abletonLinkControl.m_authorativeInterval = 1;
-
-        riffUnpackRequired      = true;
-    };
-
-    // process commands from the main thread
-    {
-        EngineCommandData engineCmd;
-        if ( m_commandQueue.try_dequeue( engineCmd ) )
-        {
-            switch ( engineCmd.getCommand() )
-            {
-                // start multitrack on the edge of a riff; the actual recording begins 
-                // when that is detected during the sample loop below
-                case EngineCommand::BeginRecording:
-                {
-                    m_multiTrackWaitingToRecordOnRiffEdge = true;
-                }
-                break;
-
-                // cleanly disengage recording from the mix thread
-                case EngineCommand::StopRecording:
-                {
-                    m_multiTrackWaitingToRecordOnRiffEdge = false;
-                    m_multiTrackRecording                 = false;
-                    m_multiTrackInFlux                    = false;
-
-                    // move recorders over to destroy on the main thread, avoid any stalls
-                    // from whatever may be required to tie off recording
-                    for ( auto i = 0; i < 8; i++ )
-                    {
-                        assert( m_multiTrackOutputsToDestroyOnMainThread[i] == nullptr );
-
-                        m_multiTrackOutputsToDestroyOnMainThread[i] = m_multiTrackOutputs[i];
-                        m_multiTrackOutputs[i].reset();
-                    }
-
-                    blog::mix( "[ Multitrack ] ... Stopped" );
-                }
-                break;
-
-                case EngineCommand::UpdateProgressionConfiguration:
-                {
-                    assert( engineCmd.getPtr() != nullptr );
-                    m_progression = *engineCmd.getPtrAs< ProgressionConfiguration >();
-                }
-                break;
-
-                case EngineCommand::UpdateRepComConfiguration:
-                {
-                    assert( !isRecording() );   // should not be allowed to update if recording is already underway
-                    assert( engineCmd.getPtr() != nullptr );
-                    m_repcom = *engineCmd.getPtrAs< RepComConfiguration >();
-                }
-                break;
-
-                case EngineCommand::ClearCurrentlyPlaying:
-                {
-                    m_riffNext = {};
-                    exchangeLiveRiff();
-                }
-                break;
-
-                case EngineCommand::ClearAllScheduledTransitions:
-                {
-                    // purge the queue
-                    endlesss::live::RiffAndPermutation dumpRiff;
-                    while ( m_riffQueue.try_dequeue( dumpRiff ) )
-                    { }
-                }
-                break;
-
-                default:
-                case EngineCommand::Invalid:
-                    blog::error::mix( "Unknown or invalid command received" );
-                    break;
-            }
-        }
-    }
-
-    const auto checkForAndDequeueNextRiff = [&]
-    {
-        if ( m_riffNext.isEmpty() )
-        {
-            if ( m_riffQueue.peek() != nullptr &&
-                 m_transitionValue == 0 )
-            {
-                if ( !m_riffQueue.try_dequeue( m_riffNext ) )
-                {
-                    assert( false );
-                    return false;
-                }
-
-                blog::mix( "[ BLEND ] DEQUEUED new riff" );
-
-                if ( m_riffNext.m_riffPtr->getSyncState() != endlesss::live::Riff::SyncState::Success )
-                {
-                    blog::error::mix( "[ BLEND ] .. new riff invalid, ignoring it" );
-                    m_riffNext = {};
-                }
-
-                // hard cut
-                if ( m_progression.m_blendTime == ProgressionConfiguration::BlendTime::Zero )
-                {
-                    blog::mix( "[ BLEND ] hard cut" );
-                    exchangeLiveRiff();
-                }
-                // pick blend rate based on how many bars to take
-                else
-                {
-                    ABSL_ASSERT( m_riffNext.isNotEmpty() );
-                    m_transitionRate = 1.0 / ( m_riffNext.m_riffPtr->m_timingDetails.m_lengthInSecPerBar * m_progression.getBlendTimeMultiplier() );
-                }
-            }
-        }
-
-        return ( m_riffNext.isNotEmpty() );
-    };
-
-    // in Arbitrary mode, check all the time to see if we could be switching
-    if ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::Arbitrary )
-    {
-        checkForAndDequeueNextRiff();
-    }
-
-    // update the transition, if one is active; and swap in the next riff if one has completed
-    if ( m_riffNext.isNotEmpty() )
-    {
-        m_transitionValue += (float)(linearTimeStep * m_transitionRate);
-
-        if ( m_transitionValue >= 1.0f )
-        {
-            blog::mix( "[ BLEND ] completed" );
-            exchangeLiveRiff();
-        }
-    }
-
-    // early out if we have nothing to play or the active riff is 0-length
-    if ( m_riffCurrent.isEmpty() ||
-         m_riffCurrent.m_riffPtr->m_timingDetails.m_lengthInSamples == 0 )
-    {
-        outputBuffer.applySilence();
-
-        // reset computed riff playback variables
-        m_playbackProgression.reset();
-
-        // check if there's something on the horizon
-        if ( m_riffQueue.peek() != nullptr )
-        {
-            if ( checkForAndDequeueNextRiff() )
-            {
-                blog::mix( "[ BLEND ] hard cut to first riff" );
-                exchangeLiveRiff();
-                notifyRepComOfActivity( 0 );
-            }
-        }
-
-        // deal with LINK session update with nothing playing
-        {
-            m_abletonLinkControl.Transaction_StopPlaying();
-            m_abletonLinkControl.m_sampleTime += static_cast<double>(samplesToWrite);
-        }
-
-        return;
-    }
-
-
-
-    const endlesss::live::Riff* currentRiff = m_riffCurrent.m_riffPtr.get();
-    const endlesss::types::RiffPlaybackPermutation& currentPermutation = m_riffCurrent.m_permutation;
-
-    // compute where we are (roughly) for the UI
-    currentRiff->getTimingDetails().ComputeProgressionAtSample( m_samplePosition, m_playbackProgression );
-
-
-
-    // update vst time structure with latest state
-    m_timeInfo.tempo              = currentRiff->m_timingDetails.m_bpm;
-    m_timeInfo.timeSigNumerator   = currentRiff->m_timingDetails.m_quarterBeats;
-    m_timeInfo.timeSigDenominator = 4;
-
-
-    std::array< bool,  16 >         stemHasBeat;
-    std::array< float, 16 >         stemEnergy;
-    std::array< float, 16 >         stemTimeStretch;
-    std::array< float, 16 >         stemGains;
-    std::array< endlesss::live::Stem*, 16 >   stemPtr;
-
-    // keep note of where we are mixing in terms of the 0..N sample count of the current riff
-    std::array< uint32_t, 2 >       riffLengthInSamples;
-    std::array< uint32_t, 2 >       riffWrappedSampleStart;
-    
-    stemHasBeat.fill( false );
-    stemEnergy.fill( 0.0f );
-    stemTimeStretch.fill( 0.0f );
-    stemGains.fill( 0.0f );
-    stemPtr.fill( nullptr );
-
-    riffLengthInSamples.fill( 0 );
-    riffWrappedSampleStart.fill( 0 );
-
-    // unpack our primary foreground riff into the local data buffers used during sample filling
-    const auto decodeForegroundRiffData = [&]
-    {
-        riffLengthInSamples[0]      = currentRiff->m_timingDetails.m_lengthInSamples;
-        riffWrappedSampleStart[0]   = samplePosition % riffLengthInSamples[0];
-
-        for (auto stemI = 0U; stemI < 8; stemI++)
-        {
-            stemTimeStretch[stemI]  = currentRiff->m_stemTimeScales[stemI];
-            stemGains[stemI]        = currentRiff->m_stemGains[stemI] * currentPermutation.m_layerGainMultiplier[stemI];
-            stemPtr[stemI]          = currentRiff->m_stemPtrs[stemI];
-        }
-    };
-    decodeForegroundRiffData();
-
-    // unpack transitional riff? can be called mid-loop if we pull a new riff off the pile
-    const auto decodeTransitionalRiffData = [&]
-    {
-        if ( m_transitionValue > 0 )
-        {
-            const auto* nextRiff        = m_riffNext.m_riffPtr.get();
-            const auto& nextPermutation = m_riffNext.m_permutation;
-
-            riffLengthInSamples[1]      = nextRiff->m_timingDetails.m_lengthInSamples;
-            riffWrappedSampleStart[1]   = samplePosition % riffLengthInSamples[1];
-
-            for ( auto stemI = 0U; stemI < 8; stemI++ )
-            {
-                stemTimeStretch[ 8 + stemI ]  = nextRiff->m_stemTimeScales[stemI];
-                stemGains[ 8 + stemI ]        = nextRiff->m_stemGains[stemI] * nextPermutation.m_layerGainMultiplier[stemI];
-                stemPtr[ 8 + stemI ]          = nextRiff->m_stemPtrs[stemI];
-            }
-        }
-    };
-    decodeTransitionalRiffData();
-
-
-    const auto segmentLengthInSamples   = currentRiff->m_timingDetails.m_lengthInSamplesPerBar;
-          auto segmentSampleStart       = samplePosition % segmentLengthInSamples;
-
-    for ( auto sI = 0U; sI < samplesToWrite; sI++ )
-    {
-        const uint64_t sample = samplePosition + sI;
-
-        // get sample position in context of the riff
-        uint64_t riffSample   = riffWrappedSampleStart[0] + sI;
-        if ( riffSample >= riffLengthInSamples[0] )
-            riffSample -= riffLengthInSamples[0];
-
-        while ( segmentSampleStart >= segmentLengthInSamples )
-        {
-            segmentSampleStart -= segmentLengthInSamples;
-
-            m_playbackProgression.m_playbackBar++;
-            if ( m_playbackProgression.m_playbackBar >= currentRiff->m_timingDetails.m_barCount )
-                m_playbackProgression.m_playbackBar = 0;
-        }
-
-        const uint64_t segmentSample = segmentSampleStart++;
-
-
-        if ( segmentSample == 0 )
-        {
-//            blog::mix( "[ Edge ] Bar {}", m_riffPlaybackBar + 1 );
-
-            const bool isEvenBarNumber = (m_playbackProgression.m_playbackBar & 1 ) == 0;
-            const bool shouldTriggerTransition =
-                // any bar
-                ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::AnyBarStart ) ||
-                // 0, 2, 4, .. 
-                ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::AnyEvenBarStart && isEvenBarNumber ) ||
-                // next riff is bar 0
-                ( m_progression.m_triggerPoint == ProgressionConfiguration::TriggerPoint::NextRiffStart && m_playbackProgression.m_playbackBar == 0 );
-
-            if ( shouldTriggerTransition )
-            {
-                bool allowedToTrigger = true;
-
-                if ( isRepComPaused() && m_repcomPausedOnBar != m_playbackProgression.m_playbackBar )
-                    allowedToTrigger = false;
-
-                if ( allowedToTrigger && checkForAndDequeueNextRiff() )
-                {
-                    if ( riffUnpackRequired )
-                        decodeForegroundRiffData();
-                    decodeTransitionalRiffData();
-                    notifyRepComOfActivity( sI );
-                }
-            }
-
-            if ( m_multiTrackRecording )
-            {
-                m_repcomRepeatBar++;
-
-                const bool repComTriggerPause = isRepComEnabled() &&
-                                                m_repcomRepeatBar >= currentRiff->m_timingDetails.m_longestStemInBars;
-
-                if (    repComTriggerPause
-                     && m_repcomState           == RepComState::Unpaused
-                     && m_riffNext.m_riffPtr    == nullptr
-                     && m_transitionValue       == 0 )
-                {
-                    blog::mix( "[ REPCOM ] Pausing @ bar {}, sample offset {}", m_playbackProgression.m_playbackBar, sI );
-
-                    m_repcomPausedOnBar = m_playbackProgression.m_playbackBar;
-
-                    m_repcomSampleStart = 0;
-                    m_repcomSampleEnd   = sI;
-                    m_repcomState       = RepComState::SampleFragmentAndPause;
-                }
-            }
-        }
-        if ( riffSample == 0 )
-        {
-            blog::mix( "[ Edge ] Riff" );
-
-            // multitrack recording waits till the start of a riff to begin
-            if ( m_multiTrackWaitingToRecordOnRiffEdge )
-            {
-                // begin writing out data
-                m_multiTrackRecording                 = true;
-                m_multiTrackWaitingToRecordOnRiffEdge = false;
-                m_multiTrackInFlux                    = false;
-
-                // reset repcom stats
-                m_repcomRepeatBar                     = 0;
-
-                blog::mix( "[ Multitrack ] Recording ..." );
-            }
-        }
-
-
-        for ( auto stemI = 0U; stemI < 8; stemI++ )
-        {
-            const endlesss::live::Stem* stemInst = stemPtr[stemI];
-            const float       stemGain = stemGains[stemI];
-
-            if ( stemInst == nullptr || stemInst->hasFailed() )
-            {
-                m_mixChannelLeft[stemI][sI] = 0;
-                m_mixChannelRight[stemI][sI] = 0;
-
-                m_stemDataAmalgam.m_wave[stemI] = 0;
-                m_stemDataAmalgam.m_beat[stemI] = 0;
-                m_stemDataAmalgam.m_low[stemI]  = 0;
-                m_stemDataAmalgam.m_high[stemI] = 0;
-                continue;
-            }
-
-            const auto sampleCount = stemInst->m_sampleCount;
-            uint64_t finalSampleIdx = riffSample;
-
-            if (stemTimeStretch[stemI] != 1.0f)
-            {
-                double scaleSample = (double)finalSampleIdx * stemTimeStretch[stemI];
-                finalSampleIdx = (uint64_t)scaleSample;
-            }
-            finalSampleIdx %= sampleCount;
-
-
-            if ( stemInst->getAnalysisState() == endlesss::live::Stem::AnalysisState::AnalysisValid )
-            {
-                const float permGain = currentPermutation.m_layerGainMultiplier[stemI];
-
-                const auto& stemAnalysis = stemInst->getAnalysisData();
-
-                const float stemWave = stemAnalysis.getWaveF( finalSampleIdx ) * permGain;
-                const float stemBeat = stemAnalysis.getBeatF( finalSampleIdx ) * permGain;
-                const float stemLow  = stemAnalysis.getLowFreqF( finalSampleIdx ) * permGain;
-                const float stemHigh = stemAnalysis.getHighFreqF( finalSampleIdx ) * permGain;
-
-                m_stemDataAmalgam.m_wave[stemI] = std::max( m_stemDataAmalgam.m_wave[stemI], stemWave );
-                m_stemDataAmalgam.m_beat[stemI] = std::max( m_stemDataAmalgam.m_beat[stemI], stemBeat );
-                m_stemDataAmalgam.m_low[stemI]  = std::max( m_stemDataAmalgam.m_low[stemI],  stemLow  );
-                m_stemDataAmalgam.m_high[stemI] = std::max( m_stemDataAmalgam.m_high[stemI], stemHigh );
-            }
-
-            m_mixChannelLeft[stemI][sI]  = stemInst->m_channel[0][finalSampleIdx] * stemGain;
-            m_mixChannelRight[stemI][sI] = stemInst->m_channel[1][finalSampleIdx] * stemGain;
-        }
-
-        if ( m_transitionValue > 0 )
-        {
-            riffSample = riffWrappedSampleStart[1] + sI;
-            if ( riffSample >= riffLengthInSamples[1] )
-                riffSample -= riffLengthInSamples[1];
-
-            for ( auto stemI = 0U; stemI < 8; stemI++ )
-            {
-                const endlesss::live::Stem* stemInst = stemPtr[ 8 + stemI ];
-                const float       stemGain = stemGains[ 8 + stemI ];
-        
-                // when transitioning, a missing/muted stem means we need to transition down to silence, not just skip entirely
-                if ( stemInst == nullptr || stemInst->hasFailed() )
-                {
-                    m_mixChannelLeft[stemI][sI]     = base::lerp( m_mixChannelLeft[stemI][sI],  0.0f, m_transitionValue );
-                    m_mixChannelRight[stemI][sI]    = base::lerp( m_mixChannelRight[stemI][sI], 0.0f, m_transitionValue );
-
-                    continue;
-                }
-        
-                const auto sampleCount = stemInst->m_sampleCount;
-                uint64_t finalSampleIdx = riffSample;
-        
-                if ( stemTimeStretch[ 8 + stemI ] != 1.0f )
-                {
-                    double scaleSample = (double)finalSampleIdx * stemTimeStretch[ 8 + stemI ];
-                    finalSampleIdx = (uint64_t)scaleSample;
-                }
-                finalSampleIdx %= sampleCount;
-
-                m_mixChannelLeft[stemI][sI]         = base::lerp( m_mixChannelLeft[stemI][sI],  stemInst->m_channel[0][finalSampleIdx] * stemGain, m_transitionValue );
-                m_mixChannelRight[stemI][sI]        = base::lerp( m_mixChannelRight[stemI][sI], stemInst->m_channel[1][finalSampleIdx] * stemGain, m_transitionValue );
-            }
-        }
-    }
-
-    m_stemDataAmalgamSamplesUsed += samplesToWrite;
-
-    // LINK logic EXTREMELY WIP HACK
-    if ( currentRiff != nullptr )
-    {
-        const auto& timingData = currentRiff->getTimingDetails();
-
-        // compute timing state when update() began
-        endlesss::live::RiffProgression progressionAtEndOfUpdate;
-        currentRiff->getTimingDetails().ComputeProgressionAtSample(
-            m_samplePosition + samplesToWrite,
-            progressionAtEndOfUpdate );
-
-        const double timingQuantum = static_cast<double>(timingData.m_quarterBeats);
-
-        const auto hostTime = m_abletonLinkControl.m_hostTimeFilter.sampleTimeToHostTime( m_abletonLinkControl.m_sampleTime );
-        m_abletonLinkControl.m_sampleTime += static_cast<double>(samplesToWrite);
-
-        const auto bufferBeginAtOutput = hostTime + m_abletonLinkControl.m_outputLatency;
-
-        auto linkSessionState = m_abletonLinkControl.m_link.captureAudioSessionState();
-
-        // always write our tempo. we are the tempo.
-        linkSessionState.setTempo( timingData.m_bpm, bufferBeginAtOutput );
-
-        // on the arrival of a new riff when nothing was playing, tag IsPlaying in the session state and force
-        // a new 0-beat to match
-        if ( !m_abletonLinkControl.m_linkIsPlaying )
-        {
-            linkSessionState.setIsPlaying( true, bufferBeginAtOutput );
-            linkSessionState.forceBeatAtTime( 0, bufferBeginAtOutput, timingQuantum );
-            m_abletonLinkControl.m_linkIsPlaying = true;
-        }
+#include "discord/discord.bot.ui.h"
+#include "discord/discord.bot.h"
+#include "discord/config.h"
 
-        if ( progressionAtEndOfUpdate.m_playbackBarSegment != m_playbackProgression.m_playbackBarSegment )
-        {
-            std::chrono::microseconds zeroBeatUsOffset( std::llround( progressionAtEndOfUpdate.m_playbackQuarterTimeSec * 1.0e6 ) );
+#include "endlesss/all.h"
 
-            if ( progressionAtEndOfUpdate.m_playbackBarSegment == 0 || m_abletonLinkControl.m_authorativeInterval >= 0 )
-                linkSessionState.forceBeatAtTime( progressionAtEndOfUpdate.m_playbackBarSegment, bufferBeginAtOutput + zeroBeatUsOffset, timingQuantum );
-            else
-                linkSessionState.requestBeatAtTime( progressionAtEndOfUpdate.m_playbackBarSegment, bufferBeginAtOutput + zeroBeatUsOffset, timingQuantum );
+#include "data/databus.h"
+#include "effect/effect.stack.h"
+#include "net/bond.riffpush.h"
+#include "net/broadcast.opus.ui.h"
+#include "net/broadcast.opus.h"
+#include "net/broadcast.config.h"
 
-            if ( m_abletonLinkControl.m_authorativeInterval >= 0 )
-            {
-                m_abletonLinkControl.m_authorativeInterval--;
-                blog::mix( FMTX( "authorativeInterval:{}" ), m_abletonLinkControl.m_authorativeInterval );
-            }
-        }
+#include "beam.config.h"
 
-        m_abletonLinkControl.m_link.commitAudioSessionState( linkSessionState );
-    }
 
-    commit( outputBuffer, outputSignal, samplesToWrite );
-}
+#define OUROVEON_BEAM           "BEAM"
+#define OUROVEON_BEAM_VERSION   OURO_FRAMEWORK_VERSION "-beta"
 
+using namespace std::chrono_literals;
 
 
 // ---------------------------------------------------------------------------------------------------------------------
+//
+//  beam [--headless] [--jam <couch-id> | --bond] [--broadcast] [--discord <voice channel>] [--link]
+//
+//  with --headless, no window or GPU context is created; playback, networking and output are driven from a
+//  lightweight service loop, configured from headless.json in the app config directory plus any of the options above
+//
 struct BeamApp : public app::OuroApp,
                  public ux::TagLineToolProvider
 {
-    BeamApp()
+    struct Arguments
+    {
+        bool                            m_headless = false;
+
+        std::optional< std::string >    m_streamSource;
+        std::optional< std::string >    m_jamCouchID;
+        std::optional< std::string >    m_discordVoiceChannel;
+        bool                            m_enableBroadcast = false;
+        bool                            m_enableAbletonLink = false;
+
+        // command line choices take precedence over whatever was loaded from disk
+        void applyTo( config::beam::Headless& headlessConfig ) const
+        {
+            if ( m_streamSource.has_value() )
+                headlessConfig.streamSource = m_streamSource.value();
+            if ( m_jamCouchID.has_value() )
+                headlessConfig.jamCouchID = m_jamCouchID.value();
+            if ( m_discordVoiceChannel.has_value() )
+                headlessConfig.discordVoiceChannel = m_discordVoiceChannel.value();
+
+            headlessConfig.enableBroadcast   |= m_enableBroadcast;
+            headlessConfig.enableAbletonLink |= m_enableAbletonLink;
+        }
+    };
+
+    BeamApp( const Arguments& arguments )
         : app::OuroApp()
+        , m_arguments( arguments )
     {
         m_discordBotUI = std::make_unique<discord::BotWithUI>( *this );
+        m_broadcastUI  = std::make_unique<net::broadcast::OpusServerWithUI>( *this );
     }
 
     const char* GetAppName() const override { return OUROVEON_BEAM; }
@@ -1011,6 +88,16 @@ struct BeamApp : public app::OuroApp,
 
     int EntrypointOuro() override;
 
+protected:
+
+    // app::CoreGUI
+    bool shouldRunHeadless() const override { return m_arguments.m_headless; }
+
+    // app::OuroApp
+    int EntrypointOuroHeadless() override;
+
+    Arguments                               m_arguments;
+
 protected:
 
     // ux::TagLineToolProvider
@@ -1046,14 +133,21 @@ protected:
 
     uint32_t                                m_bondMessagesHandled = 0;
 
+    // build the riff resolver pipeline that feeds the mixer; shared between the GUI and headless entrypoints
+    std::unique_ptr< endlesss::toolkit::Pipeline > createRiffPipeline( const endlesss::services::RiffFetchProvider& riffFetchProvider, mix::MixEngine& mixEngine );
+
+    // create a BOND server instance; plug the riff-push handler to push all new requests straight into the riff 
+    // resolver pipeline; these will then get enqueued into the mixer when they're available
+    void startBondServer( endlesss::toolkit::Pipeline& riffPipeline, mix::MixEngine& mixEngine );
+
 protected:
 
     endlesss::types::JamCouchID             m_trackedJamCouchID;
 
-    MixEngine::ProgressionConfiguration     m_mixProgressionConfig;
-    MixEngine::ProgressionConfiguration     m_mixProgressionConfigCommitted;
+    mix::MixEngine::ProgressionConfiguration     m_mixProgressionConfig;
+    mix::MixEngine::ProgressionConfiguration     m_mixProgressionConfigCommitted;
 
-    MixEngine::RepComConfiguration          m_repComConfig;
+    mix::MixEngine::RepComConfiguration          m_repComConfig;
 
     std::unique_ptr< ux::TagLine >          m_uxTagLine;
 
@@ -1062,6 +156,9 @@ protected:
 #endif // OURO_FEATURE_NST24
 
     std::unique_ptr< discord::BotWithUI >   m_discordBotUI;
+
+    std::unique_ptr< net::broadcast::OpusServerWithUI >
+                                            m_broadcastUI;
 };
 
 
@@ -1074,7 +171,7 @@ int BeamApp::EntrypointOuro()
 
 
     // create and install the mixer engine
-    MixEngine mixEngine(
+    mix::MixEngine mixEngine(
         m_mdAudio->getMaximumBufferSize(),
         m_mdAudio->getSampleRate(),
         m_mdAudio->getOutputLatencyMs(),
@@ -1090,6 +187,12 @@ int BeamApp::EntrypointOuro()
                 blog::app( FMTX( "Requesting LINK state : {}" ), LinkEnableFlag ? "enabled" : "disabled" );
                 mixEngine.enableAbletonLink( LinkEnableFlag );
             }
+
+            const auto& linkDiagnostics = mixEngine.getLinkDiagnostics();
+            ImGui::TextDisabled( "%u commits, %u beats forced, %u requested",
+                linkDiagnostics.m_sessionCommits.load( std::memory_order_relaxed ),
+                linkDiagnostics.m_beatsForced.load( std::memory_order_relaxed ),
+                linkDiagnostics.m_beatsRequested.load( std::memory_order_relaxed ) );
         });
 
 #if OURO_FEATURE_NST24
@@ -1116,33 +219,7 @@ int BeamApp::EntrypointOuro()
         m_trackedJamCouchID = newJamCID;
     };
 
-    endlesss::toolkit::Pipeline riffPipeline(
-        m_appEventBus,
-        riffFetchProvider,
-        32,
-        [this]( const endlesss::types::RiffIdentity& request, endlesss::types::RiffComplete& result) -> bool
-        {
-            // most requests can be serviced direct from the DB
-            if ( m_warehouse->fetchSingleRiffByID( request.getRiffID(), result ) )
-            {
-                ABSL_ASSERT( result.jam.couchID == request.getJamID() );
-
-                endlesss::toolkit::Pipeline::applyCustomIdentityData( request, result );
-                return true;
-            }
-
-            return endlesss::toolkit::Pipeline::defaultNetworkResolver( *m_networkConfiguration, request, result );
-        },
-        [&mixEngine]( const endlesss::types::RiffIdentity& request, endlesss::live::RiffPtr& loadedRiff, const endlesss::types::RiffPlaybackPermutationOpt& playbackPermutationOpt )
-        {
-            if ( loadedRiff )
-            {
-                mixEngine.addNextRiff( loadedRiff, playbackPermutationOpt );
-            }
-        },
-        []()
-        {
-        } );
+    auto riffPipeline = createRiffPipeline( riffFetchProvider, mixEngine );
 
 
 
@@ -1205,6 +282,7 @@ int BeamApp::EntrypointOuro()
 #endif // OURO_FEATURE_NST24
 
         m_discordBotUI->imgui( *this );
+        m_broadcastUI->imgui( *this );
 
         {
             ImGui::Begin( "System" );
@@ -1353,26 +431,7 @@ int BeamApp::EntrypointOuro()
                 {
                     if ( ImGui::Button( ICON_FA_CIRCLE_NODES " Start BOND Server ", ImVec2( panelRegionAvailable.x, chunkyButtonHeight ) ) )
                     {
-                        m_trackedJamCouchID = {};
-                        mixEngine.clearCurrentPlayback();
-
-                        // create a BOND server instance; plug the riff-push handler to push all new requests
-                        // straight into the riff resolver pipeline; these will then get enqueued into the mixer when they're available
-                        m_bondServer = std::make_unique< net::bond::RiffPushServer >();
-                        m_bondServer->setRiffPushedCallback( [&](
-                            const endlesss::types::JamCouchID& jamID,
-                            const endlesss::types::RiffCouchID& riffID,
-                            const endlesss::types::RiffPlaybackPermutationOpt& permutationOpt )
-                            {
-                                const auto operationID = base::Operations::newID( OV_RiffPlayback );
-
-                                riffPipeline.requestRiff( { { jamID, riffID }, permutationOpt, operationID } );
-
-                                m_bondMessagesHandled++;
-                            });
-
-                        m_bondMessagesHandled = 0;
-                        m_bondServerStatus = m_bondServer->start();
+                        startBondServer( *riffPipeline, mixEngine );
                     }
                 }
                 else
@@ -1423,12 +482,14 @@ int BeamApp::EntrypointOuro()
                 const auto progressBarHeight = ImVec2( -1.0f, currentLineHeight * 1.25f );
 
                 {
-                    const auto* progTrigger = MixEngine::ProgressionConfiguration::getTriggerPointName( mixEngine.m_progression.m_triggerPoint );
-                    const auto* progBlend = MixEngine::ProgressionConfiguration::getBlendTimeName( mixEngine.m_progression.m_blendTime );
+                    const auto* progTrigger = mix::MixEngine::ProgressionConfiguration::getTriggerPointName( mixEngine.m_progression.m_triggerPoint );
+                    const auto* progBlend = mix::MixEngine::ProgressionConfiguration::getBlendTimeName( mixEngine.m_progression.m_blendTime );
+                    const auto* progCurve = mix::MixEngine::ProgressionConfiguration::getBlendCurveName( mixEngine.m_progression.m_blendCurve );
 
-                    ImGui::Text( "Trigger %s, %s %s",
+                    ImGui::Text( "Trigger %s, %s %s %s",
                         progTrigger,
                         progBlend,
+                        progCurve,
                         mixEngine.m_progression.m_greedyMode ? "(Leap)" : "(Sequential)" );
                 }
 
@@ -1468,8 +529,9 @@ int BeamApp::EntrypointOuro()
 
                 ImGui::PushItemWidth( 180.0f );
 
-                ImGui::Combo( " Trigger Point", (int32_t*)&m_mixProgressionConfig.m_triggerPoint, &MixEngine::ProgressionConfiguration::triggerPointGetter, nullptr, MixEngine::ProgressionConfiguration::cTriggerPointCount );
-                ImGui::Combo( " Transition Time",  (int32_t*)&m_mixProgressionConfig.m_blendTime, &MixEngine::ProgressionConfiguration::blendTimeGetter,    nullptr, MixEngine::ProgressionConfiguration::cBlendTimeCount );
+                ImGui::Combo( " Trigger Point", (int32_t*)&m_mixProgressionConfig.m_triggerPoint, &mix::MixEngine::ProgressionConfiguration::triggerPointGetter, nullptr, mix::MixEngine::ProgressionConfiguration::cTriggerPointCount );
+                ImGui::Combo( " Transition Time",  (int32_t*)&m_mixProgressionConfig.m_blendTime, &mix::MixEngine::ProgressionConfiguration::blendTimeGetter,    nullptr, mix::MixEngine::ProgressionConfiguration::cBlendTimeCount );
+                ImGui::Combo( " Transition Curve", (int32_t*)&m_mixProgressionConfig.m_blendCurve, &mix::MixEngine::ProgressionConfiguration::blendCurveGetter,  nullptr, mix::MixEngine::ProgressionConfiguration::cBlendCurveCount );
                 //ImGui::Checkbox( "Empty Riff Queue On Transition", &m_mixProgressionConfig.m_greedyMode );
 
                 const bool progressionIsUpToDate = ( m_mixProgressionConfigCommitted == m_mixProgressionConfig );
@@ -1712,6 +774,334 @@ int BeamApp::EntrypointOuro()
     m_uxTagLine.reset();
 
     m_discordBotUI.reset();
+    m_broadcastUI.reset();
+
+    m_mdAudio->blockUntil( m_mdAudio->installMixer( nullptr ) );
+    m_mdAudio->blockUntil( m_mdAudio->effectClearAll() );
+
+#if OURO_FEATURE_NST24
+    m_effectStack->save( m_appConfigPath );
+#endif // OURO_FEATURE_NST24
+
+    return 0;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+std::unique_ptr< endlesss::toolkit::Pipeline > BeamApp::createRiffPipeline( const endlesss::services::RiffFetchProvider& riffFetchProvider, mix::MixEngine& mixEngine )
+{
+    return std::make_unique< endlesss::toolkit::Pipeline >(
+        m_appEventBus,
+        riffFetchProvider,
+        32,
+        [this]( const endlesss::types::RiffIdentity& request, endlesss::types::RiffComplete& result) -> bool
+        {
+            // most requests can be serviced direct from the DB
+            if ( m_warehouse->fetchSingleRiffByID( request.getRiffID(), result ) )
+            {
+                ABSL_ASSERT( result.jam.couchID == request.getJamID() );
+
+                endlesss::toolkit::Pipeline::applyCustomIdentityData( request, result );
+                return true;
+            }
+
+            return endlesss::toolkit::Pipeline::defaultNetworkResolver( *m_networkConfiguration, request, result );
+        },
+        [&mixEngine]( const endlesss::types::RiffIdentity& request, endlesss::live::RiffPtr& loadedRiff, const endlesss::types::RiffPlaybackPermutationOpt& playbackPermutationOpt )
+        {
+            if ( loadedRiff )
+            {
+                mixEngine.addNextRiff( loadedRiff, playbackPermutationOpt );
+            }
+        },
+        []()
+        {
+        } );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void BeamApp::startBondServer( endlesss::toolkit::Pipeline& riffPipeline, mix::MixEngine& mixEngine )
+{
+    m_trackedJamCouchID = {};
+    mixEngine.clearCurrentPlayback();
+
+    m_bondServer = std::make_unique< net::bond::RiffPushServer >();
+    m_bondServer->setRiffPushedCallback( [this, &riffPipeline](
+        const endlesss::types::JamCouchID& jamID,
+        const endlesss::types::RiffCouchID& riffID,
+        const endlesss::types::RiffPlaybackPermutationOpt& permutationOpt )
+        {
+            const auto operationID = base::Operations::newID( OV_RiffPlayback );
+
+            riffPipeline.requestRiff( { { jamID, riffID }, permutationOpt, operationID } );
+
+            m_bondMessagesHandled++;
+        });
+
+    m_bondMessagesHandled = 0;
+    m_bondServerStatus = m_bondServer->start();
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+int BeamApp::EntrypointOuroHeadless()
+{
+    config::beam::Headless headlessConfig;
+    {
+        const auto headlessLoad = config::load( *this, headlessConfig );
+        if ( headlessLoad != config::LoadResult::Success &&
+             headlessLoad != config::LoadResult::CannotFindConfigFile )
+        {
+            blog::error::cfg( FMTX( "unable to parse [{}]" ), config::beam::Headless::StorageFilename );
+            return -2;
+        }
+        m_arguments.applyTo( headlessConfig );
+    }
+
+    const bool streamFromJam = ( headlessConfig.streamSource == config::beam::Headless::StreamSourceJam );
+    if ( !streamFromJam && headlessConfig.streamSource != config::beam::Headless::StreamSourceBond )
+    {
+        blog::error::cfg( FMTX( "unknown stream source [{}]" ), headlessConfig.streamSource );
+        return -2;
+    }
+    if ( streamFromJam && headlessConfig.jamCouchID.empty() )
+    {
+        blog::error::cfg( FMTX( "no jam chosen to follow; set jamCouchID in [{}] or pass --jam" ), config::beam::Headless::StorageFilename );
+        return -2;
+    }
+
+    // ask to be told about ctrl-c / service stop, so we can unwind cleanly and finish any recordings
+    installTerminationHandlers();
+
+    // create a lifetime-tracked provider object to pass to systems that want access to Riff-fetching abilities we provide
+    endlesss::services::RiffFetchInstance riffFetchService( this );
+    endlesss::services::RiffFetchProvider riffFetchProvider = riffFetchService.makeBound();
+
+    // create and install the mixer engine
+    mix::MixEngine mixEngine(
+        m_mdAudio->getMaximumBufferSize(),
+        m_mdAudio->getSampleRate(),
+        m_mdAudio->getOutputLatencyMs(),
+        m_appEventBusClient.value() );
+    m_mdAudio->blockUntil( m_mdAudio->installMixer( &mixEngine ) );
+
+    if ( headlessConfig.enableAbletonLink )
+        mixEngine.enableAbletonLink( true );
+
+#if OURO_FEATURE_NST24
+    // VSTs for audio engine
+    m_effectStack = std::make_unique<effect::EffectStack>( m_mdAudio.get(), mixEngine.getTimeInfoPtr(), "beam" );
+    m_effectStack->load( m_appConfigPath );
+#endif // OURO_FEATURE_NST24
+
+    endlesss::toolkit::Sentinel jamSentinel( riffFetchProvider, [&]( endlesss::live::RiffPtr& riffPtr )
+    {
+        // enqueue for mixer
+        mixEngine.addNextRiff( riffPtr );
+    });
+
+    auto riffPipeline = createRiffPipeline( riffFetchProvider, mixEngine );
+
+    // == SOURCE =======================================================================================================
+
+    std::string trackedJamName = "[ none ]";
+    if ( streamFromJam )
+    {
+        m_trackedJamCouchID = endlesss::types::JamCouchID{ headlessConfig.jamCouchID };
+
+        if ( lookupJamName( m_trackedJamCouchID, trackedJamName ) == endlesss::services::IJamNameResolveService::LookupResult::NotFound )
+            trackedJamName = headlessConfig.jamCouchID;
+
+        blog::app( FMTX( "[headless] tracking jam [{}] ({})" ), trackedJamName, headlessConfig.jamCouchID );
+        jamSentinel.startTracking( { m_trackedJamCouchID, trackedJamName } );
+    }
+    else
+    {
+        startBondServer( *riffPipeline, mixEngine );
+        if ( !m_bondServerStatus.ok() )
+        {
+            blog::error::app( FMTX( "[headless] BOND server failed to start; {}" ), m_bondServerStatus.ToString() );
+        }
+        else
+        {
+            blog::app( FMTX( "[headless] BOND server started" ) );
+        }
+    }
+
+    // == OUTPUTS ======================================================================================================
+
+    std::unique_ptr< net::broadcast::OpusServer > broadcastServer;
+    if ( headlessConfig.enableBroadcast )
+    {
+        config::broadcast::Server serverConfig;
+        std::ignore = config::load( *this, serverConfig );
+
+        if ( m_mdAudio->getSampleRate() != 48000 )
+        {
+            blog::error::app( FMTX( "[headless] LAN broadcast requires a 48000 sample rate, audio is running at {}" ), m_mdAudio->getSampleRate() );
+        }
+        else
+        {
+            broadcastServer = std::make_unique< net::broadcast::OpusServer >( *this );
+            const auto broadcastStatus = broadcastServer->start( serverConfig.port, serverConfig.bitrate );
+            if ( !broadcastStatus.ok() )
+            {
+                blog::error::app( FMTX( "[headless] broadcast server failed to start; {}" ), broadcastStatus.ToString() );
+                broadcastServer.reset();
+            }
+        }
+    }
+
+    std::unique_ptr< discord::Bot > discordBot;
+    if ( !headlessConfig.discordVoiceChannel.empty() )
+    {
+        config::discord::Connection connectionConfig;
+        if ( config::load( *this, connectionConfig ) != config::LoadResult::Success ||
+             connectionConfig.botToken.empty() ||
+             connectionConfig.guildSID.empty() )
+        {
+            blog::error::cfg( FMTX( "[headless] Discord configuration data missing [{}]" ), config::discord::Connection::StorageFilename );
+        }
+        else
+        {
+            discordBot = std::make_unique< discord::Bot >();
+
+            const auto discordStatus = discordBot->initialise( *this, connectionConfig );
+            if ( !discordStatus.ok() )
+            {
+                blog::error::discord( FMTX( "[headless] bot failed to initialise; {}" ), discordStatus.ToString() );
+                discordBot.reset();
+            }
+        }
+    }
+
+    // == SERVICE LOOP =================================================================================================
+
+    // ticks at a relaxed rate; this only drives bookkeeping and the event bus, audio and network work all have
+    // their own threads
+    static constexpr auto cServiceTickInterval  = std::chrono::milliseconds( 20 );
+    static constexpr auto cTrackerRetryInterval = std::chrono::seconds( 15 );
+    static constexpr auto cDiscordJoinInterval  = std::chrono::seconds( 10 );
+
+    spacetime::Moment trackerRetryTimer;
+    spacetime::Moment discordJoinTimer;
+    spacetime::Moment statusLogTimer;
+    statusLogTimer.setToFuture( std::chrono::seconds( headlessConfig.statusLogIntervalSec ) );
+
+    blog::app( FMTX( "[headless] running, send SIGINT / SIGTERM to stop" ) );
+
+    auto tickTime = std::chrono::steady_clock::now();
+    while ( !wasTerminationRequested() )
+    {
+        std::this_thread::sleep_until( tickTime + cServiceTickInterval );
+
+        const auto tickNow = std::chrono::steady_clock::now();
+        const float deltaTime = std::chrono::duration<float>( tickNow - tickTime ).count();
+        tickTime = tickNow;
+
+        runMainThreadCalls( deltaTime );
+
+        mixEngine.mainThreadUpdate( deltaTime, m_endlesssExchange );
+
+        {
+            // process and blank out Exchange data ready to re-write it
+            emitAndClearExchangeData();
+
+            encodeExchangeData(
+                mixEngine.m_riffCurrent.m_riffPtr,
+                trackedJamName,
+                (uint64_t)mixEngine.getTimeInfoPtr()->samplePos,
+                nullptr );
+        }
+
+        // nobody is around to press the retry button, so bring a failed tracker back after a pause
+        if ( streamFromJam && jamSentinel.isTrackerBroken() && trackerRetryTimer.hasPassed() )
+        {
+            blog::app( FMTX( "[headless] jam tracker failed, restarting" ) );
+            jamSentinel.startTracking( { m_trackedJamCouchID, trackedJamName } );
+            trackerRetryTimer.setToFuture( cTrackerRetryInterval );
+        }
+
+        // once the bot is connected, get it into the chosen voice channel - and back in again if it drops out
+        if ( discordBot &&
+             discordBot->getConnectionPhase() == discord::Bot::ConnectionPhase::Ready &&
+             discordBot->getVoiceState() == discord::Bot::VoiceState::NotJoined &&
+             discordJoinTimer.hasPassed() )
+        {
+            bool channelFound = false;
+            if ( const auto voiceChannels = discordBot->getVoiceChannels() )
+            {
+                for ( const auto& voiceChannel : *voiceChannels )
+                {
+                    if ( voiceChannel.m_name == headlessConfig.discordVoiceChannel )
+                    {
+                        blog::discord( FMTX( "[headless] joining voice channel [{}]" ), voiceChannel.m_name );
+                        discordBot->joinVoiceChannel( voiceChannel );
+                        channelFound = true;
+                        break;
+                    }
+                }
+            }
+            if ( !channelFound )
+            {
+                blog::error::discord( FMTX( "[headless] cannot find voice channel [{}]" ), headlessConfig.discordVoiceChannel );
+            }
+            discordJoinTimer.setToFuture( cDiscordJoinInterval );
+        }
+
+        // flush the main thread event bus
+        m_appEventBus->mainThreadDispatch();
+
+        maintainStemCacheAsync();
+
+        if ( headlessConfig.statusLogIntervalSec > 0 && statusLogTimer.hasPassed() )
+        {
+            const auto* currentRiff = mixEngine.m_riffCurrent.m_riffPtr.get();
+
+            std::string outputStatus;
+            if ( broadcastServer )
+            {
+                net::broadcast::OpusServer::Stats broadcastStats;
+                broadcastServer->getStats( broadcastStats );
+                outputStatus += fmt::format( FMTX( " | broadcast {} listeners, {}" ), broadcastStats.m_clientsConnected, base::humaniseByteSize( "sent ", broadcastStats.m_bytesSent ) );
+            }
+            if ( discordBot )
+            {
+                outputStatus += ( discordBot->getVoiceState() == discord::Bot::VoiceState::Joined ) ? " | discord live" : " | discord idle";
+            }
+
+            blog::app( FMTX( "[headless] {} | {}{}{}" ),
+                currentRiff ? currentRiff->m_uiJamUppercase : "[ no riff ]",
+                streamFromJam ? ( jamSentinel.isTrackerRunning() ? "tracking" : "tracker down" ) : fmt::format( FMTX( "BOND {} riffs" ), m_bondMessagesHandled ),
+                base::humaniseByteSize( ", stem cache ", m_stemCache.estimateMemoryUsageBytes() ),
+                outputStatus );
+
+            statusLogTimer.setToFuture( std::chrono::seconds( headlessConfig.statusLogIntervalSec ) );
+        }
+    }
+
+    blog::app( FMTX( "[headless] shutting down ..." ) );
+
+    if ( discordBot )
+    {
+        if ( discordBot->getVoiceState() == discord::Bot::VoiceState::Joined )
+            discordBot->leaveVoiceChannel();
+        discordBot.reset();
+    }
+    if ( broadcastServer )
+    {
+        std::ignore = broadcastServer->stop();
+        broadcastServer.reset();
+    }
+    if ( m_bondServer )
+    {
+        std::ignore = m_bondServer->stop();
+        m_bondServer.reset();
+    }
+    jamSentinel.stopTracking();
+
+    m_uxTagLine.reset();
+
+    m_discordBotUI.reset();
+    m_broadcastUI.reset();
 
     m_mdAudio->blockUntil( m_mdAudio->installMixer( nullptr ) );
     m_mdAudio->blockUntil( m_mdAudio->effectClearAll() );
@@ -1726,9 +1116,45 @@ int BeamApp::EntrypointOuro()
 // ---------------------------------------------------------------------------------------------------------------------
 int main( int argc, char** argv )
 {
-    BeamApp beam;
+    BeamApp::Arguments arguments;
+
+    // only a headless launch is strict about its arguments; the GUI can be handed all sorts by the OS or a launcher
+    // (eg. macOS passing -psn_0_12345 to apps started from Finder) and should just ignore what it doesn't recognise
+    bool hasUnknownArguments = false;
+
+    for ( int argI = 1; argI < argc; argI++ )
+    {
+        const std::string_view argument( argv[argI] );
+        const bool hasValue = ( argI + 1 < argc );
+
+        if ( argument == "--headless" )
+            arguments.m_headless = true;
+        else if ( argument == "--jam" && hasValue )
+        {
+            arguments.m_streamSource = config::beam::Headless::StreamSourceJam;
+            arguments.m_jamCouchID   = argv[++argI];
+        }
+        else if ( argument == "--bond" )
+            arguments.m_streamSource = config::beam::Headless::StreamSourceBond;
+        else if ( argument == "--broadcast" )
+            arguments.m_enableBroadcast = true;
+        else if ( argument == "--discord" && hasValue )
+            arguments.m_discordVoiceChannel = argv[++argI];
+        else if ( argument == "--link" )
+            arguments.m_enableAbletonLink = true;
+        else
+            hasUnknownArguments = true;
+    }
+
+    if ( hasUnknownArguments && arguments.m_headless )
+    {
+        fmt::print( "usage : beam [--headless] [--jam <couch-id> | --bond] [--broadcast] [--discord <voice channel>] [--link]\n" );
+        return -1;
+    }
+
+    BeamApp beam( arguments );
     const int result = beam.Run();
-    if ( result != 0 )
+    if ( result != 0 && !arguments.m_headless )
         app::Core::waitForConsoleKey();
 
     return result;
@@ -0,0 +1,51 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#pragma once
+
+#include "config/base.h"
+
+namespace config {
+namespace beam {
+
+// what an unattended BEAM should do when launched with --headless; there is no UI to choose any of this, so it all
+// comes from here (and can be overridden per-launch on the command line)
+OURO_CONFIG( Headless )
+{
+    // data routing
+    static constexpr auto StoragePath       = IPathProvider::PathFor::PerAppConfig;
+    static constexpr auto StorageFilename   = "headless.json";
+
+    static constexpr auto StreamSourceJam   = "jam";
+    static constexpr auto StreamSourceBond  = "bond";
+
+    std::string     streamSource            = StreamSourceJam;  // "jam" to follow a live jam, "bond" to run a BOND riff-push server
+    std::string     jamCouchID;                                 // the jam to follow, when streamSource is "jam"
+
+    bool            enableBroadcast         = false;            // run the LAN Opus stream, using the saved broadcast.json settings
+    std::string     discordVoiceChannel;                        // if set, boot the Discord bot from discord.json and join this voice channel
+    bool            enableAbletonLink       = false;
+
+    int32_t         statusLogIntervalSec    = 60;               // how often to write a one-line status summary to the log; 0 to disable
+
+    template<class Archive>
+    void serialize( Archive& archive )
+    {
+        archive( CEREAL_OPTIONAL_NVP( streamSource )
+               , CEREAL_OPTIONAL_NVP( jamCouchID )
+               , CEREAL_OPTIONAL_NVP( enableBroadcast )
+               , CEREAL_OPTIONAL_NVP( discordVoiceChannel )
+               , CEREAL_OPTIONAL_NVP( enableAbletonLink )
+               , CEREAL_OPTIONAL_NVP( statusLogIntervalSec )
+        );
+    }
+};
+
+} // namespace beam
+} // namespace config
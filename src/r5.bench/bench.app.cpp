@@ -0,0 +1,148 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "base/utils.h"
+#include "filesys/fsutil.h"
+
+#include "app/core.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+
+#define OUROVEON_BENCH          "BENCH"
+#define OUROVEON_BENCH_VERSION  OURO_FRAMEWORK_VERSION "-dev"
+
+// ---------------------------------------------------------------------------------------------------------------------
+// headless runner for the performance-critical paths - DSP kernels, the mixers, codecs, stem decoding, the warehouse,
+// the network layer and UI; all data is synthetic and generated into a scratch workspace (or served from a localhost
+// stub), so results are comparable between machines and between commits
+//
+//  bench [--json <path>] [--filter <text>] [--quick] [--keep-workspace]
+//
+struct BenchApp final : public app::Core
+{
+    struct Arguments
+    {
+        bench::Runner::Options  m_runnerOptions;
+        fs::path                m_jsonOutput        = "bench.results.json";
+        bool                    m_keepWorkspace     = false;
+    };
+
+    BenchApp( const Arguments& arguments )
+        : app::Core()
+        , m_arguments( arguments )
+    {
+    }
+
+    const char* GetAppName() const override { return OUROVEON_BENCH; }
+    const char* GetAppNameWithVersion() const override { return (OUROVEON_BENCH " " OUROVEON_BENCH_VERSION); }
+    const char* GetAppCacheName() const override { return "bench"; }
+
+    // no outside network traffic is ever required, everything is synthesised locally or served from a localhost stub
+    bool supportsUnauthorisedEndlesssMode() const override { return true; }
+
+protected:
+
+    int Entrypoint() override;
+
+    Arguments   m_arguments;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+int BenchApp::Entrypoint()
+{
+    m_networkConfiguration->initWithoutAuthentication( m_appEventBus, m_configEndlesssAPI );
+
+    const auto workspaceID = std::chrono::duration_cast<std::chrono::seconds>( std::chrono::system_clock::now().time_since_epoch() ).count();
+
+    bench::Context benchContext;
+    benchContext.m_workspace    = fs::temp_directory_path() / fmt::format( FMTX( "ouroveon.bench.{}" ), workspaceID );
+    benchContext.m_eventBus     = m_appEventBus;
+    benchContext.m_netConfig    = m_networkConfiguration;
+
+    {
+        const auto workspaceStatus = filesys::ensureDirectoryExists( benchContext.m_workspace );
+        if ( !workspaceStatus.ok() )
+        {
+            blog::error::app( FMTX( "unable to create benchmark workspace [{}] ({})" ), benchContext.m_workspace.string(), workspaceStatus.ToString() );
+            return -2;
+        }
+    }
+    blog::app( FMTX( "[bench] workspace : {}" ), benchContext.m_workspace.string() );
+
+    bench::Runner benchRunner( m_arguments.m_runnerOptions );
+
+    bench::runSuiteDSP( benchRunner, benchContext );
+    bench::runSuiteMix( benchRunner, benchContext );
+    bench::runSuiteCodec( benchRunner, benchContext );
+    bench::runSuiteWarehouse( benchRunner, benchContext );
+    bench::runSuiteDiscord( benchRunner, benchContext );
+    bench::runSuiteArchive( benchRunner, benchContext );
+    bench::runSuiteNet( benchRunner, benchContext );
+    bench::runSuiteUI( benchRunner, benchContext );
+
+    benchRunner.logSummary();
+
+    int benchResult = benchRunner.anyFailed() ? 1 : 0;
+
+    const auto jsonStatus = benchRunner.writeJson( m_arguments.m_jsonOutput );
+    if ( jsonStatus.ok() )
+    {
+        blog::app( FMTX( "[bench] results written to [{}]" ), m_arguments.m_jsonOutput.string() );
+    }
+    else
+    {
+        blog::error::app( FMTX( "unable to write benchmark results ({})" ), jsonStatus.ToString() );
+        benchResult = -1;
+    }
+
+    if ( !m_arguments.m_keepWorkspace )
+    {
+        std::error_code removalError;
+        fs::remove_all( benchContext.m_workspace, removalError );
+        if ( removalError )
+        {
+            blog::error::app( FMTX( "unable to clean up benchmark workspace ({})" ), removalError.message() );
+        }
+    }
+
+    return benchResult;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+int main( int argc, char** argv )
+{
+    BenchApp::Arguments arguments;
+
+    for ( int argI = 1; argI < argc; argI++ )
+    {
+        const std::string_view argument( argv[argI] );
+        const bool hasValue = ( argI + 1 < argc );
+
+        if ( argument == "--json" && hasValue )
+            arguments.m_jsonOutput = fs::path( argv[++argI] );
+        else if ( argument == "--filter" && hasValue )
+            arguments.m_runnerOptions.m_filter = argv[++argI];
+        else if ( argument == "--quick" )
+            arguments.m_runnerOptions.m_quick = true;
+        else if ( argument == "--keep-workspace" )
+            arguments.m_keepWorkspace = true;
+        else
+        {
+            fmt::print( "usage : bench [--json <path>] [--filter <text>] [--quick] [--keep-workspace]\n" );
+            return -1;
+        }
+    }
+
+    BenchApp bench( arguments );
+    return bench.Run();
+}
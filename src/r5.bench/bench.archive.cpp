@@ -0,0 +1,315 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+#include "io/tarch.h"
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// lay out something shaped like an exported jam; lots of small files spread over a two-level directory fan-out, as
+// the stem cache does. contents are cheap pseudo-random runs with plenty of repetition so compression has some work
+//
+static bool generateSyntheticArchiveTree( const fs::path& rootPath, const uint32_t fileCount, std::size_t& totalBytes )
+{
+    totalBytes = 0;
+
+    static constexpr uint32_t cFanOut = 16;
+
+    std::vector< uint8_t > fileData;
+    uint32_t lcg = 0xA5C41BE5;
+
+    for ( uint32_t fileIndex = 0; fileIndex < fileCount; fileIndex++ )
+    {
+        const fs::path filePath = rootPath
+            / fmt::format( FMTX( "{:x}" ), fileIndex % cFanOut )
+            / fmt::format( FMTX( "{:x}" ), ( fileIndex / cFanOut ) % cFanOut )
+            / fmt::format( FMTX( "5e4c4000{:024x}" ), fileIndex );
+
+        if ( !filesys::ensureDirectoryExists( filePath.parent_path() ).ok() )
+            return false;
+
+        lcg = lcg * 1664525 + 1013904223;
+        fileData.resize( 512 + ( lcg >> 20 ) );    // 512b .. ~4.5kb
+        for ( std::size_t byteIndex = 0; byteIndex < fileData.size(); byteIndex++ )
+        {
+            if ( ( byteIndex & 63 ) == 0 )
+                lcg = lcg * 1664525 + 1013904223;
+            fileData[byteIndex] = static_cast<uint8_t>( ( lcg >> ( byteIndex & 7 ) ) & 0x3F );
+        }
+
+        FILE* outputFile = fopen( filePath.string().c_str(), "wb" );
+        if ( outputFile == nullptr )
+            return false;
+
+        const bool written = fwrite( fileData.data(), fileData.size(), 1, outputFile ) == 1;
+        fclose( outputFile );
+
+        if ( !written )
+            return false;
+
+        totalBytes += fileData.size();
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// the tar writer as it was before read-ahead, zstd and the embedded index went in, doing the same work per file (one
+// 1MB staging buffer, files pumped through it one at a time in directory iteration order) so the archive suite has a
+// fixed baseline to compare the current io::archiveFilesInDirectoryToTAR against
+//
+namespace baseline {
+
+struct TarHeader
+{
+    union
+    {
+        struct
+        {
+            char name[100];
+            char mode[8];
+            char uid[8];
+            char gid[8];
+            char size[12];
+            char mtime[12];
+            char check[8];
+            char link;
+            char link_name[100];
+        };
+        struct
+        {
+            char old[156];
+            char type;
+            char also_link_name[100];
+            char ustar[8];
+        };
+
+        char block[512];
+    };
+
+    void computeChecksum()
+    {
+        memset( check, ' ', 8 );
+
+        uint32_t checksum = 0;
+        for ( int i = 0; i < 512; i++ )
+            checksum += (uint32_t)block[i];
+
+        snprintf( check, sizeof( check ), "%06o0", checksum );
+        check[6] = '\0';
+        check[7] = ' ';
+    }
+
+    static void createDefault( TarHeader& result )
+    {
+        memset( &result, 0, sizeof( TarHeader ) );
+
+        strcpy( result.mode, "0000777" );
+        strcpy( result.uid,  "0000000" );
+        strcpy( result.gid,  "0000000" );
+        strcpy( result.size, "00000000000" );
+
+        memcpy( result.ustar, "ustar  \x00", 8 );
+    }
+};
+static_assert( sizeof( TarHeader ) == 512 );
+
+static absl::Status archiveFilesInDirectoryToTAR( const fs::path& inputPath, const fs::path& outputTarFile )
+{
+    static constexpr std::size_t ioBufferSize = 1 * 1024 * 1024;
+    void* ioBuffer = mem::alloc16<char>( ioBufferSize );
+
+    FILE* tarOutputFile = fopen( outputTarFile.string().c_str(), "wb" );
+    if ( tarOutputFile == nullptr )
+    {
+        mem::free16( ioBuffer );
+        return absl::InternalError( "unable to open output" );
+    }
+
+    absl::Cleanup cleanupOnScopeExit = [&]() noexcept
+        {
+            fclose( tarOutputFile );
+            mem::free16( ioBuffer );
+        };
+
+    const fs::path baseInputPath = inputPath.parent_path();
+
+    char ioPadding[512];
+    memset( ioPadding, 0, 512 );
+
+    const auto appendToTar = [&]( const bool bIsDirectory, const fs::path& entryFullFilename, const fs::path& entryRelativePath ) -> absl::Status
+        {
+            TarHeader tarHeader;
+            TarHeader::createDefault( tarHeader );
+
+            std::error_code lwtError;
+            const auto fileModTime = fs::last_write_time( entryFullFilename, lwtError );
+            const auto fileModTimeT = std::chrono::duration_cast< std::chrono::seconds >( fileModTime.time_since_epoch() ).count();
+            snprintf( tarHeader.mtime, sizeof( tarHeader.mtime ), "%011o", (int32_t)fileModTimeT );
+
+            std::string entryNamePath = entryRelativePath.string();
+            std::replace( entryNamePath.begin(), entryNamePath.end(), '\\', '/' );
+
+            if ( bIsDirectory )
+            {
+                entryNamePath += '/';
+                tarHeader.link = tarHeader.type = '5';
+            }
+            else
+            {
+                std::error_code fileSizeError;
+                const std::uintmax_t fileSize = fs::file_size( entryFullFilename, fileSizeError );
+                if ( fileSizeError )
+                    return absl::InternalError( fileSizeError.message() );
+
+                snprintf( tarHeader.size, sizeof( tarHeader.size ), "%011o", (int32_t)fileSize );
+                tarHeader.link = tarHeader.type = '0';
+            }
+
+            strncpy( tarHeader.name, entryNamePath.c_str(), 100 );
+            tarHeader.computeChecksum();
+
+            fwrite( &tarHeader, sizeof( tarHeader ), 1, tarOutputFile );
+
+            if ( !bIsDirectory )
+            {
+                FILE* entryInputFile = fopen( entryFullFilename.string().c_str(), "rb" );
+                if ( entryInputFile == nullptr )
+                    return absl::InternalError( "unable to open input" );
+
+                std::size_t bytesRead = 0;
+                std::size_t bytesWritten = 0;
+                while ( static_cast<void>( bytesRead = fread( ioBuffer, 1, ioBufferSize, entryInputFile ) ), bytesRead > 0 )
+                {
+                    fwrite( ioBuffer, bytesRead, 1, tarOutputFile );
+                    bytesWritten += bytesRead;
+                }
+                fclose( entryInputFile );
+
+                const std::size_t paddingBytes = 512 - bytesWritten % 512;
+                if ( paddingBytes != 512 )
+                    fwrite( ioPadding, paddingBytes, 1, tarOutputFile );
+            }
+
+            return absl::OkStatus();
+        };
+
+    std::ignore = appendToTar( true, inputPath, inputPath.filename() );
+
+    auto fileIterator = fs::recursive_directory_iterator( inputPath, std::filesystem::directory_options::skip_permission_denied );
+
+    std::error_code osError;
+    for ( auto fIt = fs::begin( fileIterator ); fIt != fs::end( fileIterator ); fIt = fIt.increment( osError ) )
+    {
+        if ( osError )
+            return absl::AbortedError( osError.message() );
+
+        const auto& entryFullFilename = fIt->path();
+
+        const auto appendStatus = appendToTar( fIt->is_directory(), entryFullFilename, entryFullFilename.lexically_relative( baseInputPath ) );
+        if ( !appendStatus.ok() )
+            return appendStatus;
+    }
+
+    fwrite( ioPadding, 512, 1, tarOutputFile );
+    fwrite( ioPadding, 512, 1, tarOutputFile );
+
+    return absl::OkStatus();
+}
+
+} // namespace baseline
+
+// ---------------------------------------------------------------------------------------------------------------------
+// jam export throughput. "write_baseline" is the single-buffer writer from before read-ahead went in (see above); the
+// rest run the current writer in various configurations
+//
+void runSuiteArchive( Runner& runner, Context& context )
+{
+    static constexpr std::string_view cSuite = "archive";
+
+    struct Variant
+    {
+        std::string_view    m_name;
+        bool                m_baselineWriter;
+        io::ArchiveOptions  m_options;
+    };
+    const std::array< Variant, 4 > variants = {{
+        { "tar.write_baseline",         true,  {} },
+        { "tar.write_inline_reads",     false, { .m_readAheadThreads = 0 } },
+        { "tar.write_pipelined",        false, { .m_readAheadThreads = 4 } },
+        { "tar.write_pipelined_zstd",   false, { .m_readAheadThreads = 4, .m_zstdCompressionLevel = 3 } },
+    }};
+
+    bool anyEnabled = false;
+    for ( const auto& variant : variants )
+        anyEnabled |= runner.isEnabled( cSuite, variant.m_name );
+    if ( !anyEnabled )
+        return;
+
+    const fs::path treeRoot   = context.m_workspace / "archive_input" / "benchjam";
+    const fs::path outputFile = context.m_workspace / "archive_output.tar";
+
+    const uint32_t fileCount = runner.iterations( 50000 );
+    std::size_t inputBytes = 0;
+    if ( !generateSyntheticArchiveTree( treeRoot, fileCount, inputBytes ) )
+    {
+        for ( const auto& variant : variants )
+            runner.markFailed( cSuite, variant.m_name, "unable to generate synthetic file tree" );
+        return;
+    }
+
+    for ( const auto& variant : variants )
+    {
+        if ( !runner.isEnabled( cSuite, variant.m_name ) )
+            continue;
+
+        std::size_t archiveSize = 0;
+
+        runner.measureManual( cSuite, variant.m_name, 4, fileCount, "files", [&]() -> std::optional< std::chrono::nanoseconds >
+        {
+            const auto timeStart = std::chrono::steady_clock::now();
+
+            const auto archiveStatus = variant.m_baselineWriter ?
+                baseline::archiveFilesInDirectoryToTAR( treeRoot, outputFile ) :
+                io::archiveFilesInDirectoryToTAR( treeRoot, outputFile, nullptr, variant.m_options );
+
+            const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+            if ( !archiveStatus.ok() )
+                return std::nullopt;
+
+            std::error_code sizeError;
+            archiveSize = fs::file_size( outputFile, sizeError );
+
+            // a compressed variant that doesn't come out smaller than its input isn't measuring what it says it is
+            if ( variant.m_options.m_zstdCompressionLevel > 0 && archiveSize >= inputBytes )
+                return std::nullopt;
+
+            return timeTaken;
+        });
+
+        blog::instr( FMTX( "[BENCH] {}.{} produced {} bytes from {} bytes of input across {} files ({:.1f}%)" ),
+            cSuite,
+            variant.m_name,
+            archiveSize,
+            inputBytes,
+            fileCount,
+            ( inputBytes > 0 ) ? ( 100.0 * static_cast<double>( archiveSize ) / static_cast<double>( inputBytes ) ) : 0.0 );
+    }
+
+    std::error_code removalError;
+    fs::remove( outputFile, removalError );
+    fs::remove_all( treeRoot.parent_path(), removalError );
+}
+
+} // namespace bench
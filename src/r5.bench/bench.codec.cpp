@@ -0,0 +1,568 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+#include "base/utils.h"
+
+#include "ssp/ssp.file.flac.h"
+#include "ssp/ssp.stream.opus.h"
+
+#include "endlesss/live.stem.h"
+
+#include <bit>
+#include <future>
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// encode a synthetic clip to a FLAC file on disk; the write buffer is sized to hold the whole clip so that the encode
+// happens synchronously as the writer is destroyed, rather than racing the background processor thread
+//
+bool writeSyntheticFLAC( const fs::path& outputFile, const uint32_t sampleRate, float* left, float* right, const uint32_t sampleCount )
+{
+    const float clipLengthSeconds = static_cast<float>( sampleCount ) / static_cast<float>( sampleRate );
+
+    auto flacWriter = ssp::FLACWriter::Create( outputFile, sampleRate, clipLengthSeconds + 1.0f );
+    if ( flacWriter == nullptr )
+        return false;
+
+    static constexpr uint32_t cChunkSize = 1024;
+    for ( uint32_t offset = 0; offset < sampleCount; offset += cChunkSize )
+    {
+        flacWriter->appendSamples( left + offset, right + offset, std::min( cChunkSize, sampleCount - offset ) );
+    }
+    flacWriter.reset();
+
+    return fs::exists( outputFile );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// stems are pulled through the same cache-hit path as the apps use; we drop synthetic FLAC files into a fake cache
+// directory named after made-up stem IDs and let Stem::fetch() decode (and resample, where rates differ) them
+//
+endlesss::types::Stem createSyntheticStemData( const std::string& stemCouchID, const uint32_t sampleRate, const uint32_t fileLength )
+{
+    endlesss::types::Stem stemData;
+    stemData.couchID            = endlesss::types::StemCouchID( stemCouchID );
+    stemData.jamCouchID         = endlesss::types::JamCouchID( "benchjam" );
+    stemData.fileMIME           = "audio/flac";
+    stemData.fileLengthBytes    = fileLength;
+    stemData.sampleRate         = sampleRate;
+    stemData.colour             = "ff808080";
+    stemData.BPS                = 2.0f;
+    stemData.BPMrnd             = 120.0f;
+    stemData.barLength          = 4.0f;
+    return stemData;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// check a split analysis against the serial one; Stem::analyseImpl documents the drift allowed - psa values out by one
+// quantisation step at most, and the odd beat moved or dropped near a chunk start (a moved beat shows as two bits)
+static bool analysisWithinTolerance(
+    const endlesss::live::StemAnalysisData& serialResult,
+    const endlesss::live::StemAnalysisData& splitResult,
+    const std::size_t beatBitTolerance,
+    std::string& report )
+{
+    int32_t     psaMaximumDelta  = 0;
+    std::size_t psaValuesDiffer  = 0;
+
+    const auto comparePSA = [&]( const std::vector< uint8_t >& serialPSA, const std::vector< uint8_t >& splitPSA )
+        {
+            for ( std::size_t sI = 0; sI < serialPSA.size(); sI++ )
+            {
+                const int32_t delta = std::abs( static_cast<int32_t>( serialPSA[sI] ) - static_cast<int32_t>( splitPSA[sI] ) );
+                psaMaximumDelta = std::max( psaMaximumDelta, delta );
+                psaValuesDiffer += ( delta != 0 ) ? 1 : 0;
+            }
+        };
+    comparePSA( serialResult.m_psaWave,     splitResult.m_psaWave );
+    comparePSA( serialResult.m_psaBeat,     splitResult.m_psaBeat );
+    comparePSA( serialResult.m_psaLowFreq,  splitResult.m_psaLowFreq );
+    comparePSA( serialResult.m_psaHighFreq, splitResult.m_psaHighFreq );
+
+    std::size_t beatBitsDiffer = 0;
+    for ( std::size_t bI = 0; bI < serialResult.m_beatBitfield.size(); bI++ )
+        beatBitsDiffer += std::popcount( serialResult.m_beatBitfield[bI] ^ splitResult.m_beatBitfield[bI] );
+
+    report = fmt::format( FMTX( "{} psa values differ (max delta {}), {} beat bits differ (tolerance {})" ),
+        psaValuesDiffer,
+        psaMaximumDelta,
+        beatBitsDiffer,
+        beatBitTolerance );
+
+    return ( psaMaximumDelta <= 1 ) && ( beatBitsDiffer <= beatBitTolerance );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void runSuiteCodec( Runner& runner, Context& context )
+{
+    static constexpr std::string_view cSuite = "codec";
+
+    static constexpr float      cBPM            = 120.0f;
+    static constexpr uint32_t   cClipSeconds    = 8;            // 4 bars at 120bpm, a pretty typical stem
+
+    const fs::path stemCachePath = context.m_workspace / "stems";
+    if ( !filesys::ensureDirectoryExists( stemCachePath ).ok() )
+    {
+        runner.markFailed( cSuite, "*", "unable to create stem cache directory" );
+        return;
+    }
+
+    const uint32_t clipSamples = context.m_sampleRate * cClipSeconds;
+
+    float* clipLeft  = mem::alloc16<float>( clipSamples );
+    float* clipRight = mem::alloc16<float>( clipSamples );
+    generateSyntheticAudio( 0xC0DEC000, context.m_sampleRate, cBPM, clipLeft, clipRight, clipSamples );
+
+    // -----------------------------------------------------------------------------------------------------------------
+    {
+        const fs::path encodeOutput = context.m_workspace / "encode.flac";
+
+        runner.measureManual( cSuite, "flac.encode", 16, clipSamples, "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+        {
+            const auto timeStart = std::chrono::steady_clock::now();
+            if ( !writeSyntheticFLAC( encodeOutput, context.m_sampleRate, clipLeft, clipRight, clipSamples ) )
+                return std::nullopt;
+
+            return std::chrono::steady_clock::now() - timeStart;
+        });
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // a single page of buffered frames is encoded per iteration, timed from handing over the samples to
+    // the packet block arriving back from the encoder thread
+    {
+        static constexpr uint32_t cOpusPageSamples = ssp::OpusStream::cFrameSize * ssp::OpusStream::cBufferedFrames;
+
+        if ( clipSamples <= cOpusPageSamples )
+        {
+            runner.markFailed( cSuite, "opus.encode", "synthetic clip too short" );
+        }
+        else
+        {
+            runner.measureManual( cSuite, "opus.encode", 32, cOpusPageSamples, "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+            {
+                std::promise< void > packetsArrived;
+                auto packetsArrivedFuture = packetsArrived.get_future();
+
+                auto opusStream = ssp::OpusStream::Create( [&]( ssp::OpusPacketDataInstance&& )
+                    {
+                        packetsArrived.set_value();
+                    },
+                    context.m_sampleRate );
+
+                if ( !opusStream.ok() )
+                    return std::nullopt;
+
+                const auto timeStart = std::chrono::steady_clock::now();
+
+                // one sample past a full page to trigger the page flip onto the encoder thread
+                ( *opusStream )->appendSamples( clipLeft, clipRight, cOpusPageSamples + 1 );
+
+                if ( packetsArrivedFuture.wait_for( std::chrono::seconds( 10 ) ) != std::future_status::ready )
+                    return std::nullopt;
+
+                return std::chrono::steady_clock::now() - timeStart;
+            });
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // decode at the mixer rate and from 44.1k, the latter going through the resampler as well
+    for ( const uint32_t sourceSampleRate : { context.m_sampleRate, 44100U } )
+    {
+        const std::string stemCouchID   = fmt::format( FMTX( "5e4c40000000000000000000{:08x}" ), sourceSampleRate );
+        const fs::path    stemCacheFile = stemCachePath / stemCouchID;
+        const std::string benchName     = ( sourceSampleRate == context.m_sampleRate ) ? "stem.decode" : fmt::format( FMTX( "stem.decode_resample.{}" ), sourceSampleRate );
+
+        if ( !runner.isEnabled( cSuite, benchName ) )
+            continue;
+
+        const uint32_t sourceSamples = sourceSampleRate * cClipSeconds;
+        float* sourceLeft  = mem::alloc16<float>( sourceSamples );
+        float* sourceRight = mem::alloc16<float>( sourceSamples );
+        generateSyntheticAudio( 0x5E4C4000, sourceSampleRate, cBPM, sourceLeft, sourceRight, sourceSamples );
+
+        const bool stemWritten = writeSyntheticFLAC( stemCacheFile, sourceSampleRate, sourceLeft, sourceRight, sourceSamples );
+
+        mem::free16( sourceRight );
+        mem::free16( sourceLeft );
+
+        if ( !stemWritten )
+        {
+            runner.markFailed( cSuite, benchName, "unable to write synthetic stem" );
+            continue;
+        }
+
+        const auto stemData = createSyntheticStemData( stemCouchID, sourceSampleRate, static_cast<uint32_t>( fs::file_size( stemCacheFile ) ) );
+
+        runner.measureManual( cSuite, benchName, 16, static_cast<double>( sourceSamples ), "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+        {
+            const auto timeStart = std::chrono::steady_clock::now();
+
+            endlesss::live::Stem stem( stemData, context.m_sampleRate );
+            stem.fetch( *context.m_netConfig, stemCachePath );
+
+            const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+            if ( stem.m_state != endlesss::live::Stem::State::Complete )
+                return std::nullopt;
+
+            return timeTaken;
+        });
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // warm-cache decode with the cache file read onto the heap first, as fetch() did before it mapped cache hits; the
+    // buffer is handed over the same way a mounted archive's data is. compare against "stem.decode", which maps
+    if ( runner.isEnabled( cSuite, "stem.decode_heap_read" ) )
+    {
+        const std::string stemCouchID   = "5e4c4000000000000000000000ea9ead";
+        const fs::path    stemCacheFile = stemCachePath / stemCouchID;
+
+        // same signal as "stem.decode" so the two compressed files match
+        float* sourceLeft  = mem::alloc16<float>( clipSamples );
+        float* sourceRight = mem::alloc16<float>( clipSamples );
+        generateSyntheticAudio( 0x5E4C4000, context.m_sampleRate, cBPM, sourceLeft, sourceRight, clipSamples );
+
+        const bool stemWritten = writeSyntheticFLAC( stemCacheFile, context.m_sampleRate, sourceLeft, sourceRight, clipSamples );
+
+        mem::free16( sourceRight );
+        mem::free16( sourceLeft );
+
+        if ( stemWritten )
+        {
+            const auto stemData = createSyntheticStemData( stemCouchID, context.m_sampleRate, static_cast<uint32_t>( fs::file_size( stemCacheFile ) ) );
+
+            runner.measureManual( cSuite, "stem.decode_heap_read", 16, static_cast<double>( clipSamples ), "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+            {
+                const auto timeStart = std::chrono::steady_clock::now();
+
+                std::vector< uint8_t > stemFileData( stemData.fileLengthBytes );
+                {
+                    std::basic_ifstream<char> ifs( stemCacheFile, std::ios::in | std::ios::binary );
+                    ifs.read( (char*)stemFileData.data(), stemFileData.size() );
+                    if ( ifs.gcount() != static_cast<std::streamsize>( stemFileData.size() ) )
+                        return std::nullopt;
+                }
+
+                endlesss::live::Stem stem( stemData, context.m_sampleRate );
+                stem.fetch( *context.m_netConfig, stemCachePath, stemFileData );
+
+                const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+                if ( stem.m_state != endlesss::live::Stem::State::Complete )
+                    return std::nullopt;
+
+                return timeTaken;
+            });
+        }
+        else
+        {
+            runner.markFailed( cSuite, "stem.decode_heap_read", "unable to write synthetic stem" );
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // a riff's worth of cached stems loaded the way Riff::fetch does it, timed from the first task going in to the last
+    // stem being decoded - the latency the riff loader thread sees, as it blocks on the whole lot either way.
+    // "shared" runs everything on one executor, as before the I/O executor existed; "split" reads on an I/O executor
+    // and decodes on the compute one. the "busy" variants first queue up a backlog of simulated downloads (tasks that
+    // just sleep, standing in for workers parked on sockets) on whichever executor network work would be using
+    {
+        static constexpr std::size_t cRiffStems              = 8;
+        static constexpr std::size_t cBackgroundDownloads    = 32;
+        static constexpr auto        cBackgroundDownloadTime = std::chrono::milliseconds( 50 );
+
+        struct LoadVariant
+        {
+            std::string_view    m_name;
+            bool                m_splitExecutors;
+            bool                m_backgroundDownloads;
+        };
+        static constexpr std::array< LoadVariant, 4 > cLoadVariants = {{
+            { "riff.stem_load.shared_quiet", false, false },
+            { "riff.stem_load.shared_busy",  false, true  },
+            { "riff.stem_load.split_quiet",  true,  false },
+            { "riff.stem_load.split_busy",   true,  true  },
+        }};
+
+        bool anyEnabled = false;
+        for ( const auto& loadVariant : cLoadVariants )
+            anyEnabled |= runner.isEnabled( cSuite, loadVariant.m_name );
+
+        if ( anyEnabled )
+        {
+            std::vector< endlesss::types::Stem > riffStemData;
+            for ( std::size_t stemI = 0; stemI < cRiffStems; stemI++ )
+            {
+                const std::string stemCouchID   = fmt::format( FMTX( "5e4c400000000000000000000000{:04x}" ), 0xB100 + stemI );
+                const fs::path    stemCacheFile = stemCachePath / stemCouchID;
+
+                generateSyntheticAudio( 0xB1000000 + static_cast<uint32_t>( stemI ), context.m_sampleRate, cBPM, clipLeft, clipRight, clipSamples );
+                if ( !writeSyntheticFLAC( stemCacheFile, context.m_sampleRate, clipLeft, clipRight, clipSamples ) )
+                    break;
+
+                riffStemData.emplace_back( createSyntheticStemData( stemCouchID, context.m_sampleRate, static_cast<uint32_t>( fs::file_size( stemCacheFile ) ) ) );
+            }
+
+            // restore the shared clip for anything that follows
+            generateSyntheticAudio( 0xC0DEC000, context.m_sampleRate, cBPM, clipLeft, clipRight, clipSamples );
+
+            const uint32_t hardwareThreads = std::max( 1U, std::thread::hardware_concurrency() );
+
+            tf::Executor computeExecutor( std::clamp( hardwareThreads, 2U, OURO_THREAD_LIMIT ) );
+            tf::Executor ioExecutor( std::clamp( hardwareThreads, OURO_IO_THREAD_MIN, OURO_IO_THREAD_MAX ) );
+
+            for ( const auto& loadVariant : cLoadVariants )
+            {
+                if ( !runner.isEnabled( cSuite, loadVariant.m_name ) )
+                    continue;
+
+                if ( riffStemData.size() != cRiffStems )
+                {
+                    runner.markFailed( cSuite, loadVariant.m_name, "unable to write synthetic stems" );
+                    continue;
+                }
+
+                tf::Executor& downloadExecutor = loadVariant.m_splitExecutors ? ioExecutor : computeExecutor;
+
+                runner.measureManual( cSuite, loadVariant.m_name, 8, static_cast<double>( cRiffStems ), "stems", [&]() -> std::optional< std::chrono::nanoseconds >
+                {
+                    std::vector< std::unique_ptr< endlesss::live::Stem > > riffStems;
+                    for ( const auto& stemData : riffStemData )
+                        riffStems.emplace_back( std::make_unique< endlesss::live::Stem >( stemData, context.m_sampleRate ) );
+
+                    if ( loadVariant.m_backgroundDownloads )
+                    {
+                        for ( std::size_t downloadI = 0; downloadI < cBackgroundDownloads; downloadI++ )
+                            downloadExecutor.silent_async( [] { std::this_thread::sleep_for( cBackgroundDownloadTime ); } );
+                    }
+
+                    const auto timeStart = std::chrono::steady_clock::now();
+
+                    tf::Taskflow stemLoadFlow;
+                    if ( loadVariant.m_splitExecutors )
+                    {
+                        std::array< std::shared_future<void>, cRiffStems > stemDecodeFutures;
+
+                        for ( std::size_t stemI = 0; stemI < cRiffStems; stemI++ )
+                        {
+                            stemLoadFlow.emplace( [&, stemI]()
+                                {
+                                    if ( riffStems[stemI]->fetchCompressed( *context.m_netConfig, stemCachePath ) )
+                                    {
+                                        stemDecodeFutures[stemI] = computeExecutor.async( [&, stemI]()
+                                            {
+                                                riffStems[stemI]->decodeFetched();
+                                            }).share();
+                                    }
+                                });
+                        }
+                        ioExecutor.run( stemLoadFlow ).wait();
+
+                        for ( const auto& stemDecodeFuture : stemDecodeFutures )
+                        {
+                            if ( stemDecodeFuture.valid() )
+                                stemDecodeFuture.wait();
+                        }
+                    }
+                    else
+                    {
+                        for ( std::size_t stemI = 0; stemI < cRiffStems; stemI++ )
+                        {
+                            stemLoadFlow.emplace( [&, stemI]()
+                                {
+                                    riffStems[stemI]->fetch( *context.m_netConfig, stemCachePath );
+                                });
+                        }
+                        computeExecutor.run( stemLoadFlow ).wait();
+                    }
+
+                    const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+                    // let the backlog drain outside of the timed section so iterations don't stack up on each other
+                    downloadExecutor.wait_for_all();
+
+                    for ( const auto& riffStem : riffStems )
+                    {
+                        if ( riffStem->m_state != endlesss::live::Stem::State::Complete )
+                            return std::nullopt;
+                    }
+
+                    return timeTaken;
+                });
+            }
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // analysis pass on a decoded stem, exactly as run in the background after loading
+    if ( runner.isEnabled( cSuite, "stem.analyse" ) )
+    {
+        const std::string stemCouchID   = "5e4c4000000000000000000000a9a15e";
+        const fs::path    stemCacheFile = stemCachePath / stemCouchID;
+
+        if ( writeSyntheticFLAC( stemCacheFile, context.m_sampleRate, clipLeft, clipRight, clipSamples ) )
+        {
+            const auto stemData = createSyntheticStemData( stemCouchID, context.m_sampleRate, static_cast<uint32_t>( fs::file_size( stemCacheFile ) ) );
+
+            endlesss::live::Stem stem( stemData, context.m_sampleRate );
+            stem.fetch( *context.m_netConfig, stemCachePath );
+
+            if ( stem.m_state == endlesss::live::Stem::State::Complete )
+            {
+                const auto stemProcessing = endlesss::live::Stem::createStemProcessing( context.m_sampleRate );
+
+                runner.measureManual( cSuite, "stem.analyse", 16, static_cast<double>( stem.m_sampleCount ), "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+                {
+                    endlesss::live::StemAnalysisData analysisResult;
+
+                    const auto timeStart = std::chrono::steady_clock::now();
+                    if ( !stem.analyse( *stemProcessing, analysisResult ) )
+                        return std::nullopt;
+
+                    return std::chrono::steady_clock::now() - timeStart;
+                });
+            }
+            else
+            {
+                runner.markFailed( cSuite, "stem.analyse", "synthetic stem failed to decode" );
+            }
+        }
+        else
+        {
+            runner.markFailed( cSuite, "stem.analyse", "unable to write synthetic stem" );
+        }
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // the same analysis split across an executor's workers, as run during riff loading, at a few worker counts to show
+    // how it scales. uses a longer stem, as short ones aren't worth splitting and always take the serial path. before
+    // timing, each configuration's output is checked against the serial result and the case fails if it drifts
+    // further than the documented tolerance
+    {
+        static constexpr uint32_t cLongClipSeconds = 32;
+
+        std::vector< uint32_t > workerCounts = { 1, 2, 4, std::max( 1U, std::thread::hardware_concurrency() ) };
+        std::sort( workerCounts.begin(), workerCounts.end() );
+        workerCounts.erase( std::unique( workerCounts.begin(), workerCounts.end() ), workerCounts.end() );
+
+        const auto benchNameForWorkers = []( const uint32_t workerCount )
+            {
+                return fmt::format( FMTX( "stem.analyse_split.w{}" ), workerCount );
+            };
+
+        bool anyEnabled = false;
+        for ( const auto workerCount : workerCounts )
+            anyEnabled |= runner.isEnabled( cSuite, benchNameForWorkers( workerCount ) );
+
+        if ( anyEnabled )
+        {
+            const std::string stemCouchID   = "5e4c4000000000000000000000a9a1ff";
+            const fs::path    stemCacheFile = stemCachePath / stemCouchID;
+
+            const uint32_t longClipSamples = context.m_sampleRate * cLongClipSeconds;
+            float* longClipLeft  = mem::alloc16<float>( longClipSamples );
+            float* longClipRight = mem::alloc16<float>( longClipSamples );
+            generateSyntheticAudio( 0xA9A1C000, context.m_sampleRate, cBPM, longClipLeft, longClipRight, longClipSamples );
+
+            const bool stemWritten = writeSyntheticFLAC( stemCacheFile, context.m_sampleRate, longClipLeft, longClipRight, longClipSamples );
+
+            mem::free16( longClipRight );
+            mem::free16( longClipLeft );
+
+            std::optional< endlesss::live::Stem > stem;
+            if ( stemWritten )
+            {
+                const auto stemData = createSyntheticStemData( stemCouchID, context.m_sampleRate, static_cast<uint32_t>( fs::file_size( stemCacheFile ) ) );
+
+                stem.emplace( stemData, context.m_sampleRate );
+                stem->fetch( *context.m_netConfig, stemCachePath );
+            }
+
+            const auto stemProcessing = endlesss::live::Stem::createStemProcessing( context.m_sampleRate );
+
+            endlesss::live::StemAnalysisData serialResult;
+            const bool serialAnalysed = stem.has_value() &&
+                                        stem->m_state == endlesss::live::Stem::State::Complete &&
+                                        stem->analyse( *stemProcessing, serialResult );
+
+            for ( const auto workerCount : workerCounts )
+            {
+                const std::string benchName = benchNameForWorkers( workerCount );
+                if ( !runner.isEnabled( cSuite, benchName ) )
+                    continue;
+
+                if ( !serialAnalysed )
+                {
+                    runner.markFailed( cSuite, benchName, "unable to produce serial analysis of synthetic stem" );
+                    continue;
+                }
+
+                tf::Executor analysisExecutor( workerCount );
+
+                const auto analyseSplit = [&]( endlesss::live::StemAnalysisData& result ) -> bool
+                    {
+                        bool analysed = false;
+
+                        tf::Taskflow analysisFlow;
+                        analysisFlow.emplace( [&]( tf::Subflow& subflow )
+                            {
+                                analysed = stem->analyse( *stemProcessing, result, subflow );
+                            });
+                        analysisExecutor.run( analysisFlow ).wait();
+
+                        return analysed;
+                    };
+
+                {
+                    endlesss::live::StemAnalysisData splitResult;
+                    if ( !analyseSplit( splitResult ) )
+                    {
+                        runner.markFailed( cSuite, benchName, "split analysis failed" );
+                        continue;
+                    }
+
+                    std::string toleranceReport;
+                    const bool withinTolerance = analysisWithinTolerance( serialResult, splitResult, workerCount * 2, toleranceReport );
+
+                    blog::instr( FMTX( "[BENCH] {}.{} vs serial : {}" ), cSuite, benchName, toleranceReport );
+
+                    if ( !withinTolerance )
+                    {
+                        runner.markFailed( cSuite, benchName, fmt::format( FMTX( "split analysis outside tolerance; {}" ), toleranceReport ) );
+                        continue;
+                    }
+                }
+
+                runner.measureManual( cSuite, benchName, 8, static_cast<double>( stem->m_sampleCount ), "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+                {
+                    endlesss::live::StemAnalysisData analysisResult;
+
+                    const auto timeStart = std::chrono::steady_clock::now();
+                    if ( !analyseSplit( analysisResult ) )
+                        return std::nullopt;
+
+                    return std::chrono::steady_clock::now() - timeStart;
+                });
+            }
+        }
+    }
+
+    mem::free16( clipRight );
+    mem::free16( clipLeft );
+}
+
+} // namespace bench
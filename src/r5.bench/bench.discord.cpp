@@ -0,0 +1,87 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+#include "discord/discord.voice.pacer.h"
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// discord voice pacer driven into a local stand-in sink; each iteration is one packet, timed as how far its arrival
+// landed from the ideal cadence (so the reported stats are jitter, not work time). runs in real time - about 60ms per
+// iteration - so the default count is kept low
+//
+void runSuiteDiscord( Runner& runner, Context& context )
+{
+    static constexpr std::string_view cSuite = "discord";
+    static constexpr std::string_view cName  = "voice_pacer_jitter";
+
+    if ( !runner.isEnabled( cSuite, cName ) )
+        return;
+
+    using Clock = discord::LocalVoiceSink::Clock;
+
+    static constexpr uint32_t cSyntheticPacketSize = 160;
+    static constexpr uint32_t cPacketsPerBlock     = ssp::OpusStream::cBufferedFrames;
+
+    discord::LocalVoiceSink localSink;
+    discord::VoicePacer voicePacer( localSink );
+
+    // queue up enough blocks to cover the warm-up packet, the measured run and the pre-buffering threshold
+    const uint32_t packetsNeeded = runner.iterations( 48 ) + 1;
+    const uint32_t blocksNeeded  = ( packetsNeeded / cPacketsPerBlock ) + 4;
+    for ( uint32_t block = 0; block < blocksNeeded; block++ )
+    {
+        auto packetBlock = std::make_unique< ssp::OpusPacketData >( cPacketsPerBlock );
+        for ( uint32_t packet = 0; packet < cPacketsPerBlock; packet++ )
+            packetBlock->m_opusPacketSizes.push_back( cSyntheticPacketSize );
+        packetBlock->m_averagePacketSize = cSyntheticPacketSize;
+
+        voicePacer.enqueue( std::move( packetBlock ) );
+    }
+
+    const auto packetInterval = std::chrono::duration_cast< Clock::duration >( std::chrono::duration< double >( ssp::OpusStream::cFrameTimeSec ) );
+
+    std::optional< Clock::time_point > firstArrival;
+    uint32_t packetIndex = 0;
+
+    runner.measureManual( cSuite, cName, 48, 1, "packets", [&]() -> std::optional< std::chrono::nanoseconds >
+    {
+        const auto arrival = localSink.waitForPacket( std::chrono::milliseconds( 1000 ) );
+        if ( !arrival.has_value() )
+            return std::nullopt;
+
+        // warm-up iteration establishes the cadence origin
+        if ( !firstArrival.has_value() )
+        {
+            firstArrival = arrival;
+            return std::chrono::nanoseconds::zero();
+        }
+
+        packetIndex++;
+        const auto idealArrival = firstArrival.value() + ( packetInterval * packetIndex );
+        const auto deviation    = ( arrival.value() > idealArrival ) ? ( arrival.value() - idealArrival ) : ( idealArrival - arrival.value() );
+
+        return std::chrono::duration_cast< std::chrono::nanoseconds >( deviation );
+    });
+
+    const auto telemetry = voicePacer.getTelemetry();
+    blog::instr( FMTX( "[BENCH] {}.{} pacer reports {:.2f}ms mean / {:.2f}ms max jitter, {} underruns, {} resyncs" ),
+        cSuite, cName,
+        telemetry.m_jitterMeanMs,
+        telemetry.m_jitterMaxMs,
+        telemetry.m_underruns,
+        telemetry.m_resyncs );
+}
+
+} // namespace bench
@@ -0,0 +1,127 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+#include "base/utils.h"
+#include "buffer/mix.h"
+#include "math/rng.h"
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+void generateSyntheticAudio( const uint32_t seed, const uint32_t sampleRate, const float bpm, float* left, float* right, const std::size_t sampleCount )
+{
+    math::RNG32 rng( seed );
+
+    const double sampleRateD    = static_cast<double>( sampleRate );
+    const double baseFrequency  = 55.0 * std::pow( 2.0, rng.genInt32( 0, 24 ) / 12.0 );
+    const double detune         = 1.0 + rng.genFloat( 0.001f, 0.004f );
+    const auto   samplesPerBeat = static_cast<std::size_t>( sampleRateD * 60.0 / static_cast<double>( bpm ) );
+    const double transientDecay = std::exp( -1.0 / ( 0.08 * sampleRateD ) );
+
+    double transient = 0;
+    for ( std::size_t sI = 0; sI < sampleCount; sI++ )
+    {
+        if ( sI % samplesPerBeat == 0 )
+            transient = 1.0;
+        else
+            transient *= transientDecay;
+
+        const double t = static_cast<double>( sI ) / sampleRateD;
+
+        const double tone   = 0.25 * std::sin( constants::d_2pi * baseFrequency * t ) +
+                              0.15 * std::sin( constants::d_2pi * baseFrequency * 1.5 * t );
+        const double kick   = 0.5 * transient * std::sin( constants::d_2pi * 50.0 * t );
+        const double noise  = 0.02 * rng.genFloat( -1.0f, 1.0f );
+
+        left[sI]  = static_cast<float>( tone + kick + noise );
+        right[sI] = static_cast<float>( 0.25 * std::sin( constants::d_2pi * baseFrequency * detune * t ) + kick + noise );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// mixer inner kernels, run over one second of audio per iteration in typical audio-callback sized chunks
+//
+void runSuiteDSP( Runner& runner, Context& context )
+{
+    static constexpr std::string_view cSuite = "dsp";
+
+    const uint32_t sampleRate = context.m_sampleRate;
+
+    std::array< float*, 8 > channelLeft;
+    std::array< float*, 8 > channelRight;
+    for ( auto stemI = 0U; stemI < 8; stemI++ )
+    {
+        channelLeft[stemI]  = mem::alloc16<float>( sampleRate );
+        channelRight[stemI] = mem::alloc16<float>( sampleRate );
+
+        generateSyntheticAudio( 0xBE4C0000 + stemI, sampleRate, 120.0f, channelLeft[stemI], channelRight[stemI], sampleRate );
+    }
+    float* outputLeft   = mem::alloc16<float>( sampleRate );
+    float* outputRight  = mem::alloc16<float>( sampleRate );
+    int*   outputInt24  = mem::alloc16<int>( sampleRate * 2 );
+
+    for ( const uint32_t bufferSize : { 256U, 1024U } )
+    {
+        runner.measure( cSuite, fmt::format( FMTX( "downmix_8channel_stereo.{}" ), bufferSize ), 400, sampleRate, "samples", [&]()
+        {
+            for ( uint32_t offset = 0; offset + bufferSize <= sampleRate; offset += bufferSize )
+            {
+                buffer::downmix_8channel_stereo(
+                    0.8f,
+                    static_cast<int>( bufferSize ),
+                    channelLeft[0] + offset,
+                    channelLeft[1] + offset,
+                    channelLeft[2] + offset,
+                    channelLeft[3] + offset,
+                    channelLeft[4] + offset,
+                    channelLeft[5] + offset,
+                    channelLeft[6] + offset,
+                    channelLeft[7] + offset,
+                    channelRight[0] + offset,
+                    channelRight[1] + offset,
+                    channelRight[2] + offset,
+                    channelRight[3] + offset,
+                    channelRight[4] + offset,
+                    channelRight[5] + offset,
+                    channelRight[6] + offset,
+                    channelRight[7] + offset,
+                    outputLeft + offset,
+                    outputRight + offset );
+            }
+        });
+
+        runner.measure( cSuite, fmt::format( FMTX( "interleave_float_to_int24.{}" ), bufferSize ), 400, sampleRate, "samples", [&]()
+        {
+            for ( uint32_t offset = 0; offset + bufferSize <= sampleRate; offset += bufferSize )
+            {
+                buffer::interleave_float_to_int24(
+                    static_cast<int>( bufferSize ),
+                    channelLeft[0] + offset,
+                    channelRight[0] + offset,
+                    outputInt24 + ( offset * 2 ) );
+            }
+        });
+    }
+
+    mem::free16( outputInt24 );
+    mem::free16( outputRight );
+    mem::free16( outputLeft );
+    for ( auto stemI = 0U; stemI < 8; stemI++ )
+    {
+        mem::free16( channelRight[stemI] );
+        mem::free16( channelLeft[stemI] );
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,217 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include <numeric>
+
+#include "bench.harness.h"
+
+#include "base/text.h"
+#include "spacetime/chronicle.h"
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+Runner::Runner( const Options& options )
+    : m_options( options )
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Runner::isEnabled( std::string_view suite, std::string_view name ) const
+{
+    if ( m_options.m_filter.empty() )
+        return true;
+
+    const std::string fullName = fmt::format( FMTX( "{}.{}" ), suite, name );
+    return fullName.find( m_options.m_filter ) != std::string::npos;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+uint32_t Runner::iterations( const uint32_t requested ) const
+{
+    if ( m_options.m_quick )
+        return std::max( 1U, requested / 8 );
+
+    return std::max( 1U, requested );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Runner::measure(
+    std::string_view    suite,
+    std::string_view    name,
+    const uint32_t      iterationCount,
+    const double        unitsPerIteration,
+    std::string_view    unit,
+    const TimedFn&      fn )
+{
+    measureManual( suite, name, iterationCount, unitsPerIteration, unit, [&fn]() -> std::optional< std::chrono::nanoseconds >
+    {
+        const auto timeStart = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::steady_clock::now() - timeStart;
+    });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Runner::measureManual(
+    std::string_view    suite,
+    std::string_view    name,
+    const uint32_t      iterationCount,
+    const double        unitsPerIteration,
+    std::string_view    unit,
+    const ManualFn&     fn )
+{
+    if ( !isEnabled( suite, name ) )
+        return;
+
+    const uint32_t finalIterations = iterations( iterationCount );
+
+    blog::instr( FMTX( "[BENCH] {}.{} x{} ..." ), suite, name, finalIterations );
+
+    // one untimed pass to warm caches, allocators, lazily-prepared statements and so on
+    if ( !fn().has_value() )
+    {
+        markFailed( suite, name, "warm-up iteration failed" );
+        return;
+    }
+
+    std::vector< double > timingsUs;
+    timingsUs.reserve( finalIterations );
+
+    bool iterationFailed = false;
+    for ( uint32_t iteration = 0; iteration < finalIterations; iteration++ )
+    {
+        const auto iterationTime = fn();
+        if ( !iterationTime.has_value() )
+        {
+            iterationFailed = true;
+            break;
+        }
+        timingsUs.emplace_back( std::chrono::duration< double, std::micro >( iterationTime.value() ).count() );
+    }
+
+    commitResult( suite, name, unitsPerIteration, unit, timingsUs, iterationFailed );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Runner::markFailed( std::string_view suite, std::string_view name, std::string_view reason )
+{
+    blog::error::instr( FMTX( "[BENCH] {}.{} failed; {}" ), suite, name, reason );
+
+    std::vector< double > noTimings;
+    commitResult( suite, name, 0, "", noTimings, true );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+bool Runner::anyFailed() const
+{
+    return std::any_of( m_results.begin(), m_results.end(), []( const Result& result ) { return result.m_failed; } );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Runner::commitResult( std::string_view suite, std::string_view name, const double unitsPerIteration, std::string_view unit, std::vector< double >& timingsUs, const bool failed )
+{
+    Result& result = m_results.emplace_back();
+
+    result.m_suite              = suite;
+    result.m_name               = name;
+    result.m_unit               = unit;
+    result.m_unitsPerIteration  = unitsPerIteration;
+    result.m_iterations         = static_cast<uint32_t>( timingsUs.size() );
+    result.m_failed             = failed;
+
+    if ( timingsUs.empty() )
+        return;
+
+    std::sort( timingsUs.begin(), timingsUs.end() );
+
+    const std::size_t count = timingsUs.size();
+
+    result.m_minUs      = timingsUs.front();
+    result.m_maxUs      = timingsUs.back();
+    result.m_medianUs   = ( count % 2 == 1 ) ? timingsUs[count / 2] : ( timingsUs[( count / 2 ) - 1] + timingsUs[count / 2] ) * 0.5;
+    result.m_p95Us      = timingsUs[ std::min( count - 1, static_cast<std::size_t>( std::ceil( 0.95 * static_cast<double>( count ) ) ) - 1 ) ];
+    result.m_meanUs     = std::accumulate( timingsUs.begin(), timingsUs.end(), 0.0 ) / static_cast<double>( count );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void Runner::logSummary() const
+{
+    blog::instr( FMTX( "{:<40} {:>6} {:>12} {:>12} {:>12} {:>16}" ), "benchmark", "iters", "median us", "p95 us", "min us", "throughput" );
+
+    for ( const auto& result : m_results )
+    {
+        const std::string fullName = fmt::format( FMTX( "{}.{}" ), result.m_suite, result.m_name );
+
+        if ( result.m_failed )
+        {
+            blog::error::instr( FMTX( "{:<40} FAILED" ), fullName );
+            continue;
+        }
+
+        blog::instr( FMTX( "{:<40} {:>6} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.4g} {}/s" ),
+            fullName,
+            result.m_iterations,
+            result.m_medianUs,
+            result.m_p95Us,
+            result.m_minUs,
+            result.throughput(),
+            result.m_unit );
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+absl::Status Runner::writeJson( const fs::path& outputFile ) const
+{
+    nlohmann::json resultsArray = nlohmann::json::array();
+    for ( const auto& result : m_results )
+    {
+        resultsArray.push_back(
+        {
+            { "suite",                  result.m_suite },
+            { "name",                   result.m_name },
+            { "failed",                 result.m_failed },
+            { "iterations",             result.m_iterations },
+            { "unit",                   result.m_unit },
+            { "units_per_iteration",    result.m_unitsPerIteration },
+            { "min_us",                 result.m_minUs },
+            { "median_us",              result.m_medianUs },
+            { "mean_us",                result.m_meanUs },
+            { "p95_us",                 result.m_p95Us },
+            { "max_us",                 result.m_maxUs },
+            { "throughput_per_sec",     result.throughput() },
+        });
+    }
+
+    const nlohmann::json document =
+    {
+        { "schema",         "ouroveon.bench/1" },
+        { "timestamp",      spacetime::getUnixTimeNow().count() },
+#if OURO_DEBUG
+        { "build",          "debug" },
+#else
+        { "build",          "release" },
+#endif
+        { "quick",          m_options.m_quick },
+        { "filter",         m_options.m_filter },
+        { "hw_threads",     std::thread::hardware_concurrency() },
+        { "results",        resultsArray },
+    };
+
+    std::ofstream outputStream( outputFile, std::ios::out | std::ios::trunc );
+    if ( !outputStream.is_open() )
+        return absl::UnavailableError( fmt::format( FMTX( "unable to open [{}] for writing" ), outputFile.string() ) );
+
+    outputStream << document.dump( 2 ) << std::endl;
+    return absl::OkStatus();
+}
+
+} // namespace bench
@@ -0,0 +1,100 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  minimal timing harness for the headless benchmark runner; each measurement runs a warm-up pass and then
+//  a fixed number of timed iterations, keeping per-iteration timings so we can report distribution stats
+//  rather than a single (noisy) average. results can be written out as JSON for tracking between builds
+//
+
+#pragma once
+
+#include "base/construction.h"
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct Result
+{
+    std::string     m_suite;
+    std::string     m_name;
+    std::string     m_unit;                 // what one 'unit' of work is, eg. "samples", "queries"
+    double          m_unitsPerIteration = 0;
+
+    uint32_t        m_iterations        = 0;
+    bool            m_failed            = false;
+
+    double          m_minUs             = 0;
+    double          m_medianUs          = 0;
+    double          m_meanUs            = 0;
+    double          m_p95Us             = 0;
+    double          m_maxUs             = 0;
+
+    // units of work per second, based on the median iteration time
+    ouro_nodiscard double throughput() const
+    {
+        if ( m_medianUs <= 0 )
+            return 0;
+        return m_unitsPerIteration / ( m_medianUs * 1e-6 );
+    }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+struct Runner
+{
+    DECLARE_NO_COPY_NO_MOVE( Runner );
+
+    struct Options
+    {
+        std::string     m_filter;           // only run benchmarks with "suite.name" containing this, if not empty
+        bool            m_quick = false;    // scale down iteration counts, for smoke-testing the runner itself
+    };
+
+    using TimedFn   = std::function< void() >;
+    // for benchmarks that need per-iteration setup / teardown outside of the timed region; the function
+    // returns the duration of the part that should count, or std::nullopt if the iteration failed
+    using ManualFn  = std::function< std::optional< std::chrono::nanoseconds >() >;
+
+    Runner( const Options& options );
+
+    ouro_nodiscard bool isEnabled( std::string_view suite, std::string_view name ) const;
+
+    // adjusted iteration count, respecting Options::m_quick
+    ouro_nodiscard uint32_t iterations( const uint32_t requested ) const;
+
+    void measure(
+        std::string_view    suite,
+        std::string_view    name,
+        const uint32_t      iterationCount,
+        const double        unitsPerIteration,
+        std::string_view    unit,
+        const TimedFn&      fn );
+
+    void measureManual(
+        std::string_view    suite,
+        std::string_view    name,
+        const uint32_t      iterationCount,
+        const double        unitsPerIteration,
+        std::string_view    unit,
+        const ManualFn&     fn );
+
+    // record a benchmark that could not be run at all, so it still shows up in the output
+    void markFailed( std::string_view suite, std::string_view name, std::string_view reason );
+
+    ouro_nodiscard const std::vector< Result >& getResults() const { return m_results; }
+    ouro_nodiscard bool anyFailed() const;
+
+    void logSummary() const;
+    ouro_nodiscard absl::Status writeJson( const fs::path& outputFile ) const;
+
+private:
+
+    void commitResult( std::string_view suite, std::string_view name, const double unitsPerIteration, std::string_view unit, std::vector< double >& timingsUs, const bool failed );
+
+    Options                 m_options;
+    std::vector< Result >   m_results;
+};
+
+} // namespace bench
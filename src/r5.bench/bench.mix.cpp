@@ -0,0 +1,302 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+#include "base/utils.h"
+
+#include "app/module.audio.h"
+
+#include "endlesss/live.riff.h"
+#include "endlesss/live.stem.h"
+
+#include "mix/engine.h"
+#include "mix/preview.h"
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// put a playable riff together from stems already decoded out of the synthetic cache, filling in the same timing and
+// per-stem details that Riff::fetch() would derive; every stem shares the riff's tempo and length, so nothing stretches
+//
+static endlesss::live::RiffPtr createSyntheticRiff(
+    const std::string&                                  riffCouchID,
+    const std::array< endlesss::live::StemPtr, 8 >&     riffStems,
+    const uint32_t                                      sampleRate,
+    const float                                         bpm,
+    const int32_t                                       barCount )
+{
+    endlesss::types::RiffComplete riffData;
+    riffData.jam.couchID        = endlesss::types::JamCouchID( "benchjam" );
+    riffData.jam.displayName    = "bench";
+    riffData.riff.couchID       = endlesss::types::RiffCouchID( riffCouchID );
+    riffData.riff.jamCouchID    = riffData.jam.couchID;
+    riffData.riff.BPS           = bpm / 60.0f;
+    riffData.riff.BPMrnd        = bpm;
+    riffData.riff.barLength     = 16.0f;
+
+    for ( std::size_t stemI = 0; stemI < 8; stemI++ )
+    {
+        riffData.riff.stemsOn[stemI]    = true;
+        riffData.riff.stems[stemI]      = riffStems[stemI]->m_data.couchID;
+        riffData.riff.gains[stemI]      = 0.8f;
+        riffData.stems[stemI]           = riffStems[stemI]->m_data;
+    }
+
+    auto riff = std::make_shared< endlesss::live::Riff >( riffData );
+
+    auto& timingDetails = riff->m_timingDetails;
+    timingDetails.m_rcpSampleRate           = 1.0 / static_cast<double>( sampleRate );
+    timingDetails.m_quarterBeats            = 4;
+    timingDetails.m_bps                     = riffData.riff.BPS;
+    timingDetails.m_bpm                     = bpm;
+    timingDetails.m_lengthInSecPerBar       = ( 1.0 / timingDetails.m_bps ) * static_cast<double>( timingDetails.m_quarterBeats );
+    timingDetails.m_lengthInSec             = timingDetails.m_lengthInSecPerBar * static_cast<double>( barCount );
+    timingDetails.m_barCount                = barCount;
+    timingDetails.m_lengthInSamples         = static_cast<uint32_t>( riffStems[0]->m_sampleCount );
+    timingDetails.m_lengthInSamplesPerBar   = timingDetails.m_lengthInSamples / static_cast<uint32_t>( barCount );
+    timingDetails.m_longestStemInBars       = barCount;
+
+    riff->m_stemSampleRate = sampleRate;
+    for ( std::size_t stemI = 0; stemI < 8; stemI++ )
+    {
+        riff->m_stemOwnership[stemI]        = riffStems[stemI];
+        riff->m_stemPtrs[stemI]             = riffStems[stemI].get();
+        riff->m_stemGains[stemI]            = riffData.riff.gains[stemI];
+        riff->m_stemTimeScales[stemI]       = 1.0f;
+        riff->m_stemLengthInSec[stemI]      = static_cast<float>( timingDetails.m_lengthInSec );
+        riff->m_stemLengthInSamples[stemI]  = static_cast<uint32_t>( riffStems[stemI]->m_sampleCount );
+        riff->m_stemRepetitions[stemI]      = 1;
+    }
+
+    riff->m_syncState = endlesss::live::Riff::SyncState::Success;
+    return riff;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// the two mixers, driven exactly as the audio module does - one update() per output buffer - across one second of
+// audio per iteration. BEAM's MixEngine is timed playing a single riff and then blending between two; the LORE
+// Preview mixer is timed in steady playback, where update() is renderCurrentRiff() plus the final downmix
+// (renderCurrentRiff itself is a protected member of a final class, so it is reached through update)
+//
+void runSuiteMix( Runner& runner, Context& context )
+{
+    static constexpr std::string_view cSuite = "mix";
+
+    static constexpr float      cBPM            = 120.0f;
+    static constexpr int32_t    cBarCount       = 4;
+    static constexpr uint32_t   cClipSeconds    = 8;            // 4 bars at 120bpm, as the codec suite uses
+    static constexpr uint32_t   cBufferSizes[]  = { 256, 1024 };
+
+    bool anyEnabled = false;
+    for ( const uint32_t bufferSize : cBufferSizes )
+    {
+        anyEnabled |= runner.isEnabled( cSuite, fmt::format( FMTX( "engine.update.{}" ), bufferSize ) );
+        anyEnabled |= runner.isEnabled( cSuite, fmt::format( FMTX( "engine.blend.{}" ), bufferSize ) );
+        anyEnabled |= runner.isEnabled( cSuite, fmt::format( FMTX( "preview.update.{}" ), bufferSize ) );
+    }
+    if ( !anyEnabled )
+        return;
+
+    const uint32_t sampleRate = context.m_sampleRate;
+
+    const fs::path stemCachePath = context.m_workspace / "mix.stems";
+    if ( !filesys::ensureDirectoryExists( stemCachePath ).ok() )
+    {
+        runner.markFailed( cSuite, "*", "unable to create stem cache directory" );
+        return;
+    }
+
+    // two riffs' worth of stems, decoded and analysed as they would be after a riff load
+    std::array< std::array< endlesss::live::StemPtr, 8 >, 2 > riffStems;
+    {
+        const uint32_t clipSamples = sampleRate * cClipSeconds;
+
+        float* clipLeft  = mem::alloc16<float>( clipSamples );
+        float* clipRight = mem::alloc16<float>( clipSamples );
+
+        const auto stemProcessing = endlesss::live::Stem::createStemProcessing( sampleRate );
+
+        bool stemsReady = true;
+        for ( std::size_t riffI = 0; riffI < riffStems.size() && stemsReady; riffI++ )
+        {
+            for ( std::size_t stemI = 0; stemI < 8 && stemsReady; stemI++ )
+            {
+                const auto        stemSeed      = static_cast<uint32_t>( 0x313C0000 + ( riffI * 8 ) + stemI );
+                const std::string stemCouchID   = fmt::format( FMTX( "313c40000000000000000000{:08x}" ), stemSeed );
+                const fs::path    stemCacheFile = stemCachePath / stemCouchID;
+
+                generateSyntheticAudio( stemSeed, sampleRate, cBPM, clipLeft, clipRight, clipSamples );
+                if ( !writeSyntheticFLAC( stemCacheFile, sampleRate, clipLeft, clipRight, clipSamples ) )
+                {
+                    stemsReady = false;
+                    break;
+                }
+
+                const auto stemData = createSyntheticStemData( stemCouchID, sampleRate, static_cast<uint32_t>( fs::file_size( stemCacheFile ) ) );
+
+                auto stem = std::make_shared< endlesss::live::Stem >( stemData, sampleRate );
+                stem->fetch( *context.m_netConfig, stemCachePath );
+
+                stemsReady = ( stem->m_state == endlesss::live::Stem::State::Complete ) && stem->analyse( *stemProcessing );
+
+                riffStems[riffI][stemI] = std::move( stem );
+            }
+        }
+
+        mem::free16( clipRight );
+        mem::free16( clipLeft );
+
+        if ( !stemsReady )
+        {
+            runner.markFailed( cSuite, "*", "unable to create synthetic stems" );
+            return;
+        }
+    }
+
+    std::array< endlesss::live::RiffPtr, 2 > riffs;
+    for ( std::size_t riffI = 0; riffI < riffs.size(); riffI++ )
+        riffs[riffI] = createSyntheticRiff( fmt::format( FMTX( "313c4000000000000000000000f1ff{:02x}" ), riffI ), riffStems[riffI], sampleRate, cBPM, cBarCount );
+
+    const int32_t maxBufferSize = static_cast<int32_t>( *std::max_element( std::begin( cBufferSizes ), std::end( cBufferSizes ) ) );
+
+    app::module::Audio::OutputBuffer outputBuffer( maxBufferSize );
+    app::module::Audio::OutputSignal outputSignal;
+
+    base::EventBusClient eventBusClient( context.m_eventBus );
+
+    // mixers post stem data and riff-change events as they go; clear them out between iterations, as the app's main
+    // thread would, so the bus queues never fill
+    const auto dispatchMixerEvents = [&]()
+        {
+            context.m_eventBus->mainThreadDispatch();
+        };
+
+    for ( const uint32_t bufferSize : cBufferSizes )
+    {
+        // -------------------------------------------------------------------------------------------------------------
+        {
+            const std::string benchName = fmt::format( FMTX( "engine.update.{}" ), bufferSize );
+            if ( runner.isEnabled( cSuite, benchName ) )
+            {
+                mix::MixEngine mixEngine( maxBufferSize, static_cast<int32_t>( sampleRate ), std::chrono::microseconds( 0 ), eventBusClient );
+                mixEngine.addNextRiff( riffs[0] );
+
+                uint64_t samplePosition = 0;
+
+                runner.measureManual( cSuite, benchName, 100, sampleRate, "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+                {
+                    const auto timeStart = std::chrono::steady_clock::now();
+
+                    for ( uint32_t offset = 0; offset + bufferSize <= sampleRate; offset += bufferSize )
+                    {
+                        mixEngine.update( outputBuffer, outputSignal, bufferSize, samplePosition );
+                        samplePosition += bufferSize;
+                    }
+
+                    const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+                    dispatchMixerEvents();
+
+                    if ( mixEngine.m_riffCurrent.m_riffPtr != riffs[0] )
+                        return std::nullopt;
+
+                    return timeTaken;
+                });
+            }
+        }
+
+        // -------------------------------------------------------------------------------------------------------------
+        // as above, but a new riff is queued at the start of every iteration and blended in over one bar, so each
+        // iteration spends its first half mixing two riffs and the remainder playing the new one
+        {
+            const std::string benchName = fmt::format( FMTX( "engine.blend.{}" ), bufferSize );
+            if ( runner.isEnabled( cSuite, benchName ) )
+            {
+                mix::MixEngine::ProgressionConfiguration blendConfiguration;
+                blendConfiguration.m_triggerPoint   = mix::MixEngine::ProgressionConfiguration::TriggerPoint::Arbitrary;
+                blendConfiguration.m_blendTime      = mix::MixEngine::ProgressionConfiguration::BlendTime::OneBar;
+
+                mix::MixEngine mixEngine( maxBufferSize, static_cast<int32_t>( sampleRate ), std::chrono::microseconds( 0 ), eventBusClient );
+                mixEngine.updateProgressionConfiguration( &blendConfiguration );
+                mixEngine.addNextRiff( riffs[0] );
+
+                // pump the configuration change and first riff through before anything is timed
+                uint64_t samplePosition = 0;
+                mixEngine.update( outputBuffer, outputSignal, bufferSize, samplePosition );
+                samplePosition += bufferSize;
+
+                std::size_t nextRiff = 1;
+
+                // two bars of audio per iteration; the one-bar blend has always finished before the next riff is queued
+                const auto samplesPerIteration = riffs[0]->m_timingDetails.m_lengthInSamplesPerBar * 2;
+
+                runner.measureManual( cSuite, benchName, 50, samplesPerIteration, "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+                {
+                    mixEngine.addNextRiff( riffs[nextRiff] );
+
+                    const auto timeStart = std::chrono::steady_clock::now();
+
+                    for ( uint32_t offset = 0; offset + bufferSize <= samplesPerIteration; offset += bufferSize )
+                    {
+                        mixEngine.update( outputBuffer, outputSignal, bufferSize, samplePosition );
+                        samplePosition += bufferSize;
+                    }
+
+                    const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+                    dispatchMixerEvents();
+
+                    // the queued riff should have been blended all the way in
+                    if ( mixEngine.m_riffCurrent.m_riffPtr != riffs[nextRiff] )
+                        return std::nullopt;
+
+                    nextRiff ^= 1;
+                    return timeTaken;
+                });
+            }
+        }
+
+        // -------------------------------------------------------------------------------------------------------------
+        {
+            const std::string benchName = fmt::format( FMTX( "preview.update.{}" ), bufferSize );
+            if ( runner.isEnabled( cSuite, benchName ) )
+            {
+                mix::Preview previewMixer( maxBufferSize, static_cast<int32_t>( sampleRate ), std::chrono::microseconds( 0 ), eventBusClient );
+                previewMixer.enqueueRiff( riffs[0] );
+
+                uint64_t samplePosition = 0;
+
+                runner.measureManual( cSuite, benchName, 100, sampleRate, "samples", [&]() -> std::optional< std::chrono::nanoseconds >
+                {
+                    const auto timeStart = std::chrono::steady_clock::now();
+
+                    for ( uint32_t offset = 0; offset + bufferSize <= sampleRate; offset += bufferSize )
+                    {
+                        previewMixer.update( outputBuffer, outputSignal, bufferSize, samplePosition );
+                        samplePosition += bufferSize;
+                    }
+
+                    const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+                    dispatchMixerEvents();
+
+                    return timeTaken;
+                });
+            }
+        }
+    }
+
+    dispatchMixerEvents();
+}
+
+} // namespace bench
@@ -0,0 +1,460 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+#include "endlesss/live.stem.h"
+#include "endlesss/toolkit.shares.h"
+
+namespace bench {
+
+static constexpr std::string_view cSuite = "net";
+
+static constexpr std::array< std::string_view, 2 > cSharesBenchNames = { "shares.incremental_sync", "shares.full_reconcile" };
+static constexpr std::string_view cStemResumeBenchName = "stem.resume_download";
+
+// ---------------------------------------------------------------------------------------------------------------------
+// a plain-http server on a spare localhost port, standing in for the Endlesss endpoints; the suite points the shared
+// NetConfiguration at it with setStubOrigin() so the real request / parse / retry code runs without any outside traffic
+//
+struct LocalStubServer
+{
+    DECLARE_NO_COPY_NO_MOVE( LocalStubServer );
+
+    LocalStubServer() = default;
+
+    ~LocalStubServer()
+    {
+        if ( m_listenThread.joinable() )
+        {
+            m_server.stop();
+            m_listenThread.join();
+        }
+    }
+
+    // bind and start serving; handlers must be registered on m_server beforehand
+    bool start()
+    {
+        m_port = m_server.bind_to_any_port( "127.0.0.1" );
+        if ( m_port <= 0 )
+            return false;
+
+        m_listenThread = std::thread( [this]() { m_server.listen_after_bind(); } );
+        m_server.wait_until_ready();
+        return true;
+    }
+
+    ouro_nodiscard std::string origin() const { return fmt::format( FMTX( "http://127.0.0.1:{}" ), m_port ); }
+
+    httplib::Server     m_server;
+    std::thread         m_listenThread;
+    int32_t             m_port = 0;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// shared_by feed for a single user, paged newest-first as the real API does; just enough of each share for the parser
+//
+struct StubSharesFeed
+{
+    void addShare()
+    {
+        std::scoped_lock<std::mutex> feedLock( m_mutex );
+        m_shareIndices.push_back( m_nextShareIndex++ );
+    }
+
+    void removeShare( const std::size_t position )
+    {
+        std::scoped_lock<std::mutex> feedLock( m_mutex );
+        m_shareIndices.erase( m_shareIndices.begin() + position );
+    }
+
+    ouro_nodiscard std::size_t size() const
+    {
+        std::scoped_lock<std::mutex> feedLock( m_mutex );
+        return m_shareIndices.size();
+    }
+
+    ouro_nodiscard static std::string shareID( const uint32_t shareIndex ) { return fmt::format( FMTX( "5a4e{:028x}" ), shareIndex ); }
+
+    ouro_nodiscard std::string shareIDAt( const std::size_t position ) const
+    {
+        std::scoped_lock<std::mutex> feedLock( m_mutex );
+        return shareID( m_shareIndices[position] );
+    }
+
+    void install( httplib::Server& server )
+    {
+        server.Get( R"(/api/v3/feed/shared_by/([^/]+))", [this]( const httplib::Request& req, httplib::Response& res )
+            {
+                m_requestCount++;
+
+                const std::size_t pageSize   = std::strtoull( req.get_param_value( "size" ).c_str(), nullptr, 10 );
+                const std::size_t pageOffset = std::strtoull( req.get_param_value( "from" ).c_str(), nullptr, 10 );
+
+                std::string body = "{\"data\":[";
+                {
+                    std::scoped_lock<std::mutex> feedLock( m_mutex );
+
+                    for ( std::size_t entry = 0; entry < pageSize; entry++ )
+                    {
+                        const std::size_t newestFirst = pageOffset + entry;
+                        if ( newestFirst >= m_shareIndices.size() )
+                            break;
+
+                        const uint32_t shareIndex = m_shareIndices[m_shareIndices.size() - 1 - newestFirst];
+                        const std::string riffID = fmt::format( FMTX( "7269{:028x}" ), shareIndex );
+
+                        if ( entry > 0 )
+                            body += ",";
+
+                        body += fmt::format( FMTX(
+                            R"({{"_id":"{}","doc_id":"{}","band":"band0bench","action_timestamp":{},"title":"shared riff {}",)"
+                            R"("rifff":{{"_id":"{}","state":{{"bps":2.0,"barLength":96000,"playback":[]}},"userName":"{}","created":0,"root":0,"scale":0}},)"
+                            R"("loops":[],"image":false}})" ),
+                            shareID( shareIndex ),
+                            riffID,
+                            ( 1700000000ULL + shareIndex ) * 1000,
+                            shareIndex,
+                            riffID,
+                            req.matches[1].str() );
+                    }
+                }
+                body += "]}";
+
+                res.set_content( body, "application/json" );
+            });
+    }
+
+    mutable std::mutex          m_mutex;
+    std::vector< uint32_t >     m_shareIndices;     // oldest-first
+    uint32_t                    m_nextShareIndex = 0;
+
+    std::atomic_uint32_t        m_requestCount = 0;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// shared riff sync against the stub feed; an incremental sync after one new share should cost a single request, and
+// a share removed on the server must be gone from the cache once the periodic full pass runs
+//
+static void runSharesSync( Runner& runner, Context& context, const std::string& stubOrigin, StubSharesFeed& sharesFeed )
+{
+    static constexpr std::string_view cUsername = "benchuser";
+
+    using Shares = endlesss::toolkit::Shares;
+
+    const auto& benchNames = cSharesBenchNames;
+
+    bool anyEnabled = false;
+    for ( const auto& benchName : benchNames )
+        anyEnabled |= runner.isEnabled( cSuite, benchName );
+    if ( !anyEnabled )
+        return;
+
+    Shares sharesTool;
+    tf::Executor syncExecutor( 1 );
+
+    const auto runSync = [&]( Shares::SharedData existingData ) -> Shares::StatusOrData
+        {
+            Shares::StatusOrData syncResult = absl::UnknownError( "sync did not complete" );
+
+            tf::Taskflow syncFlow = sharesTool.taskFetchLatest(
+                *context.m_netConfig,
+                std::string( cUsername ),
+                std::move( existingData ),
+                [&syncResult]( Shares::StatusOrData result ) { syncResult = std::move( result ); } );
+
+            syncExecutor.run( syncFlow ).wait();
+
+            // the net layer posts activity events for every request
+            context.m_eventBus->mainThreadDispatch();
+
+            return syncResult;
+        };
+
+    const auto containsShare = []( const config::endlesss::SharedRiffsCache& data, const std::string& sharedRiffID )
+        {
+            return std::find( data.m_sharedRiffIDs.begin(), data.m_sharedRiffIDs.end(), config::endlesss::SharedRiffsCache::SharedRiffID{ sharedRiffID } ) != data.m_sharedRiffIDs.end();
+        };
+
+    for ( uint32_t share = 0; share < 40; share++ )
+        sharesFeed.addShare();
+
+    auto initialSync = runSync( nullptr );
+    if ( !initialSync.ok() || initialSync.value()->m_count != sharesFeed.size() )
+    {
+        for ( const auto& benchName : benchNames )
+            runner.markFailed( cSuite, benchName, fmt::format( FMTX( "initial full sync from {} failed" ), stubOrigin ) );
+        return;
+    }
+
+    Shares::SharedData currentData = initialSync.value();
+
+    if ( runner.isEnabled( cSuite, benchNames[0] ) )
+    {
+        runner.measureManual( cSuite, benchNames[0], runner.iterations( 32 ), 1, "syncs", [&]() -> std::optional< std::chrono::nanoseconds >
+            {
+                sharesFeed.addShare();
+                sharesFeed.m_requestCount = 0;
+
+                const auto timeStart = std::chrono::steady_clock::now();
+                auto syncResult = runSync( currentData );
+                const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+                if ( !syncResult.ok() )
+                    return std::nullopt;
+
+                // one new share sits at the top of the first page, followed by one we know; nothing else should be asked for
+                const bool bSyncedCorrectly = ( syncResult.value()->m_count == sharesFeed.size() &&
+                                                sharesFeed.m_requestCount == 1 );
+                currentData = syncResult.value();
+
+                if ( !bSyncedCorrectly )
+                    return std::nullopt;
+
+                return timeTaken;
+            });
+    }
+
+    if ( runner.isEnabled( cSuite, benchNames[1] ) )
+    {
+        runner.measureManual( cSuite, benchNames[1], runner.iterations( 4 ), 1, "syncs", [&]() -> std::optional< std::chrono::nanoseconds >
+            {
+                // take one out of the middle of the feed; an incremental pass can't see that
+                const std::string removedShareID = sharesFeed.shareIDAt( sharesFeed.size() / 2 );
+                sharesFeed.removeShare( sharesFeed.size() / 2 );
+
+                auto incrementalResult = runSync( currentData );
+                if ( !incrementalResult.ok() || !containsShare( *incrementalResult.value(), removedShareID ) )
+                    return std::nullopt;
+
+                // age the last full sync past the interval so the next one reconciles against the whole feed
+                auto agedData = std::make_shared< config::endlesss::SharedRiffsCache >( *incrementalResult.value() );
+                agedData->m_lastFullSyncTime -= std::min( agedData->m_lastFullSyncTime, Shares::cFullSyncIntervalSeconds );
+
+                const auto timeStart = std::chrono::steady_clock::now();
+                auto reconcileResult = runSync( agedData );
+                const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+                if ( !reconcileResult.ok() )
+                    return std::nullopt;
+
+                currentData = reconcileResult.value();
+
+                if ( containsShare( *currentData, removedShareID ) ||
+                     currentData->m_count != sharesFeed.size() )
+                    return std::nullopt;
+
+                return timeTaken;
+            });
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// a CDN holding one stem that can be told to misbehave; until m_honourRequests is set, a full request has its body cut
+// off part way through (the connection drops after m_truncateAt bytes) and any ranged retry gets a 503
+//
+struct StubStemCDN
+{
+    static constexpr auto cFileKey = "attachments/oggAudio/benchstem";
+
+    void install( httplib::Server& server )
+    {
+        server.Get( fmt::format( FMTX( "/{}" ), cFileKey ), [this]( const httplib::Request& req, httplib::Response& res )
+            {
+                {
+                    std::scoped_lock<std::mutex> cdnLock( m_mutex );
+                    m_requestedRanges.emplace_back( req.get_header_value( "Range" ) );
+                }
+
+                if ( !m_honourRequests )
+                {
+                    if ( req.has_header( "Range" ) )
+                    {
+                        res.status = 503;
+                        return;
+                    }
+
+                    // claim the full length but stop short; returning false drops the connection mid-body
+                    res.set_content_provider( m_stemBytes.size(), "audio/flac", [this]( std::size_t offset, std::size_t length, httplib::DataSink& sink )
+                        {
+                            const std::size_t sendEnd = std::min( offset + length, m_truncateAt );
+                            if ( offset < sendEnd )
+                            {
+                                sink.write( reinterpret_cast<const char*>( m_stemBytes.data() + offset ), sendEnd - offset );
+                                m_bytesServed += sendEnd - offset;
+                            }
+                            return false;
+                        });
+                    return;
+                }
+
+                // httplib answers a Range request against a sized provider with a 206 and the matching Content-Range
+                res.set_content_provider( m_stemBytes.size(), "audio/flac", [this]( std::size_t offset, std::size_t length, httplib::DataSink& sink )
+                    {
+                        sink.write( reinterpret_cast<const char*>( m_stemBytes.data() + offset ), length );
+                        m_bytesServed += length;
+                        return true;
+                    });
+            });
+    }
+
+    void reset( const bool honourRequests )
+    {
+        std::scoped_lock<std::mutex> cdnLock( m_mutex );
+        m_requestedRanges.clear();
+        m_bytesServed       = 0;
+        m_honourRequests    = honourRequests;
+    }
+
+    ouro_nodiscard std::vector< std::string > requestedRanges() const
+    {
+        std::scoped_lock<std::mutex> cdnLock( m_mutex );
+        return m_requestedRanges;
+    }
+
+    std::vector< uint8_t >      m_stemBytes;
+    std::size_t                 m_truncateAt = 0;
+
+    mutable std::mutex          m_mutex;
+    std::vector< std::string >  m_requestedRanges;      // Range header of each request, empty if there wasn't one
+    std::atomic_bool            m_honourRequests = false;
+    std::atomic_size_t          m_bytesServed = 0;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// interrupted stem download; the first downloadToCache() runs out of retries with part of the stem and must leave it
+// in the .resume stash, the second must pick that up, ask for only the remainder and produce a byte-identical stem
+//
+static void runStemResume( Runner& runner, Context& context, StubStemCDN& stemCDN )
+{
+    if ( !runner.isEnabled( cSuite, cStemResumeBenchName ) )
+        return;
+
+    using Stem = endlesss::live::Stem;
+
+    const fs::path stemCachePath = context.m_workspace / "net.stem.cache";
+
+    auto stemData = createSyntheticStemData( "5e4c4000be0c4e5e0000000000000001", context.m_sampleRate, static_cast<uint32_t>( stemCDN.m_stemBytes.size() ) );
+    stemData.fileEndpoint   = "stub.cdn";
+    stemData.fileKey        = StubStemCDN::cFileKey;
+
+    const fs::path stemCacheFile = stemCachePath / stemData.couchID.value();
+    fs::path stemResumeFile = stemCacheFile;
+    stemResumeFile += ".resume";
+
+    const auto fileMatchesStem = [&]( const fs::path& filePath, const std::size_t expectedBytes )
+        {
+            std::error_code sizeError;
+            if ( fs::file_size( filePath, sizeError ) != expectedBytes || sizeError )
+                return false;
+
+            std::vector< uint8_t > fileBytes( expectedBytes );
+            std::basic_ifstream<char> ifs( filePath, std::ios::in | std::ios::binary );
+            ifs.read( reinterpret_cast<char*>( fileBytes.data() ), expectedBytes );
+
+            return ifs.gcount() == static_cast<std::streamsize>( expectedBytes ) &&
+                   std::equal( fileBytes.begin(), fileBytes.end(), stemCDN.m_stemBytes.begin() );
+        };
+
+    runner.measureManual( cSuite, cStemResumeBenchName, runner.iterations( 2 ), static_cast<double>( stemCDN.m_stemBytes.size() - stemCDN.m_truncateAt ), "bytes", [&]() -> std::optional< std::chrono::nanoseconds >
+        {
+            std::error_code removeError;
+            fs::remove( stemCacheFile, removeError );
+            fs::remove( stemResumeFile, removeError );
+
+            uint32_t httpStatus = 0;
+
+            // every attempt fails; what did arrive should be stashed
+            stemCDN.reset( false );
+            const Stem::State interruptedState = Stem::downloadToCache( *context.m_netConfig, stemData, stemCachePath, httpStatus );
+            context.m_eventBus->mainThreadDispatch();
+
+            if ( interruptedState == Stem::State::Complete ||
+                 fs::exists( stemCacheFile ) ||
+                 !fileMatchesStem( stemResumeFile, stemCDN.m_truncateAt ) )
+                return std::nullopt;
+
+            stemCDN.reset( true );
+
+            const auto timeStart = std::chrono::steady_clock::now();
+            const Stem::State resumedState = Stem::downloadToCache( *context.m_netConfig, stemData, stemCachePath, httpStatus );
+            const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+            context.m_eventBus->mainThreadDispatch();
+
+            // one ranged request picking up exactly where the stash ends, and nothing sent twice
+            const auto requestedRanges = stemCDN.requestedRanges();
+            const bool bResumedFromStash = ( requestedRanges.size() == 1 &&
+                                             requestedRanges.front() == fmt::format( FMTX( "bytes={}-" ), stemCDN.m_truncateAt ) &&
+                                             stemCDN.m_bytesServed == stemCDN.m_stemBytes.size() - stemCDN.m_truncateAt );
+
+            if ( resumedState != Stem::State::Complete ||
+                 !bResumedFromStash ||
+                 fs::exists( stemResumeFile ) ||
+                 !fileMatchesStem( stemCacheFile, stemCDN.m_stemBytes.size() ) )
+                return std::nullopt;
+
+            return timeTaken;
+        });
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// network code run end-to-end against a local stub server rather than the real Endlesss backend
+//
+void runSuiteNet( Runner& runner, Context& context )
+{
+    std::vector< std::string_view > benchNames;
+    for ( const auto& benchName : cSharesBenchNames )
+    {
+        if ( runner.isEnabled( cSuite, benchName ) )
+            benchNames.emplace_back( benchName );
+    }
+    if ( runner.isEnabled( cSuite, cStemResumeBenchName ) )
+        benchNames.emplace_back( cStemResumeBenchName );
+    if ( benchNames.empty() )
+        return;
+
+    StubSharesFeed sharesFeed;
+
+    // a couple of hundred kb of stand-in stem; only the container magic is ever checked on download
+    StubStemCDN stemCDN;
+    stemCDN.m_stemBytes.resize( 256 * 1024 );
+    {
+        uint32_t lcg = 0x5E4C4000;
+        for ( auto& stemByte : stemCDN.m_stemBytes )
+        {
+            lcg = lcg * 1664525 + 1013904223;
+            stemByte = static_cast<uint8_t>( lcg >> 24 );
+        }
+        std::memcpy( stemCDN.m_stemBytes.data(), "fLaC", 4 );
+    }
+    stemCDN.m_truncateAt = stemCDN.m_stemBytes.size() * 2 / 5;
+
+    LocalStubServer stubServer;
+    sharesFeed.install( stubServer.m_server );
+    stemCDN.install( stubServer.m_server );
+
+    if ( !stubServer.start() )
+    {
+        for ( const auto& benchName : benchNames )
+            runner.markFailed( cSuite, benchName, "unable to bind a localhost port for the stub server" );
+        return;
+    }
+
+    context.m_netConfig->setStubOrigin( stubServer.origin() );
+    absl::Cleanup clearStubOrigin = [&]() noexcept { context.m_netConfig->setStubOrigin( {} ); };
+
+    runSharesSync( runner, context, stubServer.origin(), sharesFeed );
+    runStemResume( runner, context, stemCDN );
+}
+
+} // namespace bench
@@ -0,0 +1,50 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#pragma once
+
+#include "base/eventbus.h"
+#include "endlesss/api.h"
+
+namespace bench {
+
+struct Runner;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// shared state handed to each suite; everything is generated into a scratch workspace, nothing touches the
+// user's real cache or warehouse
+struct Context
+{
+    fs::path                                    m_workspace;        // scratch root, removed on exit unless asked otherwise
+    base::EventBusPtr                           m_eventBus;
+    endlesss::api::NetConfiguration::Shared     m_netConfig;        // public-access only; the net suite points it at a localhost stub
+
+    uint32_t                                    m_sampleRate = 48000;
+};
+
+// fill a pair of channels with a deterministic, vaguely musical test signal; a few detuned tones, some noise and
+// a decaying transient on every beat so that analysis passes have something to find
+void generateSyntheticAudio( const uint32_t seed, const uint32_t sampleRate, const float bpm, float* left, float* right, const std::size_t sampleCount );
+
+// encode a synthetic clip to FLAC on disk, blocking until the file is complete
+bool writeSyntheticFLAC( const fs::path& outputFile, const uint32_t sampleRate, float* left, float* right, const uint32_t sampleCount );
+
+// stem metadata for a synthetic FLAC written into a fake stem cache under the given ID, so Stem::fetch() picks it up
+endlesss::types::Stem createSyntheticStemData( const std::string& stemCouchID, const uint32_t sampleRate, const uint32_t fileLength );
+
+void runSuiteDSP( Runner& runner, Context& context );
+void runSuiteCodec( Runner& runner, Context& context );
+void runSuiteWarehouse( Runner& runner, Context& context );
+void runSuiteDiscord( Runner& runner, Context& context );
+void runSuiteArchive( Runner& runner, Context& context );
+void runSuiteUI( Runner& runner, Context& context );
+void runSuiteMix( Runner& runner, Context& context );
+void runSuiteNet( Runner& runner, Context& context );
+
+} // namespace bench
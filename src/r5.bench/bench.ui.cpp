@@ -0,0 +1,168 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// a private imgui context with no window or renderer behind it; NewFrame / Render run as normal and produce draw lists
+// that are simply never submitted, which is all the CPU side of a frame needs
+//
+struct HeadlessImGui
+{
+    HeadlessImGui()
+        : m_previousContext( ImGui::GetCurrentContext() )
+    {
+        m_context = ImGui::CreateContext();
+        ImGui::SetCurrentContext( m_context );
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize  = ImVec2( 1920.0f, 1080.0f );
+        io.DeltaTime    = 1.0f / 60.0f;
+        io.IniFilename  = nullptr;
+        io.LogFilename  = nullptr;
+
+        // the font atlas has to be built before the first NewFrame, even if the texture goes nowhere
+        unsigned char* fontPixels = nullptr;
+        int32_t fontWidth = 0, fontHeight = 0;
+        io.Fonts->GetTexDataAsRGBA32( &fontPixels, &fontWidth, &fontHeight );
+    }
+
+    ~HeadlessImGui()
+    {
+        ImGui::DestroyContext( m_context );
+        ImGui::SetCurrentContext( m_previousContext );
+    }
+
+    ImGuiContext*   m_previousContext   = nullptr;
+    ImGuiContext*   m_context           = nullptr;
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+// frame cost of the big virtualised tables (shared riffs, warehouse contents, jam browser); a table shaped like the
+// shared riffs view - a few fixed button columns around two text columns - is filled with 50k rows and drawn once per
+// iteration, either submitting every row or only those an ImGuiListClipper says are on screen
+//
+void runSuiteUI( Runner& runner, Context& context )
+{
+    static constexpr std::string_view cSuite = "ui";
+
+    const std::array< std::string_view, 2 > benchNames = { "table_50k.all_rows", "table_50k.clipped" };
+
+    bool anyEnabled = false;
+    for ( const auto& benchName : benchNames )
+        anyEnabled |= runner.isEnabled( cSuite, benchName );
+    if ( !anyEnabled )
+        return;
+
+    const uint32_t rowCount = runner.iterations( 50000 );
+
+    std::vector< std::string > riffNames;
+    std::vector< std::string > jamNames;
+    riffNames.reserve( rowCount );
+    jamNames.reserve( rowCount );
+    for ( uint32_t row = 0; row < rowCount; row++ )
+    {
+        riffNames.emplace_back( fmt::format( FMTX( "riff {:05} by someone, 120.0 bpm, C# minor" ), row ) );
+        jamNames.emplace_back( fmt::format( FMTX( "jam number {}" ), row % 97 ) );
+    }
+
+    HeadlessImGui headlessImGui;
+
+    static const ImVec2 buttonSize( 31.0f, 22.0f );
+
+    const auto drawRow = [&]( const std::size_t row )
+        {
+            ImGui::PushID( (int32_t)row );
+
+            ImGui::TableNextColumn();
+            ImGui::Button( ">", buttonSize );
+            ImGui::TableNextColumn();
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted( riffNames[row].c_str() );
+            ImGui::TableNextColumn();
+            ImGui::Button( "S", buttonSize );
+            ImGui::TableNextColumn();
+            ImGui::Button( "W", buttonSize );
+            ImGui::TableNextColumn();
+            ImGui::Button( "F", buttonSize );
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted( jamNames[row].c_str() );
+
+            ImGui::PopID();
+        };
+
+    const auto drawFrame = [&]( const bool useClipper ) -> std::optional< std::chrono::nanoseconds >
+        {
+            const auto timeStart = std::chrono::steady_clock::now();
+
+            ImGui::NewFrame();
+
+            ImGui::SetNextWindowPos( ImVec2( 0, 0 ) );
+            ImGui::SetNextWindowSize( ImGui::GetIO().DisplaySize );
+            ImGui::Begin( "##bench_table_window", nullptr, ImGuiWindowFlags_NoDecoration );
+
+            if ( ImGui::BeginTable( "##bench_table", 6,
+                ImGuiTableFlags_ScrollY |
+                ImGuiTableFlags_Borders |
+                ImGuiTableFlags_RowBg   |
+                ImGuiTableFlags_NoSavedSettings ) )
+            {
+                ImGui::TableSetupScrollFreeze( 0, 1 );
+
+                ImGui::TableSetupColumn( "Play", ImGuiTableColumnFlags_WidthFixed,   32.0f );
+                ImGui::TableSetupColumn( "Name", ImGuiTableColumnFlags_WidthStretch, 0.5f );
+                ImGui::TableSetupColumn( "Save", ImGuiTableColumnFlags_WidthFixed,   32.0f );
+                ImGui::TableSetupColumn( "Web",  ImGuiTableColumnFlags_WidthFixed,   32.0f );
+                ImGui::TableSetupColumn( "Find", ImGuiTableColumnFlags_WidthFixed,   32.0f );
+                ImGui::TableSetupColumn( "Jam",  ImGuiTableColumnFlags_WidthStretch, 0.5f );
+                ImGui::TableHeadersRow();
+
+                if ( useClipper )
+                {
+                    ImGuiListClipper rowClipper;
+                    rowClipper.Begin( (int32_t)rowCount );
+                    while ( rowClipper.Step() )
+                    {
+                        for ( int32_t row = rowClipper.DisplayStart; row < rowClipper.DisplayEnd; row++ )
+                            drawRow( (std::size_t)row );
+                    }
+                }
+                else
+                {
+                    for ( std::size_t row = 0; row < rowCount; row++ )
+                        drawRow( row );
+                }
+
+                ImGui::EndTable();
+            }
+            ImGui::End();
+
+            ImGui::Render();
+
+            const ImDrawData* drawData = ImGui::GetDrawData();
+            if ( drawData == nullptr || drawData->TotalVtxCount == 0 )
+                return std::nullopt;
+
+            return std::chrono::steady_clock::now() - timeStart;
+        };
+
+    // table layout settles over the first couple of frames; get that out of the way before anything is timed
+    for ( int32_t settleFrame = 0; settleFrame < 3; settleFrame++ )
+        std::ignore = drawFrame( true );
+
+    runner.measureManual( cSuite, benchNames[0], 16, rowCount, "rows", [&]() { return drawFrame( false ); } );
+    runner.measureManual( cSuite, benchNames[1], 64, rowCount, "rows", [&]() { return drawFrame( true ); } );
+}
+
+} // namespace bench
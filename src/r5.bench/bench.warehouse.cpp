@@ -0,0 +1,277 @@
+//   _______ _______ ______ _______ ___ ___ _______ _______ _______ 
+//  |       |   |   |   __ \       |   |   |    ___|       |    |  |
+//  |   -   |   |   |      <   -   |   |   |    ___|   -   |       |
+//  |_______|_______|___|__|_______|\_____/|_______|_______|__|____|
+//  \\ harry denholm \\ ishani            ishani.org/shelf/ouroveon/
+//
+//  
+//
+
+#include "pch.h"
+
+#include "bench.harness.h"
+#include "bench.suites.h"
+
+#include "app/core.h"
+#include "config/data.h"
+#include "math/rng.h"
+
+#include "endlesss/core.constants.h"
+#include "endlesss/toolkit.warehouse.h"
+
+#include <future>
+
+namespace bench {
+
+// ---------------------------------------------------------------------------------------------------------------------
+// shape of the synthetic warehouse contents; riffs pull their stems from a small per-jam pool, much like a real
+// jam where most riffs are incremental edits of the previous one
+static constexpr uint32_t cSyntheticJamCount        = 6;
+static constexpr uint32_t cSyntheticRiffsPerJam     = 2500;
+static constexpr uint32_t cSyntheticStemsPerJam     = 96;
+static constexpr uint32_t cSyntheticUserCount       = 24;
+
+static std::string syntheticJamID( const uint32_t jamIndex )
+{
+    return fmt::format( FMTX( "bench{:04}" ), jamIndex );
+}
+
+static std::string syntheticRiffID( const uint32_t jamIndex, const uint32_t riffIndex )
+{
+    return fmt::format( FMTX( "b0000000{:08x}0000{:012x}" ), jamIndex, riffIndex );
+}
+
+static std::string syntheticStemID( const uint32_t jamIndex, const uint32_t stemIndex )
+{
+    return fmt::format( FMTX( "5000000{:08x}00000{:012x}" ), jamIndex, stemIndex );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// write riff and stem rows directly, bypassing the network sync tasks; one transaction for the lot
+static void populateSyntheticWarehouse()
+{
+    static constexpr char _insertRiff[] = R"(
+        INSERT OR REPLACE INTO Riffs(
+            RiffCID,
+            OwnerJamCID,
+            CreationTime,
+            Root,
+            Scale,
+            BPS,
+            BPMrnd,
+            BarLength,
+            AppVersion,
+            Magnitude,
+            UserName,
+            StemCID_1,
+            StemCID_2,
+            StemCID_3,
+            StemCID_4,
+            StemCID_5,
+            StemCID_6,
+            StemCID_7,
+            StemCID_8,
+            GainsJSON
+        ) VALUES( ?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, ?16, ?17, ?18, ?19, ?20 );
+        )";
+
+    static constexpr char _insertStem[] = R"(
+        INSERT OR REPLACE INTO Stems(
+            StemCID,
+            OwnerJamCID,
+            CreationTime,
+            FileEndpoint,
+            FileBucket,
+            FileKey,
+            FileMIME,
+            FileLength,
+            BPS,
+            BPMrnd,
+            Instrument,
+            Length16s,
+            OriginalPitch,
+            BarLength,
+            PresetName,
+            CreatorUserName,
+            SampleRate,
+            PrimaryColour
+        ) VALUES( ?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, ?16, ?17, ?18 );
+        )";
+
+    static constexpr std::array< float, 6 > cBPMChoices = { 90.0f, 110.0f, 120.0f, 124.0f, 128.0f, 140.0f };
+
+    math::RNG32 rng( 0x3A7E4005 );
+
+    endlesss::toolkit::Warehouse::SqlDB::TransactionGuard txn;
+
+    for ( uint32_t jamIndex = 0; jamIndex < cSyntheticJamCount; jamIndex++ )
+    {
+        const std::string jamID     = syntheticJamID( jamIndex );
+        const float       jamBPM    = cBPMChoices[ jamIndex % cBPMChoices.size() ];
+        const int64_t     jamStart  = 1600000000 + ( jamIndex * 86400 * 30 );
+
+        for ( uint32_t stemIndex = 0; stemIndex < cSyntheticStemsPerJam; stemIndex++ )
+        {
+            const std::string stemID   = syntheticStemID( jamIndex, stemIndex );
+            const std::string userName = fmt::format( FMTX( "user{:02}" ), rng.genInt32( 0, cSyntheticUserCount - 1 ) );
+
+            endlesss::toolkit::Warehouse::SqlDB::query<_insertStem>(
+                stemID,
+                jamID,
+                jamStart + stemIndex,
+                "bench.endlesss.fm",
+                "bench",
+                "attachments/" + stemID,
+                "audio/flac",
+                1024 * 1024,
+                jamBPM / 60.0f,
+                jamBPM,
+                rng.genInt32( 0, 6 ),
+                16.0f,
+                0.0f,
+                4.0f,
+                "bench_preset",
+                userName,
+                48000,
+                "ff808080" );
+        }
+
+        for ( uint32_t riffIndex = 0; riffIndex < cSyntheticRiffsPerJam; riffIndex++ )
+        {
+            std::array< std::string, 8 > stemIDs;
+            for ( auto& stemID : stemIDs )
+                stemID = syntheticStemID( jamIndex, rng.genInt32( 0, cSyntheticStemsPerJam - 1 ) );
+
+            endlesss::toolkit::Warehouse::SqlDB::query<_insertRiff>(
+                syntheticRiffID( jamIndex, riffIndex ),
+                jamID,
+                jamStart + ( riffIndex * 45 ),
+                rng.genInt32( 0, 11 ),
+                rng.genInt32( 0, 3 ),
+                jamBPM / 60.0f,
+                jamBPM,
+                16,
+                1,
+                1.0f,
+                fmt::format( FMTX( "user{:02}" ), rng.genInt32( 0, cSyntheticUserCount - 1 ) ),
+                stemIDs[0], stemIDs[1], stemIDs[2], stemIDs[3],
+                stemIDs[4], stemIDs[5], stemIDs[6], stemIDs[7],
+                "[1,1,1,1,1,1,1,1]" );
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+void runSuiteWarehouse( Runner& runner, Context& context )
+{
+    static constexpr std::string_view cSuite = "warehouse";
+
+    // warehouse storage lives entirely inside the scratch workspace
+    config::Data benchStorage;
+    benchStorage.storageRoot = ( context.m_workspace / "storage" ).string();
+
+    const app::StoragePaths storagePaths( benchStorage, "bench" );
+    if ( !storagePaths.tryToCreateAndValidate() )
+    {
+        runner.markFailed( cSuite, "*", "unable to create warehouse storage paths" );
+        return;
+    }
+
+    auto warehouse = std::make_unique< endlesss::toolkit::Warehouse >( storagePaths, context.m_netConfig, base::EventBusClient( context.m_eventBus ) );
+
+    {
+        const auto timeStart = std::chrono::steady_clock::now();
+        populateSyntheticWarehouse();
+        const auto timeTaken = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - timeStart );
+
+        blog::app( FMTX( "[bench] synthetic warehouse populated with {} riffs in {}ms" ), cSyntheticJamCount * cSyntheticRiffsPerJam, timeTaken.count() );
+    }
+
+    static constexpr double cTotalRiffs = cSyntheticJamCount * cSyntheticRiffsPerJam;
+
+    // -----------------------------------------------------------------------------------------------------------------
+    {
+        endlesss::constants::RootScalePairs keySearch{ { endlesss::constants::RootScalePair( 0u, 0u ) }, endlesss::constants::HarmonicSearch::BasicAdjacent };
+        endlesss::constants::computeTonalAdjacents( keySearch.pairs.front(), keySearch );
+
+        endlesss::constants::RootScalePairs noRulesSearch{ {}, endlesss::constants::HarmonicSearch::NoRules };
+
+        std::vector< endlesss::toolkit::Warehouse::BPMCountTuple > bpmCounts;
+
+        runner.measure( cSuite, "filter_riffs_by_bpm.adjacent", 64, cTotalRiffs, "riffs", [&]()
+        {
+            warehouse->filterRiffsByBPM( keySearch, endlesss::toolkit::Warehouse::BPMCountSort::ByCount, bpmCounts );
+        });
+        runner.measure( cSuite, "filter_riffs_by_bpm.norules", 64, cTotalRiffs, "riffs", [&]()
+        {
+            warehouse->filterRiffsByBPM( noRulesSearch, endlesss::toolkit::Warehouse::BPMCountSort::ByBPM, bpmCounts );
+        });
+
+        int32_t randomSeed = 0;
+        runner.measureManual( cSuite, "fetch_random_riff_by_seed", 256, 1, "queries", [&]() -> std::optional< std::chrono::nanoseconds >
+        {
+            endlesss::types::RiffComplete riffResult;
+
+            const auto timeStart = std::chrono::steady_clock::now();
+            if ( !warehouse->fetchRandomRiffBySeed( keySearch, 120, randomSeed++, riffResult ) )
+                return std::nullopt;
+
+            return std::chrono::steady_clock::now() - timeStart;
+        });
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    {
+        math::RNG32 rng( 0xF37C4001 );
+
+        runner.measureManual( cSuite, "fetch_single_riff_by_id", 1024, 1, "queries", [&]() -> std::optional< std::chrono::nanoseconds >
+        {
+            const endlesss::types::RiffCouchID riffID( syntheticRiffID(
+                rng.genInt32( 0, cSyntheticJamCount - 1 ),
+                rng.genInt32( 0, cSyntheticRiffsPerJam - 1 ) ) );
+
+            endlesss::types::RiffComplete riffResult;
+
+            const auto timeStart = std::chrono::steady_clock::now();
+            if ( !warehouse->fetchSingleRiffByID( riffID, riffResult ) )
+                return std::nullopt;
+
+            return std::chrono::steady_clock::now() - timeStart;
+        });
+    }
+
+    // -----------------------------------------------------------------------------------------------------------------
+    // jam slices are built on the warehouse worker thread; time from request to the callback landing
+    {
+        uint32_t jamIndex = 0;
+
+        runner.measureManual( cSuite, "jam_slice", 16, cSyntheticRiffsPerJam, "riffs", [&]() -> std::optional< std::chrono::nanoseconds >
+        {
+            const endlesss::types::JamCouchID jamID( syntheticJamID( jamIndex++ % cSyntheticJamCount ) );
+
+            std::promise< std::size_t > sliceArrived;
+            auto sliceArrivedFuture = sliceArrived.get_future();
+
+            const auto timeStart = std::chrono::steady_clock::now();
+
+            warehouse->addJamSliceRequest( jamID, [&sliceArrived]( const endlesss::types::JamCouchID&, endlesss::toolkit::Warehouse::JamSlicePtr&& resultSlice )
+            {
+                sliceArrived.set_value( resultSlice ? resultSlice->m_ids.size() : 0 );
+            });
+
+            if ( sliceArrivedFuture.wait_for( std::chrono::seconds( 30 ) ) != std::future_status::ready )
+                return std::nullopt;
+
+            const auto timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+            if ( sliceArrivedFuture.get() != cSyntheticRiffsPerJam )
+                return std::nullopt;
+
+            return timeTaken;
+        });
+    }
+
+    warehouse.reset();
+}
+
+} // namespace bench
@@ -46,6 +46,7 @@
 #include "vx/vibes.h"
 
 #include "discord/discord.bot.ui.h"
+#include "net/broadcast.opus.ui.h"
 
 #include "endlesss/all.h"
 
@@ -481,6 +482,7 @@ struct LoreApp final : public app::OuroApp,
         , m_rpClient( GetAppName() )
     {
         m_discordBotUI = std::make_unique<discord::BotWithUI>( *this );
+        m_broadcastUI  = std::make_unique<net::broadcast::OpusServerWithUI>( *this );
     }
 
     ~LoreApp()
@@ -507,6 +509,10 @@ protected:
     // discord bot & streaming panel 
     std::unique_ptr< discord::BotWithUI >   m_discordBotUI;
 
+    // LAN Ogg/Opus broadcast panel
+    std::unique_ptr< net::broadcast::OpusServerWithUI >
+                                            m_broadcastUI;
+
 #if OURO_FEATURE_NST24
     // VST playground
     std::unique_ptr< effect::EffectStack >  m_effectStack;
@@ -856,6 +862,7 @@ protected:
     endlesss::types::JamCouchIDSet                  m_warehouseContentsReportJamInFluxSet;      // any jams that have unfetched data
     WarehouseContentsSortMode::Enum                 m_warehouseContentsSortMode                 = WarehouseContentsSortMode::ByName;
     std::vector< std::size_t >                      m_warehouseContentsSortedIndices;
+    std::vector< std::size_t >                      m_warehouseContentsFilteredIndices;         // sorted indices passing the name filter, rebuilt per frame for the table clipper
 
     void triggerSyncOnJamInContentsReport( std::size_t index )
     {
@@ -2378,6 +2385,7 @@ int LoreApp::EntrypointOuro()
             m_vibes->doImGui( m_endlesssExchange, this );
 
         m_discordBotUI->imgui( *this );
+        m_broadcastUI->imgui( *this );
         m_uxProcWeaver->imgui( *this, currentRiffPtr, m_rpClient, *m_warehouse );
 
         mixPreview.imgui();
@@ -3357,205 +3365,209 @@ int LoreApp::EntrypointOuro()
 
                             m_jamTaggingCurrentlyHovered = {};
 
-                            int32_t riffEntry = 0;
                             const int32_t tagCount = static_cast<int32_t>(m_jamTagging.tagVector.size());
 
                             // optional operation to carry out on tag data after we've done iterating it, triggered by
                             // some kind of user interaction (like hitting up/down buttons, drag/dropping etc)
                             JamTagVectorOpToDo tagOperationToDo = std::nullopt;
 
-                            for ( auto& riffTag : m_jamTagging.tagVector )
+                            ImGuiListClipper tagClipper;
+                            tagClipper.Begin( tagCount );
+                            while ( tagClipper.Step() )
                             {
-                                const auto& riffID = riffTag.m_riff;
+                                for ( int32_t riffEntry = tagClipper.DisplayStart; riffEntry < tagClipper.DisplayEnd; riffEntry++ )
+                                {
+                                    auto& riffTag = m_jamTagging.tagVector[riffEntry];
+                                    const auto& riffID = riffTag.m_riff;
 
-                                ImGui::TableNextColumn();
-                                ImGui::PushID( static_cast<int32_t>( riffEntry ) );
+                                    ImGui::TableNextColumn();
+                                    ImGui::PushID( static_cast<int32_t>( riffEntry ) );
 
-                                const bool bRiffIsHoveredInJamView  = viewHoveredRiffID == riffID;
-                                const bool bRiffIsPlaying           = viewCurrentPlayingRiffID == riffID;
-                                const bool bRiffWaitingToPlay       = m_riffsQueuedForPlayback.contains( riffID );
-                                const bool bRiffIsExporting         = m_riffExportOperationsMap.hasValue( riffID );
+                                    const bool bRiffIsHoveredInJamView  = viewHoveredRiffID == riffID;
+                                    const bool bRiffIsPlaying           = viewCurrentPlayingRiffID == riffID;
+                                    const bool bRiffWaitingToPlay       = m_riffsQueuedForPlayback.contains( riffID );
+                                    const bool bRiffIsExporting         = m_riffExportOperationsMap.hasValue( riffID );
 
-                                if ( bRiffIsHoveredInJamView )
-                                {
-                                    ImVec4 highlightRow = ImGui::GetStyleColorVec4( ImGuiCol_TableRowBg );
-                                    highlightRow.w *= 3.0f;
+                                    if ( bRiffIsHoveredInJamView )
+                                    {
+                                        ImVec4 highlightRow = ImGui::GetStyleColorVec4( ImGuiCol_TableRowBg );
+                                        highlightRow.w *= 3.0f;
 
-                                    ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg1, ImGui::ColorConvertFloat4ToU32( highlightRow ) );
-                                }
-                                if ( bRiffWaitingToPlay )
-                                {
-                                    ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg1, ImGui::GetPulseColour( 0.25f ) );
-                                }
+                                        ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg1, ImGui::ColorConvertFloat4ToU32( highlightRow ) );
+                                    }
+                                    if ( bRiffWaitingToPlay )
+                                    {
+                                        ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg1, ImGui::GetPulseColour( 0.25f ) );
+                                    }
 
-                                {
-                                    ImGui::Scoped::Disabled disabledButton( bRiffWaitingToPlay );
-                                    ImGui::Scoped::ToggleButton highlightButton( bRiffIsPlaying, true );
-                                    if ( ImGui::Button( ICON_FA_PLAY, buttonSizeMidTable ) )
                                     {
-                                        if ( !bRiffIsPlaying )
+                                        ImGui::Scoped::Disabled disabledButton( bRiffWaitingToPlay );
+                                        ImGui::Scoped::ToggleButton highlightButton( bRiffIsPlaying, true );
+                                        if ( ImGui::Button( ICON_FA_PLAY, buttonSizeMidTable ) )
                                         {
-                                            getEventBusClient().Send< ::events::EnqueueRiffPlayback >( riffTag.m_jam, riffID );
+                                            if ( !bRiffIsPlaying )
+                                            {
+                                                getEventBusClient().Send< ::events::EnqueueRiffPlayback >( riffTag.m_jam, riffID );
+                                            }
+                                        }
+                                        if ( ImGui::IsItemHovered() )
+                                        {
+                                            m_jamTaggingCurrentlyHovered = riffID;
                                         }
                                     }
-                                    if ( ImGui::IsItemHovered() )
+                                    ImGui::SameLine();
+                                    ImGui::AlignTextToFramePadding();
                                     {
-                                        m_jamTaggingCurrentlyHovered = riffID;
+                                        uint32_t favourColour = colour::shades::tag_lvl_1.neutralU32();
+                                        switch ( riffTag.m_favour )
+                                        {
+                                            case 1: favourColour = colour::shades::tag_lvl_2.neutralU32();
+                                        }
+                                        ImGui::PushStyleColor( ImGuiCol_Text, favourColour );
+                                        ImGui::TextUnformatted( ICON_FC_FULL_BLOCK );
+                                        ImGui::PopStyleColor();
                                     }
-                                }
-                                ImGui::SameLine();
-                                ImGui::AlignTextToFramePadding();
-                                {
-                                    uint32_t favourColour = colour::shades::tag_lvl_1.neutralU32();
-                                    switch ( riffTag.m_favour )
+
+                                    ImGui::TableNextColumn();
                                     {
-                                        case 1: favourColour = colour::shades::tag_lvl_2.neutralU32();
+                                        ImGui::AlignTextToFramePadding();
+                                        ImGui::SetNextItemWidth( ImGui::GetContentRegionAvail().x );
+                                        const bool bTextAccept = ImGui::InputText( "###note", &riffTag.m_note, ImGuiInputTextFlags_EnterReturnsTrue );
+                                        if ( bTextAccept || ImGui::IsItemDeactivatedAfterEdit() )
+                                        {
+                                            getEventBusClient().Send< ::events::RiffTagAction >( riffTag, ::events::RiffTagAction::Action::Upsert );
+                                        }
                                     }
-                                    ImGui::PushStyleColor( ImGuiCol_Text, favourColour );
-                                    ImGui::TextUnformatted( ICON_FC_FULL_BLOCK );
-                                    ImGui::PopStyleColor();
-                                }
 
-                                ImGui::TableNextColumn();
-                                {
-                                    ImGui::AlignTextToFramePadding();
-                                    ImGui::SetNextItemWidth( ImGui::GetContentRegionAvail().x );
-                                    const bool bTextAccept = ImGui::InputText( "###note", &riffTag.m_note, ImGuiInputTextFlags_EnterReturnsTrue );
-                                    if ( bTextAccept || ImGui::IsItemDeactivatedAfterEdit() )
+                                    ImGui::TableNextColumn();
                                     {
-                                        getEventBusClient().Send< ::events::RiffTagAction >( riffTag, ::events::RiffTagAction::Action::Upsert );
+                                        ImGui::Dummy( { 0, 0 } );
+                                        ImGui::SameLine( 0, 8.0f );
+                                        // double-wrap tooltip so we only do the (non trivial) time conversion / string build on hover
+                                        ImGui::TextDisabled( ICON_FA_CLOCK );
+                                        if ( ImGui::IsItemHovered( ImGuiHoveredFlags_DelayNormal ) )
+                                        {
+                                            const auto shareTimeUnix = spacetime::InSeconds( std::chrono::seconds{ riffTag.m_timestamp } );
+                                            const auto cacheTimeDelta = spacetime::calculateDeltaFromNow( shareTimeUnix ).asPastTenseString( 3 );
+                                            ImGui::CompactTooltip( fmt::format( FMTX("{}\n{}"), spacetime::datestampStringFromUnix( shareTimeUnix ), cacheTimeDelta ).c_str() );
+                                        }
                                     }
-                                }
 
-                                ImGui::TableNextColumn();
-                                {
-                                    ImGui::Dummy( { 0, 0 } );
-                                    ImGui::SameLine( 0, 8.0f );
-                                    // double-wrap tooltip so we only do the (non trivial) time conversion / string build on hover
-                                    ImGui::TextDisabled( ICON_FA_CLOCK );
-                                    if ( ImGui::IsItemHovered( ImGuiHoveredFlags_DelayNormal ) )
+                                    ImGui::TableNextColumn();
+                                    if ( ImGui::Button( ICON_FA_GRIP, buttonSizeMidTable ) )
                                     {
-                                        const auto shareTimeUnix = spacetime::InSeconds( std::chrono::seconds{ riffTag.m_timestamp } );
-                                        const auto cacheTimeDelta = spacetime::calculateDeltaFromNow( shareTimeUnix ).asPastTenseString( 3 );
-                                        ImGui::CompactTooltip( fmt::format( FMTX("{}\n{}"), spacetime::datestampStringFromUnix( shareTimeUnix ), cacheTimeDelta ).c_str() );
+                                        // dispatch a request to navigate this this riff, if we can find it
+                                        getEventBusClient().Send< ::events::RequestNavigationToRiff >( endlesss::types::RiffIdentity{ riffTag.m_jam, riffID } );
                                     }
-                                }
 
-                                ImGui::TableNextColumn();
-                                if ( ImGui::Button( ICON_FA_GRIP, buttonSizeMidTable ) )
-                                {
-                                    // dispatch a request to navigate this this riff, if we can find it
-                                    getEventBusClient().Send< ::events::RequestNavigationToRiff >( endlesss::types::RiffIdentity{ riffTag.m_jam, riffID } );
-                                }
+                                    ImGui::TableNextColumn();
+                                    if ( bRiffIsExporting )
+                                    {
+                                        ImGui::AlignTextToFramePadding();
+                                        ImGui::Dummy( { 0, 0 } );
+                                        ImGui::SameLine( 0, 4.0f );
+                                        ImGui::Spinner( "##exporting", true, ImGui::GetTextLineHeight() * 0.48f, 3.0f, 0.0f, ImGui::GetColorU32( ImGuiCol_Text ) );
+                                    }
 
-                                ImGui::TableNextColumn();
-                                if ( bRiffIsExporting )
-                                {
+                                    ImGui::TableNextColumn();
                                     ImGui::AlignTextToFramePadding();
-                                    ImGui::Dummy( { 0, 0 } );
-                                    ImGui::SameLine( 0, 4.0f );
-                                    ImGui::Spinner( "##exporting", true, ImGui::GetTextLineHeight() * 0.48f, 3.0f, 0.0f, ImGui::GetColorU32( ImGuiCol_Text ) );
-                                }
-
-                                ImGui::TableNextColumn();
-                                ImGui::AlignTextToFramePadding();
-                                {
-                                    static const char* cDragPayloadType = "dnd.TaggedRiff";
-
-                                    bool bAllowDragTargetAbove = true;
-                                    bool bAllowDragTargetBelow = true;
-                                    bool bDragOperationRunning = false;
-
-                                    // check on the current drag state - we choose to allow dragging for each row based on 
-                                    // if the result would be valid - eg. don't bother dragging onto the initial drag source
-                                    const ImGuiPayload* dragPayloadPeek = ImGui::GetDragDropPayload();
-                                    if ( dragPayloadPeek && dragPayloadPeek->IsDataType( cDragPayloadType ) )
                                     {
-                                        ABSL_ASSERT( dragPayloadPeek->DataSize == sizeof( int32_t ) );
-                                        const int32_t draggedFromRiffIndex = *(const int32_t*)dragPayloadPeek->Data;
+                                        static const char* cDragPayloadType = "dnd.TaggedRiff";
 
-                                        bDragOperationRunning = true;
+                                        bool bAllowDragTargetAbove = true;
+                                        bool bAllowDragTargetBelow = true;
+                                        bool bDragOperationRunning = false;
 
-                                        // don't drag onto ourself
-                                        if ( draggedFromRiffIndex == riffEntry )
+                                        // check on the current drag state - we choose to allow dragging for each row based on 
+                                        // if the result would be valid - eg. don't bother dragging onto the initial drag source
+                                        const ImGuiPayload* dragPayloadPeek = ImGui::GetDragDropPayload();
+                                        if ( dragPayloadPeek && dragPayloadPeek->IsDataType( cDragPayloadType ) )
                                         {
-                                            bAllowDragTargetAbove = false;
-                                            bAllowDragTargetBelow = false;
-                                        }
-                                        // dont bother reordering onto our original position either
-                                        if ( riffEntry + 1 == draggedFromRiffIndex )
-                                        {
-                                            bAllowDragTargetBelow = false;
-                                        }
-                                        if ( riffEntry - 1 == draggedFromRiffIndex )
-                                        {
-                                            bAllowDragTargetAbove = false;
+                                            ABSL_ASSERT( dragPayloadPeek->DataSize == sizeof( int32_t ) );
+                                            const int32_t draggedFromRiffIndex = *(const int32_t*)dragPayloadPeek->Data;
+
+                                            bDragOperationRunning = true;
+
+                                            // don't drag onto ourself
+                                            if ( draggedFromRiffIndex == riffEntry )
+                                            {
+                                                bAllowDragTargetAbove = false;
+                                                bAllowDragTargetBelow = false;
+                                            }
+                                            // dont bother reordering onto our original position either
+                                            if ( riffEntry + 1 == draggedFromRiffIndex )
+                                            {
+                                                bAllowDragTargetBelow = false;
+                                            }
+                                            if ( riffEntry - 1 == draggedFromRiffIndex )
+                                            {
+                                                bAllowDragTargetAbove = false;
+                                            }
                                         }
-                                    }
 
-                                    // add an ordering button to shift the riff up or down in the list; this also wires in
-                                    // the drag-drop logic to hide/colour buttons during drag procedures .. it's a little convoluted in there
-                                    const auto AddOrderingButton = [&](
-                                        const char* label,
-                                        const bool exchangeEnableLogic,
-                                        const int32_t exchangeIndex,
-                                        const bool dragEnableLogic,
-                                        const JamTagVectorOp::Op dragOp )
-                                        {
+                                        // add an ordering button to shift the riff up or down in the list; this also wires in
+                                        // the drag-drop logic to hide/colour buttons during drag procedures .. it's a little convoluted in there
+                                        const auto AddOrderingButton = [&](
+                                            const char* label,
+                                            const bool exchangeEnableLogic,
+                                            const int32_t exchangeIndex,
+                                            const bool dragEnableLogic,
+                                            const JamTagVectorOp::Op dragOp )
                                             {
-                                                // don't show buttons that aren't useful drag targets when we're dragging
-                                                const bool bHideButtonDuringDragWithoutTarget = bDragOperationRunning && !dragEnableLogic;
+                                                {
+                                                    // don't show buttons that aren't useful drag targets when we're dragging
+                                                    const bool bHideButtonDuringDragWithoutTarget = bDragOperationRunning && !dragEnableLogic;
 
-                                                // disable the button for exchanging if the exchange wouldn't be valid .. UNLESS we're dragging!
-                                                ImGui::Scoped::Enabled enabledButton( bDragOperationRunning || exchangeEnableLogic );
-                                                ImGui::Scoped::ColourButton colourButton( colour::shades::pink, dragEnableLogic&& bDragOperationRunning );
+                                                    // disable the button for exchanging if the exchange wouldn't be valid .. UNLESS we're dragging!
+                                                    ImGui::Scoped::Enabled enabledButton( bDragOperationRunning || exchangeEnableLogic );
+                                                    ImGui::Scoped::ColourButton colourButton( colour::shades::pink, dragEnableLogic&& bDragOperationRunning );
 
-                                                // just stick in an empty dummy space if we're not showing the button
-                                                if ( bHideButtonDuringDragWithoutTarget )
-                                                {
-                                                    ImGui::Dummy( buttonSizeMidTable );
-                                                }
-                                                // and show the button but disable its actual click logic if we're dragging
-                                                else if ( ImGui::Button( label, buttonSizeMidTable ) && !bDragOperationRunning )
-                                                {
-                                                    tagOperationToDo = JamTagVectorOp( JamTagVectorOp::Op::Exchange, riffEntry, exchangeIndex );
+                                                    // just stick in an empty dummy space if we're not showing the button
+                                                    if ( bHideButtonDuringDragWithoutTarget )
+                                                    {
+                                                        ImGui::Dummy( buttonSizeMidTable );
+                                                    }
+                                                    // and show the button but disable its actual click logic if we're dragging
+                                                    else if ( ImGui::Button( label, buttonSizeMidTable ) && !bDragOperationRunning )
+                                                    {
+                                                        tagOperationToDo = JamTagVectorOp( JamTagVectorOp::Op::Exchange, riffEntry, exchangeIndex );
+                                                    }
                                                 }
-                                            }
-                                            // deal with creating a move operation on drop
-                                            if ( dragEnableLogic && ImGui::BeginDragDropTarget() )
-                                            {
-                                                if ( const ImGuiPayload* payload = ImGui::AcceptDragDropPayload( cDragPayloadType ) )
+                                                // deal with creating a move operation on drop
+                                                if ( dragEnableLogic && ImGui::BeginDragDropTarget() )
                                                 {
-                                                    ABSL_ASSERT( payload->DataSize == sizeof( int32_t ) );
-                                                    const int32_t draggedFromRiffIndex = *(const int32_t*)payload->Data;
+                                                    if ( const ImGuiPayload* payload = ImGui::AcceptDragDropPayload( cDragPayloadType ) )
+                                                    {
+                                                        ABSL_ASSERT( payload->DataSize == sizeof( int32_t ) );
+                                                        const int32_t draggedFromRiffIndex = *(const int32_t*)payload->Data;
 
-                                                    tagOperationToDo = JamTagVectorOp( dragOp, draggedFromRiffIndex, riffEntry );
+                                                        tagOperationToDo = JamTagVectorOp( dragOp, draggedFromRiffIndex, riffEntry );
+                                                    }
+                                                    ImGui::EndDragDropTarget();
                                                 }
-                                                ImGui::EndDragDropTarget();
-                                            }
-                                        };
+                                            };
 
-                                    AddOrderingButton( ICON_FA_ARROW_UP,    riffEntry > 0,              riffEntry - 1, bAllowDragTargetAbove, JamTagVectorOp::Op::Move1Before2 );
-                                    ImGui::SameLine( 0, 2.0f );
-                                    AddOrderingButton( ICON_FA_ARROW_DOWN,  riffEntry < tagCount - 1,   riffEntry + 1, bAllowDragTargetBelow, JamTagVectorOp::Op::Move1After2 );
+                                        AddOrderingButton( ICON_FA_ARROW_UP,    riffEntry > 0,              riffEntry - 1, bAllowDragTargetAbove, JamTagVectorOp::Op::Move1Before2 );
+                                        ImGui::SameLine( 0, 2.0f );
+                                        AddOrderingButton( ICON_FA_ARROW_DOWN,  riffEntry < tagCount - 1,   riffEntry + 1, bAllowDragTargetBelow, JamTagVectorOp::Op::Move1After2 );
 
-                                    ImGui::SameLine( 0, 4.0f );
+                                        ImGui::SameLine( 0, 4.0f );
 
-                                    // grip button to start dragging this row elsewhere in the list
-                                    if ( !bDragOperationRunning )
-                                    {
-                                        ImGui::Button( ICON_FA_GRIP_VERTICAL );
-                                        if ( ImGui::BeginDragDropSource( ImGuiDragDropFlags_None ) )
+                                        // grip button to start dragging this row elsewhere in the list
+                                        if ( !bDragOperationRunning )
                                         {
-                                            ImGui::SetDragDropPayload( cDragPayloadType, &riffEntry, sizeof( int32_t ) );
-                                            ImGui::TextUnformatted( riffTag.m_note );
-                                            ImGui::EndDragDropSource();
+                                            ImGui::Button( ICON_FA_GRIP_VERTICAL );
+                                            if ( ImGui::BeginDragDropSource( ImGuiDragDropFlags_None ) )
+                                            {
+                                                ImGui::SetDragDropPayload( cDragPayloadType, &riffEntry, sizeof( int32_t ) );
+                                                ImGui::TextUnformatted( riffTag.m_note );
+                                                ImGui::EndDragDropSource();
+                                            }
                                         }
                                     }
-                                }
 
-                                ImGui::PopID();
-                                riffEntry++;
+                                    ImGui::PopID();
+                                }
                             }
 
                             // act upon a request to move/exchange values in the array now we've done iterating
@@ -3783,7 +3795,7 @@ int LoreApp::EntrypointOuro()
                                 fileDialog->OpenDialog(
                                     "ImpFileDlg",
                                     "Choose LORE stem archive",
-                                    ".tar",
+                                    ".tar,.zst",
                                     cWarehouseImportPath.string().c_str(),
                                     1,
                                     nullptr,
@@ -3793,7 +3805,7 @@ int LoreApp::EntrypointOuro()
                                     {
                                         tf::Taskflow taskflow;
                                         enqueueJamStemArchiveImportAsync( dlg.GetFilePathName(), taskflow );
-                                        getTaskExecutor().run( std::move( taskflow ) );
+                                        getTaskExecutorIO().run( std::move( taskflow ) );
                                     });
                             }
                         }
@@ -4013,181 +4025,22 @@ int LoreApp::EntrypointOuro()
                         // lock the data report so it isn't whipped away from underneath us mid-render
                         std::scoped_lock<std::mutex> reportLock( m_warehouseContentsReportMutex );
 
+                        // apply the name filter up-front so the clipper can skip straight to the visible rows
+                        m_warehouseContentsFilteredIndices.clear();
                         for ( size_t jamIdx = 0; jamIdx < m_warehouseContentsReport.m_jamCouchIDs.size(); jamIdx++ )
                         {
-                            const std::size_t jI            = m_warehouseContentsSortedIndices[jamIdx];
-                            const int64_t unpopulatedRiffs  = m_warehouseContentsReport.m_unpopulatedRiffs[jI];
-                            const int64_t populatedRiffs    = m_warehouseContentsReport.m_populatedRiffs[jI];
-                            const int64_t unpopulatedStems  = m_warehouseContentsReport.m_unpopulatedStems[jI];
-                            const int64_t populatedStems    = m_warehouseContentsReport.m_populatedStems[jI];
-
-                            const auto iterCurrentJamID     = m_warehouseContentsReport.m_jamCouchIDs[jI];
-
-                            const auto knownCachedRiffCount = m_jamLibrary.loadKnownRiffCountForDatabaseID( iterCurrentJamID );
-
-                            const bool bIsJamInFlux         = m_warehouseContentsReportJamInFlux[jI] || doesJamHaveActiveOperations( iterCurrentJamID );
-                            const bool bHasDataToSync       = (unpopulatedRiffs > 0 || knownCachedRiffCount > populatedRiffs);
-
+                            const std::size_t jI = m_warehouseContentsSortedIndices[jamIdx];
 
                             const auto& jamNameToFilterAgainst = m_warehouseContentsReportJamTitlesForSort[jI];
-                            if ( !jamNameFilter.PassFilter( jamNameToFilterAgainst.c_str(), &jamNameToFilterAgainst.back() + 1 ) )
-                                continue;
-
-                            ImGui::PushID( (int32_t)jI );
-                            ImGui::TableNextColumn();
-
-                            // highlight or lowlight column based on state
-                            if ( bIsJamInFlux )
-                                ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg0, ImGui::GetSyncBusyColour( 0.2f ) );
-                            if ( m_currentViewedJam == iterCurrentJamID )
-                                ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg0, ImGui::GetColorU32( ImGuiCol_TableRowBgAlt, 2.5f ) );
-
-                            // always show the view-this-jam button regardless of mode
-                            {
-                                if ( bIsJamInFlux )
-                                {
-                                    ImGui::Dummy( { 8, 2 } );
-                                    ImGui::SameLine( 0, 0 );
-                                    ImGui::Spinner( "##syncing", true, ImGui::GetTextLineHeight() * 0.4f, 3.0f, 1.5f, ImGui::GetColorU32( ImGuiCol_Text ) );
-                                }
-                                else
-                                {
-                                    if ( ImGui::PrecisionButton( ICON_FA_GRIP, buttonSizeMidTable, 1.0f ) )
-                                    {
-                                        beginChangeToViewJam( iterCurrentJamID );
-                                    }
-                                }
-
-                                ImGui::TableNextColumn();
-                            }
-                            // .. followed by the jam name
-                            {
-                                ImGui::AlignTextToFramePadding();
-                                ImGui::TextUnformatted( m_warehouseContentsReportJamTitles[jI].c_str() );
-                                ImGui::TableNextColumn();
-                            }
-
-
-                            // -----------------------------------------------------------------------------------------
-                            if ( warehouseView == WarehouseView::Default )
-                            {
-                                if ( bWarehouseHasEndlesssAccess )
-                                {
-                                    if ( bIsJamInFlux )
-                                    {
-                                        // handle the option to abort the sync .. by nuking the jam
-                                        {
-                                            // only show the abort button after a delay so there are less chances of a mis-click
-                                            // given that it purges the jam entirely
-                                            const bool bNotEnoughTimePassedSinceAbortShown = !m_warehouseContentsReportJamInFluxMoment[jI].hasPassed();
-                                            ImGui::Scoped::Disabled se( bNotEnoughTimePassedSinceAbortShown || !bHasDataToSync );
-                                            ImGui::Scoped::ColourButton cb( colour::shades::errors, colour::shades::white );
-                                            if ( ImGui::Button( ICON_FA_BAN, buttonSizeMidTable ) )
-                                            {
-                                                m_warehouse->requestJamSyncAbort( iterCurrentJamID );
-                                                // push the abort task timer way forward to immediately disable the button
-                                                m_warehouseContentsReportJamInFluxMoment[jI].setToFuture( std::chrono::hours( 1 ) );
-                                            }
-                                        }
-                                        ImGui::CompactTooltip( "Stop jam sync by removing all currently un-synchronised riffs, leaving the jam not up-to-date" );
-                                    }
-                                    else
-                                    {
-                                        if ( ImGui::Button( ICON_FA_ARROWS_ROTATE, buttonSizeMidTable ) )
-                                        {
-                                            triggerSyncOnJamInContentsReport( jI );
-                                        }
-                                        ImGui::CompactTooltip( "Update and download the latest metadata for this jam" );
-                                    }
-                                }
-
-                                // riffs
-                                {
-                                    ImGui::TableNextColumn();
-                                    ImGui::AlignTextToFramePadding();
-                                    ImGui::Text( "%" PRIi64, populatedRiffs );
-
-                                    if ( unpopulatedRiffs > 0 )
-                                    {
-                                        ImGui::SameLine( 0, 0 );
-                                        ImGui::TextColored( TextColourDownloading, " (+%" PRIi64 ")", unpopulatedRiffs );
-                                    }
-                                    else if ( knownCachedRiffCount > populatedRiffs )
-                                    {
-                                        ImGui::SameLine( 0, 0 );
-                                        ImGui::TextColored( TextColourDownloadable, " (" ICON_FA_ARROW_UP "%li)", knownCachedRiffCount - populatedRiffs );
-                                    }
-                                }
-                                // stems
-                                {
-                                    ImGui::TableNextColumn();
-                                    ImGui::AlignTextToFramePadding();
-                                    ImGui::Text( "%" PRIi64, populatedStems );
-
-                                    if ( unpopulatedStems > 0 )
-                                    {
-                                        ImGui::SameLine( 0, 0 );
-                                        ImGui::TextColored( TextColourDownloading, " (+%" PRIi64 ")", unpopulatedStems );
-                                    }
-                                }
-                            }
-
-                            // -----------------------------------------------------------------------------------------
-                            if ( warehouseView == WarehouseView::ContentsManagement )
-                            {
-                                // disable tools if we're syncing
-                                ImGui::Scoped::Disabled sd( bIsJamInFlux );
-
-                                if ( ImGui::Button( " " ICON_FA_LIST_CHECK " Cache ... " ) )
-                                {
-                                    const auto popupLabel = fmt::format( FMTX( "Precache All Stems : {}###precache_modal" ), m_warehouseContentsReportJamTitles[jI] );
+                            if ( jamNameFilter.PassFilter( jamNameToFilterAgainst.c_str(), &jamNameToFilterAgainst.back() + 1 ) )
+                                m_warehouseContentsFilteredIndices.emplace_back( jI );
+                        }
 
-                                    // create and launch the precache tool w. attached state
-                                    activateModalPopup( popupLabel, [
-                                        this,
-                                            &riffFetchProvider,
-                                            state = ux::createJamPrecacheState( iterCurrentJamID )](const char* title)
-                                        {
-                                            ux::modalJamPrecache( title, *state, *m_warehouse, riffFetchProvider, getTaskExecutor() );
-                                        });
-                                }
-                                ImGui::CompactTooltip( "Open a utility that allows you to download all stems for this jam,\nallowing for fully offline browsing and archival" );
-                            }
-                            else
-                            if ( warehouseView == WarehouseView::ImportExport )
+                        // kick off metadata and/or stem exports for one jam; called from the row buttons and, for Export All,
+                        // for every jam that passes the filter rather than just those the clipper draws
+                        const auto exportJam = [&]( const std::size_t jI, const bool bExportData, const bool bExportStems )
                             {
-                                // flags used to kick off export tasks below, allowing us to have separate or combined 'do both' buttons
-                                // as well as force them all to trigger if requested
-                                bool bExportData = m_bTriggerExportAllJams;
-                                bool bExportStems = m_bTriggerExportAllJams;
-
-                                // disable tools if we're syncing
-                                ImGui::Scoped::Disabled sd( bIsJamInFlux );
-
-                                if ( ImGui::GetMergedModFlags() & ImGuiModFlags_Alt )
-                                {
-                                    if ( ImGui::Button( " " ICON_FA_BOX_ARCHIVE   " Metadata " ) )
-                                    {
-                                        bExportData = true;
-                                    }
-                                    ImGui::CompactTooltip( "Begin an export process to archive this jam's database records to a file on disk" );
-                                    ImGui::SameLine();
-
-                                    if ( ImGui::Button( " " ICON_FA_BOXES_PACKING " Stems    " ) )
-                                    {
-                                        bExportStems = true;
-                                    }
-                                    ImGui::CompactTooltip( "Begin the process to bundle up all stems from this jam into a .tar archive" );
-                                }
-                                else
-                                {
-                                    if ( ImGui::Button( " " ICON_FA_BOX_ARCHIVE   " Metadata & Stems     " ) )
-                                    {
-                                        bExportData = true;
-                                        bExportStems = true;
-                                    }
-                                    ImGui::CompactTooltip( "Begin the process to bundle up both the data and all stems from this jam into a paired .tar archive + .yaml" );
-                                }
+                                const auto iterCurrentJamID = m_warehouseContentsReport.m_jamCouchIDs[jI];
 
                                 if ( bExportData )
                                 {
@@ -4222,7 +4075,7 @@ int LoreApp::EntrypointOuro()
                                         addOperationToJam( iterCurrentJamID, exportOperationID );
 
                                         // spin up a background task to archive the stems into a .tar archive
-                                        getTaskExecutor().silent_async( [this, inputPath, outputPath, exportFile = std::move( exportFilenameTar ), exportOperationID]()
+                                        getTaskExecutorIO().silent_async( [this, inputPath, outputPath, exportFile = std::move( exportFilenameTar ), exportOperationID]()
                                             {
                                                 base::EventBusClient m_eventBusClient( m_appEventBus );
                                                 OperationCompleteOnScopeExit( exportOperationID );
@@ -4257,58 +4110,244 @@ int LoreApp::EntrypointOuro()
                                             });
                                     }
                                 }
-                            }
-                            else
-                            if ( warehouseView == WarehouseView::Advanced )
+                            };
+
+                        if ( m_bTriggerExportAllJams && warehouseView == WarehouseView::ImportExport )
+                        {
+                            for ( const std::size_t jI : m_warehouseContentsFilteredIndices )
+                                exportJam( jI, true, true );
+                        }
+
+                        ImGuiListClipper warehouseClipper;
+                        warehouseClipper.Begin( (int32_t)m_warehouseContentsFilteredIndices.size() );
+                        while ( warehouseClipper.Step() )
+                        {
+                            for ( int32_t row = warehouseClipper.DisplayStart; row < warehouseClipper.DisplayEnd; row++ )
                             {
-                                const char* jamBandID = iterCurrentJamID.c_str();
+                                const std::size_t jI            = m_warehouseContentsFilteredIndices[row];
+                                const int64_t unpopulatedRiffs  = m_warehouseContentsReport.m_unpopulatedRiffs[jI];
+                                const int64_t populatedRiffs    = m_warehouseContentsReport.m_populatedRiffs[jI];
+                                const int64_t unpopulatedStems  = m_warehouseContentsReport.m_unpopulatedStems[jI];
+                                const int64_t populatedStems    = m_warehouseContentsReport.m_populatedStems[jI];
 
-#if OURO_HAS_NDLS_ONLINE
+                                const auto iterCurrentJamID     = m_warehouseContentsReport.m_jamCouchIDs[jI];
+
+                                const auto knownCachedRiffCount = m_jamLibrary.loadKnownRiffCountForDatabaseID( iterCurrentJamID );
+
+                                const bool bIsJamInFlux         = m_warehouseContentsReportJamInFlux[jI] || doesJamHaveActiveOperations( iterCurrentJamID );
+                                const bool bHasDataToSync       = (unpopulatedRiffs > 0 || knownCachedRiffCount > populatedRiffs);
+
+                                ImGui::PushID( (int32_t)jI );
+                                ImGui::TableNextColumn();
+
+                                // highlight or lowlight column based on state
+                                if ( bIsJamInFlux )
+                                    ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg0, ImGui::GetSyncBusyColour( 0.2f ) );
+                                if ( m_currentViewedJam == iterCurrentJamID )
+                                    ImGui::TableSetBgColor( ImGuiTableBgTarget_RowBg0, ImGui::GetColorU32( ImGuiCol_TableRowBgAlt, 2.5f ) );
+
+                                // always show the view-this-jam button regardless of mode
+                                {
+                                    if ( bIsJamInFlux )
+                                    {
+                                        ImGui::Dummy( { 8, 2 } );
+                                        ImGui::SameLine( 0, 0 );
+                                        ImGui::Spinner( "##syncing", true, ImGui::GetTextLineHeight() * 0.4f, 3.0f, 1.5f, ImGui::GetColorU32( ImGuiCol_Text ) );
+                                    }
+                                    else
+                                    {
+                                        if ( ImGui::PrecisionButton( ICON_FA_GRIP, buttonSizeMidTable, 1.0f ) )
+                                        {
+                                            beginChangeToViewJam( iterCurrentJamID );
+                                        }
+                                    }
+
+                                    ImGui::TableNextColumn();
+                                }
+                                // .. followed by the jam name
+                                {
+                                    ImGui::AlignTextToFramePadding();
+                                    ImGui::TextUnformatted( m_warehouseContentsReportJamTitles[jI].c_str() );
+                                    ImGui::TableNextColumn();
+                                }
+
+
+                                // -----------------------------------------------------------------------------------------
+                                if ( warehouseView == WarehouseView::Default )
+                                {
+                                    if ( bWarehouseHasEndlesssAccess )
+                                    {
+                                        if ( bIsJamInFlux )
+                                        {
+                                            // handle the option to abort the sync .. by nuking the jam
+                                            {
+                                                // only show the abort button after a delay so there are less chances of a mis-click
+                                                // given that it purges the jam entirely
+                                                const bool bNotEnoughTimePassedSinceAbortShown = !m_warehouseContentsReportJamInFluxMoment[jI].hasPassed();
+                                                ImGui::Scoped::Disabled se( bNotEnoughTimePassedSinceAbortShown || !bHasDataToSync );
+                                                ImGui::Scoped::ColourButton cb( colour::shades::errors, colour::shades::white );
+                                                if ( ImGui::Button( ICON_FA_BAN, buttonSizeMidTable ) )
+                                                {
+                                                    m_warehouse->requestJamSyncAbort( iterCurrentJamID );
+                                                    // push the abort task timer way forward to immediately disable the button
+                                                    m_warehouseContentsReportJamInFluxMoment[jI].setToFuture( std::chrono::hours( 1 ) );
+                                                }
+                                            }
+                                            ImGui::CompactTooltip( "Stop jam sync by removing all currently un-synchronised riffs, leaving the jam not up-to-date" );
+                                        }
+                                        else
+                                        {
+                                            if ( ImGui::Button( ICON_FA_ARROWS_ROTATE, buttonSizeMidTable ) )
+                                            {
+                                                triggerSyncOnJamInContentsReport( jI );
+                                            }
+                                            ImGui::CompactTooltip( "Update and download the latest metadata for this jam" );
+                                        }
+                                    }
+
+                                    // riffs
+                                    {
+                                        ImGui::TableNextColumn();
+                                        ImGui::AlignTextToFramePadding();
+                                        ImGui::Text( "%" PRIi64, populatedRiffs );
+
+                                        if ( unpopulatedRiffs > 0 )
+                                        {
+                                            ImGui::SameLine( 0, 0 );
+                                            ImGui::TextColored( TextColourDownloading, " (+%" PRIi64 ")", unpopulatedRiffs );
+                                        }
+                                        else if ( knownCachedRiffCount > populatedRiffs )
+                                        {
+                                            ImGui::SameLine( 0, 0 );
+                                            ImGui::TextColored( TextColourDownloadable, " (" ICON_FA_ARROW_UP "%li)", knownCachedRiffCount - populatedRiffs );
+                                        }
+                                    }
+                                    // stems
+                                    {
+                                        ImGui::TableNextColumn();
+                                        ImGui::AlignTextToFramePadding();
+                                        ImGui::Text( "%" PRIi64, populatedStems );
+
+                                        if ( unpopulatedStems > 0 )
+                                        {
+                                            ImGui::SameLine( 0, 0 );
+                                            ImGui::TextColored( TextColourDownloading, " (+%" PRIi64 ")", unpopulatedStems );
+                                        }
+                                    }
+                                }
+
+                                // -----------------------------------------------------------------------------------------
+                                if ( warehouseView == WarehouseView::ContentsManagement )
                                 {
                                     // disable tools if we're syncing
                                     ImGui::Scoped::Disabled sd( bIsJamInFlux );
 
-                                    if ( ImGui::Button( " " ICON_FA_MAGNIFYING_GLASS_PLUS " Validate " ) )
+                                    if ( ImGui::Button( " " ICON_FA_LIST_CHECK " Cache ... " ) )
                                     {
-                                        const auto popupLabel = fmt::format( FMTX( "Validation : {}###validate_modal" ), m_warehouseContentsReportJamTitles[jI] );
+                                        const auto popupLabel = fmt::format( FMTX( "Precache All Stems : {}###precache_modal" ), m_warehouseContentsReportJamTitles[jI] );
 
                                         // create and launch the precache tool w. attached state
                                         activateModalPopup( popupLabel, [
                                             this,
-                                                netCfg = getNetworkConfiguration(),
-                                                state = ux::createJamValidateState( iterCurrentJamID )](const char* title)
+                                                &riffFetchProvider,
+                                                state = ux::createJamPrecacheState( iterCurrentJamID )](const char* title)
                                             {
-                                                ux::modalJamValidate( title, *state, *m_warehouse, netCfg, getTaskExecutor() );
-                                            } );
+                                                ux::modalJamPrecache( title, *state, *m_warehouse, riffFetchProvider );
+                                            });
                                     }
-                                    ImGui::CompactTooltip( "Display tools for validating the data in the warehouse against the Endlesss server" );
+                                    ImGui::CompactTooltip( "Open a utility that allows you to download all stems for this jam,\nallowing for fully offline browsing and archival" );
                                 }
-                                ImGui::SameLine();
-#endif // OURO_HAS_NDLS_ONLINE
-
-                                ImGui::AlignTextToFramePadding();
-                                ImGui::TextDisabled( "%s", jamBandID );
-                                if ( ImGui::IsItemClicked() )
+                                else
+                                if ( warehouseView == WarehouseView::ImportExport )
                                 {
-                                    ImGui::SetClipboardText( jamBandID );
-                                }
-                                ImGui::CompactTooltip( jamBandID );
+                                    // flags used to kick off export tasks below, allowing us to have separate or combined 'do both' buttons;
+                                    // Export All is handled above the clipper so that it covers rows that aren't on screen
+                                    bool bExportData = false;
+                                    bool bExportStems = false;
 
+                                    // disable tools if we're syncing
+                                    ImGui::Scoped::Disabled sd( bIsJamInFlux );
 
-                                ImGui::TableNextColumn();
-                                ImGui::AlignTextToFramePadding();
+                                    if ( ImGui::GetMergedModFlags() & ImGuiModFlags_Alt )
+                                    {
+                                        if ( ImGui::Button( " " ICON_FA_BOX_ARCHIVE   " Metadata " ) )
+                                        {
+                                            bExportData = true;
+                                        }
+                                        ImGui::CompactTooltip( "Begin an export process to archive this jam's database records to a file on disk" );
+                                        ImGui::SameLine();
 
-                                // trashing a jam even in sync should be fine, given the way the warehouse works and
-                                // sequences operations. a purge will remove and future scanning for empty riffs & stems
-                                ImGui::Scoped::ColourButton cb( colour::shades::errors, colour::shades::white );
-                                if ( ImGui::Button( ICON_FA_TRASH_CAN, buttonSizeMidTable ) )
+                                        if ( ImGui::Button( " " ICON_FA_BOXES_PACKING " Stems    " ) )
+                                        {
+                                            bExportStems = true;
+                                        }
+                                        ImGui::CompactTooltip( "Begin the process to bundle up all stems from this jam into a .tar archive" );
+                                    }
+                                    else
+                                    {
+                                        if ( ImGui::Button( " " ICON_FA_BOX_ARCHIVE   " Metadata & Stems     " ) )
+                                        {
+                                            bExportData = true;
+                                            bExportStems = true;
+                                        }
+                                        ImGui::CompactTooltip( "Begin the process to bundle up both the data and all stems from this jam into a paired .tar archive + .yaml" );
+                                    }
+
+                                    if ( bExportData || bExportStems )
+                                        exportJam( jI, bExportData, bExportStems );
+                                }
+                                else
+                                if ( warehouseView == WarehouseView::Advanced )
                                 {
-                                    m_warehouse->requestJamPurge( iterCurrentJamID );
+                                    const char* jamBandID = iterCurrentJamID.c_str();
+
+#if OURO_HAS_NDLS_ONLINE
+                                    {
+                                        // disable tools if we're syncing
+                                        ImGui::Scoped::Disabled sd( bIsJamInFlux );
+
+                                        if ( ImGui::Button( " " ICON_FA_MAGNIFYING_GLASS_PLUS " Validate " ) )
+                                        {
+                                            const auto popupLabel = fmt::format( FMTX( "Validation : {}###validate_modal" ), m_warehouseContentsReportJamTitles[jI] );
+
+                                            // create and launch the precache tool w. attached state
+                                            activateModalPopup( popupLabel, [
+                                                this,
+                                                    netCfg = getNetworkConfiguration(),
+                                                    state = ux::createJamValidateState( iterCurrentJamID )](const char* title)
+                                                {
+                                                    ux::modalJamValidate( title, *state, *m_warehouse, netCfg, getTaskExecutorIO() );
+                                                } );
+                                        }
+                                        ImGui::CompactTooltip( "Display tools for validating the data in the warehouse against the Endlesss server" );
+                                    }
+                                    ImGui::SameLine();
+#endif // OURO_HAS_NDLS_ONLINE
+
+                                    ImGui::AlignTextToFramePadding();
+                                    ImGui::TextDisabled( "%s", jamBandID );
+                                    if ( ImGui::IsItemClicked() )
+                                    {
+                                        ImGui::SetClipboardText( jamBandID );
+                                    }
+                                    ImGui::CompactTooltip( jamBandID );
+
+
+                                    ImGui::TableNextColumn();
+                                    ImGui::AlignTextToFramePadding();
+
+                                    // trashing a jam even in sync should be fine, given the way the warehouse works and
+                                    // sequences operations. a purge will remove and future scanning for empty riffs & stems
+                                    ImGui::Scoped::ColourButton cb( colour::shades::errors, colour::shades::white );
+                                    if ( ImGui::Button( ICON_FA_TRASH_CAN, buttonSizeMidTable ) )
+                                    {
+                                        m_warehouse->requestJamPurge( iterCurrentJamID );
+                                    }
+                                    ImGui::CompactTooltip( "Request a deletion of the jam and all associated data" );
                                 }
-                                ImGui::CompactTooltip( "Request a deletion of the jam and all associated data" );
-                            }
 
-                            ImGui::PopID();
+                                ImGui::PopID();
+                            }
                         }
 
                         ImGui::EndTable();
@@ -4361,6 +4400,7 @@ int LoreApp::EntrypointOuro()
     m_riffPipeline.reset();
 
     m_discordBotUI.reset();
+    m_broadcastUI.reset();
 
     m_uxTagLine.reset();
     m_uxSharedRiffView.reset();